@@ -0,0 +1,100 @@
+#include <catch2/catch_all.hpp>
+#include <string>
+
+#include "bench_common.hpp"
+
+#include <DistGeom/BoundsMatrix.h>
+#include <DistGeom/DistGeomUtils.h>
+#include <DistGeom/TriangleSmooth.h>
+#include <ForceField/ForceField.h>
+#include <GraphMol/DistGeomHelpers/BoundsMatrixBuilder.h>
+#include <GraphMol/DistGeomHelpers/Embedder.h>
+#include <GraphMol/MolOps.h>
+#include <GraphMol/SmilesParse/SmilesParse.h>
+
+using namespace RDKit;
+
+namespace bench_distgeom {
+
+// linear polyalanine with explicit Hs: 10 atoms per residue
+std::unique_ptr<RWMol> polyalanine(unsigned int nResidues) {
+  std::string smiles = "N";
+  for (auto i = 0u; i < nResidues; ++i) {
+    smiles += "[C@@H](C)C(=O)N";
+  }
+  smiles += "C";
+  auto mol = v2::SmilesParse::MolFromSmiles(smiles);
+  REQUIRE(mol);
+  MolOps::addHs(*mol);
+  return mol;
+}
+
+DistGeom::BoundsMatPtr topolBounds(const ROMol &mol) {
+  DistGeom::BoundsMatPtr mat(new DistGeom::BoundsMatrix(mol.getNumAtoms()));
+  DGeomHelpers::initBoundsMat(mat);
+  DGeomHelpers::setTopolBounds(mol, mat);
+  return mat;
+}
+
+}  // namespace bench_distgeom
+
+TEST_CASE("DistGeom::triangleSmoothBounds scaling", "[distgeom]") {
+  for (auto nResidues : {10u, 30u, 60u}) {
+    auto mol = bench_distgeom::polyalanine(nResidues);
+    auto ref = bench_distgeom::topolBounds(*mol);
+    auto natoms = std::to_string(mol->getNumAtoms());
+
+    BENCHMARK("DistGeom::triangleSmoothBounds " + natoms + " atoms") {
+      DistGeom::BoundsMatrix mat(*ref);
+      return DistGeom::triangleSmoothBounds(&mat);
+    };
+    BENCHMARK("DistGeom::triangleSmoothBoundsBlocked " + natoms + " atoms") {
+      DistGeom::BoundsMatrix mat(*ref);
+      return DistGeom::triangleSmoothBoundsBlocked(&mat);
+    };
+    BENCHMARK("DistGeom::triangleSmoothBoundsBlocked " + natoms +
+              " atoms, all threads") {
+      DistGeom::BoundsMatrix mat(*ref);
+      return DistGeom::triangleSmoothBoundsBlocked(&mat, 0., 0);
+    };
+  }
+}
+
+TEST_CASE("DistGeom::constructForceField minimize", "[distgeom]") {
+  auto mol = bench_distgeom::polyalanine(10);
+  auto bounds = bench_distgeom::topolBounds(*mol);
+  REQUIRE(DistGeom::triangleSmoothBounds(bounds));
+  auto natoms = std::to_string(mol->getNumAtoms());
+  DistGeom::VECT_CHIRALSET csets;
+
+  BENCHMARK("DistGeom::constructForceField minimize " + natoms + " atoms") {
+    std::vector<RDGeom::Point3D> coords(mol->getNumAtoms());
+    RDGeom::PointPtrVect positions;
+    for (auto &pt : coords) {
+      positions.push_back(&pt);
+    }
+    DistGeom::computeRandomCoords(positions, 20.0, 42);
+    std::unique_ptr<ForceFields::ForceField> field(
+        DistGeom::constructForceField(*bounds, positions, csets, 1.0, 1.0,
+                                      0.1, nullptr));
+    field->initialize();
+    field->minimize(200);
+    return field->calcEnergy();
+  };
+}
+
+TEST_CASE("DGeomHelpers::EmbedMolecule", "[distgeom]") {
+  auto mol = bench_distgeom::polyalanine(4);
+  auto params = DGeomHelpers::ETKDGv3;
+  params.randomSeed = 42;
+  BENCHMARK("DGeomHelpers::EmbedMolecule ETKDGv3") {
+    RWMol cp(*mol);
+    return DGeomHelpers::EmbedMolecule(cp, params);
+  };
+  params = DGeomHelpers::KDG;
+  params.randomSeed = 42;
+  BENCHMARK("DGeomHelpers::EmbedMolecule KDG") {
+    RWMol cp(*mol);
+    return DGeomHelpers::EmbedMolecule(cp, params);
+  };
+}
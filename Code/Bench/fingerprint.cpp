@@ -1,10 +1,19 @@
 #include <catch2/catch_all.hpp>
+#include <numeric>
 #include <string>
 
 #include "bench_common.hpp"
 
 #include <GraphMol/SmilesParse/SmilesParse.h>
+#include <GraphMol/MolOps.h>
 #include <GraphMol/Fingerprints/MorganGenerator.h>
+#include <GraphMol/Fingerprints/AtomPairGenerator.h>
+#include <GraphMol/Fingerprints/CombinedFingerprintGenerator.h>
+#include <GraphMol/Fingerprints/RDKitFPGenerator.h>
+#include <GraphMol/Fingerprints/TopologicalTorsionGenerator.h>
+#include <GraphMol/Fingerprints/MorganEnvironmentCache.h>
+#include <GraphMol/Fingerprints/MHFP.h>
+#include <GraphMol/Fingerprints/MHFPLSHForest.h>
 
 using namespace RDKit;
 
@@ -23,3 +32,256 @@ TEST_CASE("MorganFingerprints::getFingerprint", "[fingerprint]") {
     return sum;
   };
 }
+
+TEST_CASE("FingerprintGenerator::fillFingerprints", "[fingerprint]") {
+  auto samples = bench_common::load_samples();
+  std::vector<const ROMol *> mols;
+  for (const auto &mol : samples) {
+    mols.push_back(&mol);
+  }
+  std::unique_ptr<FingerprintGenerator<std::uint64_t>> gen(
+      MorganFingerprint::getMorganGenerator<std::uint64_t>(2));
+  std::vector<std::uint8_t> buffer(mols.size() *
+                                   gen->getOptions()->d_fpSize);
+
+  BENCHMARK("FingerprintGenerator::getFingerprints") {
+    return gen->getFingerprints(mols);
+  };
+  BENCHMARK("FingerprintGenerator::fillFingerprints") {
+    gen->fillFingerprints(mols, buffer.data());
+    return buffer[0];
+  };
+  BENCHMARK("FingerprintGenerator::fillCountFingerprints") {
+    gen->fillCountFingerprints(mols, buffer.data());
+    return buffer[0];
+  };
+}
+
+TEST_CASE("CombinedFingerprintGenerator::getFingerprints", "[fingerprint]") {
+  auto samples = bench_common::load_samples();
+  std::vector<std::unique_ptr<FingerprintGenerator<std::uint64_t>>> gens;
+  gens.emplace_back(MorganFingerprint::getMorganGenerator<std::uint64_t>(
+      2, false, true, true, false, false));
+  gens.emplace_back(
+      AtomPair::getAtomPairGenerator<std::uint64_t>(1, 30, true, true));
+  gens.emplace_back(
+      TopologicalTorsion::getTopologicalTorsionGenerator<std::uint64_t>(
+          true));
+  gens.emplace_back(RDKitFP::getRDKitFPGenerator<std::uint64_t>());
+  CombinedFingerprintGenerator combined;
+  for (const auto &gen : gens) {
+    combined.addGenerator(gen.get());
+  }
+
+  BENCHMARK("chiral Morgan, AtomPair, TopologicalTorsion, RDKit separately") {
+    auto sum = 0;
+    for (const auto &mol : samples) {
+      for (const auto &gen : gens) {
+        std::unique_ptr<ExplicitBitVect> fp(gen->getFingerprint(mol));
+        sum += fp->getNumOnBits();
+      }
+    }
+    return sum;
+  };
+  BENCHMARK("chiral Morgan, AtomPair, TopologicalTorsion, RDKit combined") {
+    auto sum = 0;
+    for (const auto &mol : samples) {
+      for (const auto &fp : combined.getFingerprints(mol)) {
+        sum += fp->getNumOnBits();
+      }
+    }
+    return sum;
+  };
+}
+
+TEST_CASE("RDKitFP streamed paths", "[fingerprint]") {
+  // large natural products: paclitaxel, erythromycin, cyclosporin A and
+  // strychnine
+  std::vector<std::unique_ptr<ROMol>> mols;
+  for (const auto smi : {
+           "CC1=C2[C@@]([C@]([C@H]([C@@H]3[C@]4([C@H](OC4)C[C@@H]([C@]3(C(=O)"
+           "[C@@H]2OC(=O)C)C)O)OC(=O)C)OC(=O)c5ccccc5)(C[C@@H]1OC(=O)[C@H](O)"
+           "[C@@H](NC(=O)c6ccccc6)c7ccccc7)O)(C)C",
+           "CC[C@@H]1[C@@]([C@@H]([C@H](C(=O)[C@@H](C[C@@]([C@@H]([C@H]([C@@H]"
+           "([C@H](C(=O)O1)C)O[C@H]2C[C@@]([C@H]([C@@H](O2)C)O)(C)OC)C)O[C@H]3"
+           "[C@@H]([C@H](C[C@H](O3)C)N(C)C)O)(C)O)C)C)O)(C)O",
+           "CC[C@H]1C(=O)N(CC(=O)N([C@H](C(=O)N[C@H](C(=O)N([C@H](C(=O)N[C@H]("
+           "C(=O)N[C@@H](C(=O)N([C@H](C(=O)N([C@H](C(=O)N([C@H](C(=O)N([C@H]("
+           "C(=O)N1)[C@@H]([C@H](C)C/C=C/C)O)C)C(C)C)C)CC(C)C)C)CC(C)C)C)C)C)"
+           "CC(C)C)C)C(C)C)CC(C)C)C)C",
+           "O=C7N2c1ccccc1[C@@]64[C@@H]2[C@@H]3[C@@H](OC/C=C5\\[C@@H]3C[C@@H]6N"
+           "(CC4)C5)C7"}) {
+    mols.emplace_back(SmilesToMol(smi));
+    REQUIRE(mols.back());
+  }
+  for (auto branchedPaths : {true, false}) {
+    RDKitFP::RDKitFPArguments args(1, 7, true, branchedPaths);
+    std::unique_ptr<FingerprintGenerator<std::uint64_t>> gen(
+        RDKitFP::getRDKitFPGenerator<std::uint64_t>(args));
+    args.df_streamPaths = true;
+    std::unique_ptr<FingerprintGenerator<std::uint64_t>> streamGen(
+        RDKitFP::getRDKitFPGenerator<std::uint64_t>(args));
+    const std::string which = branchedPaths ? "subgraphs" : "paths";
+
+    BENCHMARK("RDKitFP " + which + ", collected") {
+      auto sum = 0;
+      for (const auto &mol : mols) {
+        std::unique_ptr<ExplicitBitVect> fp(gen->getFingerprint(*mol));
+        sum += fp->getNumOnBits();
+      }
+      return sum;
+    };
+    BENCHMARK("RDKitFP " + which + ", streamed") {
+      auto sum = 0;
+      for (const auto &mol : mols) {
+        std::unique_ptr<ExplicitBitVect> fp(streamGen->getFingerprint(*mol));
+        sum += fp->getNumOnBits();
+      }
+      return sum;
+    };
+  }
+}
+
+TEST_CASE("MorganEnvironmentCache", "[fingerprint]") {
+  auto samples = bench_common::load_samples();
+  const auto radius = 2;
+  std::unique_ptr<FingerprintGenerator<std::uint32_t>> gen(
+      MorganFingerprint::getMorganGenerator<std::uint32_t>(radius));
+  // one analogue per sample, with an isotope label on the last atom
+  std::vector<MorganFingerprint::MorganEnvironmentCache> caches;
+  std::vector<RWMol> analogues;
+  std::vector<std::vector<int>> atomMaps;
+  for (const auto &mol : samples) {
+    caches.emplace_back(mol, radius);
+    analogues.emplace_back(mol);
+    analogues.back().getAtomWithIdx(mol.getNumAtoms() - 1)->setIsotope(13);
+    atomMaps.emplace_back(mol.getNumAtoms());
+    std::iota(atomMaps.back().begin(), atomMaps.back().end(), 0);
+  }
+
+  BENCHMARK("MorganEnvironmentCache analogues, generator") {
+    auto sum = 0;
+    for (const auto &mol : analogues) {
+      std::unique_ptr<ExplicitBitVect> fp(gen->getFingerprint(mol));
+      sum += fp->getNumOnBits();
+    }
+    return sum;
+  };
+  BENCHMARK("MorganEnvironmentCache analogues, cache") {
+    auto sum = 0;
+    for (size_t i = 0; i < analogues.size(); ++i) {
+      MorganFingerprint::MorganEnvironmentCache cache(caches[i], analogues[i],
+                                                      atomMaps[i]);
+      sum += cache.getFingerprint()->getNumOnBits();
+    }
+    return sum;
+  };
+}
+
+TEST_CASE("Morgan fingerprints with deferred sanitization", "[fingerprint]") {
+  std::vector<RWMol> unsanitized;
+  v2::SmilesParse::SmilesParserParams ps;
+  ps.sanitize = false;
+  for (const auto smi : bench_common::SAMPLES) {
+    unsanitized.push_back(*v2::SmilesParse::MolFromSmiles(smi, ps));
+  }
+  std::unique_ptr<FingerprintGenerator<std::uint64_t>> gen(
+      MorganFingerprint::getMorganGenerator<std::uint64_t>(2));
+
+  BENCHMARK("Morgan fingerprints, sanitizeMol") {
+    auto sum = 0;
+    for (const auto &mol : unsanitized) {
+      RWMol copy(mol);
+      MolOps::sanitizeMol(copy);
+      std::unique_ptr<ExplicitBitVect> fp(gen->getFingerprint(copy));
+      sum += fp->getNumOnBits();
+    }
+    return sum;
+  };
+  BENCHMARK("Morgan fingerprints, deferSanitization") {
+    auto sum = 0;
+    for (const auto &mol : unsanitized) {
+      RWMol copy(mol);
+      MolOps::deferSanitization(copy);
+      std::unique_ptr<ExplicitBitVect> fp(gen->getFingerprint(copy));
+      sum += fp->getNumOnBits();
+    }
+    return sum;
+  };
+}
+
+TEST_CASE("MHFPEncoder::EncodeMols", "[fingerprint]") {
+  auto samples = bench_common::load_samples();
+  std::vector<const ROMol *> mols;
+  for (const auto &mol : samples) {
+    mols.push_back(&mol);
+  }
+  MHFPFingerprints::MHFPEncoder encoder(2048);
+
+  BENCHMARK("MHFPEncoder::EncodeMols SMILES shingling") {
+    return encoder.EncodeMols(mols);
+  };
+  BENCHMARK("MHFPEncoder::EncodeMols Morgan shingling") {
+    return encoder.EncodeMols(mols, 3, true, false, false, 1,
+                              MHFPFingerprints::ShinglingType::Morgan);
+  };
+  BENCHMARK("MHFPEncoder::EncodeMols Morgan shingling, all threads") {
+    return encoder.EncodeMols(mols, 3, true, false, false, 1,
+                              MHFPFingerprints::ShinglingType::Morgan, 0);
+  };
+}
+
+TEST_CASE("MHFPLSHForest::query", "[fingerprint]") {
+  // groups of minhashes of overlapping sets, so that each query has a
+  // handful of true near neighbors
+  constexpr unsigned int numGroups = 1000;
+  constexpr unsigned int groupSize = 10;
+  constexpr unsigned int setSize = 40;
+  constexpr unsigned int k = 10;
+  MHFPFingerprints::MHFPEncoder encoder(128);
+  std::vector<std::vector<uint32_t>> fps;
+  uint64_t n = 0;
+  for (auto g = 0u; g < numGroups; ++g) {
+    std::vector<uint32_t> items(setSize);
+    for (auto &item : items) {
+      item = bench_common::nth_random(n++);
+    }
+    for (auto m = 0u; m < groupSize; ++m) {
+      auto variant = items;
+      for (auto v = 0u; v < m; ++v) {
+        const auto pos = bench_common::nth_random(n++) % setSize;
+        variant[pos] = bench_common::nth_random(n++);
+      }
+      fps.push_back(encoder.FromArray(variant));
+    }
+  }
+  MHFPFingerprints::MHFPLSHForest forest(128, 8);
+  for (const auto &fp : fps) {
+    forest.add(fp);
+  }
+  forest.index();
+  std::vector<std::vector<uint32_t>> queries;
+  for (auto i = 0u; i < fps.size(); i += 97) {
+    queries.push_back(fps[i]);
+  }
+
+  auto hits = forest.query(queries, k);
+  auto exact = forest.queryExact(queries, k);
+  auto found = 0u;
+  for (auto i = 0u; i < queries.size(); ++i) {
+    for (const auto &hit : exact[i]) {
+      found += std::find(hits[i].begin(), hits[i].end(), hit) != hits[i].end();
+    }
+  }
+  const auto recall = static_cast<double>(found) / (queries.size() * k);
+  WARN("MHFPLSHForest recall@" << k << ": " << recall);
+  CHECK(recall > 0.8);
+
+  BENCHMARK("MHFPLSHForest::query") { return forest.query(queries, k); };
+  BENCHMARK("MHFPLSHForest::query, all threads") {
+    return forest.query(queries, k, 10, 0);
+  };
+  BENCHMARK("MHFPLSHForest::queryExact") {
+    return forest.queryExact(queries, k);
+  };
+}
@@ -4,6 +4,9 @@
 #include "bench_common.hpp"
 
 #include <GraphMol/ROMol.h>
+#include <GraphMol/FrozenMol.h>
+#include <GraphMol/Descriptors/MolDescriptors.h>
+#include <GraphMol/Fingerprints/MorganEnvironmentCache.h>
 #include <GraphMol/SmilesParse/SmilesParse.h>
 
 using namespace RDKit;
@@ -70,3 +73,96 @@ TEST_CASE("ROMol::getNumHeavyAtoms", "[mol]") {
     return sum;
   };
 }
+
+TEST_CASE("ROMol properties", "[mol]") {
+  auto samples = bench_common::load_samples();
+  for (auto &mol : samples) {
+    for (auto atom : mol.atoms()) {
+      atom->setProp("label", std::to_string(atom->getIdx()));
+    }
+  }
+  BENCHMARK("ROMol::getPropIfPresent") {
+    auto sum = 0;
+    for (const auto &mol : samples) {
+      for (const auto atom : mol.atoms()) {
+        int rank = 0;
+        sum += atom->hasProp(common_properties::molAtomMapNumber);
+        sum += atom->getPropIfPresent(common_properties::_CIPRank, rank);
+        sum += atom->getProp<std::string>("label").size();
+      }
+    }
+    return sum;
+  };
+  BENCHMARK("ROMol copy and set a property") {
+    auto sum = 0;
+    for (const auto &mol : samples) {
+      ROMol copy(mol);
+      copy.getAtomWithIdx(0)->setProp("label", std::string("first"));
+      sum += copy.getNumAtoms();
+    }
+    return sum;
+  };
+}
+
+TEST_CASE("FrozenMol", "[mol]") {
+  auto samples = bench_common::load_samples();
+  std::vector<FrozenMol> frozen;
+  for (const auto &mol : samples) {
+    frozen.emplace_back(mol);
+  }
+  BENCHMARK("FrozenMol constructor") {
+    auto sum = 0;
+    for (const auto &mol : samples) {
+      FrozenMol fm(mol);
+      sum += fm.getNumAtoms();
+    }
+    return sum;
+  };
+  BENCHMARK("FrozenMol copy constructor") {
+    auto sum = 0;
+    for (const auto &fm : frozen) {
+      FrozenMol copy(fm);
+      sum += copy.getNumAtoms();
+    }
+    return sum;
+  };
+  BENCHMARK("FrozenMol::toMol") {
+    auto sum = 0;
+    for (const auto &fm : frozen) {
+      sum += fm.toMol()->getNumAtoms();
+    }
+    return sum;
+  };
+  BENCHMARK("descriptors ROMol") {
+    double sum = 0;
+    for (const auto &mol : samples) {
+      sum += Descriptors::calcExactMW(mol) + Descriptors::calcFractionCSP3(mol) +
+             Descriptors::calcNumAromaticRings(mol);
+    }
+    return sum;
+  };
+  BENCHMARK("descriptors FrozenMol") {
+    double sum = 0;
+    for (const auto &fm : frozen) {
+      sum += Descriptors::calcExactMW(fm) + Descriptors::calcFractionCSP3(fm) +
+             Descriptors::calcNumAromaticRings(fm);
+    }
+    return sum;
+  };
+  BENCHMARK("MorganEnvironmentCache ROMol") {
+    auto sum = 0;
+    for (const auto &mol : samples) {
+      MorganFingerprint::MorganEnvironmentCache cache(mol, 2);
+      sum += cache.getFingerprint()->getNumOnBits();
+    }
+    return sum;
+  };
+  BENCHMARK("MorganEnvironmentCache FrozenMol") {
+    auto sum = 0;
+    for (const auto &fm : frozen) {
+      MorganFingerprint::MorganEnvironmentCache cache(fm, 2);
+      sum += cache.getFingerprint()->getNumOnBits();
+    }
+    return sum;
+  };
+}
@@ -46,3 +46,33 @@ TEST_CASE("MolOps::getMolFrags", "[molops]") {
     return total;
   };
 }
+
+TEST_CASE("MolOps::symmetrizeSSSR", "[molops]") {
+  auto samples = bench_common::load_samples();
+  BENCHMARK("MolOps::symmetrizeSSSR") {
+    auto total = 0;
+    for (auto &mol : samples) {
+      mol.getRingInfo()->reset();
+      total += MolOps::symmetrizeSSSR(mol);
+    }
+    return total;
+  };
+  BENCHMARK("MolOps::symmetrizeSSSR legacy") {
+    auto total = 0;
+    for (auto &mol : samples) {
+      mol.getRingInfo()->reset();
+      total += MolOps::symmetrizeSSSR(
+          mol, MolOps::SymmetrizeSSSRAlgorithm::LEGACY);
+    }
+    return total;
+  };
+  BENCHMARK("MolOps::fastFindRings") {
+    auto total = 0;
+    for (auto &mol : samples) {
+      mol.getRingInfo()->reset();
+      MolOps::fastFindRings(mol);
+      total += mol.getRingInfo()->numRings();
+    }
+    return total;
+  };
+}
@@ -11,6 +11,7 @@
 #include "DistViolationContribs.h"
 #include <ForceField/ForceField.h>
 #include <RDGeneral/Invariant.h>
+#include <Numerics/Optimizer/BFGSOpt_AVX2.h>
 
 namespace DistGeom {
 
@@ -36,6 +37,123 @@ inline double distance(const unsigned int idx1, const unsigned int idx2,
   return sqrt(distance2(idx1, idx2, pos, dim));
 }
 
+#ifdef RDK_AVX2_AVAILABLE
+namespace {
+// The AVX2 kernels below evaluate the contributions four at a time; the
+// coordinates of the end points are gathered and the bound checks become lane
+// masks. The arithmetic follows the scalar code operation by operation (no
+// FMA) and the per-contribution terms are summed, or scattered into the
+// gradient, in the original order, so the results are identical to the scalar
+// code. Whatever does not fill a complete group of four is left to the scalar
+// code.
+
+__attribute__((target("avx2"))) inline __m256d avx2Distance2(
+    const DistViolationContribsParams *c, const double *pos, unsigned int dim) {
+  const __m128i i1 = _mm_setr_epi32(dim * c[0].idx1, dim * c[1].idx1,
+                                    dim * c[2].idx1, dim * c[3].idx1);
+  const __m128i i2 = _mm_setr_epi32(dim * c[0].idx2, dim * c[1].idx2,
+                                    dim * c[2].idx2, dim * c[3].idx2);
+  __m256d d2 = _mm256_setzero_pd();
+  for (unsigned int k = 0; k < dim; ++k) {
+    const __m256d d = _mm256_sub_pd(_mm256_i32gather_pd(pos + k, i1, 8),
+                                    _mm256_i32gather_pd(pos + k, i2, 8));
+    d2 = _mm256_add_pd(d2, _mm256_mul_pd(d, d));
+  }
+  return d2;
+}
+
+__attribute__((target("avx2"))) unsigned int avx2Energy(
+    const std::vector<DistViolationContribsParams> &contribs, const double *pos,
+    unsigned int dim, double &accum) {
+  const __m256d zero = _mm256_setzero_pd();
+  const __m256d one = _mm256_set1_pd(1.0);
+  const __m256d two = _mm256_set1_pd(2.0);
+  alignas(32) double terms[4];
+  unsigned int ci = 0;
+  for (; ci + 4 <= contribs.size(); ci += 4) {
+    const auto *c = &contribs[ci];
+    const __m256d d2 = avx2Distance2(c, pos, dim);
+    const __m256d ub2 = _mm256_setr_pd(c[0].ub2, c[1].ub2, c[2].ub2, c[3].ub2);
+    const __m256d lb2 = _mm256_setr_pd(c[0].lb2, c[1].lb2, c[2].lb2, c[3].lb2);
+    const __m256d w =
+        _mm256_setr_pd(c[0].weight, c[1].weight, c[2].weight, c[3].weight);
+    const __m256d upper = _mm256_cmp_pd(d2, ub2, _CMP_GT_OQ);
+    const __m256d lower = _mm256_cmp_pd(d2, lb2, _CMP_LT_OQ);
+    const __m256d valU = _mm256_sub_pd(_mm256_div_pd(d2, ub2), one);
+    const __m256d valL = _mm256_sub_pd(
+        _mm256_div_pd(_mm256_mul_pd(two, lb2), _mm256_add_pd(lb2, d2)), one);
+    // the upper bound check wins, as in the scalar code
+    __m256d val = _mm256_blendv_pd(_mm256_blendv_pd(zero, valL, lower), valU,
+                                   upper);
+    val = _mm256_max_pd(val, zero);
+    _mm256_store_pd(terms, _mm256_mul_pd(_mm256_mul_pd(w, val), val));
+    accum += terms[0];
+    accum += terms[1];
+    accum += terms[2];
+    accum += terms[3];
+  }
+  return ci;
+}
+
+__attribute__((target("avx2"))) unsigned int avx2Grad(
+    const std::vector<DistViolationContribsParams> &contribs, const double *pos,
+    unsigned int dim, double *grad) {
+  const __m256d one = _mm256_set1_pd(1.0);
+  const __m256d two = _mm256_set1_pd(2.0);
+  const __m256d four = _mm256_set1_pd(4.0);
+  const __m256d eight = _mm256_set1_pd(8.0);
+  alignas(32) double preFactors[4];
+  alignas(32) double dists[4];
+  unsigned int ci = 0;
+  for (; ci + 4 <= contribs.size(); ci += 4) {
+    const auto *c = &contribs[ci];
+    const __m256d d2 = avx2Distance2(c, pos, dim);
+    const __m256d ub2 = _mm256_setr_pd(c[0].ub2, c[1].ub2, c[2].ub2, c[3].ub2);
+    const __m256d lb2 = _mm256_setr_pd(c[0].lb2, c[1].lb2, c[2].lb2, c[3].lb2);
+    const __m256d upper = _mm256_cmp_pd(d2, ub2, _CMP_GT_OQ);
+    const __m256d lower = _mm256_cmp_pd(d2, lb2, _CMP_LT_OQ);
+    const int active = _mm256_movemask_pd(_mm256_or_pd(upper, lower));
+    if (!active) {
+      continue;
+    }
+    const __m256d d = _mm256_sqrt_pd(d2);
+    const __m256d pfU = _mm256_mul_pd(
+        _mm256_mul_pd(four,
+                      _mm256_sub_pd(_mm256_div_pd(_mm256_mul_pd(d, d), ub2),
+                                    one)),
+        _mm256_div_pd(d, ub2));
+    const __m256d l2d2 = _mm256_add_pd(d2, lb2);
+    const __m256d pfL = _mm256_div_pd(
+        _mm256_mul_pd(
+            _mm256_mul_pd(_mm256_mul_pd(eight, lb2), d),
+            _mm256_sub_pd(one, _mm256_div_pd(_mm256_mul_pd(two, lb2), l2d2))),
+        _mm256_mul_pd(l2d2, l2d2));
+    _mm256_store_pd(preFactors, _mm256_blendv_pd(pfL, pfU, upper));
+    _mm256_store_pd(dists, d);
+    for (unsigned int lane = 0; lane < 4; ++lane) {
+      if (!(active & (1 << lane))) {
+        continue;
+      }
+      const double weightedPreFactor = c[lane].weight * preFactors[lane];
+      for (unsigned int i = 0; i < dim; i++) {
+        const auto p1 = dim * c[lane].idx1 + i;
+        const auto p2 = dim * c[lane].idx2 + i;
+        double dGrad;
+        if (dists[lane] > 0.0) {
+          dGrad = weightedPreFactor * (pos[p1] - pos[p2]) / dists[lane];
+        } else {
+          dGrad = weightedPreFactor * (pos[p1] - pos[p2]);
+        }
+        grad[p1] += dGrad;
+        grad[p2] -= dGrad;
+      }
+    }
+  }
+  return ci;
+}
+}  // namespace
+#endif
+
 double DistViolationContribs::getEnergy(double *pos) const {
   PRECONDITION(dp_forceField, "no owner");
   PRECONDITION(pos, "bad vector");
@@ -53,8 +171,14 @@ double DistViolationContribs::getEnergy(double *pos) const {
       accum += c.weight * val * val;
     }
   };
-  for (const auto &c : d_contribs) {
-    contrib(c);
+  unsigned int ci = 0;
+#ifdef RDK_AVX2_AVAILABLE
+  if (BFGSOpt::cpuHasAVX2()) {
+    ci = avx2Energy(d_contribs, pos, dp_forceField->dimension(), accum);
+  }
+#endif
+  for (; ci < d_contribs.size(); ++ci) {
+    contrib(d_contribs[ci]);
   }
   return accum;
 }
@@ -94,8 +218,14 @@ void DistViolationContribs::getGrad(double *pos, double *grad) const {
       grad[p2] -= dGrad;
     }
   };
-  for (const auto &c : d_contribs) {
-    contrib(c);
+  unsigned int ci = 0;
+#ifdef RDK_AVX2_AVAILABLE
+  if (BFGSOpt::cpuHasAVX2()) {
+    ci = avx2Grad(d_contribs, pos, dim, grad);
+  }
+#endif
+  for (; ci < d_contribs.size(); ++ci) {
+    contrib(d_contribs[ci]);
   }
 }
 }  // namespace DistGeom
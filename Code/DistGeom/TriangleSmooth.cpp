@@ -10,6 +10,15 @@
 #include "BoundsMatrix.h"
 #include "TriangleSmooth.h"
 
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include <RDGeneral/RDThreads.h>
+
+#ifdef RDK_BUILD_THREADSAFE_SSS
+#include <thread>
+#endif
+
 namespace DistGeom {
 bool triangleSmoothBounds(BoundsMatPtr boundsMat, double tol) {
   return triangleSmoothBounds(boundsMat.get(), tol);
@@ -68,4 +77,150 @@ bool triangleSmoothBounds(BoundsMatrix *boundsMat, double tol) {
   }
   return true;
 }
+
+namespace {
+// Dense, symmetric working copy of the bounds used by the blocked smoothing.
+// Keeping both triangles of the upper and lower bounds lets every tile be
+// processed with unit-stride row accesses.
+struct SmoothingWorkspace {
+  unsigned int n;
+  double tol;
+  std::vector<double> upper;
+  std::vector<double> lower;
+  std::atomic<bool> failed{false};
+
+  SmoothingWorkspace(const BoundsMatrix &bm, double tolerance)
+      : n(bm.numRows()), tol(tolerance), upper(n * n, 0.0), lower(n * n, 0.0) {
+    for (auto i = 0u; i < n; ++i) {
+      for (auto j = i + 1; j < n; ++j) {
+        upper[i * n + j] = upper[j * n + i] = bm.getValUnchecked(i, j);
+        lower[i * n + j] = lower[j * n + i] = bm.getValUnchecked(j, i);
+      }
+    }
+  }
+
+  void copyTo(BoundsMatrix &bm) const {
+    for (auto i = 0u; i < n; ++i) {
+      for (auto j = i + 1; j < n; ++j) {
+        bm.setValUnchecked(i, j, upper[i * n + j]);
+        bm.setValUnchecked(j, i, lower[i * n + j]);
+      }
+    }
+  }
+
+  // relax the tile [i0,i1) x [j0,j1) through the pivots [k0,k1)
+  void relaxTile(unsigned int i0, unsigned int i1, unsigned int j0,
+                 unsigned int j1, unsigned int k0, unsigned int k1) {
+    for (auto k = k0; k < k1; ++k) {
+      const double *Uk = &upper[k * n];
+      const double *Lk = &lower[k * n];
+      for (auto i = i0; i < i1; ++i) {
+        double *Ui = &upper[i * n];
+        double *Li = &lower[i * n];
+        const auto Uik = Ui[k];
+        const auto Lik = Li[k];
+        for (auto j = j0; j < j1; ++j) {
+          Ui[j] = std::min(Ui[j], Uik + Uk[j]);
+          Li[j] = std::max(Li[j], std::max(Lik - Uk[j], Lk[j] - Uik));
+        }
+        for (auto j = j0; j < j1; ++j) {
+          if (Li[j] > Ui[j]) {
+            if (tol > 0. && (Li[j] - Ui[j]) / Li[j] < tol) {
+              Ui[j] = Li[j];
+            } else {
+              failed = true;
+              return;
+            }
+          }
+        }
+      }
+    }
+  }
+};
+
+void relaxTiles(SmoothingWorkspace &ws,
+                const std::vector<std::pair<unsigned int, unsigned int>> &tiles,
+                unsigned int blockSize, unsigned int k0, unsigned int k1,
+                unsigned int numThreads) {
+  auto worker = [&](unsigned int tidx, unsigned int stride) {
+    for (auto ti = tidx; ti < tiles.size() && !ws.failed; ti += stride) {
+      auto i0 = tiles[ti].first * blockSize;
+      auto j0 = tiles[ti].second * blockSize;
+      ws.relaxTile(i0, std::min(i0 + blockSize, ws.n), j0,
+                   std::min(j0 + blockSize, ws.n), k0, k1);
+    }
+  };
+#ifdef RDK_BUILD_THREADSAFE_SSS
+  if (numThreads > 1 && tiles.size() > 1) {
+    std::vector<std::thread> tg;
+    for (auto ti = 0u; ti < numThreads; ++ti) {
+      tg.emplace_back(worker, ti, numThreads);
+    }
+    for (auto &thread : tg) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+    return;
+  }
+#else
+  RDUNUSED_PARAM(numThreads);
+#endif
+  worker(0, 1);
+}
+}  // namespace
+
+bool triangleSmoothBoundsBlocked(BoundsMatPtr boundsMat, double tol,
+                                 int numThreads, unsigned int blockSize) {
+  return triangleSmoothBoundsBlocked(boundsMat.get(), tol, numThreads,
+                                     blockSize);
+}
+
+bool triangleSmoothBoundsBlocked(BoundsMatrix *boundsMat, double tol,
+                                 int numThreads, unsigned int blockSize) {
+  PRECONDITION(boundsMat, "bad bounds matrix");
+  PRECONDITION(blockSize > 0, "blockSize must be positive");
+  SmoothingWorkspace ws(*boundsMat, tol);
+  const auto nBlocks = (ws.n + blockSize - 1) / blockSize;
+  const auto nThreads = RDKit::getNumThreadsToUse(numThreads);
+
+  std::vector<std::pair<unsigned int, unsigned int>> tiles;
+  tiles.reserve(nBlocks * nBlocks);
+  for (auto kb = 0u; kb < nBlocks && !ws.failed; ++kb) {
+    const auto k0 = kb * blockSize;
+    const auto k1 = std::min(k0 + blockSize, ws.n);
+    // the pivot tile depends only on itself
+    ws.relaxTile(k0, k1, k0, k1, k0, k1);
+    if (ws.failed) {
+      break;
+    }
+    // tiles sharing a row or a column with the pivot tile
+    tiles.clear();
+    for (auto b = 0u; b < nBlocks; ++b) {
+      if (b != kb) {
+        tiles.emplace_back(kb, b);
+        tiles.emplace_back(b, kb);
+      }
+    }
+    relaxTiles(ws, tiles, blockSize, k0, k1, nThreads);
+    if (ws.failed) {
+      break;
+    }
+    // everything else
+    tiles.clear();
+    for (auto ib = 0u; ib < nBlocks; ++ib) {
+      for (auto jb = 0u; jb < nBlocks; ++jb) {
+        if (ib != kb && jb != kb) {
+          tiles.emplace_back(ib, jb);
+        }
+      }
+    }
+    relaxTiles(ws, tiles, blockSize, k0, k1, nThreads);
+  }
+  if (ws.failed) {
+    return false;
+  }
+  ws.copyTo(*boundsMat);
+  return true;
+}
 }  // namespace DistGeom
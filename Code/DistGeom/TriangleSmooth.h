@@ -31,6 +31,36 @@ RDKIT_DISTGEOMETRY_EXPORT bool triangleSmoothBounds(BoundsMatrix *boundsMat,
 //! \overload
 RDKIT_DISTGEOMETRY_EXPORT bool triangleSmoothBounds(BoundsMatPtr boundsMat,
                                                     double tol = 0.);
+
+//! Cache-blocked, optionally multithreaded, version of triangleSmoothBounds()
+/*!
+  The bounds are smoothed using a tiled Floyd-Warshall scheme: the matrix is
+  split into \c blockSize x \c blockSize tiles and, for each block of pivot
+  points, the tiles which do not share a row or column with the pivot block
+  are processed independently (and in parallel when \c numThreads > 1).
+  The working set is a dense symmetric copy of the upper and lower bounds, so
+  this needs roughly twice the memory of the bounds matrix itself.
+
+  This is intended for large systems (many hundreds or thousands of points),
+  where it is considerably faster than triangleSmoothBounds(). The smoothed
+  bounds agree with those from triangleSmoothBounds() to within numerical
+  noise.
+
+  \param boundsMat  A pointer to the distance bounds matrix
+  \param tol   a tolerance (percent) for errors in the smoothing process
+  \param numThreads  the number of threads to use. If this is <= 0, the
+                     number of threads will be the number of hardware threads
+                     plus this value.
+  \param blockSize  the size of the tiles
+
+*/
+RDKIT_DISTGEOMETRY_EXPORT bool triangleSmoothBoundsBlocked(
+    BoundsMatrix *boundsMat, double tol = 0., int numThreads = 1,
+    unsigned int blockSize = 64);
+//! \overload
+RDKIT_DISTGEOMETRY_EXPORT bool triangleSmoothBoundsBlocked(
+    BoundsMatPtr boundsMat, double tol = 0., int numThreads = 1,
+    unsigned int blockSize = 64);
 }  // namespace DistGeom
 
 #endif
@@ -15,6 +15,8 @@
 #include <cmath>
 #include <Numerics/SymmMatrix.h>
 #include "DistGeomUtils.h"
+#include "DistViolationContribs.h"
+#include <ForceField/ForceField.h>
 #include <RDGeneral/utils.h>
 
 using namespace DistGeom;
@@ -139,3 +141,133 @@ TEST_CASE("testIssue216") {
     delete pos[i];
   }
 }
+
+TEST_CASE("blocked triangle smoothing") {
+  // bounds derived from a random point cloud, with some of the pairs left
+  // unconstrained so that the smoothing has something to do
+  const unsigned int npt = 150;
+  std::vector<RDGeom::Point3D> pts;
+  RDKit::rng_type generator(42u);
+  RDKit::uniform_double dist(0, 1.0);
+  RDKit::double_source_type randSource(generator, dist);
+  for (auto i = 0u; i < npt; ++i) {
+    pts.emplace_back(10. * randSource(), 10. * randSource(),
+                     10. * randSource());
+  }
+  BoundsMatrix ref(npt);
+  for (auto i = 0u; i < npt; ++i) {
+    for (auto j = i + 1; j < npt; ++j) {
+      if (randSource() < 0.7) {
+        ref.setUpperBound(i, j, 100.0);
+        ref.setLowerBound(i, j, 0.0);
+      } else {
+        auto d = (pts[i] - pts[j]).length();
+        ref.setUpperBound(i, j, d + 0.1);
+        ref.setLowerBound(i, j, std::max(0.0, d - 0.1));
+      }
+    }
+  }
+  BoundsMatrix legacy(ref);
+  REQUIRE(triangleSmoothBounds(&legacy));
+
+  for (auto blockSize : {7u, 32u, 64u, 200u}) {
+    for (auto numThreads : {1, 4}) {
+      CAPTURE(blockSize, numThreads);
+      BoundsMatrix blocked(ref);
+      REQUIRE(triangleSmoothBoundsBlocked(&blocked, 0., numThreads, blockSize));
+      for (auto i = 0u; i < npt; ++i) {
+        for (auto j = i + 1; j < npt; ++j) {
+          REQUIRE_THAT(blocked.getUpperBound(i, j),
+                       Catch::Matchers::WithinAbs(legacy.getUpperBound(i, j),
+                                                  1e-8));
+          REQUIRE_THAT(blocked.getLowerBound(i, j),
+                       Catch::Matchers::WithinAbs(legacy.getLowerBound(i, j),
+                                                  1e-8));
+        }
+      }
+    }
+  }
+
+  SECTION("inconsistent bounds") {
+    BoundsMatrix bad(ref);
+    // 0-1 and 1-2 are short, 0-2 must be long
+    bad.setUpperBound(0, 1, 1.0);
+    bad.setLowerBound(0, 1, 0.5);
+    bad.setUpperBound(1, 2, 1.0);
+    bad.setLowerBound(1, 2, 0.5);
+    bad.setUpperBound(0, 2, 10.0);
+    bad.setLowerBound(0, 2, 5.0);
+    BoundsMatrix bad2(bad);
+    CHECK(!triangleSmoothBounds(&bad));
+    CHECK(!triangleSmoothBoundsBlocked(&bad2, 0., 2, 16));
+  }
+}
+
+TEST_CASE("DistViolationContribs energy and gradient") {
+  // the vectorised code paths must reproduce the scalar formulas exactly
+  RDKit::rng_type generator(42u);
+  RDKit::uniform_double dist(0, 1.0);
+  RDKit::double_source_type randSource(generator, dist);
+  for (auto dim : {3u, 4u}) {
+    const unsigned int npt = 23;
+    ForceFields::ForceField ff(dim);
+    DistViolationContribs contribs(&ff);
+    std::vector<double> pos(dim * npt);
+    for (auto &p : pos) {
+      p = 5. * randSource();
+    }
+    // coincident points hit the d == 0 case of the gradient
+    std::copy(pos.begin(), pos.begin() + dim, pos.begin() + dim);
+    struct Term {
+      unsigned int i, j;
+      double ub, lb, w;
+    };
+    std::vector<Term> terms;
+    for (auto i = 0u; i < npt; ++i) {
+      for (auto j = i + 1; j < npt; ++j) {
+        double lb = 4. * randSource();
+        double ub = lb + 2. * randSource();
+        double w = 0.5 + randSource();
+        terms.push_back({i, j, ub, lb, w});
+        contribs.addContrib(i, j, ub, lb, w);
+      }
+    }
+    double refEnergy = 0.0;
+    std::vector<double> refGrad(pos.size(), 0.0);
+    for (const auto &t : terms) {
+      double d2 = 0.0;
+      for (auto k = 0u; k < dim; ++k) {
+        double d = pos[t.i * dim + k] - pos[t.j * dim + k];
+        d2 += d * d;
+      }
+      double ub2 = t.ub * t.ub, lb2 = t.lb * t.lb;
+      double val = 0.0, preFactor = 0.0, d = sqrt(d2);
+      if (d2 > ub2) {
+        val = (d2 / ub2) - 1.0;
+        preFactor = 4. * (((d * d) / ub2) - 1.0) * (d / ub2);
+      } else if (d2 < lb2) {
+        val = ((2 * lb2) / (lb2 + d2)) - 1.0;
+        double l2d2 = d2 + lb2;
+        preFactor = 8. * lb2 * d * (1. - 2 * lb2 / l2d2) / (l2d2 * l2d2);
+      } else {
+        continue;
+      }
+      if (val > 0.0) {
+        refEnergy += t.w * val * val;
+      }
+      for (auto k = 0u; k < dim; ++k) {
+        auto p1 = t.i * dim + k, p2 = t.j * dim + k;
+        double dGrad = t.w * preFactor * (pos[p1] - pos[p2]);
+        if (d > 0.0) {
+          dGrad /= d;
+        }
+        refGrad[p1] += dGrad;
+        refGrad[p2] -= dGrad;
+      }
+    }
+    CHECK(contribs.getEnergy(pos.data()) == refEnergy);
+    std::vector<double> grad(pos.size(), 0.0);
+    contribs.getGrad(pos.data(), grad.data());
+    CHECK(grad == refGrad);
+  }
+}
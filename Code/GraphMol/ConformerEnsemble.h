@@ -0,0 +1,192 @@
+//
+//  Copyright (C) 2025 Greg Landrum and other RDKit contributors
+//
+//   @@ All Rights Reserved @@
+//  This file is part of the RDKit.
+//  The contents are covered by the terms of the BSD license
+//  which is included in the file license.txt, found at the root
+//  of the RDKit source tree.
+//
+#include <RDGeneral/export.h>
+#ifndef RD_CONFORMERENSEMBLE_H
+#define RD_CONFORMERENSEMBLE_H
+
+#include <GraphMol/Conformer.h>
+#include <GraphMol/ROMol.h>
+#include <RDGeneral/Invariant.h>
+
+#include <type_traits>
+#include <vector>
+
+namespace RDKit {
+
+//! A set of conformers stored as a single contiguous coordinate block
+/*!
+  The coordinates of all conformers live in one
+  numConformers x numAtoms x 3 array of \c CoordType (double or float), with
+  conformer \c i starting at <tt>getCoords(i)</tt>. This is the layout
+  ensemble-wide operations (RMS matrices, shape screening, serialization)
+  want, and it avoids the one-allocation-per-conformer cost of holding
+  several hundred \c Conformer objects on an \c ROMol.
+
+  Individual conformers are accessed by their index in the ensemble; they can
+  be converted to and from \c Conformer objects and copied back onto a
+  molecule.
+
+  <b>Notes:</b>
+    - conformer ids and the 3D flag are preserved, conformer properties are
+      not.
+*/
+template <typename CoordType = double>
+class ConformerEnsembleT {
+  static_assert(std::is_floating_point_v<CoordType>,
+                "coordinates must be floating point");
+
+ public:
+  using coord_type = CoordType;
+
+  ConformerEnsembleT() = default;
+  //! construct an empty ensemble for a molecule with \c numAtoms atoms
+  explicit ConformerEnsembleT(unsigned int numAtoms) : d_numAtoms(numAtoms) {}
+  //! construct an ensemble holding copies of all of \c mol's conformers
+  explicit ConformerEnsembleT(const ROMol &mol)
+      : d_numAtoms(mol.getNumAtoms()) {
+    reserve(mol.getNumConformers());
+    for (auto cit = mol.beginConformers(); cit != mol.endConformers(); ++cit) {
+      addConformer(**cit);
+    }
+  }
+
+  unsigned int getNumAtoms() const { return d_numAtoms; }
+  unsigned int getNumConformers() const {
+    return rdcast<unsigned int>(d_ids.size());
+  }
+  bool empty() const { return d_ids.empty(); }
+
+  //! reserve space for \c numConfs conformers
+  void reserve(unsigned int numConfs) {
+    d_coords.reserve(static_cast<size_t>(numConfs) * d_numAtoms * 3);
+    d_ids.reserve(numConfs);
+    d_is3D.reserve(numConfs);
+  }
+  void clear() {
+    d_coords.clear();
+    d_ids.clear();
+    d_is3D.clear();
+  }
+
+  //! adds a conformer with all atoms at the origin, returns its index
+  unsigned int addConformer(unsigned int confId, bool is3D = true) {
+    d_coords.resize(d_coords.size() + static_cast<size_t>(d_numAtoms) * 3,
+                    CoordType(0));
+    d_ids.push_back(confId);
+    d_is3D.push_back(is3D);
+    return getNumConformers() - 1;
+  }
+  //! adds a copy of the coordinates in \c conf, returns its index
+  unsigned int addConformer(const Conformer &conf) {
+    PRECONDITION(conf.getNumAtoms() == d_numAtoms, "atom count mismatch");
+    auto idx = addConformer(conf.getId(), conf.is3D());
+    auto *coords = getCoords(idx);
+    for (const auto &pt : conf.getPositions()) {
+      *coords++ = static_cast<CoordType>(pt.x);
+      *coords++ = static_cast<CoordType>(pt.y);
+      *coords++ = static_cast<CoordType>(pt.z);
+    }
+    return idx;
+  }
+
+  //! returns the coordinates of conformer \c idx as x0,y0,z0,x1,y1,z1,...
+  const CoordType *getCoords(unsigned int idx) const {
+    URANGE_CHECK(idx, getNumConformers());
+    return d_coords.data() + static_cast<size_t>(idx) * d_numAtoms * 3;
+  }
+  //! \overload
+  CoordType *getCoords(unsigned int idx) {
+    URANGE_CHECK(idx, getNumConformers());
+    return d_coords.data() + static_cast<size_t>(idx) * d_numAtoms * 3;
+  }
+  //! returns the whole coordinate block
+  const std::vector<CoordType> &getCoordBlock() const { return d_coords; }
+  //! \overload
+  std::vector<CoordType> &getCoordBlock() { return d_coords; }
+
+  unsigned int getConformerId(unsigned int idx) const {
+    URANGE_CHECK(idx, getNumConformers());
+    return d_ids[idx];
+  }
+  void setConformerId(unsigned int idx, unsigned int confId) {
+    URANGE_CHECK(idx, getNumConformers());
+    d_ids[idx] = confId;
+  }
+  bool is3D(unsigned int idx) const {
+    URANGE_CHECK(idx, getNumConformers());
+    return d_is3D[idx];
+  }
+  void set3D(unsigned int idx, bool is3D) {
+    URANGE_CHECK(idx, getNumConformers());
+    d_is3D[idx] = is3D;
+  }
+
+  RDGeom::Point3D getAtomPos(unsigned int idx, unsigned int atomId) const {
+    URANGE_CHECK(atomId, d_numAtoms);
+    const auto *coords = getCoords(idx) + 3 * atomId;
+    return {static_cast<double>(coords[0]), static_cast<double>(coords[1]),
+            static_cast<double>(coords[2])};
+  }
+  void setAtomPos(unsigned int idx, unsigned int atomId,
+                  const RDGeom::Point3D &pos) {
+    URANGE_CHECK(atomId, d_numAtoms);
+    auto *coords = getCoords(idx) + 3 * atomId;
+    coords[0] = static_cast<CoordType>(pos.x);
+    coords[1] = static_cast<CoordType>(pos.y);
+    coords[2] = static_cast<CoordType>(pos.z);
+  }
+
+  //! returns conformer \c idx as a (newly allocated) Conformer
+  Conformer getConformer(unsigned int idx) const {
+    Conformer res(d_numAtoms);
+    res.setId(getConformerId(idx));
+    res.set3D(is3D(idx));
+    const auto *coords = getCoords(idx);
+    for (auto &pt : res.getPositions()) {
+      pt.x = static_cast<double>(*coords++);
+      pt.y = static_cast<double>(*coords++);
+      pt.z = static_cast<double>(*coords++);
+    }
+    return res;
+  }
+
+  //! copies the coordinates of conformer \c idx into \c conf
+  void updateConformer(unsigned int idx, Conformer &conf) const {
+    PRECONDITION(conf.getNumAtoms() == d_numAtoms, "atom count mismatch");
+    const auto *coords = getCoords(idx);
+    for (auto &pt : conf.getPositions()) {
+      pt.x = static_cast<double>(*coords++);
+      pt.y = static_cast<double>(*coords++);
+      pt.z = static_cast<double>(*coords++);
+    }
+  }
+
+  //! replaces the conformers of \c mol with the ones in the ensemble
+  void setMolConformers(ROMol &mol) const {
+    PRECONDITION(mol.getNumAtoms() == d_numAtoms, "atom count mismatch");
+    mol.clearConformers();
+    for (unsigned int i = 0; i < getNumConformers(); ++i) {
+      mol.addConformer(new Conformer(getConformer(i)), false);
+    }
+  }
+
+ private:
+  unsigned int d_numAtoms{0};
+  std::vector<CoordType> d_coords;
+  std::vector<unsigned int> d_ids;
+  std::vector<bool> d_is3D;
+};
+
+typedef ConformerEnsembleT<double> ConformerEnsemble;
+typedef ConformerEnsembleT<float> ConformerEnsembleF;
+
+}  // namespace RDKit
+
+#endif
@@ -9,6 +9,7 @@
 //
 
 #include <GraphMol/RDKitBase.h>
+#include <GraphMol/FrozenMol.h>
 #include <GraphMol/MolPickler.h>
 #include <GraphMol/Descriptors/MolDescriptors.h>
 #include <GraphMol/SmilesParse/SmilesParse.h>
@@ -22,6 +23,7 @@
 #include <boost/flyweight/no_tracking.hpp>
 #include <RDGeneral/BoostEndInclude.h>
 
+#include <algorithm>
 #include <vector>
 #include <string>
 
@@ -205,6 +207,7 @@ const std::string NumRingsVersion = "1.0.1";
 unsigned int calcNumRings(const ROMol &mol) {
   return mol.getRingInfo()->numRings();
 }
+unsigned int calcNumRings(const FrozenMol &mol) { return mol.numRings(); }
 
 const std::string FractionCSP3Version = "1.0.0";
 double calcFractionCSP3(const ROMol &mol) {
@@ -227,6 +230,22 @@ double calcFractionCSP3(const ROMol &mol) {
   }
   return static_cast<double>(nCSP3) / nC;
 }
+double calcFractionCSP3(const FrozenMol &mol) {
+  unsigned int nCSP3 = 0;
+  unsigned int nC = 0;
+  for (unsigned int i = 0; i < mol.getNumAtoms(); ++i) {
+    if (mol.getAtom(i).atomicNum == 6) {
+      ++nC;
+      if (mol.getTotalDegree(i) == 4) {
+        ++nCSP3;
+      }
+    }
+  }
+  if (!nC) {
+    return 0;
+  }
+  return static_cast<double>(nCSP3) / nC;
+}
 
 const std::string NumHeterocyclesVersion = "1.0.0";
 unsigned int calcNumHeterocycles(const ROMol &mol) {
@@ -255,6 +274,17 @@ unsigned int calcNumAromaticRings(const ROMol &mol) {
   }
   return res;
 }
+unsigned int calcNumAromaticRings(const FrozenMol &mol) {
+  unsigned int res = 0;
+  for (unsigned int i = 0; i < mol.numRings(); ++i) {
+    const auto ringBonds = mol.getRingBonds(i);
+    if (std::all_of(ringBonds.begin(), ringBonds.end(),
+                    [&mol](auto idx) { return mol.getBond(idx).isAromatic; })) {
+      ++res;
+    }
+  }
+  return res;
+}
 const std::string NumSaturatedRingsVersion = "1.0.0";
 unsigned int calcNumSaturatedRings(const ROMol &mol) {
   unsigned int res = 0;
@@ -21,6 +21,7 @@
 
 namespace RDKit {
 class ROMol;
+class FrozenMol;
 namespace Descriptors {
 
 const std::string lipinskiHBAVersion = "1.0.0";
@@ -80,14 +81,20 @@ RDKIT_DESCRIPTORS_EXPORT unsigned int calcNumAmideBonds(const ROMol &mol);
 RDKIT_DESCRIPTORS_EXPORT extern const std::string FractionCSP3Version;
 //! calculates the fraction of carbons that are SP3 hybridized
 RDKIT_DESCRIPTORS_EXPORT double calcFractionCSP3(const ROMol &mol);
+//! \overload
+RDKIT_DESCRIPTORS_EXPORT double calcFractionCSP3(const FrozenMol &mol);
 
 RDKIT_DESCRIPTORS_EXPORT extern const std::string NumRingsVersion;
 //! calculates the number of SSSR rings
 RDKIT_DESCRIPTORS_EXPORT unsigned int calcNumRings(const ROMol &mol);
+//! \overload
+RDKIT_DESCRIPTORS_EXPORT unsigned int calcNumRings(const FrozenMol &mol);
 
 RDKIT_DESCRIPTORS_EXPORT extern const std::string NumAromaticRingsVersion;
 //! calculates the number of aromatic SSSR rings
 RDKIT_DESCRIPTORS_EXPORT unsigned int calcNumAromaticRings(const ROMol &mol);
+//! \overload
+RDKIT_DESCRIPTORS_EXPORT unsigned int calcNumAromaticRings(const FrozenMol &mol);
 
 RDKIT_DESCRIPTORS_EXPORT extern const std::string NumAliphaticRingsVersion;
 //! calculates the number of aliphatic (at least one non-aromatic bond) SSSR
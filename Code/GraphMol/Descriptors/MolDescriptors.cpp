@@ -10,6 +10,7 @@
 #include <RDGeneral/Invariant.h>
 #include <GraphMol/RDKitBase.h>
 #include <GraphMol/MolOps.h>
+#include <GraphMol/FrozenMol.h>
 #include "MolDescriptors.h"
 #include <map>
 #include <list>
@@ -24,21 +25,66 @@ double calcAMW(const ROMol &mol, bool onlyHeavy) {
   return MolOps::getAvgMolWt(mol, onlyHeavy);
 }
 
+// these follow MolOps::getAvgMolWt() and MolOps::getExactMolWt()
+double calcAMW(const FrozenMol &mol, bool onlyHeavy) {
+  double res = 0.0;
+  const PeriodicTable *table = PeriodicTable::getTable();
+  for (unsigned int i = 0; i < mol.getNumAtoms(); ++i) {
+    const auto &atom = mol.getAtom(i);
+    if (!onlyHeavy || atom.atomicNum != 1) {
+      res += mol.getMass(i);
+    }
+    if (!onlyHeavy) {
+      res += atom.getTotalNumHs() * table->getAtomicWeight(1);
+    }
+  }
+  return res;
+}
+
 const std::string NumHeavyAtomsVersion = "1.0.0";
 unsigned int calcNumHeavyAtoms(const ROMol &mol) {
   return mol.getNumHeavyAtoms();
 }
+unsigned int calcNumHeavyAtoms(const FrozenMol &mol) {
+  return mol.getNumHeavyAtoms();
+}
 
 const std::string NumAtomsVersion = "1.0.0";
 unsigned int calcNumAtoms(const ROMol &mol) {
   bool onlyExplicit = false;
   return mol.getNumAtoms(onlyExplicit);
 }
+unsigned int calcNumAtoms(const FrozenMol &mol) {
+  return mol.getNumAtomsWithHs();
+}
 
 const std::string exactmwVersion = "1.1.0";
 double calcExactMW(const ROMol &mol, bool onlyHeavy) {
   return MolOps::getExactMolWt(mol, onlyHeavy);
 }
+double calcExactMW(const FrozenMol &mol, bool onlyHeavy) {
+  double res = 0.0;
+  unsigned int nHsToCount = 0;
+  const PeriodicTable *table = PeriodicTable::getTable();
+  for (unsigned int i = 0; i < mol.getNumAtoms(); ++i) {
+    const auto &atom = mol.getAtom(i);
+    if (atom.atomicNum != 1 || !onlyHeavy) {
+      if (!atom.isotope) {
+        res += table->getMostCommonIsotopeMass(atom.atomicNum);
+      } else {
+        res += mol.getMass(i);
+      }
+      res -= constants::electronMass * atom.formalCharge;
+    }
+    if (!onlyHeavy) {
+      nHsToCount += atom.getTotalNumHs();
+    }
+  }
+  if (!onlyHeavy) {
+    res += nHsToCount * table->getMostCommonIsotopeMass(1);
+  }
+  return res;
+}
 
 static std::string _molFormulaVersion = "1.3.0";
 std::string calcMolFormula(const ROMol &mol, bool separateIsotopes,
@@ -21,6 +21,7 @@
 
 namespace RDKit {
 class ROMol;
+class FrozenMol;
 namespace Descriptors {
 /*!
   Calculates a molecule's average molecular weight
@@ -34,6 +35,9 @@ namespace Descriptors {
 RDKIT_DESCRIPTORS_EXPORT extern const std::string amwVersion;
 RDKIT_DESCRIPTORS_EXPORT double calcAMW(const ROMol &mol,
                                         bool onlyHeavy = false);
+//! \overload
+RDKIT_DESCRIPTORS_EXPORT double calcAMW(const FrozenMol &mol,
+                                        bool onlyHeavy = false);
 /*!
   Calculates a molecule's number of heavy (non-hydrogen) atoms
 
@@ -43,6 +47,8 @@ RDKIT_DESCRIPTORS_EXPORT double calcAMW(const ROMol &mol,
 */
 RDKIT_DESCRIPTORS_EXPORT extern const std::string NumHeavyAtomsVersion;
 RDKIT_DESCRIPTORS_EXPORT unsigned int calcNumHeavyAtoms(const ROMol &mol);
+//! \overload
+RDKIT_DESCRIPTORS_EXPORT unsigned int calcNumHeavyAtoms(const FrozenMol &mol);
 /*!
   Calculates a molecule's number of atoms
 
@@ -52,6 +58,8 @@ RDKIT_DESCRIPTORS_EXPORT unsigned int calcNumHeavyAtoms(const ROMol &mol);
 */
 RDKIT_DESCRIPTORS_EXPORT extern const std::string NumAtomsVersion;
 RDKIT_DESCRIPTORS_EXPORT unsigned int calcNumAtoms(const ROMol &mol);
+//! \overload
+RDKIT_DESCRIPTORS_EXPORT unsigned int calcNumAtoms(const FrozenMol &mol);
 /*!
   Calculates a molecule's exact molecular weight
 
@@ -64,6 +72,9 @@ RDKIT_DESCRIPTORS_EXPORT unsigned int calcNumAtoms(const ROMol &mol);
 RDKIT_DESCRIPTORS_EXPORT extern const std::string exactmwVersion;
 RDKIT_DESCRIPTORS_EXPORT double calcExactMW(const ROMol &mol,
                                             bool onlyHeavy = false);
+//! \overload
+RDKIT_DESCRIPTORS_EXPORT double calcExactMW(const FrozenMol &mol,
+                                            bool onlyHeavy = false);
 /*!
   Calculates a molecule's formula
 
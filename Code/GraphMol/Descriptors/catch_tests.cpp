@@ -11,6 +11,7 @@
 #include <catch2/catch_all.hpp>
 
 #include <GraphMol/RDKitBase.h>
+#include <GraphMol/FrozenMol.h>
 #include <GraphMol/FileParsers/FileParsers.h>
 #include <GraphMol/SmilesParse/SmilesParse.h>
 #include <GraphMol/SmilesParse/SmilesWrite.h>
@@ -714,6 +715,32 @@ TEST_CASE(
   }
 }
 
+TEST_CASE("descriptors of FrozenMols") {
+  for (const auto smi :
+       {"CC(=O)Oc1ccccc1C(=O)O", "[13CH3]C(=O)[O-].[Na+]",
+        "[2H]OC1CC1[H]", "c1ccc2c(c1)CCC1CCCCC21", "[Fe]", "C[NH3+]"}) {
+    INFO(smi);
+    std::unique_ptr<RWMol> mol(SmilesToMol(smi, 0, false));
+    REQUIRE(mol);
+    MolOps::sanitizeMol(*mol);
+    FrozenMol frozen(*mol);
+    for (auto onlyHeavy : {false, true}) {
+      CHECK(Descriptors::calcAMW(frozen, onlyHeavy) ==
+            Catch::Approx(Descriptors::calcAMW(*mol, onlyHeavy)));
+      CHECK(Descriptors::calcExactMW(frozen, onlyHeavy) ==
+            Catch::Approx(Descriptors::calcExactMW(*mol, onlyHeavy)));
+    }
+    CHECK(Descriptors::calcNumHeavyAtoms(frozen) ==
+          Descriptors::calcNumHeavyAtoms(*mol));
+    CHECK(Descriptors::calcNumAtoms(frozen) == Descriptors::calcNumAtoms(*mol));
+    CHECK(Descriptors::calcNumRings(frozen) == Descriptors::calcNumRings(*mol));
+    CHECK(Descriptors::calcNumAromaticRings(frozen) ==
+          Descriptors::calcNumAromaticRings(*mol));
+    CHECK(Descriptors::calcFractionCSP3(frozen) ==
+          Catch::Approx(Descriptors::calcFractionCSP3(*mol)));
+  }
+}
+
 #ifdef RDK_BUILD_DESCRIPTORS3D
 TEST_CASE("Github #7264: GETAWAY descriptors are non-deterministic") {
   SECTION("as reported") {
@@ -37,6 +37,7 @@
 #include <GraphMol/Substruct/SubstructMatch.h>
 #include <GraphMol/MolAlign/AlignMolecules.h>
 #include <boost/dynamic_bitset.hpp>
+#include <RDGeneral/RDThreadPool.h>
 #include <RDGeneral/RDThreads.h>
 #include <cmath>
 #include <cstddef>
@@ -45,7 +46,6 @@
 #include <chrono>  // for time-related functions
 
 #ifdef RDK_BUILD_THREADSAFE_SSS
-#include <future>
 #include <mutex>
 #endif
 
@@ -1468,7 +1468,13 @@ bool setupInitialBoundsMatrix(
     adjustBoundsMatFromCoordMap(mmat, nAtoms, coordMap);
     tol = 0.05;
   }
-  if (!DistGeom::triangleSmoothBounds(mmat, tol)) {
+  auto smoothBounds = [&params](DistGeom::BoundsMatPtr bm, double tol) {
+    if (params.useBlockedTriangleSmoothing) {
+      return DistGeom::triangleSmoothBoundsBlocked(bm, tol, params.numThreads);
+    }
+    return DistGeom::triangleSmoothBounds(bm, tol);
+  };
+  if (!smoothBounds(mmat, tol)) {
     // ok this bound matrix failed to triangle smooth - re-compute the
     // bounds matrix without 15 bounds and with VDW scaling
     initBoundsMat(mmat);
@@ -1481,7 +1487,7 @@ bool setupInitialBoundsMatrix(
     }
 
     // try triangle smoothing again
-    if (!DistGeom::triangleSmoothBounds(mmat, tol)) {
+    if (!smoothBounds(mmat, tol)) {
       // ok, we're not going to be able to smooth this,
       if (params.ignoreSmoothingFailures) {
         // proceed anyway with the more relaxed bounds matrix
@@ -1861,21 +1867,10 @@ void EmbedMultipleConfs(ROMol &mol, INT_VECT &res, unsigned int numConfs,
                                &chiralCenters,  &tetrahedralCarbons,
                                &doubleBondEnds, &stereoDoubleBonds,
                                &etkdgDetails,   piece->getNumHeavyAtoms()};
-    if (numThreads == 1) {
-      detail::embedHelper_(0, 1, &eargs, &params, end_time);
-    }
-#ifdef RDK_BUILD_THREADSAFE_SSS
-    else {
-      std::vector<std::future<void>> tg;
-      for (int tid = 0; tid < numThreads; ++tid) {
-        tg.emplace_back(std::async(std::launch::async, detail::embedHelper_,
-                                   tid, numThreads, &eargs, &params, end_time));
-      }
-      for (auto &fut : tg) {
-        fut.get();
-      }
-    }
-#endif
+    // each task embeds every numThreads-th conformer
+    parallelFor(numThreads, numThreads, [&](size_t tid) {
+      detail::embedHelper_(tid, numThreads, &eargs, &params, end_time);
+    });
     if (end_time != nullptr && Clock::now() > *end_time) {
       if (params.trackFailures) {
 #ifdef RDK_BUILD_THREADSAFE_SSS
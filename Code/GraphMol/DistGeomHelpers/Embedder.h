@@ -121,6 +121,10 @@ enum EmbedFailureCauses {
                    of times each embedding check fails
   enableSequentialRandomSeeds    handle the random number seeds so that
                                  conformer generation can be restarted
+  useBlockedTriangleSmoothing    use the cache-blocked (and, if numThreads
+                                 allows, multithreaded) triangle bounds
+                                 smoothing. This is much faster for very large
+                                 molecules.
 */
 struct RDKIT_DISTGEOMHELPERS_EXPORT EmbedParameters {
   unsigned int maxIterations{0};
@@ -159,6 +163,7 @@ struct RDKIT_DISTGEOMHELPERS_EXPORT EmbedParameters {
   std::vector<unsigned int> failures{};
   bool enableSequentialRandomSeeds{false};
   bool symmetrizeConjugatedTerminalGroupsForPruning{true};
+  bool useBlockedTriangleSmoothing{false};
 };
 
 //! update parameters from a JSON string
@@ -42,6 +42,7 @@ namespace DGeomHelpers {
   X(timeout)                                      \
   X(trackFailures)                                \
   X(useBasicKnowledge)                            \
+  X(useBlockedTriangleSmoothing)                  \
   X(useExpTorsionAnglePrefs)                      \
   X(useLegacyImplementation)                      \
   X(useMacrocycle14config)                        \
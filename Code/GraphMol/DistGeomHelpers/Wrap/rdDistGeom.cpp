@@ -671,6 +671,11 @@ BOOST_PYTHON_MODULE(rdDistGeom) {
           "symmetrizeConjugatedTerminalGroupsForPruning",
           &PyEmbedParameters::symmetrizeConjugatedTerminalGroupsForPruning,
           "symmetrize terminal conjugated groups for RMSD pruning")
+      .def_readwrite(
+          "useBlockedTriangleSmoothing",
+          &PyEmbedParameters::useBlockedTriangleSmoothing,
+          "use the cache-blocked (and multithreaded) triangle bounds smoothing. "
+          "This is much faster for very large molecules.")
       .def("SetCoordMap", &PyEmbedParameters::setCoordMap, python::args("self"),
            "sets the coordmap to be used")
       .def("__setattr__", &safeSetattr);
@@ -593,6 +593,11 @@ used during structural minimisation stage)DOC")
       .def_rw("symmetrizeConjugatedTerminalGroupsForPruning",
               &PyEmbedParameters::symmetrizeConjugatedTerminalGroupsForPruning,
               "symmetrize terminal conjugated groups for RMSD pruning")
+      .def_rw(
+          "useBlockedTriangleSmoothing",
+          &PyEmbedParameters::useBlockedTriangleSmoothing,
+          "use the cache-blocked (and multithreaded) triangle bounds smoothing. "
+          "This is much faster for very large molecules.")
       .def("SetCoordMap", &PyEmbedParameters::setCoordMap,
            "sets the coordmap to be used")
       .def("__setattr__", &safeSetattr);
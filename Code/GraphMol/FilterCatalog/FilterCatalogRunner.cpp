@@ -11,12 +11,8 @@
 #include "Filters.h"
 #include "FilterMatchers.h"
 #include <GraphMol/SmilesParse/SmilesParse.h>
-
-#ifdef RDK_BUILD_THREADSAFE_SSS
+#include <RDGeneral/RDThreadPool.h>
 #include <RDGeneral/RDThreads.h>
-#include <thread>
-#include <future>
-#endif
 
 namespace RDKit {
 namespace {
@@ -28,15 +24,13 @@ boost::shared_ptr<FilterCatalogEntry> &makeBadSmilesEntry() {
 }
 void CatalogSearcher(
     const FilterCatalog &fc, const std::vector<std::string> &smiles,
-    std::vector<std::vector<FilterCatalog::CONST_SENTRY>> &results, int start,
-    int numThreads) {
-  for (unsigned int idx = start; idx < smiles.size(); idx += numThreads) {
-    std::unique_ptr<ROMol> mol(SmilesToMol(smiles[idx]));
-    if (mol.get()) {
-      results[idx] = fc.getMatches(*mol);
-    } else {
-      results[idx].push_back(makeBadSmilesEntry());
-    }
+    std::vector<std::vector<FilterCatalog::CONST_SENTRY>> &results,
+    size_t idx) {
+  std::unique_ptr<ROMol> mol(SmilesToMol(smiles[idx]));
+  if (mol.get()) {
+    results[idx] = fc.getMatches(*mol);
+  } else {
+    results[idx].push_back(makeBadSmilesEntry());
   }
 }
 }  // namespace
@@ -48,25 +42,8 @@ RunFilterCatalog(const FilterCatalog &fc,
   //  There is one result per input smiles
   std::vector<std::vector<FilterCatalog::CONST_SENTRY>> results(smiles.size());
 
-#ifdef RDK_BUILD_THREADSAFE_SSS
-  std::vector<std::future<void>> thread_group;
-  numThreads = (int)getNumThreadsToUse(numThreads);
-  for (int thread_group_idx = 0; thread_group_idx < numThreads;
-       ++thread_group_idx) {
-    // need to use std::ref otherwise things are passed by value
-    thread_group.emplace_back(std::async(
-        std::launch::async, CatalogSearcher, std::ref(fc), std::ref(smiles),
-        std::ref(results), thread_group_idx, numThreads));
-  }
-  for (auto &fut : thread_group) {
-    fut.get();
-  }
-
-#else
-  int start = 0;
-  numThreads = 1;
-  CatalogSearcher(fc, smiles, results, start, numThreads);
-#endif
+  parallelFor(smiles.size(), getNumThreadsToUse(numThreads),
+              [&](size_t idx) { CatalogSearcher(fc, smiles, results, idx); });
   return results;
 }
 
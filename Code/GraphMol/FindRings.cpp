@@ -118,6 +118,24 @@ void convertToBonds(const VECT_INT_VECT &res, VECT_INT_VECT &brings,
 namespace FindRings {
 using namespace RDKit;
 
+//! working storage for the ring searches. Ring perception runs for every
+//! molecule that is sanitized, so this is kept per thread and reused instead
+//! of being allocated for each search.
+struct RingSearchScratch {
+  std::vector<int> done;
+  std::vector<int> parents;
+  std::vector<int> depths;
+  std::deque<int> bfsq;
+  INT_VECT ring;
+  //! for each atom, the (up to two) bonds of the ring being ordered
+  std::vector<int> ringBonds;
+};
+
+RingSearchScratch &getRingSearchScratch() {
+  static thread_local RingSearchScratch scratch;
+  return scratch;
+}
+
 /******************************************************************************
  * SUMMARY:
  *  remove the bond in the molecule that connect to the specified atom
@@ -179,20 +197,25 @@ int smallestRingsBfs(const ROMol &mol, int root, VECT_INT_VECT &rings,
   constexpr const int GRAY = 1;
   constexpr const int BLACK = 2;
 
-  std::vector<int> done(mol.getNumAtoms(), WHITE);
+  auto &scratch = getRingSearchScratch();
+  auto &done = scratch.done;
+  done.assign(mol.getNumAtoms(), WHITE);
   if (forbidden) {
     for (auto i : *forbidden) {
       done[i] = BLACK;
     }
   }
 
-  std::vector<int> parents(mol.getNumAtoms(), -1);
-  std::vector<int> depths(mol.getNumAtoms(), 0);
+  auto &parents = scratch.parents;
+  parents.assign(mol.getNumAtoms(), -1);
+  auto &depths = scratch.depths;
+  depths.assign(mol.getNumAtoms(), 0);
 
-  std::deque<int> bfsq;
+  auto &bfsq = scratch.bfsq;
+  bfsq.clear();
   bfsq.push_back(root);
 
-  INT_VECT ring;
+  auto &ring = scratch.ring;
 
   unsigned int curSize = UINT_MAX;
   while (!bfsq.empty()) {
@@ -272,6 +295,70 @@ int smallestRingsBfs(const ROMol &mol, int root, VECT_INT_VECT &rings,
   return rdcast<unsigned int>(rings.size());
 }
 
+// Puts the bonds of a ring family that is a single ring in ring order and
+// finds its atoms. The ring starts at its lowest atom index and continues
+// towards the lower of that atom's neighbors, which is what
+// RingUtils::normalizeRing() does. Returns false if the family isn't a
+// single ring.
+bool orderRingFamily(const ROMol &mol, const INT_VECT &familyBonds,
+                     INT_VECT &atomRing, INT_VECT &bondRing) {
+  auto &scratch = getRingSearchScratch();
+  auto &slots = scratch.ringBonds;
+  if (slots.size() < 2 * mol.getNumAtoms()) {
+    slots.resize(2 * mol.getNumAtoms(), -1);
+  }
+  auto &familyAtoms = scratch.ring;
+  familyAtoms.clear();
+  bool singleRing = true;
+  for (auto bondIdx : familyBonds) {
+    const auto bond = mol.getBondWithIdx(bondIdx);
+    for (int atomIdx : {static_cast<int>(bond->getBeginAtomIdx()),
+                        static_cast<int>(bond->getEndAtomIdx())}) {
+      if (slots[2 * atomIdx] == -1) {
+        slots[2 * atomIdx] = bondIdx;
+        familyAtoms.push_back(atomIdx);
+      } else if (slots[2 * atomIdx + 1] == -1) {
+        slots[2 * atomIdx + 1] = bondIdx;
+      } else {
+        singleRing = false;
+      }
+    }
+  }
+  for (auto atomIdx : familyAtoms) {
+    singleRing &= slots[2 * atomIdx + 1] != -1;
+  }
+
+  atomRing.clear();
+  bondRing.clear();
+  if (singleRing && !familyAtoms.empty()) {
+    auto otherAtom = [&mol](int bondIdx, int atomIdx) {
+      return static_cast<int>(
+          mol.getBondWithIdx(bondIdx)->getOtherAtomIdx(atomIdx));
+    };
+    const auto start = *std::ranges::min_element(familyAtoms);
+    auto bondIdx = slots[2 * start];
+    if (otherAtom(slots[2 * start + 1], start) < otherAtom(bondIdx, start)) {
+      bondIdx = slots[2 * start + 1];
+    }
+    atomRing.reserve(familyAtoms.size());
+    bondRing.reserve(familyBonds.size());
+    auto atomIdx = start;
+    do {
+      atomRing.push_back(atomIdx);
+      bondRing.push_back(bondIdx);
+      atomIdx = otherAtom(bondIdx, atomIdx);
+      bondIdx = slots[2 * atomIdx] == bondIdx ? slots[2 * atomIdx + 1]
+                                              : slots[2 * atomIdx];
+    } while (atomIdx != start);
+    // only one ring is walked if the bonds form several
+    singleRing = bondRing.size() == familyBonds.size();
+  }
+  for (auto idx : familyAtoms) {
+    slots[2 * idx] = slots[2 * idx + 1] = -1;
+  }
+  return singleRing && !familyAtoms.empty();
+}
+
 void storeRingInfo(const ROMol &mol, const INT_VECT &ring) {
   INT_VECT bondIndices;
   RingUtils::convertToBonds(ring, bondIndices, mol);
@@ -1101,11 +1188,37 @@ int symmetrizeSSSR(ROMol &mol, VECT_INT_VECT &res,
       ringInfo->preallocate(mol.getNumAtoms(), mol.getNumBonds());
       findRingFamilies(mol, includeDativeBonds, includeHydrogenBonds);
     }
-    res = ringInfo->atomRelevantCycles();
-    for (const auto &atomRing : res) {
-      INT_VECT bondRing;
-      RingUtils::convertToBonds(atomRing, bondRing, mol);
-      ringInfo->addRing(atomRing, bondRing);
+    // with no more relevant cycles than ring families, each family is a
+    // single ring and that is what the relevant cycle is. This is the case
+    // for most molecules and saves enumerating the cycles.
+    bool done = false;
+    if (ringInfo->numRelevantCycles() == ringInfo->numRingFamilies()) {
+      res.clear();
+      res.reserve(ringInfo->numRingFamilies());
+      done = true;
+      for (const auto &familyBonds : ringInfo->bondRingFamilies()) {
+        INT_VECT atomRing;
+        INT_VECT bondRing;
+        if (!FindRings::orderRingFamily(mol, familyBonds, atomRing,
+                                        bondRing)) {
+          done = false;
+          break;
+        }
+        res.push_back(atomRing);
+        ringInfo->addRing(std::move(atomRing), std::move(bondRing));
+      }
+      if (!done) {
+        ringInfo->reset(false);
+        ringInfo->initialize(FIND_RING_TYPE_SYMM_SSSR);
+      }
+    }
+    if (!done) {
+      res = ringInfo->atomRelevantCycles();
+      for (const auto &atomRing : res) {
+        INT_VECT bondRing;
+        RingUtils::convertToBonds(atomRing, bondRing, mol);
+        ringInfo->addRing(atomRing, bondRing);
+      }
     }
   } else {
     legacySymmetrizeSSSR(mol, res, includeDativeBonds, includeHydrogenBonds);
@@ -1183,7 +1296,7 @@ void findRingFamilies(const ROMol &mol, bool includeDativeBonds,
       unsigned int eidx = edges[ridx][1];
       evect[ridx] = mol.getBondBetweenAtoms(bidx, eidx)->getIdx();
     }
-    mol.getRingInfo()->addRingFamily(nvect, evect);
+    mol.getRingInfo()->addRingFamily(std::move(nvect), std::move(evect));
     free(nodes);
     free(edges);
   }
@@ -46,6 +46,14 @@ std::string AtomPairAtomInvGenerator::infoString() const {
          std::to_string(df_topologicalTorsionCorrection);
 }
 
+unsigned int AtomPairAtomInvGenerator::getRequiredSanitization() const {
+  if (df_includeChirality) {
+    return MolOps::SANITIZE_ALL;
+  }
+  // the number of pi electrons depends on the hybridization
+  return MolOps::SANITIZE_SETHYBRIDIZATION | MolOps::SANITIZE_ADJUSTHS;
+}
+
 void AtomPairAtomInvGenerator::toJSON(boost::property_tree::ptree &pt) const {
   pt.put("type", "AtomPairAtomInvGenerator");
   pt.put("includeChirality", df_includeChirality);
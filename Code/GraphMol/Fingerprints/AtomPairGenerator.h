@@ -40,6 +40,7 @@ class RDKIT_FINGERPRINTS_EXPORT AtomPairAtomInvGenerator
       const ROMol &mol) const override;
 
   std::string infoString() const override;
+  unsigned int getRequiredSanitization() const override;
   void toJSON(boost::property_tree::ptree &pt) const override;
   void fromJSON(const boost::property_tree::ptree &pt) override;
 
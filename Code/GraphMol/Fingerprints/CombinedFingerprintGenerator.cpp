@@ -0,0 +1,264 @@
+//
+//  Copyright (C) 2026 Greg Landrum and other RDKit contributors
+//
+//   @@ All Rights Reserved @@
+//  This file is part of the RDKit.
+//  The contents are covered by the terms of the BSD license
+//  which is included in the file license.txt, found at the root
+//  of the RDKit source tree.
+//
+
+#include <cstdint>
+#include <sstream>
+
+#include <GraphMol/RDKitBase.h>
+#include <GraphMol/MolOps.h>
+#include <GraphMol/Fingerprints/AtomPairGenerator.h>
+#include <GraphMol/Fingerprints/Fingerprints.h>
+#include <RDGeneral/RDThreadPool.h>
+#include <RDGeneral/RDThreads.h>
+
+#include <RDGeneral/BoostStartInclude.h>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <RDGeneral/BoostEndInclude.h>
+
+#include "CombinedFingerprintGenerator.h"
+
+namespace RDKit {
+
+struct CombinedFingerprintGenerator::SharedData {
+  //! the molecule with its stereochemistry assigned, if that was needed
+  std::unique_ptr<ROMol> stereoMol;
+  std::vector<std::vector<std::uint32_t>> atomInvariants;
+  std::vector<std::vector<std::uint32_t>> bondInvariants;
+  //! the atom invariants of generators with an offset
+  std::vector<std::vector<std::uint32_t>> offsetAtomInvariants;
+};
+
+namespace {
+//! Generators with the same key produce the same invariants. The key of a
+//! generator that doesn't describe itself is unique to it.
+template <typename T>
+std::string getInvariantsKey(const T *gen, boost::property_tree::ptree &pt) {
+  gen->toJSON(pt);
+  if (!pt.get_optional<std::string>("type")) {
+    return "unknown " +
+           std::to_string(reinterpret_cast<std::uintptr_t>(gen));
+  }
+  std::ostringstream buf;
+  boost::property_tree::write_json(buf, pt, false);
+  return buf.str();
+}
+
+template <typename T>
+int findOrAdd(const std::string &key, const T *gen,
+              std::vector<std::string> &keys, std::vector<const T *> &gens) {
+  for (unsigned int i = 0; i < keys.size(); ++i) {
+    if (keys[i] == key) {
+      return i;
+    }
+  }
+  keys.push_back(key);
+  gens.push_back(gen);
+  return keys.size() - 1;
+}
+}  // namespace
+
+unsigned int CombinedFingerprintGenerator::addGenerator(
+    const FingerprintGenerator<std::uint64_t> *gen) {
+  PRECONDITION(gen, "no generator provided");
+  GeneratorInfo info{gen, -1, -1, 0};
+  if (const auto atomInvGen = gen->getAtomInvariantsGenerator()) {
+    boost::property_tree::ptree pt;
+    auto key = getInvariantsKey(atomInvGen, pt);
+    // the topological torsion invariants are the atom pair ones less 2
+    if (pt.get<std::string>("type", "") == "AtomPairAtomInvGenerator" &&
+        pt.get<bool>("topologicalTorsionCorrection", false)) {
+      pt.put("topologicalTorsionCorrection", false);
+      std::ostringstream buf;
+      boost::property_tree::write_json(buf, pt, false);
+      key = buf.str();
+      info.atomInvOffset = 2;
+      auto numKeys = d_atomInvKeys.size();
+      std::unique_ptr<AtomInvariantsGenerator> base(
+          new AtomPair::AtomPairAtomInvGenerator(
+              pt.get<bool>("includeChirality", false), false));
+      info.atomInvIdx =
+          findOrAdd(key, base.get(), d_atomInvKeys, d_atomInvGenerators);
+      if (d_atomInvKeys.size() > numKeys) {
+        d_ownedAtomInvGenerators.push_back(std::move(base));
+      }
+    } else {
+      info.atomInvIdx =
+          findOrAdd(key, atomInvGen, d_atomInvKeys, d_atomInvGenerators);
+    }
+  }
+  if (const auto bondInvGen = gen->getBondInvariantsGenerator()) {
+    boost::property_tree::ptree pt;
+    info.bondInvIdx = findOrAdd(getInvariantsKey(bondInvGen, pt), bondInvGen,
+                                d_bondInvKeys, d_bondInvGenerators);
+  }
+  d_generators.push_back(info);
+  return d_generators.size() - 1;
+}
+
+void CombinedFingerprintGenerator::addPatternFingerprint(
+    unsigned int fpSize, bool tautomericFingerprint) {
+  df_patternFingerprint = true;
+  d_patternFpSize = fpSize;
+  df_tautomericPatternFingerprint = tautomericFingerprint;
+}
+
+void CombinedFingerprintGenerator::prepare(const ROMol &mol,
+                                           SharedData &shared) const {
+  bool needStereo = false;
+  bool needDistanceMatrix = false;
+  unsigned int sanitizeOps =
+      df_patternFingerprint ? MolOps::SANITIZE_ALL : MolOps::SANITIZE_NONE;
+  for (const auto &info : d_generators) {
+    sanitizeOps |= info.generator->getRequiredSanitization();
+    const auto opts = info.generator->getOptions();
+    needStereo |= opts->df_includeChirality;
+    if (const auto apOpts =
+            dynamic_cast<const AtomPair::AtomPairArguments *>(opts)) {
+      needDistanceMatrix |= apOpts->df_use2D;
+    }
+  }
+  MolOps::requireSanitization(mol, sanitizeOps);
+  // the distance matrix is cached on the molecule, so doing it before the
+  // copy is made means it is only done once
+  if (needDistanceMatrix) {
+    MolOps::getDistanceMat(mol);
+  }
+  if (needStereo && !mol.hasProp(common_properties::_StereochemDone)) {
+    shared.stereoMol.reset(new ROMol(mol));
+    MolOps::assignStereochemistry(*shared.stereoMol);
+  }
+
+  // like the individual generators, the invariants are calculated from the
+  // molecule as it was passed in
+  shared.atomInvariants.resize(d_atomInvGenerators.size());
+  for (unsigned int i = 0; i < d_atomInvGenerators.size(); ++i) {
+    std::unique_ptr<std::vector<std::uint32_t>> invs(
+        d_atomInvGenerators[i]->getAtomInvariants(mol));
+    shared.atomInvariants[i] = std::move(*invs);
+  }
+  shared.bondInvariants.resize(d_bondInvGenerators.size());
+  for (unsigned int i = 0; i < d_bondInvGenerators.size(); ++i) {
+    std::unique_ptr<std::vector<std::uint32_t>> invs(
+        d_bondInvGenerators[i]->getBondInvariants(mol));
+    shared.bondInvariants[i] = std::move(*invs);
+  }
+  shared.offsetAtomInvariants.resize(d_generators.size());
+  for (unsigned int i = 0; i < d_generators.size(); ++i) {
+    const auto &info = d_generators[i];
+    if (info.atomInvOffset) {
+      auto &invs = shared.offsetAtomInvariants[i];
+      invs = shared.atomInvariants[info.atomInvIdx];
+      for (auto &inv : invs) {
+        inv -= info.atomInvOffset;
+      }
+    }
+  }
+}
+
+FingerprintFuncArguments CombinedFingerprintGenerator::getArguments(
+    const SharedData &shared, unsigned int genIdx) const {
+  const auto &info = d_generators[genIdx];
+  FingerprintFuncArguments args;
+  if (info.atomInvOffset) {
+    args.customAtomInvariants = &shared.offsetAtomInvariants[genIdx];
+  } else if (info.atomInvIdx >= 0) {
+    args.customAtomInvariants = &shared.atomInvariants[info.atomInvIdx];
+  }
+  if (info.bondInvIdx >= 0) {
+    args.customBondInvariants = &shared.bondInvariants[info.bondInvIdx];
+  }
+  return args;
+}
+
+const ROMol &CombinedFingerprintGenerator::getMol(const ROMol &mol,
+                                                  const SharedData &shared,
+                                                  unsigned int genIdx) const {
+  if (shared.stereoMol &&
+      d_generators[genIdx].generator->getOptions()->df_includeChirality) {
+    return *shared.stereoMol;
+  }
+  return mol;
+}
+
+std::vector<std::unique_ptr<ExplicitBitVect>>
+CombinedFingerprintGenerator::getFingerprints(const ROMol &mol) const {
+  SharedData shared;
+  prepare(mol, shared);
+  std::vector<std::unique_ptr<ExplicitBitVect>> res;
+  res.reserve(d_generators.size() + df_patternFingerprint);
+  for (unsigned int i = 0; i < d_generators.size(); ++i) {
+    auto args = getArguments(shared, i);
+    res.push_back(
+        d_generators[i].generator->getFingerprint(getMol(mol, shared, i), args));
+  }
+  if (df_patternFingerprint) {
+    res.emplace_back(PatternFingerprintMol(mol, d_patternFpSize, nullptr,
+                                           nullptr,
+                                           df_tautomericPatternFingerprint));
+  }
+  return res;
+}
+
+std::vector<std::unique_ptr<SparseIntVect<std::uint32_t>>>
+CombinedFingerprintGenerator::getCountFingerprints(const ROMol &mol) const {
+  SharedData shared;
+  prepare(mol, shared);
+  std::vector<std::unique_ptr<SparseIntVect<std::uint32_t>>> res;
+  res.reserve(d_generators.size());
+  for (unsigned int i = 0; i < d_generators.size(); ++i) {
+    auto args = getArguments(shared, i);
+    res.push_back(d_generators[i].generator->getCountFingerprint(
+        getMol(mol, shared, i), args));
+  }
+  return res;
+}
+
+std::vector<std::unique_ptr<SparseIntVect<std::uint64_t>>>
+CombinedFingerprintGenerator::getSparseCountFingerprints(
+    const ROMol &mol) const {
+  SharedData shared;
+  prepare(mol, shared);
+  std::vector<std::unique_ptr<SparseIntVect<std::uint64_t>>> res;
+  res.reserve(d_generators.size());
+  for (unsigned int i = 0; i < d_generators.size(); ++i) {
+    auto args = getArguments(shared, i);
+    res.push_back(d_generators[i].generator->getSparseCountFingerprint(
+        getMol(mol, shared, i), args));
+  }
+  return res;
+}
+
+std::vector<std::vector<std::unique_ptr<ExplicitBitVect>>>
+CombinedFingerprintGenerator::getFingerprints(
+    const std::vector<const ROMol *> &mols, int numThreads) const {
+  std::vector<std::vector<std::unique_ptr<ExplicitBitVect>>> res(mols.size());
+  parallelFor(mols.size(), getNumThreadsToUse(numThreads), [&](size_t i) {
+    if (mols[i]) {
+      res[i] = getFingerprints(*mols[i]);
+    }
+  });
+  return res;
+}
+
+std::vector<std::vector<std::unique_ptr<SparseIntVect<std::uint32_t>>>>
+CombinedFingerprintGenerator::getCountFingerprints(
+    const std::vector<const ROMol *> &mols, int numThreads) const {
+  std::vector<std::vector<std::unique_ptr<SparseIntVect<std::uint32_t>>>> res(
+      mols.size());
+  parallelFor(mols.size(), getNumThreadsToUse(numThreads), [&](size_t i) {
+    if (mols[i]) {
+      res[i] = getCountFingerprints(*mols[i]);
+    }
+  });
+  return res;
+}
+
+}  // namespace RDKit
@@ -0,0 +1,117 @@
+//
+//  Copyright (C) 2026 Greg Landrum and other RDKit contributors
+//
+//   @@ All Rights Reserved @@
+//  This file is part of the RDKit.
+//  The contents are covered by the terms of the BSD license
+//  which is included in the file license.txt, found at the root
+//  of the RDKit source tree.
+//
+
+/*! \file CombinedFingerprintGenerator.h
+
+  Generation of several kinds of fingerprint for a molecule at once.
+
+*/
+#include <RDGeneral/export.h>
+#ifndef RD_COMBINEDFINGERPRINTGENERATOR_H
+#define RD_COMBINEDFINGERPRINTGENERATOR_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <GraphMol/Fingerprints/FingerprintGenerator.h>
+
+namespace RDKit {
+class ROMol;
+
+//! Generates several fingerprints for each molecule
+/*!
+  The work that the individual generators would each repeat is done once
+  per molecule and shared:
+    - atom and bond invariants: generators whose invariant generators have
+      the same settings use the same invariants. The invariants of the
+      topological torsion generator are derived from the atom pair ones.
+    - the stereochemistry perception (and the copy of the molecule it needs)
+      for the generators that include chirality.
+    - the ring information and topological distance matrix, which are
+      cached on the molecule.
+
+  The fingerprints are the same as those from the individual generators.
+
+  The generators are not owned and must outlive this object.
+*/
+class RDKIT_FINGERPRINTS_EXPORT CombinedFingerprintGenerator {
+ public:
+  //! Adds a generator, returns the index of its fingerprints in the results
+  unsigned int addGenerator(const FingerprintGenerator<std::uint64_t> *gen);
+  //! Adds a pattern fingerprint, see PatternFingerprintMol()
+  /*!
+    The pattern fingerprint has no counts, so it is only part of the results
+    of getFingerprints(), where it comes after those of the generators.
+  */
+  void addPatternFingerprint(unsigned int fpSize = 2048,
+                             bool tautomericFingerprint = false);
+
+  unsigned int getNumGenerators() const {
+    return static_cast<unsigned int>(d_generators.size());
+  }
+  bool hasPatternFingerprint() const { return df_patternFingerprint; }
+
+  //! Returns the bit vector fingerprints of a molecule
+  std::vector<std::unique_ptr<ExplicitBitVect>> getFingerprints(
+      const ROMol &mol) const;
+  //! Returns the count fingerprints of a molecule
+  std::vector<std::unique_ptr<SparseIntVect<std::uint32_t>>>
+  getCountFingerprints(const ROMol &mol) const;
+  //! Returns the sparse count fingerprints of a molecule
+  std::vector<std::unique_ptr<SparseIntVect<std::uint64_t>>>
+  getSparseCountFingerprints(const ROMol &mol) const;
+
+  //! Returns the bit vector fingerprints of a set of molecules
+  /*!
+    The results for null molecules are empty.
+  */
+  std::vector<std::vector<std::unique_ptr<ExplicitBitVect>>> getFingerprints(
+      const std::vector<const ROMol *> &mols, int numThreads = 1) const;
+  //! Returns the count fingerprints of a set of molecules
+  std::vector<std::vector<std::unique_ptr<SparseIntVect<std::uint32_t>>>>
+  getCountFingerprints(const std::vector<const ROMol *> &mols,
+                       int numThreads = 1) const;
+
+ private:
+  //! what is shared between the generators for one molecule
+  struct SharedData;
+
+  struct GeneratorInfo {
+    const FingerprintGenerator<std::uint64_t> *generator;
+    //! indices into d_atomInvGenerators / d_bondInvGenerators, -1 for none
+    int atomInvIdx;
+    int bondInvIdx;
+    //! subtracted from the shared atom invariants
+    std::uint32_t atomInvOffset;
+  };
+
+  void prepare(const ROMol &mol, SharedData &shared) const;
+  FingerprintFuncArguments getArguments(const SharedData &shared,
+                                        unsigned int genIdx) const;
+  const ROMol &getMol(const ROMol &mol, const SharedData &shared,
+                      unsigned int genIdx) const;
+
+  std::vector<GeneratorInfo> d_generators;
+  std::vector<std::string> d_atomInvKeys;
+  std::vector<const AtomInvariantsGenerator *> d_atomInvGenerators;
+  std::vector<std::string> d_bondInvKeys;
+  std::vector<const BondInvariantsGenerator *> d_bondInvGenerators;
+  //! generators made here to calculate shared invariants
+  std::vector<std::unique_ptr<AtomInvariantsGenerator>> d_ownedAtomInvGenerators;
+  bool df_patternFingerprint{false};
+  unsigned int d_patternFpSize{2048};
+  bool df_tautomericPatternFingerprint{false};
+};
+
+}  // namespace RDKit
+
+#endif
@@ -13,7 +13,9 @@
 #include <DataStructs/SparseBitVect.h>
 #include <GraphMol/Fingerprints/FingerprintGenerator.h>
 #include <RDGeneral/hash/hash.hpp>
+#include <algorithm>
 #include <cstdint>
+#include <limits>
 
 #include <GraphMol/Fingerprints/AtomPairGenerator.h>
 #include <GraphMol/Fingerprints/MorganGenerator.h>
@@ -25,11 +27,8 @@
 #include <boost/property_tree/json_parser.hpp>
 #include <RDGeneral/BoostEndInclude.h>
 
+#include <RDGeneral/RDThreadPool.h>
 #include <RDGeneral/RDThreads.h>
-#ifdef RDK_BUILD_THREADSAFE_SSS
-#include <thread>
-#include <future>
-#endif
 
 namespace RDKit {
 
@@ -147,6 +146,9 @@ void reinitAdditionalOutput(AdditionalOutput &ao, size_t numAtoms) {
   if (ao.bitPaths) {
     ao.bitPaths->clear();
   }
+  if (ao.pathStats) {
+    *ao.pathStats = PathEnumerationStats();
+  }
 }
 }  // namespace
 
@@ -154,6 +156,37 @@ template FingerprintGenerator<std::uint32_t>::~FingerprintGenerator();
 
 template FingerprintGenerator<std::uint64_t>::~FingerprintGenerator();
 
+unsigned int AtomInvariantsGenerator::getRequiredSanitization() const {
+  return MolOps::SANITIZE_ALL;
+}
+
+unsigned int BondInvariantsGenerator::getRequiredSanitization() const {
+  return MolOps::SANITIZE_ALL;
+}
+
+template <typename OutputType>
+unsigned int FingerprintGenerator<OutputType>::getRequiredSanitization()
+    const {
+  if (dp_fingerprintArguments->df_includeChirality) {
+    return MolOps::SANITIZE_ALL;
+  }
+  // the environments depend on the bond orders, aromaticity and rings
+  unsigned int res =
+      MolOps::SANITIZE_SYMMRINGS | MolOps::SANITIZE_SETAROMATICITY;
+  if (dp_atomInvariantsGenerator) {
+    res |= dp_atomInvariantsGenerator->getRequiredSanitization();
+  }
+  if (dp_bondInvariantsGenerator) {
+    res |= dp_bondInvariantsGenerator->getRequiredSanitization();
+  }
+  return res;
+}
+
+template unsigned int
+FingerprintGenerator<std::uint32_t>::getRequiredSanitization() const;
+template unsigned int
+FingerprintGenerator<std::uint64_t>::getRequiredSanitization() const;
+
 template std::string FingerprintGenerator<std::uint32_t>::infoString() const;
 
 template std::string FingerprintGenerator<std::uint64_t>::infoString() const;
@@ -321,10 +354,11 @@ std::unique_ptr<FingerprintGenerator<std::uint64_t>> generatorFromJSON(
 }
 
 template <typename OutputType>
-std::unique_ptr<SparseIntVect<OutputType>>
-FingerprintGenerator<OutputType>::getFingerprintHelper(
+template <typename BitFunc>
+void FingerprintGenerator<OutputType>::forEachBitId(
     const ROMol &mol, FingerprintFuncArguments &args,
-    const std::uint64_t fpSize) const {
+    const std::uint64_t fpSize, BitFunc addBit) const {
+  MolOps::requireSanitization(mol, getRequiredSanitization());
   const ROMol *lmol = &mol;
   std::unique_ptr<ROMol> tmol;
   if (dp_fingerprintArguments->df_includeChirality &&
@@ -366,10 +400,6 @@ FingerprintGenerator<OutputType>::getFingerprintHelper(
       args.confId, args.additionalOutput, atomInvariants.get(),
       bondInvariants.get(), hashResults);
 
-  // allocate the result
-  auto res = std::make_unique<SparseIntVect<OutputType>>(
-      fpSize ? fpSize : dp_atomEnvironmentGenerator->getResultSize());
-
   // define a mersenne twister with customized parameters.
   // The standard parameters (used to create boost::mt19937)
   // result in an RNG that's much too computationally intensive
@@ -404,11 +434,14 @@ FingerprintGenerator<OutputType>::getFingerprintHelper(
                                     atomInvariants.get(), bondInvariants.get(),
                                     args.additionalOutput, hashResults, fpSize);
 
+    const auto count = env->getCount();
     auto bitId = seed;
     if (fpSize != 0) {
       bitId %= fpSize;
     }
-    res->setVal(bitId, res->getVal(bitId) + 1);
+    for (unsigned int i = 0; i < count; ++i) {
+      addBit(bitId);
+    }
     if (args.additionalOutput) {
       env->updateAdditionalOutput(args.additionalOutput, bitId);
     }
@@ -422,7 +455,9 @@ FingerprintGenerator<OutputType>::getFingerprintHelper(
         if (fpSize != 0) {
           bitId %= fpSize;
         }
-        res->setVal(bitId, res->getVal(bitId) + 1);
+        for (unsigned int i = 0; i < count; ++i) {
+          addBit(bitId);
+        }
         if (args.additionalOutput) {
           env->updateAdditionalOutput(args.additionalOutput, bitId);
         }
@@ -430,7 +465,18 @@ FingerprintGenerator<OutputType>::getFingerprintHelper(
     }
     delete env;
   }
+}
 
+template <typename OutputType>
+std::unique_ptr<SparseIntVect<OutputType>>
+FingerprintGenerator<OutputType>::getFingerprintHelper(
+    const ROMol &mol, FingerprintFuncArguments &args,
+    const std::uint64_t fpSize) const {
+  auto res = std::make_unique<SparseIntVect<OutputType>>(
+      fpSize ? fpSize : dp_atomEnvironmentGenerator->getResultSize());
+  forEachBitId(mol, args, fpSize, [&res](OutputType bitId) {
+    res->setVal(bitId, res->getVal(bitId) + 1);
+  });
   return res;
 }
 namespace {
@@ -496,6 +542,7 @@ void setupTempAdditionalOutput(RDKit::FingerprintFuncArguments &args,
   if (args.additionalOutput->atomsPerBit) {
     countSimulationOutput.allocateAtomsPerBit();
   }
+  countSimulationOutput.pathStats = args.additionalOutput->pathStats;
   reinitAdditionalOutput(*args.additionalOutput, numAtoms);
 }
 }  // namespace
@@ -588,24 +635,31 @@ FingerprintGenerator<OutputType>::getCountFingerprint(
   return result;
 }
 
-template <typename OutputType>
-std::unique_ptr<ExplicitBitVect>
-FingerprintGenerator<OutputType>::getFingerprint(
-    const ROMol &mol, FingerprintFuncArguments &args) const {
-  std::uint32_t effectiveSize = dp_fingerprintArguments->d_fpSize;
-  if (dp_fingerprintArguments->df_countSimulation) {
-    if (dp_fingerprintArguments->d_countBounds.empty()) {
+namespace {
+std::uint32_t getEffectiveSize(const FingerprintArguments &fpArgs) {
+  std::uint32_t effectiveSize = fpArgs.d_fpSize;
+  if (fpArgs.df_countSimulation) {
+    if (fpArgs.d_countBounds.empty()) {
       throw ValueErrorException("Count bounds are empty");
     }
 
-    if (dp_fingerprintArguments->d_countBounds.size() >= effectiveSize) {
+    if (fpArgs.d_countBounds.size() >= effectiveSize) {
       throw ValueErrorException("Count bounds size is >= fingerprint size");
     }
 
     // effective size needs to be smaller than result size to compensate for
     // count simulation
-    effectiveSize /= dp_fingerprintArguments->d_countBounds.size();
+    effectiveSize /= fpArgs.d_countBounds.size();
   }
+  return effectiveSize;
+}
+}  // namespace
+
+template <typename OutputType>
+std::unique_ptr<ExplicitBitVect>
+FingerprintGenerator<OutputType>::getFingerprint(
+    const ROMol &mol, FingerprintFuncArguments &args) const {
+  const auto effectiveSize = getEffectiveSize(*dp_fingerprintArguments);
 
   AdditionalOutput countSimulationOutput;
   AdditionalOutput *origAO = nullptr;
@@ -665,48 +719,15 @@ std::vector<std::unique_ptr<ReturnType>> mtgetFingerprints(
                                 additionalOutput, customAtomInvariants,
                                 customBondInvariants);
 
-  std::vector<std::unique_ptr<ReturnType>> result;
-  auto numThreadsToUse = getNumThreadsToUse(numThreads);
-  unsigned int nmols = mols.size();
-  result.reserve(nmols);
-  if (numThreadsToUse == 1) {
-    for (auto i = 0u; i < nmols; ++i) {
-      if (!mols[i]) {
-        result.emplace_back(std::unique_ptr<ReturnType>());
-      } else {
-        result.emplace_back(std::move(func(*mols[i], args)));
-      }
-    }
-  }
-#ifdef RDK_BUILD_THREADSAFE_SSS
-  else {
-    std::vector<std::vector<std::unique_ptr<ReturnType>>> accum(
-        numThreadsToUse);
-    std::vector<std::thread> tg;
-    for (auto ti = 0u; ti < numThreadsToUse; ++ti) {
-      auto lfunc = [&](unsigned int tidx) {
-        for (auto midx = tidx; midx < mols.size(); midx += numThreadsToUse) {
-          if (!mols[midx]) {
-            accum[tidx].emplace_back(std::unique_ptr<ReturnType>());
-          } else {
-            accum[tidx].emplace_back(std::move(func(*mols[midx], args)));
-          }
-        }
-      };
-      tg.emplace_back(std::thread(lfunc, ti));
-    }
-    for (auto &thread : tg) {
-      if (thread.joinable()) {
-        thread.join();
-      }
-    }
-    for (auto midx = 0u; midx < mols.size(); ++midx) {
-      auto tidx = midx % numThreadsToUse;
-      auto jidx = midx / numThreadsToUse;
-      result.emplace_back(std::move(accum[tidx][jidx]));
-    }
-  }
-#endif
+  std::vector<std::unique_ptr<ReturnType>> result(mols.size());
+  // FingerprintFuncArguments only holds pointers to the (null) extra inputs
+  // and outputs, so the threads can share it
+  parallelFor(mols.size(), getNumThreadsToUse(numThreads),
+              [&](size_t midx) {
+                if (mols[midx]) {
+                  result[midx] = func(*mols[midx], args);
+                }
+              });
   return result;
 }
 }  // namespace
@@ -755,6 +776,90 @@ FingerprintGenerator<OutputType>::getSparseCountFingerprints(
       fpfunc, mols, numThreads);
 }
 
+template <typename OutputType>
+void FingerprintGenerator<OutputType>::fillFingerprints(
+    const std::vector<const ROMol *> &mols, std::uint8_t *buffer,
+    int numThreads) const {
+  PRECONDITION(buffer || mols.empty(), "no buffer provided");
+  const auto fpSize = dp_fingerprintArguments->d_fpSize;
+  const auto effectiveSize = getEffectiveSize(*dp_fingerprintArguments);
+  const auto &countBounds = dp_fingerprintArguments->d_countBounds;
+  const bool countSimulation = dp_fingerprintArguments->df_countSimulation;
+  if (countSimulation &&
+      *std::max_element(countBounds.begin(), countBounds.end()) >
+          std::numeric_limits<std::uint8_t>::max()) {
+    throw ValueErrorException(
+        "fillFingerprints() does not support count bounds larger than 255");
+  }
+  FingerprintFuncArguments args;
+  parallelFor(mols.size(), getNumThreadsToUse(numThreads), [&](size_t midx) {
+    auto row = buffer + midx * fpSize;
+    std::fill(row, row + fpSize, 0);
+    if (!mols[midx]) {
+      return;
+    }
+    if (!countSimulation) {
+      forEachBitId(*mols[midx], args, effectiveSize,
+                   [row](OutputType bitId) { row[bitId] = 1; });
+      return;
+    }
+    // count the features in the unused tail of the row, then spread each
+    // count over countBounds.size() bits from the front. Position i * nBounds + j
+    // is only written after the count for i has been read, and that count
+    // sits at or after it.
+    const auto nBounds = countBounds.size();
+    auto counts = row + fpSize - effectiveSize;
+    forEachBitId(*mols[midx], args, effectiveSize, [counts](OutputType bitId) {
+      if (counts[bitId] < std::numeric_limits<std::uint8_t>::max()) {
+        ++counts[bitId];
+      }
+    });
+    for (std::uint32_t i = 0; i < effectiveSize; ++i) {
+      const auto count = counts[i];
+      counts[i] = 0;
+      for (unsigned int j = 0; j < nBounds; ++j) {
+        row[i * nBounds + j] = count >= countBounds[j];
+      }
+    }
+  });
+}
+
+template <typename OutputType>
+template <typename CountType>
+void FingerprintGenerator<OutputType>::fillCountFingerprintsHelper(
+    const std::vector<const ROMol *> &mols, CountType *buffer,
+    int numThreads) const {
+  PRECONDITION(buffer || mols.empty(), "no buffer provided");
+  const auto fpSize = dp_fingerprintArguments->d_fpSize;
+  FingerprintFuncArguments args;
+  parallelFor(mols.size(), getNumThreadsToUse(numThreads), [&](size_t midx) {
+    auto row = buffer + midx * fpSize;
+    std::fill(row, row + fpSize, 0);
+    if (!mols[midx]) {
+      return;
+    }
+    forEachBitId(*mols[midx], args, fpSize, [row](OutputType bitId) {
+      if (row[bitId] < std::numeric_limits<CountType>::max()) {
+        ++row[bitId];
+      }
+    });
+  });
+}
+
+template <typename OutputType>
+void FingerprintGenerator<OutputType>::fillCountFingerprints(
+    const std::vector<const ROMol *> &mols, std::uint8_t *buffer,
+    int numThreads) const {
+  fillCountFingerprintsHelper(mols, buffer, numThreads);
+}
+
+template <typename OutputType>
+void FingerprintGenerator<OutputType>::fillCountFingerprints(
+    const std::vector<const ROMol *> &mols, std::uint16_t *buffer,
+    int numThreads) const {
+  fillCountFingerprintsHelper(mols, buffer, numThreads);
+}
+
 template RDKIT_FINGERPRINTS_EXPORT std::unique_ptr<SparseIntVect<std::uint32_t>>
 FingerprintGenerator<std::uint32_t>::getSparseCountFingerprint(
     const ROMol &mol, FingerprintFuncArguments &args) const;
@@ -823,6 +928,36 @@ template RDKIT_FINGERPRINTS_EXPORT
     FingerprintGenerator<std::uint64_t>::getSparseCountFingerprints(
         const std::vector<const ROMol *> &mols, int numThreads) const;
 
+template RDKIT_FINGERPRINTS_EXPORT void
+FingerprintGenerator<std::uint32_t>::fillFingerprints(
+    const std::vector<const ROMol *> &mols, std::uint8_t *buffer,
+    int numThreads) const;
+
+template RDKIT_FINGERPRINTS_EXPORT void
+FingerprintGenerator<std::uint64_t>::fillFingerprints(
+    const std::vector<const ROMol *> &mols, std::uint8_t *buffer,
+    int numThreads) const;
+
+template RDKIT_FINGERPRINTS_EXPORT void
+FingerprintGenerator<std::uint32_t>::fillCountFingerprints(
+    const std::vector<const ROMol *> &mols, std::uint8_t *buffer,
+    int numThreads) const;
+
+template RDKIT_FINGERPRINTS_EXPORT void
+FingerprintGenerator<std::uint32_t>::fillCountFingerprints(
+    const std::vector<const ROMol *> &mols, std::uint16_t *buffer,
+    int numThreads) const;
+
+template RDKIT_FINGERPRINTS_EXPORT void
+FingerprintGenerator<std::uint64_t>::fillCountFingerprints(
+    const std::vector<const ROMol *> &mols, std::uint8_t *buffer,
+    int numThreads) const;
+
+template RDKIT_FINGERPRINTS_EXPORT void
+FingerprintGenerator<std::uint64_t>::fillCountFingerprints(
+    const std::vector<const ROMol *> &mols, std::uint16_t *buffer,
+    int numThreads) const;
+
 SparseIntVect<std::uint64_t> *getSparseCountFP(const ROMol &mol,
                                                FPType fPType) {
   std::vector<const ROMol *> tempVect(1, &mol);
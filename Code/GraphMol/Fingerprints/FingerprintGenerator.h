@@ -24,6 +24,14 @@
 namespace RDKit {
 class ROMol;
 
+//! counters from the path enumeration of the RDKit fingerprint
+struct RDKIT_FINGERPRINTS_EXPORT PathEnumerationStats {
+  //! the number of paths (or subgraphs) which were enumerated
+  std::uint64_t numPaths = 0;
+  //! set if the enumeration was stopped because it reached the maximum
+  bool budgetExceeded = false;
+};
+
 struct RDKIT_FINGERPRINTS_EXPORT AdditionalOutput {
   using atomToBitsType = std::vector<std::vector<std::uint64_t>>;
   using bitInfoMapType =
@@ -52,6 +60,10 @@ struct RDKIT_FINGERPRINTS_EXPORT AdditionalOutput {
   // maps bitId -> vector of atoms involved in setting that bit
   atomsPerBitType *atomsPerBit = nullptr;
 
+  // rdkit fp when streaming the paths
+  // how many paths were enumerated and whether maxPaths was reached
+  PathEnumerationStats *pathStats = nullptr;
+
   void allocateAtomToBits() {
     atomToBitsHolder.reset(new atomToBitsType);
     atomToBits = atomToBitsHolder.get();
@@ -72,6 +84,10 @@ struct RDKIT_FINGERPRINTS_EXPORT AdditionalOutput {
     atomsPerBitHolder.reset(new atomsPerBitType);
     atomsPerBit = atomsPerBitHolder.get();
   }
+  void allocatePathStats() {
+    pathStatsHolder.reset(new PathEnumerationStats);
+    pathStats = pathStatsHolder.get();
+  }
 
  private:
   std::unique_ptr<atomToBitsType> atomToBitsHolder;
@@ -79,6 +95,7 @@ struct RDKIT_FINGERPRINTS_EXPORT AdditionalOutput {
   std::unique_ptr<bitPathsType> bitPathsHolder;
   std::unique_ptr<atomCountsType> atomCountsHolder;
   std::unique_ptr<atomsPerBitType> atomsPerBitHolder;
+  std::unique_ptr<PathEnumerationStats> pathStatsHolder;
 };
 
 /*!
@@ -149,6 +166,9 @@ class RDKIT_FINGERPRINTS_EXPORT AtomEnvironment : private boost::noncopyable {
                               const std::uint64_t fpSize = 0) const = 0;
   virtual void updateAdditionalOutput(AdditionalOutput *AdditionalOutput,
                                       std::uint64_t bitId) const = 0;
+  //! the number of times this environment occurs, its bits are set that
+  //! many times
+  virtual unsigned int getCount() const { return 1; }
 
   virtual ~AtomEnvironment() {}
 };
@@ -246,6 +266,9 @@ class RDKIT_FINGERPRINTS_EXPORT AtomInvariantsGenerator
   virtual std::string infoString() const = 0;
   virtual void toJSON(boost::property_tree::ptree &) const {};
   virtual void fromJSON(const boost::property_tree::ptree &) {};
+  //! the sanitization operations (see MolOps::SanitizeFlags) whose results
+  //! the invariants depend on, all of them unless this is overridden
+  virtual unsigned int getRequiredSanitization() const;
 
   virtual ~AtomInvariantsGenerator() {}
   virtual AtomInvariantsGenerator *clone() const = 0;
@@ -278,6 +301,9 @@ class RDKIT_FINGERPRINTS_EXPORT BondInvariantsGenerator
   virtual std::string infoString() const = 0;
   virtual void toJSON(boost::property_tree::ptree &) const {};
   virtual void fromJSON(const boost::property_tree::ptree &) {};
+  //! the sanitization operations (see MolOps::SanitizeFlags) whose results
+  //! the invariants depend on, all of them unless this is overridden
+  virtual unsigned int getRequiredSanitization() const;
 
   virtual ~BondInvariantsGenerator() {}
   virtual BondInvariantsGenerator *clone() const = 0;
@@ -329,6 +355,13 @@ class RDKIT_FINGERPRINTS_EXPORT FingerprintGenerator
   std::unique_ptr<SparseIntVect<OutputType>> getFingerprintHelper(
       const ROMol &mol, FingerprintFuncArguments &args,
       const std::uint64_t fpSize = 0) const;
+  //! calls addBit(bitId) for every bit set by the atom environments of mol
+  template <typename BitFunc>
+  void forEachBitId(const ROMol &mol, FingerprintFuncArguments &args,
+                    const std::uint64_t fpSize, BitFunc addBit) const;
+  template <typename CountType>
+  void fillCountFingerprintsHelper(const std::vector<const ROMol *> &mols,
+                                   CountType *buffer, int numThreads) const;
 
  public:
   FingerprintGenerator(
@@ -344,6 +377,16 @@ class RDKIT_FINGERPRINTS_EXPORT FingerprintGenerator
   const FingerprintArguments *getOptions() const {
     return dp_fingerprintArguments;
   };
+  const AtomInvariantsGenerator *getAtomInvariantsGenerator() const {
+    return dp_atomInvariantsGenerator;
+  };
+  const BondInvariantsGenerator *getBondInvariantsGenerator() const {
+    return dp_bondInvariantsGenerator;
+  };
+  //! the sanitization operations (see MolOps::SanitizeFlags) whose results
+  //! the fingerprints depend on. Pending ones are carried out by
+  //! MolOps::requireSanitization() before a fingerprint is generated.
+  unsigned int getRequiredSanitization() const;
 
   std::unique_ptr<SparseIntVect<OutputType>> getSparseCountFingerprint(
       const ROMol &mol, FingerprintFuncArguments &args) const;
@@ -371,6 +414,32 @@ class RDKIT_FINGERPRINTS_EXPORT FingerprintGenerator
   getSparseCountFingerprints(const std::vector<const ROMol *> &mols,
                              int numThreads = 1) const;
 
+  //! Writes the fingerprints of a set of molecules into a buffer
+  /*!
+    The fingerprint of mols[i] goes into the fpSize bytes starting at
+    buffer + i * fpSize, one byte per bit holding 0 or 1. These are the same
+    bits as getFingerprint() sets, but no intermediate vectors are created,
+    so this is the fastest way to fill e.g. a numpy array with
+    fingerprints. Rows for null molecules are set to zero.
+
+    \param mols the molecules
+    \param buffer room for mols.size() * fpSize bytes
+    \param numThreads the number of threads to use
+  */
+  void fillFingerprints(const std::vector<const ROMol *> &mols,
+                        std::uint8_t *buffer, int numThreads = 1) const;
+  //! Writes the count fingerprints of a set of molecules into a buffer
+  /*!
+    The same as fillFingerprints(), but row i holds the counts that
+    getCountFingerprint() returns for mols[i]. Counts that do not fit into
+    the buffer's type are set to its maximum value.
+  */
+  void fillCountFingerprints(const std::vector<const ROMol *> &mols,
+                             std::uint8_t *buffer, int numThreads = 1) const;
+  //! \overload
+  void fillCountFingerprints(const std::vector<const ROMol *> &mols,
+                             std::uint16_t *buffer, int numThreads = 1) const;
+
   SparseIntVect<OutputType> *getSparseCountFingerprint(
       const ROMol &mol, const std::vector<std::uint32_t> *fromAtoms = nullptr,
       const std::vector<std::uint32_t> *ignoreAtoms = nullptr, int confId = -1,
@@ -239,28 +239,33 @@ void getFeatureInvariants(const ROMol &mol, std::vector<uint32_t> &invars,
   }
 }  // end of getFeatureInvariants()
 
+std::uint32_t getConnectivityInvariant(const Atom &atom,
+                                       bool includeRingMembership) {
+  std::vector<uint32_t> components;
+  components.push_back(atom.getAtomicNum());
+  components.push_back(atom.getTotalDegree());
+  components.push_back(atom.getTotalNumHs(true));
+  components.push_back(atom.getFormalCharge());
+  int deltaMass = static_cast<int>(
+      atom.getMass() -
+      PeriodicTable::getTable()->getAtomicWeight(atom.getAtomicNum()));
+  components.push_back(deltaMass);
+
+  if (includeRingMembership &&
+      atom.getOwningMol().getRingInfo()->numAtomRings(atom.getIdx())) {
+    components.push_back(1);
+  }
+  gboost::hash<std::vector<uint32_t>> vectHasher;
+  return vectHasher(components);
+}
+
 void getConnectivityInvariants(const ROMol &mol, std::vector<uint32_t> &invars,
                                bool includeRingMembership) {
   unsigned int nAtoms = mol.getNumAtoms();
   PRECONDITION(invars.size() >= nAtoms, "vector too small");
-  gboost::hash<std::vector<uint32_t>> vectHasher;
   for (unsigned int i = 0; i < nAtoms; ++i) {
-    Atom const *atom = mol.getAtomWithIdx(i);
-    std::vector<uint32_t> components;
-    components.push_back(atom->getAtomicNum());
-    components.push_back(atom->getTotalDegree());
-    components.push_back(atom->getTotalNumHs(true));
-    components.push_back(atom->getFormalCharge());
-    int deltaMass = static_cast<int>(
-        atom->getMass() -
-        PeriodicTable::getTable()->getAtomicWeight(atom->getAtomicNum()));
-    components.push_back(deltaMass);
-
-    if (includeRingMembership &&
-        atom->getOwningMol().getRingInfo()->numAtomRings(atom->getIdx())) {
-      components.push_back(1);
-    }
-    invars[i] = vectHasher(components);
+    invars[i] =
+        getConnectivityInvariant(*mol.getAtomWithIdx(i), includeRingMembership);
   }
 }  // end of getConnectivityInvariants()
 
@@ -279,6 +284,78 @@ void buildDefaultRDKitFingerprintAtomInvariants(
   }
 }
 
+namespace {
+// calculates the hashes of the bonds in a path. atomDegrees holds the number
+// of bonds in the path at each atom.
+void hashBondsInPath(const std::vector<const Bond *> &bondCache,
+                     const PATH_TYPE &path, bool useBondOrder,
+                     const std::vector<std::uint32_t> &atomInvariants,
+                     const std::vector<unsigned int> &atomDegrees,
+                     std::vector<unsigned int> &bondNbrs,
+                     std::vector<unsigned int> &bondHashes) {
+  bondNbrs.assign(path.size(), 0);
+  bondHashes.clear();
+  bondHashes.reserve(path.size() + 1);
+
+  for (unsigned int i = 0; i < path.size(); ++i) {
+    const Bond *bi = bondCache[path[i]];
+#ifdef REPORT_FP_STATS
+    if (std::find(atomsToUse.begin(), atomsToUse.end(),
+                  bi->getBeginAtomIdx()) == atomsToUse.end()) {
+      atomsToUse.push_back(bi->getBeginAtomIdx());
+    }
+    if (std::find(atomsToUse.begin(), atomsToUse.end(), bi->getEndAtomIdx()) ==
+        atomsToUse.end()) {
+      atomsToUse.push_back(bi->getEndAtomIdx());
+    }
+#endif
+    for (unsigned int j = i + 1; j < path.size(); ++j) {
+      const Bond *bj = bondCache[path[j]];
+      if (bi->getBeginAtomIdx() == bj->getBeginAtomIdx() ||
+          bi->getBeginAtomIdx() == bj->getEndAtomIdx() ||
+          bi->getEndAtomIdx() == bj->getBeginAtomIdx() ||
+          bi->getEndAtomIdx() == bj->getEndAtomIdx()) {
+        ++bondNbrs[i];
+        ++bondNbrs[j];
+      }
+    }
+#ifdef VERBOSE_FINGERPRINTING
+    std::cerr << "   bond(" << i << "):" << bondNbrs[i] << std::endl;
+#endif
+    // we have the count of neighbors for bond bi, compute its hash:
+    unsigned int a1Hash = atomInvariants[bi->getBeginAtomIdx()];
+    unsigned int a2Hash = atomInvariants[bi->getEndAtomIdx()];
+    unsigned int deg1 = atomDegrees[bi->getBeginAtomIdx()];
+    unsigned int deg2 = atomDegrees[bi->getEndAtomIdx()];
+    if (a1Hash < a2Hash) {
+      std::swap(a1Hash, a2Hash);
+      std::swap(deg1, deg2);
+    } else if (a1Hash == a2Hash && deg1 < deg2) {
+      std::swap(deg1, deg2);
+    }
+    unsigned int bondHash = 1;
+    if (useBondOrder) {
+      if (bi->getIsAromatic() || bi->getBondType() == Bond::AROMATIC) {
+        // makes sure aromatic bonds always hash as aromatic
+        bondHash = Bond::AROMATIC;
+      } else {
+        bondHash = bi->getBondType();
+      }
+    }
+    std::uint32_t ourHash = bondNbrs[i];
+    gboost::hash_combine(ourHash, bondHash);
+    gboost::hash_combine(ourHash, a1Hash);
+    gboost::hash_combine(ourHash, deg1);
+    gboost::hash_combine(ourHash, a2Hash);
+    gboost::hash_combine(ourHash, deg2);
+    bondHashes.push_back(ourHash);
+    // std::cerr<<"    "<<bi->getIdx()<<"
+    // "<<a1Hash<<"("<<deg1<<")"<<"-"<<a2Hash<<"("<<deg2<<")"<<" "<<bondHash<<"
+    // -> "<<ourHash<<std::endl;
+  }
+}
+}  // namespace
+
 void enumerateAllPaths(const ROMol &mol, INT_PATH_LIST_MAP &allPaths,
                        const std::vector<std::uint32_t> *fromAtoms,
                        bool branchedPaths, bool useHs, unsigned int minPath,
@@ -381,68 +458,88 @@ std::vector<unsigned int> generateBondHashes(
     return bondHashes;
   }
 
-  // -----------------
-  // calculate the bond hashes:
-  std::vector<unsigned int> bondNbrs(path.size(), 0);
-  bondHashes.reserve(path.size() + 1);
+  std::vector<unsigned int> bondNbrs;
+  hashBondsInPath(bondCache, path, useBondOrder, *atomInvariants, atomDegrees,
+                  bondNbrs, bondHashes);
+  return bondHashes;
+}
 
-  for (unsigned int i = 0; i < path.size(); ++i) {
-    const Bond *bi = bondCache[path[i]];
-#ifdef REPORT_FP_STATS
-    if (std::find(atomsToUse.begin(), atomsToUse.end(),
-                  bi->getBeginAtomIdx()) == atomsToUse.end()) {
-      atomsToUse.push_back(bi->getBeginAtomIdx());
+PathEnumerationStats hashAllPaths(
+    const ROMol &mol, const PathHashCallback &callback,
+    const std::vector<std::uint32_t> *fromAtoms, bool branchedPaths, bool useHs,
+    unsigned int minPath, unsigned int maxPath, bool useBondOrder,
+    const std::vector<std::uint32_t> *atomInvariants, std::uint64_t maxPaths,
+    boost::dynamic_bitset<> *ignoreAtoms) {
+  PRECONDITION(atomInvariants && atomInvariants->size() >= mol.getNumAtoms(),
+               "bad atomInvariants size");
+  PRECONDITION(!ignoreAtoms || ignoreAtoms->size() == mol.getNumAtoms(),
+               "bad ignoreAtoms size");
+  std::vector<short> isQueryBond(mol.getNumBonds(), 0);
+  std::vector<const Bond *> bondCache;
+  identifyQueryBonds(mol, bondCache, isQueryBond);
+
+  // reused for every path, only the entries of the atoms in the path are set
+  // and they are cleared again afterwards
+  std::vector<unsigned int> atomDegrees(mol.getNumAtoms(), 0);
+  std::vector<unsigned int> bondNbrs;
+  std::vector<unsigned int> bondHashes;
+
+  PathEnumerationStats stats;
+  auto hashPath = [&](const PATH_TYPE &path) {
+    if (maxPaths && stats.numPaths >= maxPaths) {
+      stats.budgetExceeded = true;
+      return false;
     }
-    if (std::find(atomsToUse.begin(), atomsToUse.end(), bi->getEndAtomIdx()) ==
-        atomsToUse.end()) {
-      atomsToUse.push_back(bi->getEndAtomIdx());
+    ++stats.numPaths;
+    bool queryInPath = false;
+    unsigned int numAtoms = 0;
+    for (const auto bidx : path) {
+      const Bond *bond = bondCache[bidx];
+      numAtoms += !atomDegrees[bond->getBeginAtomIdx()]++;
+      numAtoms += !atomDegrees[bond->getEndAtomIdx()]++;
+      if (isQueryBond[bidx]) {
+        queryInPath = true;
+      }
     }
-#endif
-    for (unsigned int j = i + 1; j < path.size(); ++j) {
-      const Bond *bj = bondCache[path[j]];
-      if (bi->getBeginAtomIdx() == bj->getBeginAtomIdx() ||
-          bi->getBeginAtomIdx() == bj->getEndAtomIdx() ||
-          bi->getEndAtomIdx() == bj->getBeginAtomIdx() ||
-          bi->getEndAtomIdx() == bj->getEndAtomIdx()) {
-        ++bondNbrs[i];
-        ++bondNbrs[j];
+    if (!queryInPath) {
+      hashBondsInPath(bondCache, path, useBondOrder, *atomInvariants,
+                      atomDegrees, bondNbrs, bondHashes);
+      // this needs to match RDKitFPEnvGenerator::getEnvironments()
+      std::uint32_t seed;
+      if (path.size() > 1) {
+        std::sort(bondHashes.begin(), bondHashes.end());
+        bondHashes.push_back(numAtoms);
+        seed = gboost::hash_range(bondHashes.begin(), bondHashes.end());
+      } else {
+        seed = bondHashes[0];
       }
+      callback(seed, path);
     }
-#ifdef VERBOSE_FINGERPRINTING
-    std::cerr << "   bond(" << i << "):" << bondNbrs[i] << std::endl;
-#endif
-    // we have the count of neighbors for bond bi, compute its hash:
-    unsigned int a1Hash = (*atomInvariants)[bi->getBeginAtomIdx()];
-    unsigned int a2Hash = (*atomInvariants)[bi->getEndAtomIdx()];
-    unsigned int deg1 = atomDegrees[bi->getBeginAtomIdx()];
-    unsigned int deg2 = atomDegrees[bi->getEndAtomIdx()];
-    if (a1Hash < a2Hash) {
-      std::swap(a1Hash, a2Hash);
-      std::swap(deg1, deg2);
-    } else if (a1Hash == a2Hash && deg1 < deg2) {
-      std::swap(deg1, deg2);
+    for (const auto bidx : path) {
+      atomDegrees[bondCache[bidx]->getBeginAtomIdx()] = 0;
+      atomDegrees[bondCache[bidx]->getEndAtomIdx()] = 0;
     }
-    unsigned int bondHash = 1;
-    if (useBondOrder) {
-      if (bi->getIsAromatic() || bi->getBondType() == Bond::AROMATIC) {
-        // makes sure aromatic bonds always hash as aromatic
-        bondHash = Bond::AROMATIC;
-      } else {
-        bondHash = bi->getBondType();
+    return true;
+  };
+
+  auto visitPaths = [&](int rootedAtAtom) {
+    if (branchedPaths) {
+      return visitAllSubgraphsOfLengthsMtoN(mol, minPath, maxPath, hashPath,
+                                            useHs, rootedAtAtom, ignoreAtoms);
+    }
+    return visitAllPathsOfLengthsMtoN(mol, minPath, maxPath, hashPath, useHs,
+                                      rootedAtAtom, ignoreAtoms);
+  };
+  if (!fromAtoms) {
+    visitPaths(-1);
+  } else {
+    for (const auto aidx : *fromAtoms) {
+      if (!visitPaths(aidx)) {
+        break;
       }
     }
-    std::uint32_t ourHash = bondNbrs[i];
-    gboost::hash_combine(ourHash, bondHash);
-    gboost::hash_combine(ourHash, a1Hash);
-    gboost::hash_combine(ourHash, deg1);
-    gboost::hash_combine(ourHash, a2Hash);
-    gboost::hash_combine(ourHash, deg2);
-    bondHashes.push_back(ourHash);
-    // std::cerr<<"    "<<bi->getIdx()<<"
-    // "<<a1Hash<<"("<<deg1<<")"<<"-"<<a2Hash<<"("<<deg2<<")"<<" "<<bondHash<<"
-    // -> "<<ourHash<<std::endl;
   }
-  return bondHashes;
+  return stats;
 }
 
 }  // namespace RDKitFPUtils
@@ -16,6 +16,7 @@
 #include <DataStructs/SparseIntVect.h>
 #include <DataStructs/BitVects.h>
 #include <cstdint>
+#include <functional>
 #include <tuple>
 #include <vector>
 #include <map>
@@ -23,6 +24,7 @@
 #include <boost/dynamic_bitset.hpp>
 
 #include <GraphMol/Subgraphs/Subgraphs.h>
+#include <GraphMol/Fingerprints/FingerprintGenerator.h>
 
 namespace RDKit {
 namespace AtomPairs {
@@ -112,6 +114,10 @@ RDKIT_FINGERPRINTS_EXPORT extern std::vector<std::string> defaultFeatureSmarts;
 RDKIT_FINGERPRINTS_EXPORT void getConnectivityInvariants(
     const ROMol &mol, std::vector<std::uint32_t> &invars,
     bool includeRingMembership = true);
+//! returns the connectivity invariant of a single atom
+//! (see getConnectivityInvariants())
+RDKIT_FINGERPRINTS_EXPORT std::uint32_t getConnectivityInvariant(
+    const Atom &atom, bool includeRingMembership = true);
 const std::string morganConnectivityInvariantVersion = "1.0.0";
 
 //! returns the feature invariants for a molecule
@@ -155,6 +161,29 @@ RDKIT_FINGERPRINTS_EXPORT std::vector<unsigned int> generateBondHashes(
     const std::vector<short> &isQueryBond, const std::vector<int> &path,
     bool useBondOrder, const std::vector<std::uint32_t> *atomInvariants);
 
+//! called by hashAllPaths() with the hash of each path and the path (as bond
+//! indices)
+using PathHashCallback =
+    std::function<void(std::uint32_t, const std::vector<int> &)>;
+
+//! hashes the paths of the RDKit fingerprint as they are enumerated
+/*!
+  The hashes are the same as those of the paths from enumerateAllPaths(), but
+  the paths are never collected. Paths which contain query bonds or atoms are
+  skipped, like in generateBondHashes().
+
+  \param maxPaths  if nonzero, the enumeration stops after this many paths
+
+  \return the number of paths which were enumerated and whether the
+  enumeration was stopped by \c maxPaths
+*/
+RDKIT_FINGERPRINTS_EXPORT PathEnumerationStats hashAllPaths(
+    const ROMol &mol, const PathHashCallback &callback,
+    const std::vector<std::uint32_t> *fromAtoms, bool branchedPaths, bool useHs,
+    unsigned int minPath, unsigned int maxPath, bool useBondOrder,
+    const std::vector<std::uint32_t> *atomInvariants,
+    std::uint64_t maxPaths = 0, boost::dynamic_bitset<> *ignoreAtoms = nullptr);
+
 }  // namespace RDKitFPUtils
 
 }  // namespace RDKit
@@ -22,7 +22,11 @@
 #include <RDGeneral/BoostEndInclude.h>
 
 #include <RDGeneral/types.h>
+#include <RDGeneral/hash/hash.hpp>
+#include <RDGeneral/RDThreadPool.h>
+#include <RDGeneral/RDThreads.h>
 #include <GraphMol/MolOps.h>
+#include <GraphMol/Fingerprints/MorganGenerator.h>
 #include <GraphMol/Subgraphs/Subgraphs.h>
 #include <GraphMol/Subgraphs/SubgraphUtils.h>
 #include <GraphMol/SmilesParse/SmilesParse.h>
@@ -64,7 +68,7 @@ MHFPEncoder::MHFPEncoder(unsigned int n_permutations, unsigned int seed)
 }
 
 std::vector<uint32_t> MHFPEncoder::FromStringArray(
-    const std::vector<std::string> &vec) {
+    const std::vector<std::string> &vec) const {
   std::vector<uint32_t> mh(n_permutations_, max_hash_);
 
   for (uint32_t i = 0; i < vec.size(); i++) {
@@ -79,7 +83,8 @@ std::vector<uint32_t> MHFPEncoder::FromStringArray(
   return mh;
 }
 
-std::vector<uint32_t> MHFPEncoder::FromArray(const std::vector<uint32_t> &vec) {
+std::vector<uint32_t> MHFPEncoder::FromArray(
+    const std::vector<uint32_t> &vec) const {
   std::vector<uint32_t> mh(n_permutations_, max_hash_);
 
   for (uint32_t i = 0; i < vec.size(); i++) {
@@ -95,7 +100,7 @@ std::vector<uint32_t> MHFPEncoder::FromArray(const std::vector<uint32_t> &vec) {
 
 std::vector<std::string> MHFPEncoder::CreateShingling(
     const ROMol &mol, unsigned char radius, bool rings, bool isomeric,
-    bool kekulize, unsigned char min_radius) {
+    bool kekulize, unsigned char min_radius) const {
   RWMol tmol(mol);
   if (kekulize) {
     MolOps::Kekulize(tmol);
@@ -154,12 +159,151 @@ std::vector<std::string> MHFPEncoder::CreateShingling(
 
 std::vector<std::string> MHFPEncoder::CreateShingling(
     const std::string &smiles, unsigned char radius, bool rings, bool isomeric,
-    bool kekulize, unsigned char min_radius) {
+    bool kekulize, unsigned char min_radius) const {
   std::unique_ptr<RWMol> m(SmilesToMol(smiles));
   PRECONDITION(m, "could not parse smiles");
   return CreateShingling(*m, radius, rings, isomeric, kekulize, min_radius);
 }
 
+namespace {
+std::unique_ptr<FingerprintGenerator<std::uint32_t>> makeShinglingGenerator(
+    unsigned char radius, bool isomeric) {
+  // every atom contributes an environment at each radius, as in the SMILES
+  // shingling
+  const bool countSimulation = false;
+  const bool useBondTypes = true;
+  const bool onlyNonzeroInvariants = false;
+  const bool includeRedundantEnvironments = true;
+  return std::unique_ptr<FingerprintGenerator<std::uint32_t>>(
+      MorganFingerprint::getMorganGenerator<std::uint32_t>(
+          radius, countSimulation, isomeric, useBondTypes,
+          onlyNonzeroInvariants, includeRedundantEnvironments));
+}
+
+// Hashes the cycle of atom and bond labels around a ring, starting from the
+// lexicographically smallest of its rotations in either direction so that
+// the result doesn't depend on how the ring was perceived.
+std::uint32_t hashRing(const ROMol &mol, const INT_VECT &bondRing) {
+  const auto ringSize = bondRing.size();
+  std::vector<std::uint32_t> labels;
+  labels.reserve(2 * ringSize);
+  for (size_t i = 0; i < ringSize; ++i) {
+    const auto bond = mol.getBondWithIdx(bondRing[i]);
+    const auto nextBond = mol.getBondWithIdx(bondRing[(i + 1) % ringSize]);
+    // the atom this bond shares with the next one
+    auto atomIdx = bond->getBeginAtomIdx();
+    if (atomIdx != nextBond->getBeginAtomIdx() &&
+        atomIdx != nextBond->getEndAtomIdx()) {
+      atomIdx = bond->getEndAtomIdx();
+    }
+    const auto atom = mol.getAtomWithIdx(atomIdx);
+    labels.push_back(static_cast<std::uint32_t>(bond->getBondType()));
+    labels.push_back((atom->getAtomicNum() << 1) | atom->getIsAromatic());
+  }
+  const auto n = labels.size();
+  auto reversed = labels;
+  std::reverse(reversed.begin(), reversed.end());
+  const std::vector<std::uint32_t> *best = &labels;
+  size_t bestStart = 0;
+  auto less = [n](const std::vector<std::uint32_t> &l1, size_t s1,
+                  const std::vector<std::uint32_t> &l2, size_t s2) {
+    for (size_t i = 0; i < n; ++i) {
+      const auto v1 = l1[(s1 + i) % n];
+      const auto v2 = l2[(s2 + i) % n];
+      if (v1 != v2) {
+        return v1 < v2;
+      }
+    }
+    return false;
+  };
+  for (const auto *cand : {&labels, &reversed}) {
+    for (size_t start = 0; start < n; ++start) {
+      if (less(*cand, start, *best, bestStart)) {
+        best = cand;
+        bestStart = start;
+      }
+    }
+  }
+  // keep the ring hashes apart from the Morgan identifiers
+  std::uint32_t res = 0x52494e47;  // "RING"
+  for (size_t i = 0; i < n; ++i) {
+    gboost::hash_combine(res, (*best)[(bestStart + i) % n]);
+  }
+  return res;
+}
+
+std::vector<uint32_t> hashedShingling(
+    const ROMol &mol, const FingerprintGenerator<std::uint32_t> &generator,
+    bool rings, unsigned char min_radius) {
+  const ROMol *workMol = &mol;
+  std::unique_ptr<ROMol> molCopy;
+  if (!mol.getRingInfo()->isInitialized()) {
+    molCopy.reset(new ROMol(mol));
+    MolOps::findSSSR(*molCopy);
+    workMol = molCopy.get();
+  }
+
+  AdditionalOutput::bitInfoMapType bitInfo;
+  AdditionalOutput additionalOutput;
+  additionalOutput.bitInfoMap = &bitInfo;
+  FingerprintFuncArguments args;
+  args.additionalOutput = &additionalOutput;
+  std::unique_ptr<SparseIntVect<std::uint32_t>> fp(
+      generator.getSparseCountFingerprint(*workMol, args));
+
+  std::vector<uint32_t> shingling;
+  shingling.reserve(bitInfo.size());
+  for (const auto &[bitId, envs] : bitInfo) {
+    for (const auto &env : envs) {
+      if (env.second >= min_radius) {
+        shingling.push_back(static_cast<uint32_t>(bitId));
+        break;
+      }
+    }
+  }
+  if (rings) {
+    for (const auto &bondRing : workMol->getRingInfo()->bondRings()) {
+      shingling.push_back(hashRing(*workMol, bondRing));
+    }
+  }
+  std::sort(shingling.begin(), shingling.end());
+  shingling.erase(std::unique(shingling.begin(), shingling.end()),
+                  shingling.end());
+  return shingling;
+}
+}  // namespace
+
+std::vector<uint32_t> MHFPEncoder::CreateHashedShingling(
+    const ROMol &mol, unsigned char radius, bool rings, bool isomeric,
+    unsigned char min_radius) const {
+  auto generator = makeShinglingGenerator(radius, isomeric);
+  return hashedShingling(mol, *generator, rings, min_radius);
+}
+
+std::vector<std::vector<uint32_t>> MHFPEncoder::EncodeMols(
+    const std::vector<const ROMol *> &mols, unsigned char radius, bool rings,
+    bool isomeric, bool kekulize, unsigned char min_radius,
+    ShinglingType shinglingType, int numThreads) const {
+  std::unique_ptr<FingerprintGenerator<std::uint32_t>> generator;
+  if (shinglingType == ShinglingType::Morgan) {
+    generator = makeShinglingGenerator(radius, isomeric);
+  }
+  std::vector<std::vector<uint32_t>> results(mols.size());
+  parallelFor(mols.size(), getNumThreadsToUse(numThreads), [&](size_t i) {
+    if (!mols[i]) {
+      return;
+    }
+    if (generator) {
+      results[i] =
+          FromArray(hashedShingling(*mols[i], *generator, rings, min_radius));
+    } else {
+      results[i] = FromStringArray(CreateShingling(
+          *mols[i], radius, rings, isomeric, kekulize, min_radius));
+    }
+  });
+  return results;
+}
+
 std::vector<uint32_t> MHFPEncoder::Encode(ROMol &mol, unsigned char radius,
                                           bool rings, bool isomeric,
                                           bool kekulize,
@@ -41,6 +41,12 @@ inline uint32_t hash(const std::string &str, uint32_t hash = seed) {
 };
 }  // namespace FNV
 
+//! The source of the identifiers that make up the shingling of a molecule
+enum class ShinglingType {
+  SMILES,  //!< the SMILES of circular substructures, hashed with FNV
+  Morgan   //!< Morgan environment identifiers, which are much faster
+};
+
 class RDKIT_FINGERPRINTS_EXPORT MHFPEncoder {
  public:
   //! Constructor
@@ -72,7 +78,8 @@ class RDKIT_FINGERPRINTS_EXPORT MHFPEncoder {
 
     \returns the MinHash of the input.
    */
-  std::vector<uint32_t> FromStringArray(const std::vector<std::string> &vec);
+  std::vector<uint32_t> FromStringArray(
+      const std::vector<std::string> &vec) const;
 
   /*!
     \brief Creates a MinHash from a list of unsigned integers.
@@ -85,7 +92,7 @@ class RDKIT_FINGERPRINTS_EXPORT MHFPEncoder {
 
     \returns the MinHash of the input.
    */
-  std::vector<uint32_t> FromArray(const std::vector<uint32_t> &vec);
+  std::vector<uint32_t> FromArray(const std::vector<uint32_t> &vec) const;
 
   /*!
     \brief Creates a molecular shingling based on circular substructures.
@@ -116,7 +123,7 @@ class RDKIT_FINGERPRINTS_EXPORT MHFPEncoder {
                                            bool rings = true,
                                            bool isomeric = false,
                                            bool kekulize = false,
-                                           unsigned char min_radius = 1);
+                                           unsigned char min_radius = 1) const;
 
   //! \overload
   std::vector<std::string> CreateShingling(const std::string &smiles,
@@ -124,7 +131,37 @@ class RDKIT_FINGERPRINTS_EXPORT MHFPEncoder {
                                            bool rings = true,
                                            bool isomeric = false,
                                            bool kekulize = false,
-                                           unsigned char min_radius = 1);
+                                           unsigned char min_radius = 1) const;
+
+  /*!
+    \brief Creates a molecular shingling from Morgan environments.
+
+    This is a much faster alternative to CreateShingling. Rather than
+    generating and hashing the SMILES of the substructure around each atom,
+    the shingles are the identifiers of the Morgan environments of each atom
+    with radii from <tt>min_radius</tt> to <tt>radius</tt>. Rings are
+    represented by a hash of the atoms and bonds around them that does not
+    depend on where the ring starts or its direction.
+
+    The resulting MinHashes are not compatible with those from the SMILES
+    shingling.
+
+    \param radius the maximum radius of the environments. Default:
+           <tt>3</tt>.
+    \param rings whether the rings (SSSR) are added to the shingling.
+           Default: <tt>true</tt>.
+    \param isomeric whether chirality is included in the environments.
+           Default: <tt>false</tt>.
+    \param min_radius the minimum radius of the environments. Default:
+           <tt>1</tt>.
+
+    \returns the hashed shingling of a molecule, without duplicates.
+   */
+  std::vector<uint32_t> CreateHashedShingling(const ROMol &mol,
+                                              unsigned char radius = 3,
+                                              bool rings = true,
+                                              bool isomeric = false,
+                                              unsigned char min_radius = 1) const;
 
   /*!
     \brief Creates a MinHash vector from a molecule.
@@ -177,6 +214,30 @@ class RDKIT_FINGERPRINTS_EXPORT MHFPEncoder {
                                             bool kekulize = false,
                                             unsigned char min_radius = 1);
 
+  /*!
+    \brief Creates MinHash vectors for a collection of molecules using
+           multiple threads.
+
+    \param mols the molecules. Null pointers give empty vectors.
+    \param shinglingType whether the shingling is built from SMILES, as in
+           Encode, or from Morgan environments, as in CreateHashedShingling.
+           Default: <tt>ShinglingType::SMILES</tt>.
+    \param numThreads the number of threads to use. Uses the usual RDKit
+           convention where values <= 0 mean use all available threads less
+           that number. Default: <tt>1</tt>.
+
+    The other parameters are as for Encode. <tt>kekulize</tt> is ignored for
+    the Morgan shingling.
+
+    \returns the MHFP fingerprints, in the same order as the molecules.
+   */
+  std::vector<std::vector<uint32_t>> EncodeMols(
+      const std::vector<const ROMol *> &mols, unsigned char radius = 3,
+      bool rings = true, bool isomeric = false, bool kekulize = false,
+      unsigned char min_radius = 1,
+      ShinglingType shinglingType = ShinglingType::SMILES,
+      int numThreads = 1) const;
+
   /*!
     \brief Creates a binary fingerprint based on circular sub-SMILES.
 
@@ -251,7 +312,7 @@ class RDKIT_FINGERPRINTS_EXPORT MHFPEncoder {
 
  private:
   //! The fastest mod implementation.
-  uint64_t FastMod(const uint64_t input, const uint64_t ceil) {
+  uint64_t FastMod(const uint64_t input, const uint64_t ceil) const {
     return input >= ceil ? input % ceil : input;
   }
 
@@ -0,0 +1,295 @@
+//
+//  Copyright (C) 2026 Greg Landrum and other RDKit contributors
+//
+//   @@ All Rights Reserved @@
+//  This file is part of the RDKit.
+//  The contents are covered by the terms of the BSD license
+//  which is included in the file license.txt, found at the root
+//  of the RDKit source tree.
+//
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <limits>
+
+#include <RDGeneral/BadFileException.h>
+#include <RDGeneral/Exceptions.h>
+#include <RDGeneral/Invariant.h>
+#include <RDGeneral/RDThreadPool.h>
+#include <RDGeneral/RDThreads.h>
+#include <RDGeneral/StreamOps.h>
+
+#include "MHFPLSHForest.h"
+
+namespace RDKit {
+namespace MHFPFingerprints {
+
+namespace {
+constexpr std::uint32_t lshForestMagic = 0x464c484d;  // "MHLF"
+constexpr std::uint32_t lshForestVersion = 1;
+
+// The arrays are written little-endian, which on the usual hosts means in
+// one go.
+void writeVector(std::ostream &os, const std::vector<std::uint32_t> &vec) {
+  std::uint64_t n = vec.size();
+  streamWrite(os, n);
+  if constexpr (HOST_ENDIAN_ORDER == LITTLE_ENDIAN_ORDER) {
+    os.write(reinterpret_cast<const char *>(vec.data()),
+             vec.size() * sizeof(std::uint32_t));
+  } else {
+    for (auto v : vec) {
+      streamWrite(os, v);
+    }
+  }
+}
+
+void readVector(std::istream &is, std::vector<std::uint32_t> &vec) {
+  std::uint64_t n = 0;
+  streamRead(is, n);
+  if (is.fail()) {
+    throw ValueErrorException("LSH Forest stream is truncated.");
+  }
+  vec.resize(n);
+  if constexpr (HOST_ENDIAN_ORDER == LITTLE_ENDIAN_ORDER) {
+    is.read(reinterpret_cast<char *>(vec.data()),
+            vec.size() * sizeof(std::uint32_t));
+  } else {
+    for (auto &v : vec) {
+      streamRead(is, v);
+    }
+  }
+  if (is.fail()) {
+    throw ValueErrorException("LSH Forest stream is truncated.");
+  }
+}
+
+bool hitLess(const LSHForestHit &h1, const LSHForestHit &h2) {
+  return h1.second < h2.second ||
+         (h1.second == h2.second && h1.first < h2.first);
+}
+}  // namespace
+
+MHFPLSHForest::MHFPLSHForest(unsigned int numPermutations,
+                             unsigned int numPrefixTrees)
+    : d_numPermutations(numPermutations), d_numPrefixTrees(numPrefixTrees) {
+  if (!d_numPrefixTrees || d_numPrefixTrees > d_numPermutations) {
+    throw ValueErrorException(
+        "numPrefixTrees must be between 1 and numPermutations");
+  }
+  d_hashesPerTree = d_numPermutations / d_numPrefixTrees;
+  d_trees.resize(d_numPrefixTrees);
+}
+
+MHFPLSHForest::MHFPLSHForest(std::istream &is) { read(is); }
+
+MHFPLSHForest::MHFPLSHForest(const std::string &fileName) {
+  std::ifstream ifs(fileName, std::ios_base::binary);
+  if (!ifs) {
+    throw BadFileException("Could not open LSH Forest file " + fileName);
+  }
+  read(ifs);
+}
+
+void MHFPLSHForest::checkFingerprint(const std::vector<uint32_t> &fp) const {
+  if (fp.size() != d_numPermutations) {
+    throw ValueErrorException(
+        "fingerprint length does not match the number of permutations");
+  }
+}
+
+unsigned int MHFPLSHForest::add(const std::vector<uint32_t> &fp) {
+  checkFingerprint(fp);
+  if (d_numItems == std::numeric_limits<unsigned int>::max()) {
+    throw ValueErrorException("LSH Forest is full");
+  }
+  d_fps.insert(d_fps.end(), fp.begin(), fp.end());
+  return d_numItems++;
+}
+
+void MHFPLSHForest::index(int numThreads) {
+  if (d_numIndexed == d_numItems) {
+    return;
+  }
+  const auto numOld = d_numIndexed;
+  const auto nthreads = getNumThreadsToUse(numThreads);
+  parallelFor(d_numPrefixTrees, nthreads, [&](size_t tree) {
+    auto keyLess = [this, tree](uint32_t i, uint32_t j) {
+      return std::lexicographical_compare(
+          key(i, tree), key(i, tree) + d_hashesPerTree, key(j, tree),
+          key(j, tree) + d_hashesPerTree);
+    };
+    auto &sorted = d_trees[tree];
+    sorted.reserve(d_numItems);
+    for (auto i = numOld; i < d_numItems; ++i) {
+      sorted.push_back(i);
+    }
+    // stable, so equal keys stay in order of index
+    std::stable_sort(sorted.begin() + numOld, sorted.end(), keyLess);
+    std::inplace_merge(sorted.begin(), sorted.begin() + numOld, sorted.end(),
+                       keyLess);
+  });
+  d_numIndexed = d_numItems;
+}
+
+std::vector<uint32_t> MHFPLSHForest::getFingerprint(unsigned int idx) const {
+  URANGE_CHECK(idx, d_numItems);
+  return std::vector<uint32_t>(key(idx, 0), key(idx, 0) + d_numPermutations);
+}
+
+std::vector<LSHForestHit> MHFPLSHForest::rankCandidates(
+    const std::vector<uint32_t> &fp, std::vector<unsigned int> &candidates,
+    unsigned int k) const {
+  std::vector<LSHForestHit> res;
+  res.reserve(candidates.size());
+  for (auto idx : candidates) {
+    const auto *other = key(idx, 0);
+    unsigned int mismatches = 0;
+    for (unsigned int i = 0; i < d_numPermutations; ++i) {
+      mismatches += fp[i] != other[i];
+    }
+    // the same as MHFPEncoder::Distance()
+    res.emplace_back(idx, mismatches / static_cast<double>(d_numPermutations));
+  }
+  if (res.size() > k) {
+    std::partial_sort(res.begin(), res.begin() + k, res.end(), hitLess);
+    res.resize(k);
+  } else {
+    std::sort(res.begin(), res.end(), hitLess);
+  }
+  return res;
+}
+
+std::vector<LSHForestHit> MHFPLSHForest::query(const std::vector<uint32_t> &fp,
+                                               unsigned int k,
+                                               unsigned int kc) const {
+  checkFingerprint(fp);
+  if (!k || !d_numIndexed) {
+    return {};
+  }
+  const size_t numWanted = static_cast<size_t>(k) * std::max(kc, 1u);
+  std::vector<unsigned int> candidates;
+  // Work from the longest prefix down, every match of a longer prefix also
+  // matches the shorter ones so the candidates from the previous round are
+  // found again.
+  for (auto prefixLen = d_hashesPerTree; prefixLen > 0; --prefixLen) {
+    candidates.clear();
+    for (unsigned int tree = 0; tree < d_numPrefixTrees; ++tree) {
+      const auto *queryKey = fp.data() + tree * d_hashesPerTree;
+      const auto &sorted = d_trees[tree];
+      auto first = std::lower_bound(
+          sorted.begin(), sorted.end(), queryKey,
+          [this, tree, prefixLen](uint32_t i, const uint32_t *qk) {
+            return std::lexicographical_compare(
+                key(i, tree), key(i, tree) + prefixLen, qk, qk + prefixLen);
+          });
+      auto last = std::upper_bound(
+          first, sorted.end(), queryKey,
+          [this, tree, prefixLen](const uint32_t *qk, uint32_t i) {
+            return std::lexicographical_compare(qk, qk + prefixLen,
+                                                key(i, tree),
+                                                key(i, tree) + prefixLen);
+          });
+      candidates.insert(candidates.end(), first, last);
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                     candidates.end());
+    if (candidates.size() >= numWanted) {
+      break;
+    }
+  }
+  return rankCandidates(fp, candidates, k);
+}
+
+std::vector<std::vector<LSHForestHit>> MHFPLSHForest::query(
+    const std::vector<std::vector<uint32_t>> &fps, unsigned int k,
+    unsigned int kc, int numThreads) const {
+  for (const auto &fp : fps) {
+    checkFingerprint(fp);
+  }
+  std::vector<std::vector<LSHForestHit>> res(fps.size());
+  parallelFor(fps.size(), getNumThreadsToUse(numThreads),
+              [&](size_t i) { res[i] = query(fps[i], k, kc); });
+  return res;
+}
+
+std::vector<LSHForestHit> MHFPLSHForest::queryExact(
+    const std::vector<uint32_t> &fp, unsigned int k) const {
+  checkFingerprint(fp);
+  std::vector<unsigned int> candidates(d_numItems);
+  for (unsigned int i = 0; i < d_numItems; ++i) {
+    candidates[i] = i;
+  }
+  return rankCandidates(fp, candidates, k);
+}
+
+std::vector<std::vector<LSHForestHit>> MHFPLSHForest::queryExact(
+    const std::vector<std::vector<uint32_t>> &fps, unsigned int k,
+    int numThreads) const {
+  for (const auto &fp : fps) {
+    checkFingerprint(fp);
+  }
+  std::vector<std::vector<LSHForestHit>> res(fps.size());
+  parallelFor(fps.size(), getNumThreadsToUse(numThreads),
+              [&](size_t i) { res[i] = queryExact(fps[i], k); });
+  return res;
+}
+
+void MHFPLSHForest::write(std::ostream &os) const {
+  streamWrite(os, lshForestMagic);
+  streamWrite(os, lshForestVersion);
+  streamWrite(os, d_numPermutations);
+  streamWrite(os, d_numPrefixTrees);
+  streamWrite(os, d_numItems);
+  streamWrite(os, d_numIndexed);
+  writeVector(os, d_fps);
+  for (const auto &tree : d_trees) {
+    writeVector(os, tree);
+  }
+}
+
+void MHFPLSHForest::write(const std::string &fileName) const {
+  std::ofstream ofs(fileName, std::ios_base::binary);
+  if (!ofs) {
+    throw BadFileException("Could not open LSH Forest file " + fileName +
+                           " for writing");
+  }
+  write(ofs);
+}
+
+void MHFPLSHForest::read(std::istream &is) {
+  std::uint32_t magic = 0, version = 0;
+  streamRead(is, magic);
+  streamRead(is, version);
+  if (is.fail() || magic != lshForestMagic) {
+    throw ValueErrorException("Stream does not contain an LSH Forest.");
+  }
+  if (version != lshForestVersion) {
+    throw ValueErrorException("Unsupported LSH Forest version " +
+                              std::to_string(version));
+  }
+  streamRead(is, d_numPermutations);
+  streamRead(is, d_numPrefixTrees);
+  streamRead(is, d_numItems);
+  streamRead(is, d_numIndexed);
+  if (is.fail() || !d_numPrefixTrees ||
+      d_numPrefixTrees > d_numPermutations || d_numIndexed > d_numItems) {
+    throw ValueErrorException("Bad LSH Forest header.");
+  }
+  d_hashesPerTree = d_numPermutations / d_numPrefixTrees;
+  readVector(is, d_fps);
+  d_trees.resize(d_numPrefixTrees);
+  for (auto &tree : d_trees) {
+    readVector(is, tree);
+  }
+  if (d_fps.size() != static_cast<size_t>(d_numItems) * d_numPermutations ||
+      std::any_of(d_trees.begin(), d_trees.end(), [this](const auto &tree) {
+        return tree.size() != d_numIndexed;
+      })) {
+    throw ValueErrorException("Inconsistent LSH Forest data.");
+  }
+}
+
+}  // namespace MHFPFingerprints
+}  // namespace RDKit
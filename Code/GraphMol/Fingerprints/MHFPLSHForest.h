@@ -0,0 +1,148 @@
+//
+//  Copyright (C) 2026 Greg Landrum and other RDKit contributors
+//
+//   @@ All Rights Reserved @@
+//  This file is part of the RDKit.
+//  The contents are covered by the terms of the BSD license
+//  which is included in the file license.txt, found at the root
+//  of the RDKit source tree.
+//
+
+/*! \file MHFPLSHForest.h
+
+  An LSH Forest index for approximate nearest neighbor searches of MHFP
+  (MinHash) fingerprints.
+
+*/
+#include <RDGeneral/export.h>
+#ifndef RD_MHFPLSHFOREST_H
+#define RD_MHFPLSHFOREST_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace RDKit {
+namespace MHFPFingerprints {
+
+//! An index entry found by a query and its distance from the query
+using LSHForestHit = std::pair<unsigned int, double>;
+
+//! An LSH Forest index of MHFP fingerprints
+/*!
+  This follows the LSH Forest of Bawa, Condie and Ganesan (WWW '05) as used
+  for MHFP by Probst and Reymond (J. Cheminf. 10:66 (2018)). The hashes of
+  each fingerprint are split into numPrefixTrees bands, and each band is
+  treated as the key of a prefix tree. Fingerprints whose keys share a long
+  prefix share many of their hashes and so are likely to be close.
+
+  Each prefix tree is stored as an array of the indices of the fingerprints,
+  sorted by their keys, so the fingerprints matching a prefix form a single
+  range that is found by binary search. The only storage beyond the
+  fingerprints themselves is one index per fingerprint per tree.
+
+  A query collects candidates from all the trees using progressively shorter
+  prefixes until it has k * kc of them. These are then ranked by their
+  actual MHFP distance to the query.
+
+  Fingerprints can be added at any time, but are only found by query() once
+  index() has been called.
+*/
+class RDKIT_FINGERPRINTS_EXPORT MHFPLSHForest {
+ public:
+  //! Constructor
+  /*!
+    \param numPermutations the number of permutations (i.e. the length) of
+           the MHFP fingerprints that will be indexed.
+    \param numPrefixTrees the number of prefix trees. Each tree uses
+           numPermutations / numPrefixTrees of the hashes.
+  */
+  MHFPLSHForest(unsigned int numPermutations = 2048,
+                unsigned int numPrefixTrees = 8);
+  //! Construct the index from a stream written by write().
+  explicit MHFPLSHForest(std::istream &is);
+  //! Construct the index from a file written by write().
+  explicit MHFPLSHForest(const std::string &fileName);
+
+  //! Adds a fingerprint, returns its index.
+  unsigned int add(const std::vector<uint32_t> &fp);
+  //! Adds the fingerprints to the prefix trees so that query() finds them.
+  /*!
+    Only the fingerprints added since the last call need to be sorted, and
+    they are then merged into the trees.
+
+    \param numThreads the number of threads to use, the trees are updated in
+           parallel. Uses the usual RDKit convention where values <= 0 mean
+           use all available threads less that number.
+  */
+  void index(int numThreads = 1);
+
+  //! The number of fingerprints added.
+  unsigned int size() const { return d_numItems; }
+  //! The number of fingerprints that have been indexed.
+  unsigned int numIndexed() const { return d_numIndexed; }
+  unsigned int getNumPermutations() const { return d_numPermutations; }
+  unsigned int getNumPrefixTrees() const { return d_numPrefixTrees; }
+  //! Returns the fingerprint at index idx.
+  std::vector<uint32_t> getFingerprint(unsigned int idx) const;
+
+  //! Finds the approximate k nearest neighbors of a fingerprint.
+  /*!
+    \param fp the MHFP fingerprint of the query.
+    \param k the number of neighbors to find.
+    \param kc the number of candidates for each neighbor that are compared
+           with the query. Larger values give better recall at the cost of
+           speed.
+
+    \returns up to k hits, in order of increasing distance and then index.
+  */
+  std::vector<LSHForestHit> query(const std::vector<uint32_t> &fp,
+                                  unsigned int k, unsigned int kc = 10) const;
+  //! \overload
+  //! Queries for many fingerprints at once using multiple threads.
+  std::vector<std::vector<LSHForestHit>> query(
+      const std::vector<std::vector<uint32_t>> &fps, unsigned int k,
+      unsigned int kc = 10, int numThreads = 1) const;
+
+  //! Finds the exact k nearest neighbors of a fingerprint by comparing it
+  //! with every fingerprint that has been added.
+  std::vector<LSHForestHit> queryExact(const std::vector<uint32_t> &fp,
+                                       unsigned int k) const;
+  //! \overload
+  std::vector<std::vector<LSHForestHit>> queryExact(
+      const std::vector<std::vector<uint32_t>> &fps, unsigned int k,
+      int numThreads = 1) const;
+
+  //! Write the index to a binary stream.
+  void write(std::ostream &os) const;
+  //! Write the index to a binary file.
+  void write(const std::string &fileName) const;
+
+ private:
+  void read(std::istream &is);
+  void checkFingerprint(const std::vector<uint32_t> &fp) const;
+  const uint32_t *key(unsigned int idx, unsigned int tree) const {
+    return d_fps.data() + static_cast<size_t>(idx) * d_numPermutations +
+           tree * d_hashesPerTree;
+  }
+  std::vector<LSHForestHit> rankCandidates(
+      const std::vector<uint32_t> &fp, std::vector<unsigned int> &candidates,
+      unsigned int k) const;
+
+  unsigned int d_numPermutations;
+  unsigned int d_numPrefixTrees;
+  unsigned int d_hashesPerTree;
+  unsigned int d_numItems{0};
+  unsigned int d_numIndexed{0};
+  //! all the fingerprints, one after the other
+  std::vector<uint32_t> d_fps;
+  //! for each tree the indices of the fingerprints sorted by their keys
+  std::vector<std::vector<uint32_t>> d_trees;
+};
+
+}  // namespace MHFPFingerprints
+}  // namespace RDKit
+
+#endif
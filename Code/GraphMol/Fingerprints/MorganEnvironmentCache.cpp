@@ -0,0 +1,347 @@
+//
+//  Copyright (C) 2026 Greg Landrum and other RDKit contributors
+//
+//   @@ All Rights Reserved @@
+//  This file is part of the RDKit.
+//  The contents are covered by the terms of the BSD license
+//  which is included in the file license.txt, found at the root
+//  of the RDKit source tree.
+//
+
+#include <algorithm>
+#include <limits>
+#include <unordered_set>
+
+#include <GraphMol/RDKitBase.h>
+#include <GraphMol/FrozenMol.h>
+#include <GraphMol/MolOps.h>
+#include <GraphMol/Fingerprints/FingerprintUtil.h>
+#include <RDGeneral/Exceptions.h>
+#include <RDGeneral/hash/hash.hpp>
+
+#include "MorganEnvironmentCache.h"
+
+namespace RDKit {
+namespace MorganFingerprint {
+
+MorganEnvironmentCache::MorganEnvironmentCache(
+    const ROMol &mol, unsigned int radius, bool useBondTypes,
+    bool onlyNonzeroInvariants, bool includeRedundantEnvironments,
+    bool includeRingMembership)
+    : d_radius(radius),
+      df_useBondTypes(useBondTypes),
+      df_onlyNonzeroInvariants(onlyNonzeroInvariants),
+      df_includeRedundantEnvironments(includeRedundantEnvironments),
+      df_includeRingMembership(includeRingMembership) {
+  load(mol);
+  calculate(nullptr, nullptr);
+}
+
+MorganEnvironmentCache::MorganEnvironmentCache(
+    const FrozenMol &mol, unsigned int radius, bool useBondTypes,
+    bool onlyNonzeroInvariants, bool includeRedundantEnvironments,
+    bool includeRingMembership)
+    : d_radius(radius),
+      df_useBondTypes(useBondTypes),
+      df_onlyNonzeroInvariants(onlyNonzeroInvariants),
+      df_includeRedundantEnvironments(includeRedundantEnvironments),
+      df_includeRingMembership(includeRingMembership) {
+  load(mol);
+  calculate(nullptr, nullptr);
+}
+
+MorganEnvironmentCache::MorganEnvironmentCache(
+    const MorganEnvironmentCache &parent, const ROMol &analogue,
+    const std::vector<int> &atomMap)
+    : d_radius(parent.d_radius),
+      df_useBondTypes(parent.df_useBondTypes),
+      df_onlyNonzeroInvariants(parent.df_onlyNonzeroInvariants),
+      df_includeRedundantEnvironments(parent.df_includeRedundantEnvironments),
+      df_includeRingMembership(parent.df_includeRingMembership) {
+  if (atomMap.size() != analogue.getNumAtoms()) {
+    throw ValueErrorException(
+        "atomMap must have an entry for every atom of the analogue");
+  }
+  for (auto idx : atomMap) {
+    if (idx < -1 || idx >= static_cast<int>(parent.d_numAtoms)) {
+      throw ValueErrorException("bad parent atom index in atomMap");
+    }
+  }
+  load(analogue);
+  calculate(&parent, &atomMap);
+}
+
+void MorganEnvironmentCache::load(const ROMol &mol) {
+  MolOps::requireSanitization(mol, MolOps::SANITIZE_SYMMRINGS |
+                                       MolOps::SANITIZE_SETAROMATICITY |
+                                       MolOps::SANITIZE_ADJUSTHS);
+  if (df_includeRingMembership && !mol.getRingInfo()->isInitialized()) {
+    MolOps::fastFindRings(mol);
+  }
+  d_numAtoms = mol.getNumAtoms();
+  d_numBonds = mol.getNumBonds();
+  const auto periodicTable = PeriodicTable::getTable();
+
+  d_atomKeys.clear();
+  d_atomKeys.reserve(d_numAtoms);
+  d_neighborStarts.assign(1, 0);
+  d_neighbors.clear();
+  d_neighborBonds.clear();
+  for (const auto atom : mol.atoms()) {
+    d_atomKeys.push_back(
+        {atom->getAtomicNum(), atom->getTotalDegree(),
+         atom->getTotalNumHs(true), atom->getFormalCharge(),
+         static_cast<int>(atom->getMass() -
+                          periodicTable->getAtomicWeight(atom->getAtomicNum())),
+         df_includeRingMembership &&
+             mol.getRingInfo()->numAtomRings(atom->getIdx()) > 0});
+    const auto begin = d_neighbors.size();
+    for (const auto bond : mol.atomBonds(atom)) {
+      // the same as MorganBondInvGenerator without chirality
+      std::uint32_t bondInvariant =
+          df_useBondTypes ? static_cast<std::uint32_t>(bond->getBondType())
+                          : 1;
+      d_neighbors.emplace_back(bond->getOtherAtomIdx(atom->getIdx()),
+                               bondInvariant);
+      d_neighborBonds.push_back(bond->getIdx());
+    }
+    sortNeighbors(begin);
+  }
+}
+
+void MorganEnvironmentCache::load(const FrozenMol &mol) {
+  d_numAtoms = mol.getNumAtoms();
+  d_numBonds = mol.getNumBonds();
+  const auto periodicTable = PeriodicTable::getTable();
+
+  d_atomKeys.clear();
+  d_atomKeys.reserve(d_numAtoms);
+  d_neighborStarts.assign(1, 0);
+  d_neighborStarts.reserve(d_numAtoms + 1);
+  d_neighbors.clear();
+  d_neighbors.reserve(2 * d_numBonds);
+  d_neighborBonds.clear();
+  d_neighborBonds.reserve(2 * d_numBonds);
+  for (unsigned int i = 0; i < d_numAtoms; ++i) {
+    const auto &atom = mol.getAtom(i);
+    d_atomKeys.push_back(
+        {atom.atomicNum, mol.getTotalDegree(i), mol.getTotalNumHs(i, true),
+         atom.formalCharge,
+         static_cast<int>(mol.getMass(i) -
+                          periodicTable->getAtomicWeight(atom.atomicNum)),
+         df_includeRingMembership && mol.numAtomRings(i) > 0});
+    const auto begin = d_neighbors.size();
+    for (const auto &nbr : mol.getNeighbors(i)) {
+      std::uint32_t bondInvariant =
+          df_useBondTypes ? mol.getBond(nbr.bond).bondType : 1;
+      d_neighbors.emplace_back(nbr.atom, bondInvariant);
+      d_neighborBonds.push_back(nbr.bond);
+    }
+    sortNeighbors(begin);
+  }
+}
+
+void MorganEnvironmentCache::sortNeighbors(unsigned int begin) {
+  const auto end = d_neighbors.size();
+  for (auto i = begin + 1; i < end; ++i) {
+    for (auto j = i; j > begin && d_neighbors[j] < d_neighbors[j - 1]; --j) {
+      std::swap(d_neighbors[j], d_neighbors[j - 1]);
+      std::swap(d_neighborBonds[j], d_neighborBonds[j - 1]);
+    }
+  }
+  d_neighborStarts.push_back(end);
+}
+
+std::uint32_t MorganEnvironmentCache::getInvariant(const AtomKey &key) {
+  std::vector<std::uint32_t> components{
+      static_cast<std::uint32_t>(key.atomicNum), key.totalDegree,
+      key.totalNumHs, static_cast<std::uint32_t>(key.formalCharge),
+      static_cast<std::uint32_t>(key.deltaMass)};
+  if (key.inRing) {
+    components.push_back(1);
+  }
+  gboost::hash<std::vector<std::uint32_t>> vectHasher;
+  return vectHasher(components);
+}
+
+void MorganEnvironmentCache::calculate(const MorganEnvironmentCache *parent,
+                                       const std::vector<int> *atomMap) {
+  const auto nAtoms = d_numAtoms;
+
+  // The identifier of an atom at the next radius only depends on its own
+  // identifier and those of its neighbors, so it can be copied from the
+  // parent when those and the bonds to the neighbors are the same.
+  std::vector<int> parentIdx(nAtoms, -1);
+  std::vector<bool> sameNeighbors(nAtoms, false);
+  if (parent) {
+    std::vector<Neighbor> mapped;
+    for (unsigned int i = 0; i < nAtoms; ++i) {
+      parentIdx[i] = (*atomMap)[i];
+      if (parentIdx[i] < 0) {
+        continue;
+      }
+      mapped.clear();
+      bool allMapped = true;
+      for (auto ni = d_neighborStarts[i]; ni < d_neighborStarts[i + 1];
+           ++ni) {
+        const auto &[nbr, bondInvariant] = d_neighbors[ni];
+        if ((*atomMap)[nbr] < 0) {
+          allMapped = false;
+          break;
+        }
+        mapped.emplace_back((*atomMap)[nbr], bondInvariant);
+      }
+      if (!allMapped) {
+        continue;
+      }
+      std::sort(mapped.begin(), mapped.end());
+      const auto pi = parentIdx[i];
+      sameNeighbors[i] = std::equal(
+          mapped.begin(), mapped.end(),
+          parent->d_neighbors.begin() + parent->d_neighborStarts[pi],
+          parent->d_neighbors.begin() + parent->d_neighborStarts[pi + 1]);
+    }
+  }
+
+  d_numCalculated = 0;
+  d_codes.assign((d_radius + 1) * nAtoms, 0);
+  d_expanded.assign((d_radius + 1) * nAtoms, false);
+  d_environments.clear();
+  d_environments.reserve((d_radius + 1) * nAtoms);
+
+  std::vector<std::uint32_t> atomInvariants(nAtoms);
+  for (unsigned int i = 0; i < nAtoms; ++i) {
+    const auto pi = parentIdx[i];
+    if (pi >= 0 && d_atomKeys[i] == parent->d_atomKeys[pi]) {
+      atomInvariants[i] = parent->code(0, pi);
+    } else {
+      atomInvariants[i] = getInvariant(d_atomKeys[i]);
+      ++d_numCalculated;
+    }
+    d_codes[i] = atomInvariants[i];
+    d_expanded[i] = true;
+    if (!df_onlyNonzeroInvariants || atomInvariants[i]) {
+      d_environments.push_back(atomInvariants[i]);
+    }
+  }
+
+  // From here on this follows MorganEnvGenerator::getEnvironments()
+  std::vector<std::uint32_t> currentInvariants = atomInvariants;
+  std::vector<std::uint32_t> nextLayerInvariants(nAtoms, 0);
+  std::vector<bool> changed(nAtoms);
+  std::vector<std::pair<int32_t, uint32_t>> neighborhoodInvariants;
+  neighborhoodInvariants.reserve(8);
+
+  std::unordered_set<boost::dynamic_bitset<>> neighborhoods;
+  neighborhoods.reserve((d_radius + 1) * nAtoms);
+  std::vector<boost::dynamic_bitset<>> atomNeighborhoods(
+      nAtoms, boost::dynamic_bitset<>(d_numBonds));
+  std::vector<boost::dynamic_bitset<>> roundAtomNeighborhoods =
+      atomNeighborhoods;
+  boost::dynamic_bitset<> deadAtoms(nAtoms);
+
+  for (unsigned int layer = 0; layer < d_radius; ++layer) {
+    for (unsigned int i = 0; i < nAtoms; ++i) {
+      changed[i] = parentIdx[i] < 0 ||
+                   currentInvariants[i] != parent->code(layer, parentIdx[i]);
+    }
+    std::vector<MorganFingerprints::AccumTuple> allNeighborhoodsThisRound;
+    for (unsigned int atomIdx = 0; atomIdx < nAtoms; ++atomIdx) {
+      if (deadAtoms[atomIdx]) {
+        continue;
+      }
+      if (d_neighborStarts[atomIdx] == d_neighborStarts[atomIdx + 1]) {
+        deadAtoms.set(atomIdx, 1);
+        continue;
+      }
+      bool canCopy = sameNeighbors[atomIdx] && !changed[atomIdx] &&
+                     parent->d_expanded[(layer + 1) * parent->d_numAtoms +
+                                        parentIdx[atomIdx]];
+      for (auto ni = d_neighborStarts[atomIdx];
+           ni < d_neighborStarts[atomIdx + 1]; ++ni) {
+        roundAtomNeighborhoods[atomIdx][d_neighborBonds[ni]] = 1;
+        const auto oIdx = d_neighbors[ni].first;
+        roundAtomNeighborhoods[atomIdx] |= atomNeighborhoods[oIdx];
+        canCopy &= !changed[oIdx];
+      }
+
+      std::uint32_t invar;
+      if (canCopy) {
+        invar = parent->code(layer + 1, parentIdx[atomIdx]);
+      } else {
+        neighborhoodInvariants.clear();
+        for (auto ni = d_neighborStarts[atomIdx];
+             ni < d_neighborStarts[atomIdx + 1]; ++ni) {
+          const auto &[nbr, bondInvariant] = d_neighbors[ni];
+          neighborhoodInvariants.emplace_back(
+              static_cast<int32_t>(bondInvariant), currentInvariants[nbr]);
+        }
+        std::sort(neighborhoodInvariants.begin(),
+                  neighborhoodInvariants.end());
+        invar = layer;
+        gboost::hash_combine(invar, currentInvariants[atomIdx]);
+        for (const auto &ni : neighborhoodInvariants) {
+          gboost::hash_combine(invar, ni);
+        }
+        ++d_numCalculated;
+      }
+      nextLayerInvariants[atomIdx] = invar;
+      d_codes[(layer + 1) * nAtoms + atomIdx] = invar;
+      d_expanded[(layer + 1) * nAtoms + atomIdx] = true;
+      allNeighborhoodsThisRound.push_back(
+          std::make_tuple(roundAtomNeighborhoods[atomIdx], invar, atomIdx));
+    }
+
+    std::sort(allNeighborhoodsThisRound.begin(),
+              allNeighborhoodsThisRound.end());
+    for (const auto &[neighborhood, invar, atomIdx] :
+         allNeighborhoodsThisRound) {
+      if (df_includeRedundantEnvironments ||
+          neighborhoods.count(neighborhood) == 0) {
+        if (!df_onlyNonzeroInvariants || atomInvariants[atomIdx]) {
+          d_environments.push_back(invar);
+          neighborhoods.insert(neighborhood);
+        }
+      } else {
+        deadAtoms[atomIdx] = 1;
+      }
+    }
+
+    currentInvariants.swap(nextLayerInvariants);
+    std::fill(nextLayerInvariants.begin(), nextLayerInvariants.end(), 0);
+    atomNeighborhoods = roundAtomNeighborhoods;
+  }
+}
+
+std::unique_ptr<SparseIntVect<std::uint32_t>>
+MorganEnvironmentCache::getSparseCountFingerprint() const {
+  auto res = std::make_unique<SparseIntVect<std::uint32_t>>(
+      std::numeric_limits<std::uint32_t>::max());
+  for (auto code : d_environments) {
+    res->setVal(code, res->getVal(code) + 1);
+  }
+  return res;
+}
+
+std::unique_ptr<SparseIntVect<std::uint32_t>>
+MorganEnvironmentCache::getCountFingerprint(unsigned int fpSize) const {
+  PRECONDITION(fpSize, "fpSize must be positive");
+  auto res = std::make_unique<SparseIntVect<std::uint32_t>>(fpSize);
+  for (auto code : d_environments) {
+    res->setVal(code % fpSize, res->getVal(code % fpSize) + 1);
+  }
+  return res;
+}
+
+std::unique_ptr<ExplicitBitVect> MorganEnvironmentCache::getFingerprint(
+    unsigned int fpSize) const {
+  PRECONDITION(fpSize, "fpSize must be positive");
+  auto res = std::make_unique<ExplicitBitVect>(fpSize);
+  for (auto code : d_environments) {
+    res->setBit(code % fpSize);
+  }
+  return res;
+}
+
+}  // namespace MorganFingerprint
+}  // namespace RDKit
@@ -0,0 +1,166 @@
+//
+//  Copyright (C) 2026 Greg Landrum and other RDKit contributors
+//
+//   @@ All Rights Reserved @@
+//  This file is part of the RDKit.
+//  The contents are covered by the terms of the BSD license
+//  which is included in the file license.txt, found at the root
+//  of the RDKit source tree.
+//
+
+/*! \file MorganEnvironmentCache.h
+
+  Incremental calculation of Morgan fingerprints for molecules made by
+  editing another one, e.g. the products of a reaction enumeration or of
+  molzip().
+
+*/
+#include <RDGeneral/export.h>
+#ifndef RD_MORGANENVIRONMENTCACHE_H
+#define RD_MORGANENVIRONMENTCACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <DataStructs/ExplicitBitVect.h>
+#include <DataStructs/SparseIntVect.h>
+
+namespace RDKit {
+class ROMol;
+class FrozenMol;
+namespace MorganFingerprint {
+
+//! The Morgan environments of a molecule
+/*!
+  This holds the identifiers of the environments of every atom at every
+  radius. When the cache of an analogue is constructed from the cache of its
+  parent, only the identifiers of atoms that are within the radius of an
+  atom or bond that differs from the parent are recalculated, the others are
+  copied. Which environments are redundant depends on the whole molecule, so
+  that is always worked out again.
+
+  The fingerprints are the same as those from the generator returned by
+  getMorganGenerator<std::uint32_t>() with the same arguments.
+
+  Chirality and count simulation are not supported.
+*/
+class RDKIT_FINGERPRINTS_EXPORT MorganEnvironmentCache {
+ public:
+  //! Construct the cache for a molecule
+  /*!
+    \param mol the molecule, it must have had its ring information found,
+           e.g. by sanitization.
+    \param radius the radius of the fingerprint
+    \param useBondTypes if set, bond types will be included in the
+           environments
+    \param onlyNonzeroInvariants if set, only atoms with non-zero invariants
+           are used
+    \param includeRedundantEnvironments if set, redundant environments are
+           included in the fingerprint
+    \param includeRingMembership if set, whether or not an atom is in a ring
+           is part of its invariant
+  */
+  MorganEnvironmentCache(const ROMol &mol, unsigned int radius = 3,
+                         bool useBondTypes = true,
+                         bool onlyNonzeroInvariants = false,
+                         bool includeRedundantEnvironments = false,
+                         bool includeRingMembership = true);
+  //! \overload
+  MorganEnvironmentCache(const FrozenMol &mol, unsigned int radius = 3,
+                         bool useBondTypes = true,
+                         bool onlyNonzeroInvariants = false,
+                         bool includeRedundantEnvironments = false,
+                         bool includeRingMembership = true);
+  //! Construct the cache for an analogue of the parent molecule
+  /*!
+    \param parent the cache of the parent molecule
+    \param analogue the analogue
+    \param atomMap for each atom of the analogue the index of the
+           corresponding atom of the parent, or -1 for atoms that were added.
+           Atoms and bonds that were removed or changed are found by
+           comparing the two molecules. For reaction products this is the
+           react_atom_idx property of the atoms from the parent reactant,
+           i.e. those whose react_idx property is the parent's index in the
+           reactants.
+  */
+  MorganEnvironmentCache(const MorganEnvironmentCache &parent,
+                         const ROMol &analogue,
+                         const std::vector<int> &atomMap);
+
+  //! Returns the unfolded count fingerprint
+  std::unique_ptr<SparseIntVect<std::uint32_t>> getSparseCountFingerprint()
+      const;
+  //! Returns the count fingerprint folded to fpSize
+  std::unique_ptr<SparseIntVect<std::uint32_t>> getCountFingerprint(
+      unsigned int fpSize = 2048) const;
+  //! Returns the bit vector fingerprint folded to fpSize
+  std::unique_ptr<ExplicitBitVect> getFingerprint(
+      unsigned int fpSize = 2048) const;
+
+  unsigned int getNumAtoms() const { return d_numAtoms; }
+  unsigned int getRadius() const { return d_radius; }
+  //! The number of atom environment identifiers that had to be calculated
+  //! when the cache was constructed, the rest were copied from the parent.
+  unsigned int getNumCalculated() const { return d_numCalculated; }
+
+ private:
+  //! what the invariant of an atom is calculated from
+  struct AtomKey {
+    int atomicNum;
+    unsigned int totalDegree;
+    unsigned int totalNumHs;
+    int formalCharge;
+    //! the difference between the mass and the atomic weight, truncated
+    int deltaMass;
+    bool inRing;
+    bool operator==(const AtomKey &o) const {
+      return atomicNum == o.atomicNum && totalDegree == o.totalDegree &&
+             totalNumHs == o.totalNumHs && formalCharge == o.formalCharge &&
+             deltaMass == o.deltaMass && inRing == o.inRing;
+    }
+  };
+  //! a neighbor of an atom and the invariant of the bond to it
+  using Neighbor = std::pair<std::uint32_t, std::uint32_t>;
+
+  //! fill in the atom keys and neighbors
+  void load(const ROMol &mol);
+  void load(const FrozenMol &mol);
+  void sortNeighbors(unsigned int begin);
+  void calculate(const MorganEnvironmentCache *parent,
+                 const std::vector<int> *atomMap);
+  //! the same as MorganFingerprints::getConnectivityInvariant()
+  static std::uint32_t getInvariant(const AtomKey &key);
+  std::uint32_t code(unsigned int layer, unsigned int atomIdx) const {
+    return d_codes[layer * d_numAtoms + atomIdx];
+  }
+
+  unsigned int d_radius;
+  bool df_useBondTypes;
+  bool df_onlyNonzeroInvariants;
+  bool df_includeRedundantEnvironments;
+  bool df_includeRingMembership;
+
+  unsigned int d_numAtoms{0};
+  unsigned int d_numCalculated{0};
+  std::vector<AtomKey> d_atomKeys;
+  //! the neighbors of atom i are d_neighbors[d_neighborStarts[i]] to
+  //! d_neighbors[d_neighborStarts[i + 1]], sorted
+  std::vector<unsigned int> d_neighborStarts;
+  std::vector<Neighbor> d_neighbors;
+  //! the bonds to the neighbors, in the same order
+  std::vector<std::uint32_t> d_neighborBonds;
+  unsigned int d_numBonds{0};
+  //! the identifier of every atom at every radius, layer by layer. Atoms
+  //! that are no longer expanded at a radius have zero.
+  std::vector<std::uint32_t> d_codes;
+  //! which atoms were expanded at each radius, layer by layer
+  std::vector<bool> d_expanded;
+  //! the identifiers of the environments in the fingerprint
+  std::vector<std::uint32_t> d_environments;
+};
+
+}  // namespace MorganFingerprint
+}  // namespace RDKit
+
+#endif
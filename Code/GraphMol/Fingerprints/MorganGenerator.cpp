@@ -52,6 +52,11 @@ std::string MorganAtomInvGenerator::infoString() const {
   return "MorganInvariantGenerator includeRingMembership=" +
          std::to_string(df_includeRingMembership);
 }
+
+unsigned int MorganAtomInvGenerator::getRequiredSanitization() const {
+  // the invariants use the ring membership and the hydrogen counts
+  return MolOps::SANITIZE_SYMMRINGS | MolOps::SANITIZE_ADJUSTHS;
+}
 void MorganAtomInvGenerator::toJSON(boost::property_tree::ptree &pt) const {
   pt.put("type", "MorganAtomInvGenerator");
   pt.put("includeRingMembership", df_includeRingMembership);
@@ -193,6 +198,13 @@ std::string MorganBondInvGenerator::infoString() const {
          std::to_string(df_useBondTypes) +
          " useChirality=" + std::to_string(df_useChirality);
 }
+
+unsigned int MorganBondInvGenerator::getRequiredSanitization() const {
+  if (df_useChirality) {
+    return MolOps::SANITIZE_ALL;
+  }
+  return MolOps::SANITIZE_SETAROMATICITY;
+}
 void MorganBondInvGenerator::toJSON(boost::property_tree::ptree &pt) const {
   pt.put("type", "MorganBondInvGenerator");
   pt.put("useBondTypes", df_useBondTypes);
@@ -30,8 +30,10 @@
 #include <RDGeneral/types.h>
 #include <algorithm>
 #include <boost/dynamic_bitset.hpp>
+#include <unordered_map>
 
 #include <GraphMol/Fingerprints/FingerprintUtil.h>
+#include <RDGeneral/RDLog.h>
 
 #include <RDGeneral/BoostStartInclude.h>
 #include <boost/property_tree/ptree.hpp>
@@ -57,6 +59,10 @@ std::string RDKitFPAtomInvGenerator::infoString() const {
   return "RDKitFPAtomInvGenerator";
 }
 
+unsigned int RDKitFPAtomInvGenerator::getRequiredSanitization() const {
+  return MolOps::SANITIZE_SETAROMATICITY;
+}
+
 void RDKitFPAtomInvGenerator::toJSON(boost::property_tree::ptree &pt) const {
   pt.put("type", "RDKitFPAtomInvGenerator");
 }
@@ -88,6 +94,8 @@ void RDKitFPArguments::toJSON(boost::property_tree::ptree &pt) const {
   pt.put("useHs", df_useHs);
   pt.put("branchedPaths", df_branchedPaths);
   pt.put("useBondOrder", df_useBondOrder);
+  pt.put("streamPaths", df_streamPaths);
+  pt.put("maxPaths", d_maxPaths);
   FingerprintArguments::toJSON(pt);
 }
 void RDKitFPArguments::fromJSON(const boost::property_tree::ptree &pt) {
@@ -96,6 +104,8 @@ void RDKitFPArguments::fromJSON(const boost::property_tree::ptree &pt) {
   df_useHs = pt.get<bool>("useHs", df_useHs);
   df_branchedPaths = pt.get<bool>("branchedPaths", df_branchedPaths);
   df_useBondOrder = pt.get<bool>("useBondOrder", df_useBondOrder);
+  df_streamPaths = pt.get<bool>("streamPaths", df_streamPaths);
+  d_maxPaths = pt.get<std::uint64_t>("maxPaths", d_maxPaths);
   FingerprintArguments::fromJSON(pt);
 }
 
@@ -182,8 +192,8 @@ RDKitFPEnvGenerator<OutputType>::getEnvironments(
     const ROMol &mol, FingerprintArguments *arguments,
     const std::vector<std::uint32_t> *fromAtoms,
     const std::vector<std::uint32_t> *ignoreAtoms,
-    const int,                 // confId
-    const AdditionalOutput *,  // additionalOutput
+    const int,  // confId
+    const AdditionalOutput *additionalOutput,
     const std::vector<std::uint32_t> *atomInvariants,
     const std::vector<std::uint32_t> *,  // bondInvariants
     const bool                           // hashResults
@@ -195,9 +205,6 @@ RDKitFPEnvGenerator<OutputType>::getEnvironments(
 
   std::vector<AtomEnvironment<OutputType> *> result;
 
-  // get all paths
-  INT_PATH_LIST_MAP allPaths;
-
   boost::dynamic_bitset<> ignoreAtomsBitset;
   if (ignoreAtoms) {
     ignoreAtomsBitset.resize(mol.getNumAtoms());
@@ -205,6 +212,57 @@ RDKitFPEnvGenerator<OutputType>::getEnvironments(
       ignoreAtomsBitset.set(atomIdx);
     });
   }
+
+  if (fpArguments->df_streamPaths) {
+    const bool needPaths =
+        additionalOutput &&
+        (additionalOutput->atomToBits || additionalOutput->bitInfoMap ||
+         additionalOutput->bitPaths || additionalOutput->atomCounts ||
+         additionalOutput->atomsPerBit);
+    std::unordered_map<std::uint32_t, unsigned int> seedCounts;
+    std::vector<const Bond *> bondCache;
+    if (needPaths) {
+      bondCache.resize(mol.getNumBonds());
+      for (const auto bond : mol.bonds()) {
+        bondCache[bond->getIdx()] = bond;
+      }
+    }
+    auto addPath = [&](std::uint32_t seed, const INT_VECT &path) {
+      if (!needPaths) {
+        ++seedCounts[seed];
+        return;
+      }
+      boost::dynamic_bitset<> atomsInPath(mol.getNumAtoms());
+      for (const auto bidx : path) {
+        atomsInPath.set(bondCache[bidx]->getBeginAtomIdx());
+        atomsInPath.set(bondCache[bidx]->getEndAtomIdx());
+      }
+      result.push_back(new RDKitFPAtomEnv<OutputType>(
+          static_cast<OutputType>(seed), std::move(atomsInPath), path));
+    };
+    auto stats = RDKitFPUtils::hashAllPaths(
+        mol, addPath, fromAtoms, fpArguments->df_branchedPaths,
+        fpArguments->df_useHs, fpArguments->d_minPath, fpArguments->d_maxPath,
+        fpArguments->df_useBondOrder, atomInvariants, fpArguments->d_maxPaths,
+        ignoreAtoms ? &ignoreAtomsBitset : nullptr);
+    if (stats.budgetExceeded) {
+      BOOST_LOG(rdWarningLog)
+          << "RDKit fingerprint: path enumeration stopped after "
+          << stats.numPaths << " paths" << std::endl;
+    }
+    if (additionalOutput && additionalOutput->pathStats) {
+      *additionalOutput->pathStats = stats;
+    }
+    result.reserve(result.size() + seedCounts.size());
+    for (const auto &[seed, count] : seedCounts) {
+      result.push_back(
+          new RDKitFPAtomEnv<OutputType>(static_cast<OutputType>(seed), count));
+    }
+    return result;
+  }
+
+  // get all paths
+  INT_PATH_LIST_MAP allPaths;
   RDKitFPUtils::enumerateAllPaths(
       mol, allPaths, fromAtoms, fpArguments->df_branchedPaths,
       fpArguments->df_useHs, fpArguments->d_minPath, fpArguments->d_maxPath,
@@ -24,6 +24,11 @@ class RDKIT_FINGERPRINTS_EXPORT RDKitFPArguments : public FingerprintArguments {
   bool df_useHs = true;
   bool df_branchedPaths = true;
   bool df_useBondOrder = true;
+  //! hash the paths as they are enumerated instead of collecting them first
+  bool df_streamPaths = false;
+  //! the maximum number of paths to enumerate for a molecule when streaming
+  //! the paths, zero for no limit
+  std::uint64_t d_maxPaths = 0;
 
   std::string infoString() const override;
   void toJSON(boost::property_tree::ptree &pt) const override;
@@ -64,6 +69,7 @@ class RDKIT_FINGERPRINTS_EXPORT RDKitFPAtomInvGenerator
       const ROMol &mol) const override;
 
   std::string infoString() const override;
+  unsigned int getRequiredSanitization() const override;
   void toJSON(boost::property_tree::ptree &pt) const override;
   void fromJSON(const boost::property_tree::ptree &pt) override;
 
@@ -76,6 +82,7 @@ class RDKIT_FINGERPRINTS_EXPORT RDKitFPAtomEnv
   const OutputType d_bitId;
   const boost::dynamic_bitset<> d_atomsInPath;
   const INT_VECT d_bondPath;
+  const unsigned int d_count = 1;
 
  public:
   OutputType getBitId(
@@ -102,6 +109,19 @@ class RDKIT_FINGERPRINTS_EXPORT RDKitFPAtomEnv
       : d_bitId(bitId),
         d_atomsInPath(std::move(atomsInPath)),
         d_bondPath(std::move(bondPath)) {}
+  /**
+  \brief Construct an RDKitFPAtomEnv object for all the paths with a bitId
+
+  These environments do not set additional output.
+
+  \param bitId bitId generated for the paths
+  \param count the number of paths
+
+  */
+  RDKitFPAtomEnv(const OutputType bitId, unsigned int count)
+      : d_bitId(bitId), d_count(count) {}
+
+  unsigned int getCount() const override { return d_count; }
 };
 
 template <typename OutputType>
@@ -116,10 +136,15 @@ class RDKIT_FINGERPRINTS_EXPORT RDKitFPEnvGenerator
     \param fromAtoms         only generate subgraphs starting at these atoms
     \param ignoreAtoms      ignore any subgraphs that contain these atoms
     \param confId           IGNORED
-    \param additionalOutput IGNORED
+    \param additionalOutput receives the path counters when the paths are
+                            streamed
     \param atomInvariants   atom invariants to be used
     \param bondInvariants   IGNORED
     \param hashResults      IGNORED
+
+    When RDKitFPArguments::df_streamPaths is set the paths are hashed as they
+    are enumerated. Unless the additional output needs the individual paths,
+    one environment is then returned for each distinct hash.
   */
   std::vector<AtomEnvironment<OutputType> *> getEnvironments(
       const ROMol &mol, FingerprintArguments *arguments,
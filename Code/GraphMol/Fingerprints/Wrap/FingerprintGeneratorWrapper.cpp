@@ -17,6 +17,7 @@
 #include <RDBoost/import_array.h>
 #include <GraphMol/RDKitBase.h>
 #include <GraphMol/Fingerprints/FingerprintGenerator.h>
+#include <GraphMol/Fingerprints/CombinedFingerprintGenerator.h>
 #include <GraphMol/Fingerprints/Wrap/AtomPairWrapper.cpp>
 #include <GraphMol/Fingerprints/Wrap/MorganWrapper.cpp>
 #include <GraphMol/Fingerprints/Wrap/RDKitFPWrapper.cpp>
@@ -319,6 +320,54 @@ python::object getNumPyCountFingerprint(
   return python::object(res);
 }
 
+template <typename OutputType>
+python::object getNumPyFingerprints(
+    const FingerprintGenerator<OutputType> *fpGen, python::object mols,
+    int numThreads) {
+  unsigned int nmols = python::len(mols);
+  std::vector<const ROMol *> tmols;
+  for (auto i = 0u; i < nmols; ++i) {
+    tmols.push_back(python::extract<const ROMol *>(mols[i])());
+  }
+  npy_intp size[2] = {static_cast<npy_intp>(nmols),
+                      static_cast<npy_intp>(fpGen->getOptions()->d_fpSize)};
+  python::handle<> res(PyArray_ZEROS(2, size, NPY_UINT8, 0));
+  auto data = static_cast<std::uint8_t *>(
+      PyArray_DATA(reinterpret_cast<PyArrayObject *>(res.get())));
+  {
+    NOGIL gil;
+    fpGen->fillFingerprints(tmols, data, numThreads);
+  }
+  return python::object(res);
+}
+
+template <typename OutputType>
+python::object getNumPyCountFingerprints(
+    const FingerprintGenerator<OutputType> *fpGen, python::object mols,
+    int numThreads, bool useUInt16) {
+  unsigned int nmols = python::len(mols);
+  std::vector<const ROMol *> tmols;
+  for (auto i = 0u; i < nmols; ++i) {
+    tmols.push_back(python::extract<const ROMol *>(mols[i])());
+  }
+  npy_intp size[2] = {static_cast<npy_intp>(nmols),
+                      static_cast<npy_intp>(fpGen->getOptions()->d_fpSize)};
+  python::handle<> res(
+      PyArray_ZEROS(2, size, useUInt16 ? NPY_UINT16 : NPY_UINT8, 0));
+  auto data = PyArray_DATA(reinterpret_cast<PyArrayObject *>(res.get()));
+  {
+    NOGIL gil;
+    if (useUInt16) {
+      fpGen->fillCountFingerprints(
+          tmols, static_cast<std::uint16_t *>(data), numThreads);
+    } else {
+      fpGen->fillCountFingerprints(tmols, static_cast<std::uint8_t *>(data),
+                                   numThreads);
+    }
+  }
+  return python::object(res);
+}
+
 template <typename OutputType>
 std::string getInfoString(const FingerprintGenerator<OutputType> *fpGen) {
   return std::string(fpGen->infoString());
@@ -406,6 +455,13 @@ python::object getAtomCountsHelper(const AdditionalOutput &ao) {
   }
   return python::tuple(res);
 }
+python::object getPathStatsHelper(const AdditionalOutput &ao) {
+  if (!ao.pathStats) {
+    return python::object();
+  }
+  return python::make_tuple(ao.pathStats->numPaths,
+                            ao.pathStats->budgetExceeded);
+}
 python::object getAtomToBitsHelper(const AdditionalOutput &ao) {
   if (!ao.atomToBits) {
     return python::object();
@@ -651,6 +707,24 @@ void wrapGenerator(const std::string &nm) {
            "    - mol: molecule to be fingerprinted\n"
            "    - numThreads: number of threads to use\n\n"
            "  RETURNS: a tuple of SparseIntVects\n\n")
+      .def("GetFingerprintsAsNumPy", getNumPyFingerprints<T>,
+           ((python::arg("self"), python::arg("mols")),
+            python::arg("numThreads") = 1),
+           "Generates fingerprints for a sequence of molecules\n\n"
+           "  ARGUMENTS:\n"
+           "    - mols: molecules to be fingerprinted\n"
+           "    - numThreads: number of threads to use\n\n"
+           "  RETURNS: a 2D numpy array of uint8 with one row per molecule\n\n")
+      .def("GetCountFingerprintsAsNumPy", getNumPyCountFingerprints<T>,
+           ((python::arg("self"), python::arg("mols")),
+            python::arg("numThreads") = 1, python::arg("useUInt16") = false),
+           "Generates count fingerprints for a sequence of molecules\n\n"
+           "  ARGUMENTS:\n"
+           "    - mols: molecules to be fingerprinted\n"
+           "    - numThreads: number of threads to use\n"
+           "    - useUInt16: store the counts as uint16 instead of uint8.\n"
+           "      Counts that don't fit are set to the largest value.\n\n"
+           "  RETURNS: a 2D numpy array with one row per molecule\n\n")
       .def("GetInfoString", getInfoString<T>, python::args("self"),
            "Returns a string containing information about the fingerprint "
            "generator\n\n"
@@ -663,6 +737,65 @@ void wrapGenerator(const std::string &nm) {
            "Serialize a FingerprintGenerator to JSON");
 }
 
+template <typename T>
+python::tuple fpsToTuple(std::vector<std::unique_ptr<T>> &fps) {
+  python::list res;
+  for (auto &fp : fps) {
+    res.append(boost::shared_ptr<T>(fp.release()));
+  }
+  return python::tuple(res);
+}
+
+python::tuple combinedGetFingerprints(const CombinedFingerprintGenerator &gen,
+                                      const ROMol &mol) {
+  std::vector<std::unique_ptr<ExplicitBitVect>> fps;
+  {
+    NOGIL gil;
+    fps = gen.getFingerprints(mol);
+  }
+  return fpsToTuple(fps);
+}
+
+python::tuple combinedGetCountFingerprints(
+    const CombinedFingerprintGenerator &gen, const ROMol &mol) {
+  std::vector<std::unique_ptr<SparseIntVect<std::uint32_t>>> fps;
+  {
+    NOGIL gil;
+    fps = gen.getCountFingerprints(mol);
+  }
+  return fpsToTuple(fps);
+}
+
+python::tuple combinedGetSparseCountFingerprints(
+    const CombinedFingerprintGenerator &gen, const ROMol &mol) {
+  std::vector<std::unique_ptr<SparseIntVect<std::uint64_t>>> fps;
+  {
+    NOGIL gil;
+    fps = gen.getSparseCountFingerprints(mol);
+  }
+  return fpsToTuple(fps);
+}
+
+python::tuple combinedGetFingerprintsForMols(
+    const CombinedFingerprintGenerator &gen, python::object mols,
+    int numThreads) {
+  unsigned int nmols = python::len(mols);
+  std::vector<const ROMol *> tmols;
+  for (auto i = 0u; i < nmols; ++i) {
+    tmols.push_back(python::extract<const ROMol *>(mols[i])());
+  }
+  std::vector<std::vector<std::unique_ptr<ExplicitBitVect>>> fps;
+  {
+    NOGIL gil;
+    fps = gen.getFingerprints(tmols, numThreads);
+  }
+  python::list res;
+  for (auto &molFps : fps) {
+    res.append(fpsToTuple(molFps));
+  }
+  return python::tuple(res);
+}
+
 void setCountBoundsHelper(FingerprintArguments &opts, python::object bounds) {
   pythonObjectToVect(bounds, opts.d_countBounds);
 }
@@ -687,6 +820,8 @@ BOOST_PYTHON_MODULE(rdFingerprintGenerator) {
            python::args("self"), "synonym for CollectAtomCounts()")
       .def("AllocateAtomsPerBit", &AdditionalOutput::allocateAtomsPerBit,
            python::args("self"), "synonym for CollectAtomsPerBit()")
+      .def("AllocatePathStats", &AdditionalOutput::allocatePathStats,
+           python::args("self"), "synonym for CollectPathStats()")
       .def(
           "CollectAtomToBits", &AdditionalOutput::allocateAtomToBits,
           python::args("self"),
@@ -707,11 +842,17 @@ BOOST_PYTHON_MODULE(rdFingerprintGenerator) {
           "CollectAtomsPerBit", &AdditionalOutput::allocateAtomsPerBit,
           python::args("self"),
           "toggles collection of information about all atoms involved in setting each bit")
+      .def(
+          "CollectPathStats", &AdditionalOutput::allocatePathStats,
+          python::args("self"),
+          "toggles collection of the number of paths enumerated and whether the path budget was reached (only for RDKit fingerprints with streamPaths set)")
       .def("GetAtomToBits", &getAtomToBitsHelper, python::args("self"))
       .def("GetBitInfoMap", &getBitInfoMapHelper, python::args("self"))
       .def("GetBitPaths", &getBitPathsHelper, python::args("self"))
       .def("GetAtomCounts", &getAtomCountsHelper, python::args("self"))
-      .def("GetAtomsPerBit", &getAtomsPerBitHelper, python::args("self"));
+      .def("GetAtomsPerBit", &getAtomsPerBitHelper, python::args("self"))
+      .def("GetPathStats", &getPathStatsHelper, python::args("self"),
+           "returns (number of paths, whether the path budget was reached)");
 
   python::class_<FingerprintArguments, boost::noncopyable>("FingerprintOptions",
                                                            python::no_init)
@@ -732,6 +873,41 @@ BOOST_PYTHON_MODULE(rdFingerprintGenerator) {
   wrapGenerator<std::uint32_t>("FingerprintGenerator32");
   wrapGenerator<std::uint64_t>("FingerprintGenerator64");
 
+  python::class_<CombinedFingerprintGenerator, boost::noncopyable>(
+      "CombinedFingerprintGenerator",
+      "Generates several fingerprints for each molecule, sharing the work "
+      "the generators have in common.\n"
+      "The results are the same as those of the individual generators.",
+      python::init<>(python::args("self")))
+      .def("AddGenerator", &CombinedFingerprintGenerator::addGenerator,
+           python::with_custodian_and_ward<1, 2>(),
+           (python::arg("self"), python::arg("generator")),
+           "Adds a FingerprintGenerator64, returns the index of its "
+           "fingerprints in the results")
+      .def("AddPatternFingerprint",
+           &CombinedFingerprintGenerator::addPatternFingerprint,
+           (python::arg("self"), python::arg("fpSize") = 2048,
+            python::arg("tautomericFingerprint") = false),
+           "Adds a pattern fingerprint. It is only part of the results of "
+           "GetFingerprints(), after those of the generators.")
+      .def("GetNumGenerators", &CombinedFingerprintGenerator::getNumGenerators,
+           python::args("self"))
+      .def("GetFingerprints", combinedGetFingerprints,
+           (python::arg("self"), python::arg("mol")),
+           "Returns a tuple with the ExplicitBitVect fingerprints of a "
+           "molecule")
+      .def("GetCountFingerprints", combinedGetCountFingerprints,
+           (python::arg("self"), python::arg("mol")),
+           "Returns a tuple with the count fingerprints of a molecule")
+      .def("GetSparseCountFingerprints", combinedGetSparseCountFingerprints,
+           (python::arg("self"), python::arg("mol")),
+           "Returns a tuple with the sparse count fingerprints of a molecule")
+      .def("GetFingerprintsForMols", combinedGetFingerprintsForMols,
+           ((python::arg("self"), python::arg("mols")),
+            python::arg("numThreads") = 1),
+           "Returns a tuple with the result of GetFingerprints() for each "
+           "molecule");
+
   python::enum_<FPType>("FPType")
       .value("RDKitFP", FPType::RDKitFP)
       .value("MorganFP", FPType::MorganFP)
@@ -11,10 +11,12 @@
 #include <boost/python.hpp>
 #include <RDBoost/Wrap.h>
 #include <GraphMol/Fingerprints/MHFP.h>
+#include <GraphMol/Fingerprints/MHFPLSHForest.h>
 #include <vector>
 
 namespace python = boost::python;
 using RDKit::MHFPFingerprints::MHFPEncoder;
+using RDKit::MHFPFingerprints::MHFPLSHForest;
 
 namespace RDKit {
 namespace MHFPWrapper {
@@ -103,6 +105,41 @@ python::object EncodeMolsBulk(MHFPEncoder *mhfpEnc, python::list &mols,
   return python::tuple(resList);
 }
 
+python::tuple CreateHashedShingling(const MHFPEncoder *mhfpEnc,
+                                    const ROMol &mol, unsigned char radius,
+                                    bool rings, bool isomeric,
+                                    unsigned char min_radius) {
+  auto shingling =
+      mhfpEnc->CreateHashedShingling(mol, radius, rings, isomeric, min_radius);
+  python::list res;
+  for (auto shingle : shingling) {
+    res.append(shingle);
+  }
+  return python::tuple(res);
+}
+
+python::tuple EncodeMols(const MHFPEncoder *mhfpEnc, python::object &mols,
+                         unsigned char radius, bool rings, bool isomeric,
+                         bool kekulize, unsigned char min_radius,
+                         MHFPFingerprints::ShinglingType shinglingType,
+                         int numThreads) {
+  std::vector<const ROMol *> molPtrs;
+  for (auto i = 0u; i < python::len(mols); ++i) {
+    molPtrs.push_back(python::extract<const ROMol *>(mols[i]));
+  }
+  std::vector<std::vector<uint32_t>> resVect;
+  {
+    NOGIL gil;
+    resVect = mhfpEnc->EncodeMols(molPtrs, radius, rings, isomeric, kekulize,
+                                  min_radius, shinglingType, numThreads);
+  }
+  python::list resList;
+  for (const auto &item : resVect) {
+    resList.append(item);
+  }
+  return python::tuple(resList);
+}
+
 // SECFP
 
 ExplicitBitVect EncodeSECFPSmiles(MHFPEncoder *mhfpEnc, std::string smiles,
@@ -156,6 +193,71 @@ python::object EncodeSECFPMolsBulk(MHFPEncoder *mhfpEnc, python::list &mols,
   return python::tuple(resList);
 }
 
+// LSH Forest
+
+python::tuple HitsToTuple(
+    const std::vector<MHFPFingerprints::LSHForestHit> &hits) {
+  python::list res;
+  for (const auto &[idx, dist] : hits) {
+    res.append(python::make_tuple(idx, dist));
+  }
+  return python::tuple(res);
+}
+
+unsigned int LSHForestAdd(MHFPLSHForest *forest, python::object &fp) {
+  return forest->add(ListToVector<uint32_t>(fp));
+}
+
+void LSHForestIndex(MHFPLSHForest *forest, int numThreads) {
+  NOGIL gil;
+  forest->index(numThreads);
+}
+
+python::tuple LSHForestQuery(const MHFPLSHForest *forest, python::object &fp,
+                             unsigned int k, unsigned int kc) {
+  auto vec = ListToVector<uint32_t>(fp);
+  std::vector<MHFPFingerprints::LSHForestHit> hits;
+  {
+    NOGIL gil;
+    hits = forest->query(vec, k, kc);
+  }
+  return HitsToTuple(hits);
+}
+
+python::tuple LSHForestQueryExact(const MHFPLSHForest *forest,
+                                  python::object &fp, unsigned int k) {
+  auto vec = ListToVector<uint32_t>(fp);
+  std::vector<MHFPFingerprints::LSHForestHit> hits;
+  {
+    NOGIL gil;
+    hits = forest->queryExact(vec, k);
+  }
+  return HitsToTuple(hits);
+}
+
+python::tuple LSHForestBulkQuery(const MHFPLSHForest *forest,
+                                 python::object &fps, unsigned int k,
+                                 unsigned int kc, int numThreads) {
+  VectMinHashVect vecs;
+  for (auto i = 0u; i < python::len(fps); ++i) {
+    vecs.push_back(ListToVector<uint32_t>(fps[i]));
+  }
+  std::vector<std::vector<MHFPFingerprints::LSHForestHit>> hits;
+  {
+    NOGIL gil;
+    hits = forest->query(vecs, k, kc, numThreads);
+  }
+  python::list res;
+  for (const auto &queryHits : hits) {
+    res.append(HitsToTuple(queryHits));
+  }
+  return python::tuple(res);
+}
+
+void LSHForestWrite(const MHFPLSHForest *forest, const std::string &fileName) {
+  forest->write(fileName);
+}
+
 BOOST_PYTHON_FUNCTION_OVERLOADS(CreateShinglingFromSmilesOverloads,
                                 CreateShinglingFromSmiles, 2, 7)
 BOOST_PYTHON_FUNCTION_OVERLOADS(CreateShinglingFromMolOverloads,
@@ -176,6 +278,11 @@ BOOST_PYTHON_FUNCTION_OVERLOADS(EncodeSECFPMolsBulkOverloads,
                                 EncodeSECFPMolsBulk, 2, 8)
 
 BOOST_PYTHON_MODULE(rdMHFPFingerprint) {
+  python::enum_<MHFPFingerprints::ShinglingType>("ShinglingType")
+      .value("SMILES", MHFPFingerprints::ShinglingType::SMILES)
+      .value("Morgan", MHFPFingerprints::ShinglingType::Morgan)
+      .export_values();
+
   python::class_<MHFPEncoder>(
       "MHFPEncoder", python::init<python::optional<unsigned int, unsigned int>>(
                          python::args("self", "n_permutations", "seed")))
@@ -227,6 +334,24 @@ BOOST_PYTHON_MODULE(rdMHFPFingerprint) {
                 python::arg("isomeric") = false,
                 python::arg("kekulize") = false, python::arg("min_radius") = 1),
                "Creates a MHFP vector from a list of RDKit Mol instances."))
+      .def("CreateHashedShingling", CreateHashedShingling,
+           (python::arg("self"), python::arg("mol"), python::arg("radius") = 3,
+            python::arg("rings") = true, python::arg("isomeric") = false,
+            python::arg("min_radius") = 1),
+           "Creates a shingling from the Morgan environments (and rings) of "
+           "an RDKit Mol instance.\n"
+           "This is much faster than the SMILES shingling, but the results "
+           "are not compatible with it.")
+      .def("EncodeMols", EncodeMols,
+           (python::arg("self"), python::arg("mols"), python::arg("radius") = 3,
+            python::arg("rings") = true, python::arg("isomeric") = false,
+            python::arg("kekulize") = false, python::arg("min_radius") = 1,
+            python::arg("shinglingType") =
+                MHFPFingerprints::ShinglingType::SMILES,
+            python::arg("numThreads") = 1),
+           "Creates MHFP vectors from a list of RDKit Mol instances using "
+           "multiple threads.\n"
+           "shinglingType selects between the SMILES and Morgan shinglings.")
       .def(
           "EncodeSECFPSmiles", EncodeSECFPSmiles,
           EncodeSECFPSmilesOverloads(
@@ -262,6 +387,43 @@ BOOST_PYTHON_MODULE(rdMHFPFingerprint) {
               "instances."))
       .def("Distance", &MHFPEncoder::Distance, python::args("a", "b"))
       .staticmethod("Distance");
+
+  python::class_<MHFPLSHForest>(
+      "MHFPLSHForest",
+      "An LSH Forest index for approximate nearest neighbor searches of MHFP "
+      "vectors.\n"
+      "Vectors that have been added are only found by Query() after Index() "
+      "has been called.",
+      python::init<python::optional<unsigned int, unsigned int>>(
+          python::args("self", "n_permutations", "n_prefix_trees")))
+      .def(python::init<std::string>(python::args("self", "fileName"),
+                                     "Reads an index written by Write()."))
+      .def("__len__", &MHFPLSHForest::size, python::args("self"))
+      .def("Add", LSHForestAdd, python::args("self", "fp"),
+           "Adds a MHFP vector to the index and returns its index.")
+      .def("Index", LSHForestIndex,
+           (python::arg("self"), python::arg("numThreads") = 1),
+           "Adds the vectors added since the last call to the prefix trees.")
+      .def("GetNumIndexed", &MHFPLSHForest::numIndexed, python::args("self"),
+           "The number of vectors that can be found by Query().")
+      .def("GetFingerprint", &MHFPLSHForest::getFingerprint,
+           python::args("self", "idx"), "Returns a MHFP vector from the index.")
+      .def("Query", LSHForestQuery,
+           (python::arg("self"), python::arg("fp"), python::arg("k"),
+            python::arg("kc") = 10),
+           "Returns the approximate k nearest neighbors of a MHFP vector as "
+           "(index, distance) tuples.\n"
+           "k*kc candidates are compared with the query.")
+      .def("BulkQuery", LSHForestBulkQuery,
+           (python::arg("self"), python::arg("fps"), python::arg("k"),
+            python::arg("kc") = 10, python::arg("numThreads") = 1),
+           "Query() for a list of MHFP vectors using multiple threads.")
+      .def("QueryExact", LSHForestQueryExact,
+           (python::arg("self"), python::arg("fp"), python::arg("k")),
+           "Returns the exact k nearest neighbors of a MHFP vector by "
+           "comparing it with every vector in the index.")
+      .def("Write", LSHForestWrite, python::args("self", "fileName"),
+           "Writes the index to a binary file.");
 }
 
 }  // namespace MHFPWrapper
@@ -10,6 +10,7 @@
 
 #include <boost/python.hpp>
 #include <GraphMol/Fingerprints/FingerprintGenerator.h>
+#include <GraphMol/Fingerprints/MorganEnvironmentCache.h>
 #include <GraphMol/Fingerprints/MorganGenerator.h>
 #include <RDBoost/Wrap.h>
 
@@ -73,6 +74,32 @@ BondInvariantsGenerator *getMorganBondInvGen(const bool useBondTypes,
                                                        useChirality);
 }
 
+MorganFingerprint::MorganEnvironmentCache *getAnalogueCache(
+    const MorganFingerprint::MorganEnvironmentCache &self,
+    const ROMol &analogue, python::object &py_atomMap) {
+  auto atomMap = pythonObjectToVect<int>(py_atomMap);
+  if (!atomMap) {
+    throw_value_error("atomMap must not be empty");
+  }
+  return new MorganFingerprint::MorganEnvironmentCache(self, analogue,
+                                                       *atomMap);
+}
+
+SparseIntVect<std::uint32_t> *cacheGetSparseCountFingerprint(
+    const MorganFingerprint::MorganEnvironmentCache &self) {
+  return self.getSparseCountFingerprint().release();
+}
+SparseIntVect<std::uint32_t> *cacheGetCountFingerprint(
+    const MorganFingerprint::MorganEnvironmentCache &self,
+    unsigned int fpSize) {
+  return self.getCountFingerprint(fpSize).release();
+}
+ExplicitBitVect *cacheGetFingerprint(
+    const MorganFingerprint::MorganEnvironmentCache &self,
+    unsigned int fpSize) {
+  return self.getFingerprint(fpSize).release();
+}
+
 void exportMorgan() {
   python::class_<MorganFingerprint::MorganArguments,
                  python::bases<FingerprintArguments>, boost::noncopyable>(
@@ -156,6 +183,53 @@ void exportMorgan() {
       "  RETURNS: BondInvariantsGenerator\n\n",
       python::return_value_policy<python::manage_new_object>());
 
+  python::class_<MorganFingerprint::MorganEnvironmentCache>(
+      "MorganEnvironmentCache",
+      "The Morgan environments of a molecule, used to find the Morgan "
+      "fingerprints of analogues of it without starting from scratch.\n"
+      "The fingerprints are the same as those from a Morgan generator with "
+      "the same arguments, chirality and count simulation are not "
+      "supported.",
+      python::init<const ROMol &, unsigned int, bool, bool, bool, bool>(
+          (python::arg("self"), python::arg("mol"),
+           python::arg("radius") = 3, python::arg("useBondTypes") = true,
+           python::arg("onlyNonzeroInvariants") = false,
+           python::arg("includeRedundantEnvironments") = false,
+           python::arg("includeRingMembership") = true)))
+      .def("GetAnalogueCache", getAnalogueCache,
+           (python::arg("self"), python::arg("analogue"),
+            python::arg("atomMap")),
+           "Returns the cache for an analogue of this molecule.\n\n"
+           "  ARGUMENTS:\n"
+           "    - analogue: the analogue\n"
+           "    - atomMap: for each atom of the analogue the index of the "
+           "corresponding atom of this molecule, or -1 for atoms that were "
+           "added\n\n"
+           "Only the environments near atoms and bonds that differ from "
+           "this molecule are calculated again.\n",
+           python::return_value_policy<python::manage_new_object>())
+      .def("GetSparseCountFingerprint", cacheGetSparseCountFingerprint,
+           python::args("self"), "Returns the unfolded count fingerprint",
+           python::return_value_policy<python::manage_new_object>())
+      .def("GetCountFingerprint", cacheGetCountFingerprint,
+           (python::arg("self"), python::arg("fpSize") = 2048),
+           "Returns the count fingerprint folded to fpSize",
+           python::return_value_policy<python::manage_new_object>())
+      .def("GetFingerprint", cacheGetFingerprint,
+           (python::arg("self"), python::arg("fpSize") = 2048),
+           "Returns the bit vector fingerprint folded to fpSize",
+           python::return_value_policy<python::manage_new_object>())
+      .def("GetNumAtoms",
+           &MorganFingerprint::MorganEnvironmentCache::getNumAtoms,
+           python::args("self"))
+      .def("GetRadius", &MorganFingerprint::MorganEnvironmentCache::getRadius,
+           python::args("self"))
+      .def("GetNumCalculated",
+           &MorganFingerprint::MorganEnvironmentCache::getNumCalculated,
+           python::args("self"),
+           "The number of environment identifiers that were calculated, "
+           "the rest were copied from the parent");
+
   return;
 }
 }  // namespace MorganWrapper
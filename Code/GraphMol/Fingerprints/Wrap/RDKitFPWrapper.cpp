@@ -63,7 +63,13 @@ void exportRDKit() {
                      "generate branched subgraphs, not just linear ones")
       .def_readwrite("useBondOrder",
                      &RDKitFP::RDKitFPArguments::df_useBondOrder,
-                     "include bond orders in the path hashes");
+                     "include bond orders in the path hashes")
+      .def_readwrite("streamPaths", &RDKitFP::RDKitFPArguments::df_streamPaths,
+                     "hash the paths as they are enumerated instead of "
+                     "collecting them first")
+      .def_readwrite("maxPaths", &RDKitFP::RDKitFPArguments::d_maxPaths,
+                     "maximum number of paths to enumerate for a molecule "
+                     "when streamPaths is set (0 for no limit)");
   python::def(
       "GetRDKitFPGenerator", &getRDKitFPGenerator<std::uint64_t>,
       (python::arg("minPath") = 1, python::arg("maxPath") = 7,
@@ -285,6 +285,55 @@ class TestCase(unittest.TestCase):
       arr = gen.GetCountFingerprintAsNumPy(m)
       np.testing.assert_array_equal(oarr, arr)
 
+  def testNumpyFingerprintBatches(self):
+    ms = [
+      Chem.MolFromSmiles(smi)
+      for smi in ('COc1ccc(CCNC(=O)c2ccccc2C(=O)NCCc2ccc(OC)cc2)cc1', 'CCCO', 'c1ccccc1O')
+    ]
+    for fn in (rdFingerprintGenerator.GetRDKitFPGenerator,
+               rdFingerprintGenerator.GetMorganGenerator,
+               rdFingerprintGenerator.GetAtomPairGenerator,
+               rdFingerprintGenerator.GetTopologicalTorsionGenerator):
+      gen = fn(fpSize=1024)
+      arr = gen.GetFingerprintsAsNumPy(ms, numThreads=2)
+      self.assertEqual(arr.shape, (3, 1024))
+      self.assertEqual(arr.dtype, np.uint8)
+      for i, m in enumerate(ms):
+        np.testing.assert_array_equal(arr[i], gen.GetFingerprintAsNumPy(m))
+
+      arr = gen.GetCountFingerprintsAsNumPy(ms)
+      self.assertEqual(arr.dtype, np.uint8)
+      arr16 = gen.GetCountFingerprintsAsNumPy(ms, useUInt16=True)
+      self.assertEqual(arr16.dtype, np.uint16)
+      for i, m in enumerate(ms):
+        np.testing.assert_array_equal(arr16[i], gen.GetCountFingerprintAsNumPy(m))
+        np.testing.assert_array_equal(arr[i], np.minimum(arr16[i], 255))
+
+  def testCombinedFingerprintGenerator(self):
+    gens = (rdFingerprintGenerator.GetMorganGenerator(radius=2),
+            rdFingerprintGenerator.GetMorganGenerator(radius=2, includeChirality=True),
+            rdFingerprintGenerator.GetAtomPairGenerator(),
+            rdFingerprintGenerator.GetTopologicalTorsionGenerator(),
+            rdFingerprintGenerator.GetRDKitFPGenerator())
+    combined = rdFingerprintGenerator.CombinedFingerprintGenerator()
+    for i, gen in enumerate(gens):
+      self.assertEqual(combined.AddGenerator(gen), i)
+    combined.AddPatternFingerprint()
+    self.assertEqual(combined.GetNumGenerators(), len(gens))
+
+    ms = [Chem.MolFromSmiles(smi) for smi in ('C[C@H](F)Cl', 'c1ccccc1CC(=O)NC1CC1', 'OCCO')]
+    batch = combined.GetFingerprintsForMols(ms, numThreads=2)
+    for m, batchFps in zip(ms, batch):
+      fps = combined.GetFingerprints(m)
+      cfps = combined.GetCountFingerprints(m)
+      self.assertEqual(len(fps), len(gens) + 1)
+      self.assertEqual(len(cfps), len(gens))
+      for gen, fp, bfp, cfp in zip(gens, fps, batchFps, cfps):
+        self.assertEqual(fp, gen.GetFingerprint(m))
+        self.assertEqual(bfp, fp)
+        self.assertEqual(cfp, gen.GetCountFingerprint(m))
+      self.assertEqual(fps[-1], Chem.PatternFingerprint(m))
+
   def testMorganRedundantEnvironments(self):
     m = Chem.MolFromSmiles('CC(=O)O')
 
@@ -424,6 +473,51 @@ class TestCase(unittest.TestCase):
     nz = fp.GetNonzeroElements()
     self.assertEqual(len(nz), 0)
 
+  def testMorganEnvironmentCache(self):
+    from rdkit.Chem import rdChemReactions
+    acid = Chem.MolFromSmiles('OC(=O)c1ccc(cc1)-c1ccc(cc1)C(=O)NC1CCN(CC1)C(=O)OC(C)(C)C')
+    g = rdFingerprintGenerator.GetMorganGenerator(radius=2)
+    cache = rdFingerprintGenerator.MorganEnvironmentCache(acid, radius=2)
+    self.assertEqual(cache.GetNumAtoms(), acid.GetNumAtoms())
+    self.assertEqual(cache.GetRadius(), 2)
+    self.assertEqual(cache.GetSparseCountFingerprint().GetNonzeroElements(),
+                     g.GetSparseCountFingerprint(acid).GetNonzeroElements())
+    self.assertEqual(cache.GetFingerprint(), g.GetFingerprint(acid))
+
+    rxn = rdChemReactions.ReactionFromSmarts('[C:1](=[O:2])[OH].[N;!H0:3]>>[C:1](=[O:2])[N:3]')
+    for amine in ('CN', 'C1CCNCC1', 'NCc1ccccc1'):
+      product = rxn.RunReactants((acid, Chem.MolFromSmiles(amine)))[0][0]
+      Chem.SanitizeMol(product)
+      atomMap = [
+        atom.GetUnsignedProp('react_atom_idx') if atom.GetUnsignedProp('react_idx') == 0 else -1
+        for atom in product.GetAtoms()
+      ]
+      pcache = cache.GetAnalogueCache(product, atomMap)
+      self.assertEqual(pcache.GetSparseCountFingerprint().GetNonzeroElements(),
+                       g.GetSparseCountFingerprint(product).GetNonzeroElements())
+      self.assertEqual(pcache.GetFingerprint(), g.GetFingerprint(product))
+      self.assertLess(pcache.GetNumCalculated(), cache.GetNumCalculated())
+
+
+  def testRDKitFPStreamedPaths(self):
+    m = Chem.MolFromSmiles('C12C3C4C1C5C2C3C45')
+    g = rdFingerprintGenerator.GetRDKitFPGenerator()
+    sg = rdFingerprintGenerator.GetRDKitFPGenerator()
+    sg.GetOptions().streamPaths = True
+    self.assertEqual(
+      sg.GetSparseCountFingerprint(m).GetNonzeroElements(),
+      g.GetSparseCountFingerprint(m).GetNonzeroElements())
+
+    ao = rdFingerprintGenerator.AdditionalOutput()
+    ao.CollectPathStats()
+    sg.GetFingerprint(m, additionalOutput=ao)
+    numPaths, budgetExceeded = ao.GetPathStats()
+    self.assertGreater(numPaths, 100)
+    self.assertFalse(budgetExceeded)
+
+    sg.GetOptions().maxPaths = 100
+    sg.GetFingerprint(m, additionalOutput=ao)
+    self.assertEqual(ao.GetPathStats(), (100, True))
 
 if __name__ == '__main__':
   unittest.main()
@@ -7,6 +7,8 @@ which is included in the file license.txt, found at the root
 of the RDKit source tree.
 """
 
+import os
+import tempfile
 import unittest
 
 from rdkit import Chem
@@ -70,6 +72,61 @@ class TestCase(unittest.TestCase):
     self.assertEqual(len(fps), 10)
     self.assertEqual(list(fps[0]), list(fp))
 
+  def testMorganShingling(self):
+    smis = ["CN1C=NC2=C1C(=O)N(C(=O)N2C)C", "Cn1cnc2c1c(=O)[nH]c(=O)n2C", "CCCCCCO"]
+    mols = [Chem.MolFromSmiles(x) for x in smis]
+    enc = rdMHFPFingerprint.MHFPEncoder(128, 42)
+    sh = enc.CreateHashedShingling(mols[0])
+    self.assertGreater(len(sh), 0)
+    self.assertEqual(sh, enc.CreateHashedShingling(Chem.MolFromSmiles("Cn1c(=O)c2c(ncn2C)n(C)c1=O")))
+
+    fps = enc.EncodeMols(mols)
+    self.assertEqual(len(fps), 3)
+    self.assertEqual(list(fps[0]), list(enc.EncodeMol(mols[0])))
+    morganFps = enc.EncodeMols(mols, shinglingType=rdMHFPFingerprint.ShinglingType.Morgan,
+                               numThreads=2)
+    self.assertEqual(len(morganFps), 3)
+    self.assertEqual(list(morganFps[0]), list(enc.FromArray(list(sh))))
+    self.assertLess(enc.Distance(morganFps[0], morganFps[1]),
+                    enc.Distance(morganFps[0], morganFps[2]))
+
+  def testLSHForest(self):
+    smis = [
+      "CN1C=NC2=C1C(=O)N(C(=O)N2C)C", "Cn1cnc2c1c(=O)[nH]c(=O)n2C", "c1ccccc1O", "c1ccccc1N",
+      "c1ccccc1CO", "CCCCCCO", "CCCCCCN", "OC(=O)c1ccccc1O", "CC(=O)Oc1ccccc1C(=O)O"
+    ]
+    enc = rdMHFPFingerprint.MHFPEncoder(128, 42)
+    fps = enc.EncodeSmilesBulk(smis)
+    forest = rdMHFPFingerprint.MHFPLSHForest(128, 8)
+    for i, fp in enumerate(fps):
+      self.assertEqual(forest.Add(fp), i)
+    self.assertEqual(len(forest), len(fps))
+    self.assertEqual(forest.GetNumIndexed(), 0)
+    forest.Index()
+    self.assertEqual(forest.GetNumIndexed(), len(fps))
+    self.assertEqual(list(forest.GetFingerprint(3)), list(fps[3]))
+
+    hits = forest.Query(fps[0], 3)
+    self.assertEqual(hits[0], (0, 0.0))
+    self.assertLessEqual(len(hits), 3)
+    exact = forest.QueryExact(fps[0], 3)
+    self.assertEqual(len(exact), 3)
+    self.assertEqual(exact[0], (0, 0.0))
+    self.assertAlmostEqual(exact[1][1], enc.Distance(fps[0], fps[exact[1][0]]))
+    bulk = forest.BulkQuery(fps, 3, numThreads=2)
+    self.assertEqual(len(bulk), len(fps))
+    self.assertEqual(bulk[0], hits)
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+      fname = os.path.join(tmpdir, "forest.bin")
+      forest.Write(fname)
+      forest2 = rdMHFPFingerprint.MHFPLSHForest(fname)
+    self.assertEqual(len(forest2), len(fps))
+    self.assertEqual(forest2.Query(fps[0], 3), hits)
+
+    with self.assertRaises(ValueError):
+      forest.Add(fps[0][:64])
+
 
 if __name__ == "__main__":
   unittest.main()
@@ -10,7 +10,10 @@
 
 #include <catch2/catch_all.hpp>
 
+#include <filesystem>
 #include <memory>
+#include <random>
+#include <sstream>
 #include <RDGeneral/test.h>
 #include <GraphMol/RDKitBase.h>
 #include <GraphMol/MolBundle.h>
@@ -18,6 +21,8 @@
 #include <GraphMol/FileParsers/FileParsers.h>
 #include <GraphMol/Fingerprints/Fingerprints.h>
 #include <GraphMol/Fingerprints/MorganFingerprints.h>
+#include <GraphMol/Fingerprints/MHFP.h>
+#include <GraphMol/Fingerprints/MHFPLSHForest.h>
 #include <RDGeneral/Exceptions.h>
 #include <GraphMol/Fingerprints/RDKitFPGenerator.h>
 #include <GraphMol/Fingerprints/MorganGenerator.h>
@@ -944,4 +949,176 @@ TEST_CASE("toJSON") {
     CHECK(jsonStr == jsonStr2);
     CHECK(*fp1 == *fp2);
   }
-}
\ No newline at end of file
+}
+TEST_CASE("MHFP LSH Forest") {
+  // groups of related minhashes: each group shares most of its items
+  MHFPFingerprints::MHFPEncoder encoder(128);
+  std::mt19937 rng(0xf00d);
+  std::uniform_int_distribution<std::uint32_t> dist;
+  std::vector<std::vector<std::uint32_t>> fps;
+  constexpr unsigned int numGroups = 100;
+  constexpr unsigned int groupSize = 5;
+  for (unsigned int g = 0; g < numGroups; ++g) {
+    std::vector<std::uint32_t> items(50);
+    for (auto &item : items) {
+      item = dist(rng);
+    }
+    for (unsigned int m = 0; m < groupSize; ++m) {
+      auto variant = items;
+      for (unsigned int v = 0; v < m; ++v) {
+        variant[dist(rng) % variant.size()] = dist(rng);
+      }
+      fps.push_back(encoder.FromArray(variant));
+    }
+  }
+
+  MHFPFingerprints::MHFPLSHForest forest(128, 8);
+  for (const auto &fp : fps) {
+    forest.add(fp);
+  }
+  CHECK(forest.size() == fps.size());
+  CHECK(forest.numIndexed() == 0);
+  CHECK(forest.query(fps[0], 5).empty());
+  forest.index();
+  CHECK(forest.numIndexed() == fps.size());
+  CHECK(forest.getFingerprint(7) == fps[7]);
+
+  SECTION("basics") {
+    for (unsigned int i = 0; i < fps.size(); ++i) {
+      auto hits = forest.query(fps[i], 1);
+      REQUIRE(hits.size() == 1);
+      CHECK(hits[0].first == i);
+      CHECK(hits[0].second == 0.0);
+    }
+    // recall of the group members compared with an exhaustive search
+    unsigned int numFound = 0;
+    auto allHits = forest.query(fps, groupSize, 10, 2);
+    auto allExact = forest.queryExact(fps, groupSize, 2);
+    for (unsigned int i = 0; i < fps.size(); ++i) {
+      CHECK(allHits[i] == forest.query(fps[i], groupSize));
+      CHECK(allExact[i] == forest.queryExact(fps[i], groupSize));
+      for (const auto &hit : allExact[i]) {
+        numFound += std::find(allHits[i].begin(), allHits[i].end(), hit) !=
+                    allHits[i].end();
+      }
+      for (const auto &hit : allHits[i]) {
+        CHECK(hit.second == MHFPFingerprints::MHFPEncoder::Distance(
+                                fps[i], fps[hit.first]));
+      }
+    }
+    CHECK(numFound >= 0.9 * fps.size() * groupSize);
+  }
+  SECTION("incremental indexing") {
+    MHFPFingerprints::MHFPLSHForest forest2(128, 8);
+    for (unsigned int i = 0; i < fps.size(); ++i) {
+      forest2.add(fps[i]);
+      if (i % 97 == 0) {
+        forest2.index(2);
+      }
+    }
+    forest2.index();
+    for (unsigned int i = 0; i < fps.size(); i += 7) {
+      CHECK(forest2.query(fps[i], 10) == forest.query(fps[i], 10));
+    }
+  }
+  SECTION("serialization") {
+    std::stringstream ss;
+    forest.write(ss);
+    MHFPFingerprints::MHFPLSHForest forest2(ss);
+    CHECK(forest2.size() == forest.size());
+    CHECK(forest2.numIndexed() == forest.numIndexed());
+    CHECK(forest2.getNumPrefixTrees() == 8);
+    auto fileName =
+        (std::filesystem::temp_directory_path() / "rdkit_mhfp_lshf.bin")
+            .string();
+    forest.write(fileName);
+    MHFPFingerprints::MHFPLSHForest forest3(fileName);
+    std::filesystem::remove(fileName);
+    for (unsigned int i = 0; i < fps.size(); i += 7) {
+      auto hits = forest.query(fps[i], 10);
+      CHECK(forest2.query(fps[i], 10) == hits);
+      CHECK(forest3.query(fps[i], 10) == hits);
+    }
+    std::stringstream bad("not an LSH Forest");
+    CHECK_THROWS_AS(MHFPFingerprints::MHFPLSHForest(bad), ValueErrorException);
+  }
+  SECTION("errors") {
+    CHECK_THROWS_AS(MHFPFingerprints::MHFPLSHForest(128, 0),
+                    ValueErrorException);
+    CHECK_THROWS_AS(MHFPFingerprints::MHFPLSHForest(8, 16),
+                    ValueErrorException);
+    std::vector<std::uint32_t> shortFp(64);
+    CHECK_THROWS_AS(forest.add(shortFp), ValueErrorException);
+    CHECK_THROWS_AS(forest.query(shortFp, 10), ValueErrorException);
+  }
+}
+
+TEST_CASE("MHFP Morgan shingling") {
+  MHFPFingerprints::MHFPEncoder encoder(128);
+  SECTION("basics") {
+    auto m1 = "Oc1ccccc1CC1CCNCC1"_smiles;
+    auto m2 = "C1NCCC(Cc2c(O)cccc2)C1"_smiles;
+    REQUIRE(m1);
+    REQUIRE(m2);
+    auto sh1 = encoder.CreateHashedShingling(*m1);
+    CHECK(!sh1.empty());
+    CHECK(std::is_sorted(sh1.begin(), sh1.end()));
+    CHECK(sh1 == encoder.CreateHashedShingling(*m2));
+
+    auto sh0 = encoder.CreateHashedShingling(*m1, 3, true, false, 0);
+    CHECK(sh0.size() > sh1.size());
+    CHECK(std::includes(sh0.begin(), sh0.end(), sh1.begin(), sh1.end()));
+    auto noRings = encoder.CreateHashedShingling(*m1, 3, false);
+    CHECK(noRings.size() == sh1.size() - 2);
+
+    // rings with the same atoms in a different order are different
+    auto r1 = "C1CCOCNC1"_smiles;
+    auto r2 = "C1CCONCC1"_smiles;
+    REQUIRE(r1);
+    REQUIRE(r2);
+    auto rsh1 = encoder.CreateHashedShingling(*r1, 0, true, false, 1);
+    auto rsh2 = encoder.CreateHashedShingling(*r2, 0, true, false, 1);
+    REQUIRE(rsh1.size() == 1);
+    REQUIRE(rsh2.size() == 1);
+    CHECK(rsh1 != rsh2);
+  }
+  SECTION("EncodeMols") {
+    std::vector<std::string> smis = {"Oc1ccccc1CC1CCNCC1",
+                                     "Oc1ccccc1CC1CCOCC1", "CCCCCCCCO",
+                                     "C[C@H](N)C(=O)O", "c1ccc2ccccc2c1"};
+    std::vector<std::unique_ptr<ROMol>> mols;
+    std::vector<const ROMol *> molPtrs;
+    for (const auto &smi : smis) {
+      mols.emplace_back(SmilesToMol(smi));
+      REQUIRE(mols.back());
+      molPtrs.push_back(mols.back().get());
+    }
+    molPtrs.push_back(nullptr);
+
+    auto fps = encoder.EncodeMols(molPtrs);
+    REQUIRE(fps.size() == molPtrs.size());
+    for (unsigned int i = 0; i < mols.size(); ++i) {
+      ROMol mol(*mols[i]);
+      CHECK(fps[i] == encoder.Encode(mol));
+    }
+    CHECK(fps.back().empty());
+
+    auto morganFps = encoder.EncodeMols(molPtrs, 3, true, false, false, 1,
+                                        MHFPFingerprints::ShinglingType::Morgan);
+    REQUIRE(morganFps.size() == molPtrs.size());
+    for (unsigned int i = 0; i < mols.size(); ++i) {
+      CHECK(morganFps[i] ==
+            encoder.FromArray(encoder.CreateHashedShingling(*mols[i])));
+    }
+    CHECK(morganFps.back().empty());
+    CHECK(MHFPFingerprints::MHFPEncoder::Distance(morganFps[0], morganFps[1]) <
+          MHFPFingerprints::MHFPEncoder::Distance(morganFps[0], morganFps[2]));
+
+    CHECK(encoder.EncodeMols(molPtrs, 3, true, false, false, 1,
+                             MHFPFingerprints::ShinglingType::Morgan,
+                             3) == morganFps);
+    CHECK(encoder.EncodeMols(molPtrs, 3, true, false, false, 1,
+                             MHFPFingerprints::ShinglingType::SMILES, 2) ==
+          fps);
+  }
+}
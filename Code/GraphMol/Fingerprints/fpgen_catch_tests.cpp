@@ -10,6 +10,8 @@
 
 #include <catch2/catch_all.hpp>
 
+#include <numeric>
+
 #include <RDGeneral/RDLog.h>
 #include <GraphMol/RDKitBase.h>
 #include <RDGeneral/test.h>
@@ -17,7 +19,10 @@
 #include <GraphMol/Fingerprints/MorganFingerprints.h>
 #include <GraphMol/Fingerprints/Fingerprints.h>
 #include <GraphMol/SmilesParse/SmilesParse.h>
+#include <GraphMol/FrozenMol.h>
 #include <GraphMol/Fingerprints/AtomPairGenerator.h>
+#include <GraphMol/Fingerprints/CombinedFingerprintGenerator.h>
+#include <GraphMol/Fingerprints/MorganEnvironmentCache.h>
 #include <GraphMol/Fingerprints/MorganGenerator.h>
 #include <GraphMol/Fingerprints/RDKitFPGenerator.h>
 #include <GraphMol/Fingerprints/TopologicalTorsionGenerator.h>
@@ -558,3 +563,468 @@ TEST_CASE("RDKit fingerprinter and ignoreAtoms") {
       fpg->getSparseFingerprint(*mol, funcArgs)};
   CHECK(fp3->getNumOnBits() == 0);
 }
+
+TEST_CASE("RDKit fingerprinter with streamed paths") {
+  std::vector<std::string> smileses = {
+      "CCO", "c1ccccc1C(=O)O", "CC(C)(C)C1CCC(CC1)[C@H](F)Cl",
+      "C12C3C4C1C5C2C3C45", "[H]C([H])([H])C(=O)N", "C1CCCCCCCCCCC1",
+      "OC1C(O)C(OC2CCC(CO)O2)OC(CO)C1O"};
+  for (const auto &smi : smileses) {
+    INFO(smi);
+    std::unique_ptr<RWMol> mol(SmilesToMol(smi, 0, false));
+    REQUIRE(mol);
+    mol->updatePropertyCache(false);
+    MolOps::fastFindRings(*mol);
+    for (auto branchedPaths : {true, false}) {
+      for (auto useHs : {true, false}) {
+        for (auto countSimulation : {false, true}) {
+          RDKitFP::RDKitFPArguments args(1, 6, useHs, branchedPaths);
+          args.df_countSimulation = countSimulation;
+          std::unique_ptr<FingerprintGenerator<std::uint64_t>> fpg{
+              RDKitFP::getRDKitFPGenerator<std::uint64_t>(args)};
+          args.df_streamPaths = true;
+          std::unique_ptr<FingerprintGenerator<std::uint64_t>> sfpg{
+              RDKitFP::getRDKitFPGenerator<std::uint64_t>(args)};
+          CHECK(*sfpg->getSparseCountFingerprint(*mol) ==
+                *fpg->getSparseCountFingerprint(*mol));
+          CHECK(*sfpg->getCountFingerprint(*mol) ==
+                *fpg->getCountFingerprint(*mol));
+          CHECK(*sfpg->getFingerprint(*mol) == *fpg->getFingerprint(*mol));
+
+          std::vector<std::uint32_t> fromAtoms = {0, 2};
+          std::vector<std::uint32_t> ignoreAtoms = {1};
+          FingerprintFuncArguments funcArgs;
+          funcArgs.fromAtoms = &fromAtoms;
+          CHECK(*sfpg->getSparseCountFingerprint(*mol, funcArgs) ==
+                *fpg->getSparseCountFingerprint(*mol, funcArgs));
+          funcArgs.fromAtoms = nullptr;
+          funcArgs.ignoreAtoms = &ignoreAtoms;
+          CHECK(*sfpg->getSparseCountFingerprint(*mol, funcArgs) ==
+                *fpg->getSparseCountFingerprint(*mol, funcArgs));
+        }
+      }
+    }
+  }
+  SECTION("queries") {
+    auto mol = "[#6]-[#6,#7]-C=O"_smarts;
+    REQUIRE(mol);
+    RDKitFP::RDKitFPArguments args;
+    std::unique_ptr<FingerprintGenerator<std::uint64_t>> fpg{
+        RDKitFP::getRDKitFPGenerator<std::uint64_t>(args)};
+    args.df_streamPaths = true;
+    std::unique_ptr<FingerprintGenerator<std::uint64_t>> sfpg{
+        RDKitFP::getRDKitFPGenerator<std::uint64_t>(args)};
+    CHECK(*sfpg->getFingerprint(*mol) == *fpg->getFingerprint(*mol));
+  }
+  SECTION("additional output") {
+    auto mol = "CC1CCC1C(=O)O"_smiles;
+    REQUIRE(mol);
+    RDKitFP::RDKitFPArguments args;
+    std::unique_ptr<FingerprintGenerator<std::uint64_t>> fpg{
+        RDKitFP::getRDKitFPGenerator<std::uint64_t>(args)};
+    args.df_streamPaths = true;
+    std::unique_ptr<FingerprintGenerator<std::uint64_t>> sfpg{
+        RDKitFP::getRDKitFPGenerator<std::uint64_t>(args)};
+    AdditionalOutput ao1;
+    ao1.allocateAtomCounts();
+    ao1.allocateAtomToBits();
+    FingerprintFuncArguments funcArgs;
+    funcArgs.additionalOutput = &ao1;
+    auto fp1 = fpg->getFingerprint(*mol, funcArgs);
+    AdditionalOutput ao2;
+    ao2.allocateAtomCounts();
+    ao2.allocateAtomToBits();
+    ao2.allocatePathStats();
+    funcArgs.additionalOutput = &ao2;
+    auto fp2 = sfpg->getFingerprint(*mol, funcArgs);
+    CHECK(*fp1 == *fp2);
+    CHECK(*ao1.atomCounts == *ao2.atomCounts);
+    for (unsigned int i = 0; i < mol->getNumAtoms(); ++i) {
+      auto bits1 = ao1.atomToBits->at(i);
+      auto bits2 = ao2.atomToBits->at(i);
+      std::sort(bits1.begin(), bits1.end());
+      std::sort(bits2.begin(), bits2.end());
+      CHECK(bits1 == bits2);
+    }
+    auto numPaths = ao2.pathStats->numPaths;
+    CHECK(numPaths > 0);
+    CHECK(!ao2.pathStats->budgetExceeded);
+
+    // the path counters alone don't need the individual paths
+    AdditionalOutput ao3;
+    ao3.allocatePathStats();
+    funcArgs.additionalOutput = &ao3;
+    auto fp3 = sfpg->getFingerprint(*mol, funcArgs);
+    CHECK(*fp1 == *fp3);
+    CHECK(ao3.pathStats->numPaths == numPaths);
+  }
+  SECTION("path budget") {
+    auto mol = "C12C3C4C1C5C2C3C45"_smiles;
+    REQUIRE(mol);
+    RDKitFP::RDKitFPArguments args;
+    args.df_streamPaths = true;
+    std::unique_ptr<FingerprintGenerator<std::uint64_t>> fpg{
+        RDKitFP::getRDKitFPGenerator<std::uint64_t>(args)};
+    AdditionalOutput ao;
+    ao.allocatePathStats();
+    FingerprintFuncArguments funcArgs;
+    funcArgs.additionalOutput = &ao;
+    auto fp = fpg->getSparseCountFingerprint(*mol, funcArgs);
+    auto numPaths = ao.pathStats->numPaths;
+    CHECK(!ao.pathStats->budgetExceeded);
+    auto total = 0;
+    for (const auto &[bit, count] : fp->getNonzeroElements()) {
+      total += count;
+    }
+    CHECK(total == static_cast<int>(numPaths * args.d_numBitsPerFeature));
+
+    args.d_maxPaths = 100;
+    fpg.reset(RDKitFP::getRDKitFPGenerator<std::uint64_t>(args));
+    fp = fpg->getSparseCountFingerprint(*mol, funcArgs);
+    CHECK(ao.pathStats->numPaths == 100);
+    CHECK(ao.pathStats->budgetExceeded);
+    total = 0;
+    for (const auto &[bit, count] : fp->getNonzeroElements()) {
+      total += count;
+    }
+    CHECK(total == static_cast<int>(100 * args.d_numBitsPerFeature));
+
+    // a budget which isn't reached doesn't change anything
+    args.d_maxPaths = numPaths;
+    fpg.reset(RDKitFP::getRDKitFPGenerator<std::uint64_t>(args));
+    fpg->getSparseCountFingerprint(*mol, funcArgs);
+    CHECK(ao.pathStats->numPaths == numPaths);
+    CHECK(!ao.pathStats->budgetExceeded);
+  }
+}
+
+TEST_CASE("MorganEnvironmentCache") {
+  auto checkSame = [](const MorganFingerprint::MorganEnvironmentCache &cache,
+                      const ROMol &mol, unsigned int radius,
+                      bool onlyNonzeroInvariants = false,
+                      bool includeRedundantEnvironments = false,
+                      bool useBondTypes = true) {
+    std::unique_ptr<FingerprintGenerator<std::uint32_t>> fpgen{
+        MorganFingerprint::getMorganGenerator<std::uint32_t>(
+            radius, false, false, useBondTypes, onlyNonzeroInvariants,
+            includeRedundantEnvironments)};
+    auto sfp = fpgen->getSparseCountFingerprint(mol);
+    CHECK(*cache.getSparseCountFingerprint() == *sfp);
+    auto cfp = fpgen->getCountFingerprint(mol);
+    CHECK(*cache.getCountFingerprint() == *cfp);
+    auto fp = fpgen->getFingerprint(mol);
+    CHECK(*cache.getFingerprint() == *fp);
+  };
+  auto parent =
+      "OC(=O)c1ccc(cc1)-c1ccc(cc1)C(=O)NC1CCN(CC1)C(=O)OC(C)(C)C"_smiles;
+  REQUIRE(parent);
+  SECTION("basics") {
+    for (auto radius : {0u, 1u, 2u, 3u}) {
+      for (auto onlyNonzero : {false, true}) {
+        for (auto redundant : {false, true}) {
+          MorganFingerprint::MorganEnvironmentCache cache(
+              *parent, radius, true, onlyNonzero, redundant);
+          CHECK(cache.getNumAtoms() == parent->getNumAtoms());
+          checkSame(cache, *parent, radius, onlyNonzero, redundant);
+        }
+      }
+    }
+    MorganFingerprint::MorganEnvironmentCache cache(*parent, 2, false);
+    checkSame(cache, *parent, 2, false, false, false);
+  }
+  SECTION("unchanged") {
+    MorganFingerprint::MorganEnvironmentCache cache(*parent, 2);
+    CHECK(cache.getNumCalculated() > 0);
+    std::vector<int> atomMap(parent->getNumAtoms());
+    std::iota(atomMap.begin(), atomMap.end(), 0);
+    MorganFingerprint::MorganEnvironmentCache same(cache, *parent, atomMap);
+    CHECK(same.getNumCalculated() == 0);
+    checkSame(same, *parent, 2);
+  }
+  SECTION("amide formation") {
+    // replace the OH of the acid with N(C)C
+    RWMol analogue(*parent);
+    analogue.removeAtom(0u);
+    auto nIdx = analogue.addAtom(new Atom(7), false, true);
+    analogue.addBond(0u, nIdx, Bond::SINGLE);
+    for (auto i = 0; i < 2; ++i) {
+      auto cIdx = analogue.addAtom(new Atom(6), false, true);
+      analogue.addBond(nIdx, cIdx, Bond::SINGLE);
+    }
+    MolOps::sanitizeMol(analogue);
+    std::vector<int> atomMap(analogue.getNumAtoms(), -1);
+    for (unsigned int i = 0; i + 1 < parent->getNumAtoms(); ++i) {
+      atomMap[i] = i + 1;
+    }
+    for (auto radius : {1u, 2u, 3u}) {
+      for (auto redundant : {false, true}) {
+        MorganFingerprint::MorganEnvironmentCache cache(*parent, radius, true,
+                                                        false, redundant);
+        MorganFingerprint::MorganEnvironmentCache acache(cache, analogue,
+                                                         atomMap);
+        checkSame(acache, analogue, radius, false, redundant);
+        // only the atoms near the edit were done again
+        MorganFingerprint::MorganEnvironmentCache scratch(
+            analogue, radius, true, false, redundant);
+        CHECK(acache.getNumCalculated() < scratch.getNumCalculated() / 2);
+
+        // and the analogue can be the parent of another one
+        RWMol analogue2(analogue);
+        analogue2.getAtomWithIdx(analogue2.getNumAtoms() - 1)
+            ->setAtomicNum(8);
+        MolOps::sanitizeMol(analogue2);
+        std::vector<int> atomMap2(analogue2.getNumAtoms());
+        std::iota(atomMap2.begin(), atomMap2.end(), 0);
+        MorganFingerprint::MorganEnvironmentCache acache2(acache, analogue2,
+                                                          atomMap2);
+        checkSame(acache2, analogue2, radius, false, redundant);
+        CHECK(acache2.getNumCalculated() < acache.getNumCalculated());
+      }
+    }
+  }
+  SECTION("ring closure") {
+    // closing a ring changes the invariants of atoms away from the edit
+    auto chain = "CCCCCCCCO"_smiles;
+    REQUIRE(chain);
+    MorganFingerprint::MorganEnvironmentCache cache(*chain, 3);
+    RWMol ring(*chain);
+    ring.addBond(0u, 5u, Bond::SINGLE);
+    MolOps::sanitizeMol(ring);
+    std::vector<int> atomMap(ring.getNumAtoms());
+    std::iota(atomMap.begin(), atomMap.end(), 0);
+    MorganFingerprint::MorganEnvironmentCache rcache(cache, ring, atomMap);
+    checkSame(rcache, ring, 3);
+  }
+  SECTION("bad atom maps") {
+    MorganFingerprint::MorganEnvironmentCache cache(*parent, 2);
+    std::vector<int> atomMap(parent->getNumAtoms() - 1, 0);
+    CHECK_THROWS_AS(
+        MorganFingerprint::MorganEnvironmentCache(cache, *parent, atomMap),
+        ValueErrorException);
+    atomMap.push_back(parent->getNumAtoms());
+    CHECK_THROWS_AS(
+        MorganFingerprint::MorganEnvironmentCache(cache, *parent, atomMap),
+        ValueErrorException);
+    // a wrong (but valid) map just means more is calculated
+    std::fill(atomMap.begin(), atomMap.end(), 0);
+    MorganFingerprint::MorganEnvironmentCache wrong(cache, *parent, atomMap);
+    checkSame(wrong, *parent, 2);
+  }
+  SECTION("FrozenMol") {
+    for (const auto smi :
+         {"OC(=O)c1ccc(cc1)-c1ccc(cc1)C(=O)NC1CCN(CC1)C(=O)OC(C)(C)C",
+          "[13CH3]C(=O)[O-].[Na+]", "[2H]OC1CC1[H]"}) {
+      std::unique_ptr<RWMol> mol(SmilesToMol(smi, 0, false));
+      REQUIRE(mol);
+      MolOps::sanitizeMol(*mol);
+      FrozenMol frozen(*mol);
+      for (auto radius : {0u, 2u, 3u}) {
+        MorganFingerprint::MorganEnvironmentCache cache(frozen, radius);
+        checkSame(cache, *mol, radius);
+      }
+      MorganFingerprint::MorganEnvironmentCache cache(frozen, 2, false);
+      checkSame(cache, *mol, 2, false, false, false);
+    }
+  }
+}
+
+TEST_CASE("filling buffers with fingerprints") {
+  std::vector<std::unique_ptr<RWMol>> owned;
+  for (const auto smi :
+       {"CCCCCCCCCCO", "c1ccccc1CC(=O)NC1CC1", "OCCO", "C1CCC1CCCCCCCCCCCC",
+        "CC(C)(C)c1ccc(O)cc1"}) {
+    owned.emplace_back(SmilesToMol(smi));
+    REQUIRE(owned.back());
+  }
+  std::vector<const ROMol *> mols;
+  for (const auto &mol : owned) {
+    mols.push_back(mol.get());
+  }
+  mols.push_back(nullptr);
+
+  for (auto countSimulation : {false, true}) {
+    std::vector<std::unique_ptr<FingerprintGenerator<std::uint64_t>>> gens;
+    gens.emplace_back(MorganFingerprint::getMorganGenerator<std::uint64_t>(
+        2, countSimulation, false, true, false, false, nullptr, nullptr, 512));
+    gens.emplace_back(AtomPair::getAtomPairGenerator<std::uint64_t>(
+        1, 30, false, true, nullptr, countSimulation, 1024));
+    gens.emplace_back(RDKitFP::getRDKitFPGenerator<std::uint64_t>(
+        1, 7, true, true, true, nullptr, countSimulation, {1, 2, 4, 8}, 256,
+        2));
+    for (const auto &gen : gens) {
+      const auto fpSize = gen->getOptions()->d_fpSize;
+      for (int numThreads : {1, 4}) {
+        std::vector<std::uint8_t> bits(mols.size() * fpSize, 7);
+        gen->fillFingerprints(mols, bits.data(), numThreads);
+        std::vector<std::uint8_t> counts8(mols.size() * fpSize, 7);
+        gen->fillCountFingerprints(mols, counts8.data(), numThreads);
+        std::vector<std::uint16_t> counts16(mols.size() * fpSize, 7);
+        gen->fillCountFingerprints(mols, counts16.data(), numThreads);
+        for (size_t i = 0; i < mols.size(); ++i) {
+          std::unique_ptr<ExplicitBitVect> fp;
+          std::unique_ptr<SparseIntVect<std::uint32_t>> cfp;
+          if (mols[i]) {
+            fp.reset(gen->getFingerprint(*mols[i]));
+            cfp.reset(gen->getCountFingerprint(*mols[i]));
+          }
+          for (unsigned int j = 0; j < fpSize; ++j) {
+            const auto idx = i * fpSize + j;
+            CHECK(bits[idx] == (fp && (*fp)[j] ? 1 : 0));
+            const auto count = cfp ? cfp->getVal(j) : 0;
+            CHECK(counts16[idx] == count);
+            CHECK(counts8[idx] == std::min(count, 255));
+          }
+        }
+      }
+    }
+  }
+
+  SECTION("saturation") {
+    auto mol = "CCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCC"
+               "CCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCC"
+               "CCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCC"
+               "CCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCC"
+               "CCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCC"_smiles;
+    REQUIRE(mol);
+    std::unique_ptr<FingerprintGenerator<std::uint64_t>> gen(
+        MorganFingerprint::getMorganGenerator<std::uint64_t>(0));
+    std::vector<const ROMol *> mols{mol.get()};
+    std::vector<std::uint8_t> counts8(2048);
+    gen->fillCountFingerprints(mols, counts8.data());
+    CHECK(*std::max_element(counts8.begin(), counts8.end()) == 255);
+    std::vector<std::uint16_t> counts16(2048);
+    gen->fillCountFingerprints(mols, counts16.data());
+    CHECK(*std::max_element(counts16.begin(), counts16.end()) ==
+          mol->getNumAtoms() - 2);
+  }
+}
+
+TEST_CASE("CombinedFingerprintGenerator") {
+  std::vector<std::unique_ptr<FingerprintGenerator<std::uint64_t>>> gens;
+  gens.emplace_back(MorganFingerprint::getMorganGenerator<std::uint64_t>(2));
+  gens.emplace_back(MorganFingerprint::getMorganGenerator<std::uint64_t>(
+      3, false, true, true, false, false, nullptr, nullptr, 1024));
+  gens.emplace_back(AtomPair::getAtomPairGenerator<std::uint64_t>());
+  gens.emplace_back(
+      AtomPair::getAtomPairGenerator<std::uint64_t>(1, 30, true, true));
+  gens.emplace_back(
+      TopologicalTorsion::getTopologicalTorsionGenerator<std::uint64_t>());
+  gens.emplace_back(
+      TopologicalTorsion::getTopologicalTorsionGenerator<std::uint64_t>(
+          true));
+  gens.emplace_back(RDKitFP::getRDKitFPGenerator<std::uint64_t>());
+  CombinedFingerprintGenerator combined;
+  for (unsigned int i = 0; i < gens.size(); ++i) {
+    CHECK(combined.addGenerator(gens[i].get()) == i);
+  }
+  combined.addPatternFingerprint(1024);
+  CHECK(combined.getNumGenerators() == gens.size());
+  CHECK(combined.hasPatternFingerprint());
+
+  std::vector<std::unique_ptr<RWMol>> owned;
+  for (const auto smi :
+       {"C[C@H](F)Cl", "c1ccccc1CC(=O)N[C@@H]1CC[C@H](O)CC1", "OCCO",
+        "C/C=C/C1CCC1CC[C@@](F)(Cl)Br", "CC(C)(C)c1ccc(O)cc1"}) {
+    owned.emplace_back(SmilesToMol(smi));
+    REQUIRE(owned.back());
+  }
+  std::vector<const ROMol *> mols;
+  for (const auto &mol : owned) {
+    mols.push_back(mol.get());
+  }
+  mols.push_back(nullptr);
+
+  auto batchFps = combined.getFingerprints(mols, 4);
+  auto batchCountFps = combined.getCountFingerprints(mols, 4);
+  REQUIRE(batchFps.size() == mols.size());
+  CHECK(batchFps.back().empty());
+  CHECK(batchCountFps.back().empty());
+  for (size_t midx = 0; midx + 1 < mols.size(); ++midx) {
+    const auto &mol = *mols[midx];
+    auto fps = combined.getFingerprints(mol);
+    auto countFps = combined.getCountFingerprints(mol);
+    auto sparseCountFps = combined.getSparseCountFingerprints(mol);
+    REQUIRE(fps.size() == gens.size() + 1);
+    REQUIRE(countFps.size() == gens.size());
+    REQUIRE(sparseCountFps.size() == gens.size());
+    for (unsigned int i = 0; i < gens.size(); ++i) {
+      std::unique_ptr<ExplicitBitVect> fp(gens[i]->getFingerprint(mol));
+      CHECK(*fps[i] == *fp);
+      CHECK(*batchFps[midx][i] == *fp);
+      std::unique_ptr<SparseIntVect<std::uint32_t>> cfp(
+          gens[i]->getCountFingerprint(mol));
+      CHECK(*countFps[i] == *cfp);
+      CHECK(*batchCountFps[midx][i] == *cfp);
+      std::unique_ptr<SparseIntVect<std::uint64_t>> scfp(
+          gens[i]->getSparseCountFingerprint(mol));
+      CHECK(*sparseCountFps[i] == *scfp);
+    }
+    std::unique_ptr<ExplicitBitVect> pfp(PatternFingerprintMol(mol, 1024));
+    CHECK(*fps.back() == *pfp);
+    CHECK(*batchFps[midx].back() == *pfp);
+  }
+  // make sure the chiral generators actually saw the stereo
+  auto fps = combined.getFingerprints(*mols[0]);
+  auto mol = "CC(F)Cl"_smiles;
+  auto achiralFps = combined.getFingerprints(*mol);
+  CHECK(*fps[0] == *achiralFps[0]);
+  CHECK(*fps[1] != *achiralFps[1]);
+}
+
+TEST_CASE("fingerprints of molecules with deferred sanitization") {
+  const std::vector<std::string> smis{
+      "OC(=O)c1ccc(cc1)-c1ccc(cc1)C(=O)NC1CCN(CC1)C(=O)OC(C)(C)C",
+      "C1=CC=CC=C1[N+](=O)[O-]", "[CH2]C1CC1", "O=c1cc[nH]cc1"};
+  std::unique_ptr<FingerprintGenerator<std::uint64_t>> morgan(
+      MorganFingerprint::getMorganGenerator<std::uint64_t>(2));
+  std::unique_ptr<FingerprintGenerator<std::uint64_t>> atomPairs(
+      AtomPair::getAtomPairGenerator<std::uint64_t>());
+  std::unique_ptr<FingerprintGenerator<std::uint64_t>> rdkit(
+      RDKitFP::getRDKitFPGenerator<std::uint64_t>());
+  std::unique_ptr<FingerprintGenerator<std::uint64_t>> chiralMorgan(
+      MorganFingerprint::getMorganGenerator<std::uint64_t>(2, false, true));
+  // the Morgan fingerprint doesn't need conjugation or hybridization
+  CHECK(!(morgan->getRequiredSanitization() &
+          (MolOps::SANITIZE_SETCONJUGATION |
+           MolOps::SANITIZE_SETHYBRIDIZATION)));
+  CHECK(chiralMorgan->getRequiredSanitization() == MolOps::SANITIZE_ALL);
+  for (const auto &smi : smis) {
+    INFO(smi);
+    std::unique_ptr<RWMol> expected(SmilesToMol(smi));
+    REQUIRE(expected);
+    for (const auto gen :
+         {morgan.get(), atomPairs.get(), rdkit.get(), chiralMorgan.get()}) {
+      v2::SmilesParse::SmilesParserParams ps;
+      ps.sanitize = false;
+      auto mol = v2::SmilesParse::MolFromSmiles(smi, ps);
+      REQUIRE(mol);
+      MolOps::deferSanitization(*mol);
+      std::unique_ptr<SparseIntVect<std::uint64_t>> fp(
+          gen->getSparseCountFingerprint(*mol));
+      std::unique_ptr<SparseIntVect<std::uint64_t>> efp(
+          gen->getSparseCountFingerprint(*expected));
+      CHECK(*fp == *efp);
+      if (gen == morgan.get()) {
+        CHECK((MolOps::getPendingSanitization(*mol) &
+               MolOps::SANITIZE_SETHYBRIDIZATION));
+      }
+    }
+  }
+  SECTION("the environment cache") {
+    v2::SmilesParse::SmilesParserParams ps;
+    ps.sanitize = false;
+    auto mol = v2::SmilesParse::MolFromSmiles(smis[0], ps);
+    REQUIRE(mol);
+    MolOps::deferSanitization(*mol);
+    MorganFingerprint::MorganEnvironmentCache cache(*mol, 2);
+    CHECK((MolOps::getPendingSanitization(*mol) &
+           MolOps::SANITIZE_SETCONJUGATION));
+    std::unique_ptr<RWMol> expected(SmilesToMol(smis[0]));
+    REQUIRE(expected);
+    std::unique_ptr<FingerprintGenerator<std::uint32_t>> fpgen(
+        MorganFingerprint::getMorganGenerator<std::uint32_t>(2));
+    std::unique_ptr<SparseIntVect<std::uint32_t>> efp(
+        fpgen->getSparseCountFingerprint(*expected));
+    CHECK(*cache.getSparseCountFingerprint() == *efp);
+  }
+}
@@ -17,6 +17,7 @@
 #include <RDBoost/import_array.h>
 #include <GraphMol/RDKitBase.h>
 #include <GraphMol/Fingerprints/FingerprintGenerator.h>
+#include <GraphMol/Fingerprints/CombinedFingerprintGenerator.h>
 #include <GraphMol/Fingerprints/nbWrap/AtomPairWrapper.cpp>
 #include <GraphMol/Fingerprints/nbWrap/MorganWrapper.cpp>
 #include <GraphMol/Fingerprints/nbWrap/RDKitFPWrapper.cpp>
@@ -279,6 +280,60 @@ nb::object getNumPyCountFingerprint(
   return nb::steal<nb::object>(arr);
 }
 
+template <typename OutputType>
+nb::object getNumPyFingerprints(const FingerprintGenerator<OutputType> *fpGen,
+                                nb::object mols, int numThreads) {
+  std::vector<const ROMol *> tmols;
+  for (auto item : mols) {
+    tmols.push_back(nb::cast<const ROMol *>(item));
+  }
+  npy_intp size[2] = {static_cast<npy_intp>(tmols.size()),
+                      static_cast<npy_intp>(fpGen->getOptions()->d_fpSize)};
+  auto res = nb::steal<nb::object>(PyArray_ZEROS(2, size, NPY_UINT8, 0));
+  auto data = static_cast<std::uint8_t *>(
+      PyArray_DATA(reinterpret_cast<PyArrayObject *>(res.ptr())));
+  {
+    nb::gil_scoped_release release;
+    fpGen->fillFingerprints(tmols, data, numThreads);
+  }
+  return res;
+}
+
+template <typename OutputType>
+nb::object getNumPyCountFingerprints(
+    const FingerprintGenerator<OutputType> *fpGen, nb::object mols,
+    int numThreads, bool useUInt16) {
+  std::vector<const ROMol *> tmols;
+  for (auto item : mols) {
+    tmols.push_back(nb::cast<const ROMol *>(item));
+  }
+  npy_intp size[2] = {static_cast<npy_intp>(tmols.size()),
+                      static_cast<npy_intp>(fpGen->getOptions()->d_fpSize)};
+  auto res = nb::steal<nb::object>(
+      PyArray_ZEROS(2, size, useUInt16 ? NPY_UINT16 : NPY_UINT8, 0));
+  auto data = PyArray_DATA(reinterpret_cast<PyArrayObject *>(res.ptr()));
+  {
+    nb::gil_scoped_release release;
+    if (useUInt16) {
+      fpGen->fillCountFingerprints(
+          tmols, static_cast<std::uint16_t *>(data), numThreads);
+    } else {
+      fpGen->fillCountFingerprints(tmols, static_cast<std::uint8_t *>(data),
+                                   numThreads);
+    }
+  }
+  return res;
+}
+
+template <typename T>
+nb::tuple fpsToTuple(std::vector<std::unique_ptr<T>> &fps) {
+  nb::list res;
+  for (auto &fp : fps) {
+    res.append(nb::cast(fp.release(), nb::rv_policy::take_ownership));
+  }
+  return nb::tuple(res);
+}
+
 const std::vector<const ROMol *> convertPyArgumentsForBulk(
     nb::object py_molVect) {
   std::vector<const ROMol *> molVect;
@@ -352,6 +407,13 @@ nb::object getAtomCountsHelper(const AdditionalOutput &ao) {
   return nb::tuple(res);
 }
 
+nb::object getPathStatsHelper(const AdditionalOutput &ao) {
+  if (!ao.pathStats) {
+    return nb::none();
+  }
+  return nb::make_tuple(ao.pathStats->numPaths, ao.pathStats->budgetExceeded);
+}
+
 nb::object getAtomToBitsHelper(const AdditionalOutput &ao) {
   if (!ao.atomToBits) {
     return nb::none();
@@ -556,6 +618,28 @@ ARGUMENTS:
     - numThreads: number of threads to use
 
 RETURNS: a tuple of ExplicitBitVects
+)DOC")
+      .def("GetFingerprintsAsNumPy", getNumPyFingerprints<T>, "mols"_a,
+           "numThreads"_a = 1,
+           R"DOC(Generates fingerprints for a sequence of molecules
+
+ARGUMENTS:
+    - mols: molecules to be fingerprinted
+    - numThreads: number of threads to use
+
+RETURNS: a 2D numpy array of uint8 with one row per molecule
+)DOC")
+      .def("GetCountFingerprintsAsNumPy", getNumPyCountFingerprints<T>,
+           "mols"_a, "numThreads"_a = 1, "useUInt16"_a = false,
+           R"DOC(Generates count fingerprints for a sequence of molecules
+
+ARGUMENTS:
+    - mols: molecules to be fingerprinted
+    - numThreads: number of threads to use
+    - useUInt16: store the counts as uint16 instead of uint8.
+      Counts that don't fit are set to the largest value.
+
+RETURNS: a 2D numpy array with one row per molecule
 )DOC")
       .def("GetCountFingerprints", getCountFingerprints<T>, "mols"_a,
            "numThreads"_a = 1,
@@ -625,6 +709,8 @@ NB_MODULE(rdFingerprintGenerator, m) {
            "synonym for CollectAtomCounts()")
       .def("AllocateAtomsPerBit", &AdditionalOutput::allocateAtomsPerBit,
            "synonym for CollectAtomsPerBit()")
+      .def("AllocatePathStats", &AdditionalOutput::allocatePathStats,
+           "synonym for CollectPathStats()")
       .def(
           "CollectAtomToBits", &AdditionalOutput::allocateAtomToBits,
           R"DOC(toggle collection of information mapping each atom to the bits it is involved in.)DOC")
@@ -640,11 +726,16 @@ NB_MODULE(rdFingerprintGenerator, m) {
       .def(
           "CollectAtomsPerBit", &AdditionalOutput::allocateAtomsPerBit,
           R"DOC(toggles collection of information about all atoms involved in setting each bit)DOC")
+      .def(
+          "CollectPathStats", &AdditionalOutput::allocatePathStats,
+          R"DOC(toggles collection of the number of paths enumerated and whether the path budget was reached (only for RDKit fingerprints with streamPaths set))DOC")
       .def("GetAtomToBits", &getAtomToBitsHelper)
       .def("GetBitInfoMap", &getBitInfoMapHelper)
       .def("GetBitPaths", &getBitPathsHelper)
       .def("GetAtomCounts", &getAtomCountsHelper)
-      .def("GetAtomsPerBit", &getAtomsPerBitHelper);
+      .def("GetAtomsPerBit", &getAtomsPerBitHelper)
+      .def("GetPathStats", &getPathStatsHelper,
+           "returns (number of paths, whether the path budget was reached)");
 
   nb::class_<FingerprintArguments>(m, "FingerprintOptions")
       .def_rw("countSimulation", &FingerprintArguments::df_countSimulation,
@@ -668,6 +759,81 @@ NB_MODULE(rdFingerprintGenerator, m) {
   wrapGenerator<std::uint32_t>(m, "FingerprintGenerator32");
   wrapGenerator<std::uint64_t>(m, "FingerprintGenerator64");
 
+  nb::class_<CombinedFingerprintGenerator>(
+      m, "CombinedFingerprintGenerator",
+      R"DOC(Generates several fingerprints for each molecule, sharing the work
+the generators have in common.
+The results are the same as those of the individual generators.)DOC")
+      .def(nb::init<>())
+      .def("AddGenerator", &CombinedFingerprintGenerator::addGenerator,
+           "generator"_a, nb::keep_alive<1, 2>(),
+           "Adds a FingerprintGenerator64, returns the index of its "
+           "fingerprints in the results")
+      .def("AddPatternFingerprint",
+           &CombinedFingerprintGenerator::addPatternFingerprint,
+           "fpSize"_a = 2048, "tautomericFingerprint"_a = false,
+           "Adds a pattern fingerprint. It is only part of the results of "
+           "GetFingerprints(), after those of the generators.")
+      .def("GetNumGenerators", &CombinedFingerprintGenerator::getNumGenerators)
+      .def(
+          "GetFingerprints",
+          [](const CombinedFingerprintGenerator &gen, const ROMol &mol) {
+            std::vector<std::unique_ptr<ExplicitBitVect>> fps;
+            {
+              nb::gil_scoped_release release;
+              fps = gen.getFingerprints(mol);
+            }
+            return fpsToTuple(fps);
+          },
+          "mol"_a,
+          "Returns a tuple with the ExplicitBitVect fingerprints of a "
+          "molecule")
+      .def(
+          "GetCountFingerprints",
+          [](const CombinedFingerprintGenerator &gen, const ROMol &mol) {
+            std::vector<std::unique_ptr<SparseIntVect<std::uint32_t>>> fps;
+            {
+              nb::gil_scoped_release release;
+              fps = gen.getCountFingerprints(mol);
+            }
+            return fpsToTuple(fps);
+          },
+          "mol"_a, "Returns a tuple with the count fingerprints of a molecule")
+      .def(
+          "GetSparseCountFingerprints",
+          [](const CombinedFingerprintGenerator &gen, const ROMol &mol) {
+            std::vector<std::unique_ptr<SparseIntVect<std::uint64_t>>> fps;
+            {
+              nb::gil_scoped_release release;
+              fps = gen.getSparseCountFingerprints(mol);
+            }
+            return fpsToTuple(fps);
+          },
+          "mol"_a,
+          "Returns a tuple with the sparse count fingerprints of a molecule")
+      .def(
+          "GetFingerprintsForMols",
+          [](const CombinedFingerprintGenerator &gen, nb::object mols,
+             int numThreads) {
+            std::vector<const ROMol *> tmols;
+            for (auto item : mols) {
+              tmols.push_back(nb::cast<const ROMol *>(item));
+            }
+            std::vector<std::vector<std::unique_ptr<ExplicitBitVect>>> fps;
+            {
+              nb::gil_scoped_release release;
+              fps = gen.getFingerprints(tmols, numThreads);
+            }
+            nb::list res;
+            for (auto &molFps : fps) {
+              res.append(fpsToTuple(molFps));
+            }
+            return nb::tuple(res);
+          },
+          "mols"_a, "numThreads"_a = 1,
+          "Returns a tuple with the result of GetFingerprints() for each "
+          "molecule");
+
   nb::enum_<FPType>(m, "FPType")
       .value("RDKitFP", FPType::RDKitFP)
       .value("MorganFP", FPType::MorganFP)
@@ -13,11 +13,13 @@
 #include <nanobind/stl/string.h>
 #include <nanobind/stl/vector.h>
 #include <GraphMol/Fingerprints/MHFP.h>
+#include <GraphMol/Fingerprints/MHFPLSHForest.h>
 #include <vector>
 
 namespace nb = nanobind;
 using namespace nb::literals;
 using RDKit::MHFPFingerprints::MHFPEncoder;
+using RDKit::MHFPFingerprints::MHFPLSHForest;
 
 namespace RDKit {
 namespace MHFPWrapper {
@@ -31,7 +33,21 @@ std::vector<T> ListToVector(nb::object obj) {
   return result;
 }
 
+nb::tuple HitsToTuple(
+    const std::vector<MHFPFingerprints::LSHForestHit> &hits) {
+  nb::list res;
+  for (const auto &[idx, dist] : hits) {
+    res.append(nb::make_tuple(idx, dist));
+  }
+  return nb::tuple(res);
+}
+
 NB_MODULE(rdMHFPFingerprint, m) {
+  nb::enum_<MHFPFingerprints::ShinglingType>(m, "ShinglingType")
+      .value("SMILES", MHFPFingerprints::ShinglingType::SMILES)
+      .value("Morgan", MHFPFingerprints::ShinglingType::Morgan)
+      .export_values();
+
   nb::class_<MHFPEncoder>(m, "MHFPEncoder")
       .def(nb::init<unsigned int, unsigned int>(), "n_permutations"_a = 2048,
            "seed"_a = 42)
@@ -194,7 +210,131 @@ NB_MODULE(rdMHFPFingerprint, m) {
           "mols"_a, "radius"_a = 3, "rings"_a = true, "isomeric"_a = false,
           "kekulize"_a = true, "min_radius"_a = 1, "length"_a = 2048,
           "Creates a SECFP binary vector from a list of RDKit Mol instances.")
+      .def(
+          "CreateHashedShingling",
+          [](const MHFPEncoder *enc, const ROMol &mol, unsigned char radius,
+             bool rings, bool isomeric, unsigned char min_radius) {
+            auto shingling = enc->CreateHashedShingling(mol, radius, rings,
+                                                        isomeric, min_radius);
+            nb::list res;
+            for (auto shingle : shingling) {
+              res.append(shingle);
+            }
+            return nb::tuple(res);
+          },
+          "mol"_a, "radius"_a = 3, "rings"_a = true, "isomeric"_a = false,
+          "min_radius"_a = 1,
+          R"DOC(Creates a shingling from the Morgan environments (and rings) of an RDKit Mol instance.
+This is much faster than the SMILES shingling, but the results are not compatible with it.)DOC")
+      .def(
+          "EncodeMols",
+          [](const MHFPEncoder *enc, nb::object mols, unsigned char radius,
+             bool rings, bool isomeric, bool kekulize, unsigned char min_radius,
+             MHFPFingerprints::ShinglingType shinglingType,
+             int numThreads) -> nb::tuple {
+            std::vector<const ROMol *> molPtrs;
+            for (auto item : mols) {
+              molPtrs.push_back(nb::cast<const ROMol *>(item));
+            }
+            std::vector<std::vector<uint32_t>> resVect;
+            {
+              nb::gil_scoped_release release;
+              resVect =
+                  enc->EncodeMols(molPtrs, radius, rings, isomeric, kekulize,
+                                  min_radius, shinglingType, numThreads);
+            }
+            nb::list resList;
+            for (const auto &item : resVect) {
+              resList.append(item);
+            }
+            return nb::tuple(resList);
+          },
+          "mols"_a, "radius"_a = 3, "rings"_a = true, "isomeric"_a = false,
+          "kekulize"_a = false, "min_radius"_a = 1,
+          "shinglingType"_a = MHFPFingerprints::ShinglingType::SMILES,
+          "numThreads"_a = 1,
+          R"DOC(Creates MHFP vectors from a list of RDKit Mol instances using multiple threads.
+shinglingType selects between the SMILES and Morgan shinglings.)DOC")
       .def_static("Distance", &MHFPEncoder::Distance, "a"_a, "b"_a);
+
+  nb::class_<MHFPLSHForest>(
+      m, "MHFPLSHForest",
+      R"DOC(An LSH Forest index for approximate nearest neighbor searches of MHFP vectors.
+Vectors that have been added are only found by Query() after Index() has been called.)DOC")
+      .def(nb::init<unsigned int, unsigned int>(), "n_permutations"_a = 2048,
+           "n_prefix_trees"_a = 8)
+      .def(nb::init<std::string>(), "fileName"_a,
+           "Reads an index written by Write().")
+      .def("__len__", &MHFPLSHForest::size)
+      .def(
+          "Add",
+          [](MHFPLSHForest *forest, nb::object fp) {
+            return forest->add(ListToVector<uint32_t>(fp));
+          },
+          "fp"_a, "Adds a MHFP vector to the index and returns its index.")
+      .def("Index", &MHFPLSHForest::index, "numThreads"_a = 1,
+           nb::call_guard<nb::gil_scoped_release>(),
+           "Adds the vectors added since the last call to the prefix trees.")
+      .def("GetNumIndexed", &MHFPLSHForest::numIndexed,
+           "The number of vectors that can be found by Query().")
+      .def("GetFingerprint", &MHFPLSHForest::getFingerprint, "idx"_a,
+           "Returns a MHFP vector from the index.")
+      .def(
+          "Query",
+          [](const MHFPLSHForest *forest, nb::object fp, unsigned int k,
+             unsigned int kc) {
+            auto vec = ListToVector<uint32_t>(fp);
+            std::vector<MHFPFingerprints::LSHForestHit> hits;
+            {
+              nb::gil_scoped_release release;
+              hits = forest->query(vec, k, kc);
+            }
+            return HitsToTuple(hits);
+          },
+          "fp"_a, "k"_a, "kc"_a = 10,
+          R"DOC(Returns the approximate k nearest neighbors of a MHFP vector as (index, distance) tuples.
+k*kc candidates are compared with the query.)DOC")
+      .def(
+          "BulkQuery",
+          [](const MHFPLSHForest *forest, nb::object fps, unsigned int k,
+             unsigned int kc, int numThreads) {
+            std::vector<std::vector<uint32_t>> vecs;
+            for (auto fp : fps) {
+              vecs.push_back(ListToVector<uint32_t>(nb::borrow(fp)));
+            }
+            std::vector<std::vector<MHFPFingerprints::LSHForestHit>> hits;
+            {
+              nb::gil_scoped_release release;
+              hits = forest->query(vecs, k, kc, numThreads);
+            }
+            nb::list res;
+            for (const auto &queryHits : hits) {
+              res.append(HitsToTuple(queryHits));
+            }
+            return nb::tuple(res);
+          },
+          "fps"_a, "k"_a, "kc"_a = 10, "numThreads"_a = 1,
+          "Query() for a list of MHFP vectors using multiple threads.")
+      .def(
+          "QueryExact",
+          [](const MHFPLSHForest *forest, nb::object fp, unsigned int k) {
+            auto vec = ListToVector<uint32_t>(fp);
+            std::vector<MHFPFingerprints::LSHForestHit> hits;
+            {
+              nb::gil_scoped_release release;
+              hits = forest->queryExact(vec, k);
+            }
+            return HitsToTuple(hits);
+          },
+          "fp"_a, "k"_a,
+          "Returns the exact k nearest neighbors of a MHFP vector by "
+          "comparing it with every vector in the index.")
+      .def(
+          "Write",
+          [](const MHFPLSHForest *forest, const std::string &fileName) {
+            forest->write(fileName);
+          },
+          "fileName"_a, "Writes the index to a binary file.");
 }
 
 }  // namespace MHFPWrapper
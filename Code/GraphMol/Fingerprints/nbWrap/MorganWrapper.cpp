@@ -10,7 +10,9 @@
 
 #include <nanobind/nanobind.h>
 #include <GraphMol/Fingerprints/FingerprintGenerator.h>
+#include <GraphMol/Fingerprints/MorganEnvironmentCache.h>
 #include <GraphMol/Fingerprints/MorganGenerator.h>
+#include <nanobind/stl/vector.h>
 
 using namespace RDKit;
 namespace nb = nanobind;
@@ -161,6 +163,68 @@ ARGUMENTS:
 RETURNS: BondInvariantsGenerator
 )DOC",
       nb::rv_policy::take_ownership);
+
+  nb::class_<MorganFingerprint::MorganEnvironmentCache>(
+      m, "MorganEnvironmentCache",
+      R"DOC(The Morgan environments of a molecule, used to find the Morgan
+fingerprints of analogues of it without starting from scratch.
+The fingerprints are the same as those from a Morgan generator with the same
+arguments, chirality and count simulation are not supported.)DOC")
+      .def(nb::init<const ROMol &, unsigned int, bool, bool, bool, bool>(),
+           "mol"_a, "radius"_a = 3, "useBondTypes"_a = true,
+           "onlyNonzeroInvariants"_a = false,
+           "includeRedundantEnvironments"_a = false,
+           "includeRingMembership"_a = true)
+      .def(
+          "GetAnalogueCache",
+          [](const MorganFingerprint::MorganEnvironmentCache &self,
+             const ROMol &analogue, const std::vector<int> &atomMap) {
+            return new MorganFingerprint::MorganEnvironmentCache(
+                self, analogue, atomMap);
+          },
+          "analogue"_a, "atomMap"_a,
+          R"DOC(Returns the cache for an analogue of this molecule.
+
+ARGUMENTS:
+    - analogue: the analogue
+    - atomMap: for each atom of the analogue the index of the corresponding
+      atom of this molecule, or -1 for atoms that were added
+
+Only the environments near atoms and bonds that differ from this molecule
+are calculated again.
+)DOC",
+          nb::rv_policy::take_ownership)
+      .def(
+          "GetSparseCountFingerprint",
+          [](const MorganFingerprint::MorganEnvironmentCache &self) {
+            return self.getSparseCountFingerprint().release();
+          },
+          "Returns the unfolded count fingerprint",
+          nb::rv_policy::take_ownership)
+      .def(
+          "GetCountFingerprint",
+          [](const MorganFingerprint::MorganEnvironmentCache &self,
+             unsigned int fpSize) {
+            return self.getCountFingerprint(fpSize).release();
+          },
+          "fpSize"_a = 2048, "Returns the count fingerprint folded to fpSize",
+          nb::rv_policy::take_ownership)
+      .def(
+          "GetFingerprint",
+          [](const MorganFingerprint::MorganEnvironmentCache &self,
+             unsigned int fpSize) {
+            return self.getFingerprint(fpSize).release();
+          },
+          "fpSize"_a = 2048,
+          "Returns the bit vector fingerprint folded to fpSize",
+          nb::rv_policy::take_ownership)
+      .def("GetNumAtoms",
+           &MorganFingerprint::MorganEnvironmentCache::getNumAtoms)
+      .def("GetRadius", &MorganFingerprint::MorganEnvironmentCache::getRadius)
+      .def("GetNumCalculated",
+           &MorganFingerprint::MorganEnvironmentCache::getNumCalculated,
+           "The number of environment identifiers that were calculated, the "
+           "rest were copied from the parent");
 }
 }  // namespace MorganWrapper
 
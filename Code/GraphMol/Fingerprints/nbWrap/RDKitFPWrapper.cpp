@@ -58,7 +58,13 @@ void exportRDKit(nb::module_ &m) {
       .def_rw("branchedPaths", &RDKitFP::RDKitFPArguments::df_branchedPaths,
               "generate branched subgraphs, not just linear ones")
       .def_rw("useBondOrder", &RDKitFP::RDKitFPArguments::df_useBondOrder,
-              "include bond orders in the path hashes");
+              "include bond orders in the path hashes")
+      .def_rw("streamPaths", &RDKitFP::RDKitFPArguments::df_streamPaths,
+              "hash the paths as they are enumerated instead of collecting "
+              "them first")
+      .def_rw("maxPaths", &RDKitFP::RDKitFPArguments::d_maxPaths,
+              "maximum number of paths to enumerate for a molecule when "
+              "streamPaths is set (0 for no limit)");
 
   m.def(
       "GetRDKitFPGenerator", &getRDKitFPGenerator<std::uint64_t>,
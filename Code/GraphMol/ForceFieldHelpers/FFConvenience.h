@@ -12,6 +12,7 @@
 #define RD_FFCONVENIENCE_H
 #include <GraphMol/ROMol.h>
 #include <ForceField/ForceField.h>
+#include <RDGeneral/RDThreadPool.h>
 #include <RDGeneral/RDThreads.h>
 
 namespace RDKit {
@@ -48,16 +49,11 @@ inline void OptimizeMoleculeConfsMT(ROMol &mol,
                                     const ForceFields::ForceField &ff,
                                     std::vector<std::pair<int, double>> &res,
                                     int numThreads, int maxIters) {
-  std::vector<std::thread> tg;
-  for (int ti = 0; ti < numThreads; ++ti) {
-    tg.emplace_back(std::thread(detail::OptimizeMoleculeConfsHelper_, ff, &mol,
-                                &res, ti, numThreads, maxIters));
-  }
-  for (auto &thread : tg) {
-    if (thread.joinable()) {
-      thread.join();
-    }
-  }
+  // each task works on its own copy of the force field
+  parallelFor(numThreads, numThreads, [&](size_t ti) {
+    detail::OptimizeMoleculeConfsHelper_(ff, &mol, &res, ti, numThreads,
+                                         maxIters);
+  });
 }
 #endif
 
@@ -0,0 +1,326 @@
+//
+//  Copyright (C) 2026 Greg Landrum and other RDKit contributors
+//
+//   @@ All Rights Reserved @@
+//  This file is part of the RDKit.
+//  The contents are covered by the terms of the BSD license
+//  which is included in the file license.txt, found at the root
+//  of the RDKit source tree.
+//
+
+#include <algorithm>
+#include <unordered_map>
+
+#include <GraphMol/RDKitBase.h>
+#include <GraphMol/MolOps.h>
+#include <RDGeneral/Exceptions.h>
+
+#include "FrozenMol.h"
+
+namespace RDKit {
+
+FrozenMol::FrozenMol(const ROMol &mol) {
+  const auto nAtoms = mol.getNumAtoms();
+  const auto nBonds = mol.getNumBonds();
+
+  d_atoms.reserve(nAtoms);
+  d_neighborStarts.reserve(nAtoms + 1);
+  d_neighborStarts.push_back(0);
+  d_neighbors.reserve(2 * nBonds);
+  for (const auto atom : mol.atoms()) {
+    if (atom->hasQuery()) {
+      throw ValueErrorException("FrozenMol does not support query atoms");
+    }
+    AtomData data;
+    data.isotope = atom->getIsotope();
+    data.atomicNum = atom->getAtomicNum();
+    data.formalCharge = atom->getFormalCharge();
+    data.numExplicitHs = atom->getNumExplicitHs();
+    data.numImplicitHs = atom->getNumImplicitHs();
+    data.numRadicalElectrons = atom->getNumRadicalElectrons();
+    data.hybridization = atom->getHybridization();
+    data.chiralTag = atom->getChiralTag();
+    data.isAromatic = atom->getIsAromatic();
+    data.noImplicit = atom->getNoImplicit();
+    d_atoms.push_back(data);
+    for (const auto bond : mol.atomBonds(atom)) {
+      d_neighbors.push_back(
+          {bond->getOtherAtomIdx(atom->getIdx()), bond->getIdx()});
+    }
+    d_neighborStarts.push_back(d_neighbors.size());
+  }
+
+  d_bonds.reserve(nBonds);
+  for (const auto bond : mol.bonds()) {
+    if (bond->hasQuery()) {
+      throw ValueErrorException("FrozenMol does not support query bonds");
+    }
+    BondData data;
+    data.beginAtom = bond->getBeginAtomIdx();
+    data.endAtom = bond->getEndAtomIdx();
+    const auto &stereoAtoms = bond->getStereoAtoms();
+    if (stereoAtoms.size() == 2) {
+      data.stereoAtoms[0] = stereoAtoms[0];
+      data.stereoAtoms[1] = stereoAtoms[1];
+    } else {
+      data.stereoAtoms[0] = data.stereoAtoms[1] = -1;
+    }
+    data.bondType = bond->getBondType();
+    data.bondDir = bond->getBondDir();
+    data.stereo = bond->getStereo();
+    data.isAromatic = bond->getIsAromatic();
+    data.isConjugated = bond->getIsConjugated();
+    d_bonds.push_back(data);
+  }
+
+  const auto ringInfo = mol.getRingInfo();
+  if (!ringInfo->isInitialized()) {
+    MolOps::fastFindRings(mol);
+  }
+  d_ringType = ringInfo->getRingType();
+  d_ringStarts.push_back(0);
+  d_numAtomRings.assign(nAtoms, 0);
+  d_numBondRings.assign(nBonds, 0);
+  for (unsigned int i = 0; i < ringInfo->numRings(); ++i) {
+    for (auto idx : ringInfo->atomRings()[i]) {
+      d_ringAtoms.push_back(idx);
+      ++d_numAtomRings[idx];
+    }
+    for (auto idx : ringInfo->bondRings()[i]) {
+      d_ringBonds.push_back(idx);
+      ++d_numBondRings[idx];
+    }
+    d_ringStarts.push_back(d_ringAtoms.size());
+  }
+
+  d_confIds.reserve(mol.getNumConformers());
+  d_positions.reserve(mol.getNumConformers() * nAtoms);
+  for (auto cit = mol.beginConformers(); cit != mol.endConformers(); ++cit) {
+    d_confIds.push_back((*cit)->getId());
+    d_confIs3D.push_back((*cit)->is3D());
+    const auto &positions = (*cit)->getPositions();
+    d_positions.insert(d_positions.end(), positions.begin(), positions.end());
+  }
+
+  std::unordered_map<std::string, std::uint32_t> nameIndices;
+  d_propStarts.reserve(2 + nAtoms + nBonds);
+  d_propStarts.push_back(0);
+  auto addProps = [&](const RDProps &owner) {
+    for (const auto &pair : owner.getDict()) {
+      auto [it, inserted] =
+          nameIndices.emplace(pair.key, static_cast<std::uint32_t>(
+                                            d_propNames.size()));
+      if (inserted) {
+        d_propNames.push_back(pair.key);
+      }
+      d_props.push_back({it->second, RDValue()});
+      copy_rdvalue(d_props.back().val, pair.val);
+    }
+    d_propStarts.push_back(d_props.size());
+  };
+  addProps(mol);
+  for (const auto atom : mol.atoms()) {
+    addProps(*atom);
+  }
+  for (const auto bond : mol.bonds()) {
+    addProps(*bond);
+  }
+}
+
+FrozenMol::FrozenMol(const FrozenMol &other)
+    : d_atoms(other.d_atoms),
+      d_bonds(other.d_bonds),
+      d_neighborStarts(other.d_neighborStarts),
+      d_neighbors(other.d_neighbors),
+      d_ringType(other.d_ringType),
+      d_ringStarts(other.d_ringStarts),
+      d_ringAtoms(other.d_ringAtoms),
+      d_ringBonds(other.d_ringBonds),
+      d_numAtomRings(other.d_numAtomRings),
+      d_numBondRings(other.d_numBondRings),
+      d_confIds(other.d_confIds),
+      d_confIs3D(other.d_confIs3D),
+      d_positions(other.d_positions),
+      d_propNames(other.d_propNames),
+      d_propStarts(other.d_propStarts) {
+  copyProps(other);
+}
+
+FrozenMol &FrozenMol::operator=(const FrozenMol &other) {
+  if (this == &other) {
+    return *this;
+  }
+  FrozenMol tmp(other);
+  *this = std::move(tmp);
+  return *this;
+}
+
+FrozenMol &FrozenMol::operator=(FrozenMol &&other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  clearProps();
+  d_atoms = std::move(other.d_atoms);
+  d_bonds = std::move(other.d_bonds);
+  d_neighborStarts = std::move(other.d_neighborStarts);
+  d_neighbors = std::move(other.d_neighbors);
+  d_ringType = other.d_ringType;
+  d_ringStarts = std::move(other.d_ringStarts);
+  d_ringAtoms = std::move(other.d_ringAtoms);
+  d_ringBonds = std::move(other.d_ringBonds);
+  d_numAtomRings = std::move(other.d_numAtomRings);
+  d_numBondRings = std::move(other.d_numBondRings);
+  d_confIds = std::move(other.d_confIds);
+  d_confIs3D = std::move(other.d_confIs3D);
+  d_positions = std::move(other.d_positions);
+  d_propNames = std::move(other.d_propNames);
+  d_propStarts = std::move(other.d_propStarts);
+  d_props = std::move(other.d_props);
+  other.d_props.clear();
+  return *this;
+}
+
+FrozenMol::~FrozenMol() { clearProps(); }
+
+void FrozenMol::copyProps(const FrozenMol &other) {
+  d_props.reserve(other.d_props.size());
+  for (const auto &prop : other.d_props) {
+    d_props.push_back({prop.name, RDValue()});
+    copy_rdvalue(d_props.back().val, prop.val);
+  }
+}
+
+void FrozenMol::clearProps() {
+  for (auto &prop : d_props) {
+    RDValue::cleanup_rdvalue(prop.val);
+  }
+  d_props.clear();
+}
+
+const RDValue *FrozenMol::findProp(unsigned int owner,
+                                   std::string_view key) const {
+  PRECONDITION(owner + 1 < d_propStarts.size(), "bad index");
+  for (auto i = d_propStarts[owner]; i < d_propStarts[owner + 1]; ++i) {
+    if (d_propNames[d_props[i].name] == key) {
+      return &d_props[i].val;
+    }
+  }
+  return nullptr;
+}
+
+unsigned int FrozenMol::getNumAtomsWithHs() const {
+  unsigned int res = d_atoms.size();
+  for (const auto &atom : d_atoms) {
+    res += atom.getTotalNumHs();
+  }
+  return res;
+}
+
+unsigned int FrozenMol::getNumHeavyAtoms() const {
+  return std::count_if(d_atoms.begin(), d_atoms.end(), [](const auto &atom) {
+    return atom.atomicNum > 1;
+  });
+}
+
+unsigned int FrozenMol::getTotalNumHs(unsigned int atomIdx,
+                                      bool includeNeighbors) const {
+  PRECONDITION(atomIdx < d_atoms.size(), "bad atom index");
+  unsigned int res = d_atoms[atomIdx].getTotalNumHs();
+  if (includeNeighbors) {
+    for (const auto &nbr : getNeighbors(atomIdx)) {
+      res += d_atoms[nbr.atom].atomicNum == 1;
+    }
+  }
+  return res;
+}
+
+double FrozenMol::getMass(unsigned int atomIdx) const {
+  PRECONDITION(atomIdx < d_atoms.size(), "bad atom index");
+  const auto &atom = d_atoms[atomIdx];
+  if (atom.isotope) {
+    double res = PeriodicTable::getTable()->getMassForIsotope(atom.atomicNum,
+                                                              atom.isotope);
+    if (atom.atomicNum != 0 && res == 0.0) {
+      res = atom.isotope;
+    }
+    return res;
+  }
+  return PeriodicTable::getTable()->getAtomicWeight(atom.atomicNum);
+}
+
+int FrozenMol::getBondBetweenAtoms(unsigned int idx1, unsigned int idx2) const {
+  PRECONDITION(idx1 < d_atoms.size() && idx2 < d_atoms.size(),
+               "bad atom index");
+  for (const auto &nbr : getNeighbors(idx1)) {
+    if (nbr.atom == idx2) {
+      return nbr.bond;
+    }
+  }
+  return -1;
+}
+
+std::unique_ptr<RWMol> FrozenMol::toMol() const {
+  auto res = std::make_unique<RWMol>();
+  auto addProps = [&](RDProps &owner, unsigned int ownerIdx) {
+    auto &dict = owner.getDict();
+    for (auto i = d_propStarts[ownerIdx]; i < d_propStarts[ownerIdx + 1];
+         ++i) {
+      Dict::Pair pair(d_propNames[d_props[i].name]);
+      copy_rdvalue(pair.val, d_props[i].val);
+      dict.insert(std::move(pair));
+    }
+  };
+  addProps(*res, 0);
+
+  for (unsigned int i = 0; i < d_atoms.size(); ++i) {
+    const auto &data = d_atoms[i];
+    auto atom = new Atom(data.atomicNum);
+    atom->setIsotope(data.isotope);
+    atom->setFormalCharge(data.formalCharge);
+    atom->setNumExplicitHs(data.numExplicitHs);
+    atom->setNumRadicalElectrons(data.numRadicalElectrons);
+    atom->setHybridization(data.getHybridization());
+    atom->setChiralTag(data.getChiralTag());
+    atom->setIsAromatic(data.isAromatic);
+    atom->setNoImplicit(data.noImplicit);
+    addProps(*atom, 1 + i);
+    res->addAtom(atom, false, true);
+  }
+  for (unsigned int i = 0; i < d_bonds.size(); ++i) {
+    const auto &data = d_bonds[i];
+    res->addBond(data.beginAtom, data.endAtom, data.getBondType());
+    auto bond = res->getBondWithIdx(i);
+    bond->setBondDir(data.getBondDir());
+    bond->setIsAromatic(data.isAromatic);
+    bond->setIsConjugated(data.isConjugated);
+    if (data.stereoAtoms[0] >= 0) {
+      bond->getStereoAtoms() = {data.stereoAtoms[0], data.stereoAtoms[1]};
+    }
+    bond->setStereo(data.getStereo());
+    addProps(*bond, 1 + d_atoms.size() + i);
+  }
+
+  auto ringInfo = res->getRingInfo();
+  ringInfo->initialize(d_ringType);
+  for (unsigned int i = 0; i < numRings(); ++i) {
+    const auto ringAtoms = getRingAtoms(i);
+    const auto ringBonds = getRingBonds(i);
+    ringInfo->addRing(INT_VECT(ringAtoms.begin(), ringAtoms.end()),
+                      INT_VECT(ringBonds.begin(), ringBonds.end()));
+  }
+
+  for (unsigned int i = 0; i < d_confIds.size(); ++i) {
+    const auto positions = getPositions(i);
+    auto conf = new Conformer(d_atoms.size());
+    conf->setId(d_confIds[i]);
+    conf->set3D(d_confIs3D[i]);
+    std::copy(positions.begin(), positions.end(),
+              conf->getPositions().begin());
+    res->addConformer(conf, false);
+  }
+
+  res->updatePropertyCache(false);
+  return res;
+}
+
+}  // namespace RDKit
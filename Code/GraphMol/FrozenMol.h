@@ -0,0 +1,288 @@
+//
+//  Copyright (C) 2026 Greg Landrum and other RDKit contributors
+//
+//   @@ All Rights Reserved @@
+//  This file is part of the RDKit.
+//  The contents are covered by the terms of the BSD license
+//  which is included in the file license.txt, found at the root
+//  of the RDKit source tree.
+//
+
+/*! \file FrozenMol.h
+
+  A compact, read-only representation of a molecule for workloads that
+  store or scan many molecules without modifying them.
+
+*/
+#include <RDGeneral/export.h>
+#ifndef RD_FROZENMOL_H
+#define RD_FROZENMOL_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Geometry/point.h>
+#include <GraphMol/Atom.h>
+#include <GraphMol/Bond.h>
+#include <GraphMol/RingInfo.h>
+#include <RDGeneral/RDValue.h>
+
+namespace RDKit {
+class ROMol;
+class RWMol;
+
+//! An immutable molecule held in a few flat arrays
+/*!
+  The atoms and bonds are stored as small structs, the neighbors of the atoms
+  in compressed sparse row (CSR) form and the property names are interned, so
+  a FrozenMol needs much less memory than an ROMol and has no per-atom or
+  per-bond allocations.
+
+  What is kept:
+    - the atoms and bonds, including the computed implicit hydrogen counts
+    - the ring information, which is found if the molecule doesn't have it
+    - the conformers (but not their properties)
+    - the properties of the molecule, its atoms and its bonds, including the
+      computed ones
+
+  Query atoms and bonds, stereo groups, substance groups and monomer
+  information are not supported.
+
+  The property cache of the molecule must be up to date, e.g. it has been
+  sanitized.
+*/
+class RDKIT_GRAPHMOL_EXPORT FrozenMol {
+ public:
+  struct AtomData {
+    std::uint16_t isotope;
+    std::uint8_t atomicNum;
+    std::int8_t formalCharge;
+    std::uint8_t numExplicitHs;
+    std::uint8_t numImplicitHs;
+    std::uint8_t numRadicalElectrons;
+    std::uint8_t hybridization;
+    std::uint8_t chiralTag;
+    bool isAromatic;
+    bool noImplicit;
+
+    unsigned int getTotalNumHs() const { return numExplicitHs + numImplicitHs; }
+    Atom::HybridizationType getHybridization() const {
+      return static_cast<Atom::HybridizationType>(hybridization);
+    }
+    Atom::ChiralType getChiralTag() const {
+      return static_cast<Atom::ChiralType>(chiralTag);
+    }
+  };
+
+  struct BondData {
+    std::uint32_t beginAtom;
+    std::uint32_t endAtom;
+    //! the stereo atoms, -1 if there are none
+    std::int32_t stereoAtoms[2];
+    std::uint8_t bondType;
+    std::uint8_t bondDir;
+    std::uint8_t stereo;
+    bool isAromatic;
+    bool isConjugated;
+
+    Bond::BondType getBondType() const {
+      return static_cast<Bond::BondType>(bondType);
+    }
+    Bond::BondDir getBondDir() const {
+      return static_cast<Bond::BondDir>(bondDir);
+    }
+    Bond::BondStereo getStereo() const {
+      return static_cast<Bond::BondStereo>(stereo);
+    }
+    std::uint32_t getOtherAtomIdx(std::uint32_t idx) const {
+      return idx == beginAtom ? endAtom : beginAtom;
+    }
+  };
+
+  //! a neighboring atom and the bond to it
+  struct Neighbor {
+    std::uint32_t atom;
+    std::uint32_t bond;
+  };
+
+  //! a contiguous range of the elements of one of the arrays
+  template <typename T>
+  class Span {
+   public:
+    Span(const T *begin, const T *end) : d_begin(begin), d_end(end) {}
+    const T *begin() const { return d_begin; }
+    const T *end() const { return d_end; }
+    size_t size() const { return d_end - d_begin; }
+    bool empty() const { return d_begin == d_end; }
+    const T &operator[](size_t i) const { return d_begin[i]; }
+
+   private:
+    const T *d_begin;
+    const T *d_end;
+  };
+
+  explicit FrozenMol(const ROMol &mol);
+  FrozenMol(const FrozenMol &other);
+  FrozenMol &operator=(const FrozenMol &other);
+  FrozenMol(FrozenMol &&other) noexcept = default;
+  FrozenMol &operator=(FrozenMol &&other) noexcept;
+  ~FrozenMol();
+
+  //! Returns an RWMol with the atoms, bonds, properties, ring information
+  //! and conformers of this molecule
+  std::unique_ptr<RWMol> toMol() const;
+
+  unsigned int getNumAtoms() const { return d_atoms.size(); }
+  unsigned int getNumBonds() const { return d_bonds.size(); }
+  //! the number of atoms plus the number of implicit and explicit hydrogens
+  unsigned int getNumAtomsWithHs() const;
+  unsigned int getNumHeavyAtoms() const;
+
+  const AtomData &getAtom(unsigned int idx) const { return d_atoms[idx]; }
+  const BondData &getBond(unsigned int idx) const { return d_bonds[idx]; }
+  const std::vector<AtomData> &atoms() const { return d_atoms; }
+  const std::vector<BondData> &bonds() const { return d_bonds; }
+
+  //! the neighbors of an atom, in the order of ROMol::atomBonds()
+  Span<Neighbor> getNeighbors(unsigned int atomIdx) const {
+    return {d_neighbors.data() + d_neighborStarts[atomIdx],
+            d_neighbors.data() + d_neighborStarts[atomIdx + 1]};
+  }
+  unsigned int getDegree(unsigned int atomIdx) const {
+    return d_neighborStarts[atomIdx + 1] - d_neighborStarts[atomIdx];
+  }
+  unsigned int getTotalDegree(unsigned int atomIdx) const {
+    return getDegree(atomIdx) + d_atoms[atomIdx].getTotalNumHs();
+  }
+  //! the hydrogens on an atom, including any neighbors that are hydrogens
+  unsigned int getTotalNumHs(unsigned int atomIdx,
+                             bool includeNeighbors = false) const;
+  //! the mass of an atom, the same as Atom::getMass()
+  double getMass(unsigned int atomIdx) const;
+  //! returns the index of the bond between two atoms, -1 if there is none
+  int getBondBetweenAtoms(unsigned int idx1, unsigned int idx2) const;
+
+  //! \name Rings
+  //! @{
+  FIND_RING_TYPE getRingType() const { return d_ringType; }
+  unsigned int numRings() const { return d_ringStarts.size() - 1; }
+  Span<std::uint32_t> getRingAtoms(unsigned int ringIdx) const {
+    return {d_ringAtoms.data() + d_ringStarts[ringIdx],
+            d_ringAtoms.data() + d_ringStarts[ringIdx + 1]};
+  }
+  //! the bonds of a ring, in the order of RingInfo::bondRings()
+  Span<std::uint32_t> getRingBonds(unsigned int ringIdx) const {
+    return {d_ringBonds.data() + d_ringStarts[ringIdx],
+            d_ringBonds.data() + d_ringStarts[ringIdx + 1]};
+  }
+  unsigned int numAtomRings(unsigned int atomIdx) const {
+    return d_numAtomRings[atomIdx];
+  }
+  unsigned int numBondRings(unsigned int bondIdx) const {
+    return d_numBondRings[bondIdx];
+  }
+  //! @}
+
+  //! \name Conformers
+  //! @{
+  unsigned int getNumConformers() const { return d_confIds.size(); }
+  unsigned int getConformerId(unsigned int confIdx) const {
+    return d_confIds[confIdx];
+  }
+  bool getConformerIs3D(unsigned int confIdx) const {
+    return d_confIs3D[confIdx];
+  }
+  //! the positions of the atoms in a conformer, in atom order
+  Span<RDGeom::Point3D> getPositions(unsigned int confIdx) const {
+    const auto start = d_positions.data() + confIdx * d_atoms.size();
+    return {start, start + d_atoms.size()};
+  }
+  //! @}
+
+  //! \name Properties
+  //! @{
+  //! every property name used by the molecule, its atoms or its bonds
+  const std::vector<std::string> &getPropNames() const { return d_propNames; }
+
+  bool hasProp(std::string_view key) const {
+    return findProp(0, key) != nullptr;
+  }
+  bool hasAtomProp(unsigned int atomIdx, std::string_view key) const {
+    return findProp(1 + atomIdx, key) != nullptr;
+  }
+  bool hasBondProp(unsigned int bondIdx, std::string_view key) const {
+    return findProp(1 + d_atoms.size() + bondIdx, key) != nullptr;
+  }
+  template <typename T>
+  bool getPropIfPresent(std::string_view key, T &res) const {
+    return getValue(findProp(0, key), res);
+  }
+  template <typename T>
+  bool getAtomPropIfPresent(unsigned int atomIdx, std::string_view key,
+                            T &res) const {
+    return getValue(findProp(1 + atomIdx, key), res);
+  }
+  template <typename T>
+  bool getBondPropIfPresent(unsigned int bondIdx, std::string_view key,
+                            T &res) const {
+    return getValue(findProp(1 + d_atoms.size() + bondIdx, key), res);
+  }
+  //! @}
+
+ private:
+  //! a property value and the index of its name in d_propNames
+  struct Property {
+    std::uint32_t name;
+    RDValue val;
+  };
+
+  //! owners are numbered: the molecule, then the atoms, then the bonds
+  const RDValue *findProp(unsigned int owner, std::string_view key) const;
+  template <typename T>
+  static bool getValue(const RDValue *val, T &res) {
+    if (!val) {
+      return false;
+    }
+    res = from_rdvalue<T>(*val);
+    return true;
+  }
+  static bool getValue(const RDValue *val, std::string &res) {
+    if (!val) {
+      return false;
+    }
+    rdvalue_tostring(*val, res);
+    return true;
+  }
+  void copyProps(const FrozenMol &other);
+  void clearProps();
+
+  std::vector<AtomData> d_atoms;
+  std::vector<BondData> d_bonds;
+  std::vector<std::uint32_t> d_neighborStarts;
+  std::vector<Neighbor> d_neighbors;
+
+  FIND_RING_TYPE d_ringType{FIND_RING_TYPE::FIND_RING_TYPE_OTHER_OR_UNKNOWN};
+  std::vector<std::uint32_t> d_ringStarts;
+  std::vector<std::uint32_t> d_ringAtoms;
+  std::vector<std::uint32_t> d_ringBonds;
+  std::vector<std::uint16_t> d_numAtomRings;
+  std::vector<std::uint16_t> d_numBondRings;
+
+  std::vector<unsigned int> d_confIds;
+  std::vector<bool> d_confIs3D;
+  //! the positions of each conformer, conformer by conformer
+  std::vector<RDGeom::Point3D> d_positions;
+
+  std::vector<std::string> d_propNames;
+  //! the properties of owner i are d_props[d_propStarts[i]] to
+  //! d_props[d_propStarts[i + 1]]
+  std::vector<std::uint32_t> d_propStarts;
+  std::vector<Property> d_props;
+};
+
+}  // namespace RDKit
+
+#endif
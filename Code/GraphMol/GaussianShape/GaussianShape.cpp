@@ -31,10 +31,7 @@
 namespace RDKit {
 namespace GaussianShape {
 
-namespace {
-// Compute final overlay transform, which applies fitShape's
-// initial canonical transformation, followed by the overlay transform and
-// finally the inverse of refShape's initial canonical transformation.
+namespace details {
 RDGeom::Transform3D computeFinalTransform(
     const std::array<double, 3> &inRefTrans,
     const std::array<double, 9> &inRefRot,
@@ -76,12 +73,30 @@ RDGeom::Transform3D computeFinalTransform(
   return finalTransform;
 }
 
+std::unique_ptr<SingleConformerAlignment> makeAligner(
+    const ShapeView &ref, const ShapeView &fit,
+    const std::array<double, 7> &quatTrans,
+    const ShapeOverlayOptions &overlayOpts) {
+  return std::make_unique<SingleConformerAlignment>(
+      ref.coords, ref.alphas, ref.types, ref.carbonRadii, ref.numAtoms,
+      ref.numFeats, ref.shapeVol, ref.colorVol, fit.coords, fit.alphas,
+      fit.types, fit.carbonRadii, fit.numAtoms, fit.numFeats, fit.shapeVol,
+      fit.colorVol, quatTrans, overlayOpts.optimMode, overlayOpts.simAlpha,
+      overlayOpts.simBeta, overlayOpts.optParam, overlayOpts.useDistCutoff,
+      overlayOpts.distCutoff, overlayOpts.shapeConvergenceCriterion,
+      overlayOpts.nSteps);
+}
+}  // namespace details
+
+namespace {
+
 // Return the original transformation quaternion for the given index.
 // Different optimisation modes have different numbers of starting
 // orientations to try. In order these are no transformation, rotate 180
 // degrees about each axis and rotate +/- 45 degrees about 2 axes at a time.
 std::array<double, 4> getInitialRotationPlain(
-    int index, const ShapeInput &refShape, const ShapeInput &fitShape,
+    int index, const details::ShapeView &refShape,
+    const details::ShapeView &fitShape,
     const RDGeom::Point3D &refDisp, const ShapeOverlayOptions &overlayOpts,
     double &score) {
   static const double sinpi_4 = std::sin(std::numbers::pi / 4.0);
@@ -98,19 +113,8 @@ std::array<double, 4> getInitialRotationPlain(
   const std::array<double, 7> quatTrans{
       quats[index][0], quats[index][1], quats[index][2], quats[index][3],
       refDisp[0],      refDisp[1],      refDisp[2]};
-  SingleConformerAlignment sca(
-      refShape.getCoords(), refShape.getAlphas(),
-      refShape.getFeatureTypes().data(), refShape.getCarbonRadii(),
-      refShape.getNumAtoms(), refShape.getNumFeatures(),
-      refShape.getShapeVolume(), refShape.getColorVolume(),
-      fitShape.getCoords(), fitShape.getAlphas(),
-      fitShape.getFeatureTypes().data(), fitShape.getCarbonRadii(),
-      fitShape.getNumAtoms(), fitShape.getNumFeatures(),
-      fitShape.getShapeVolume(), fitShape.getColorVolume(), quatTrans,
-      overlayOpts.optimMode, overlayOpts.simAlpha, overlayOpts.simBeta,
-      overlayOpts.optParam, overlayOpts.useDistCutoff, overlayOpts.distCutoff,
-      overlayOpts.shapeConvergenceCriterion, overlayOpts.nSteps);
-  const auto scores = sca.calcScores(useColor);
+  auto sca = details::makeAligner(refShape, fitShape, quatTrans, overlayOpts);
+  const auto scores = sca->calcScores(useColor);
   score = scores[0];
   return quats[index];
 }
@@ -120,7 +124,8 @@ std::array<double, 4> getInitialRotationPlain(
 // add +/ ~25 degrees from that.  It is not revealed where that
 // angle comes from.
 std::array<double, 4> getInitialRotationWiggle(
-    int index, const ShapeInput &refShape, const ShapeInput &fitShape,
+    int index, const details::ShapeView &refShape,
+    const details::ShapeView &fitShape,
     const RDGeom::Point3D &refDisp, const ShapeOverlayOptions &overlayOpts,
     double &score) {
   const static double qrot1 = 0.977659114061,
@@ -147,25 +152,15 @@ std::array<double, 4> getInitialRotationWiggle(
   double bestScore = 0.0;
   bool useColor = overlayOpts.optimMode != OptimMode::SHAPE_ONLY;
   std::array<double, 7> tmpQuatTrans{1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
-  SingleConformerAlignment sca(
-      refShape.getCoords(), refShape.getAlphas(),
-      refShape.getFeatureTypes().data(), refShape.getCarbonRadii(),
-      refShape.getNumAtoms(), refShape.getNumFeatures(),
-      refShape.getShapeVolume(), refShape.getColorVolume(),
-      fitShape.getCoords(), fitShape.getAlphas(),
-      fitShape.getFeatureTypes().data(), fitShape.getCarbonRadii(),
-      fitShape.getNumAtoms(), fitShape.getNumFeatures(),
-      fitShape.getShapeVolume(), fitShape.getColorVolume(), tmpQuatTrans,
-      overlayOpts.optimMode, overlayOpts.simAlpha, overlayOpts.simBeta,
-      overlayOpts.optParam, overlayOpts.useDistCutoff, overlayOpts.distCutoff,
-      overlayOpts.shapeConvergenceCriterion, overlayOpts.nSteps);
+  auto sca =
+      details::makeAligner(refShape, fitShape, tmpQuatTrans, overlayOpts);
 
   for (unsigned int i = start_quat; i < start_quat + 7; ++i) {
     std::array<double, 7> quatTrans{quats[i][0], quats[i][1], quats[i][2],
                                     quats[i][3], refDisp[0],  refDisp[1],
                                     refDisp[2]};
-    sca.setQuatTrans(quatTrans);
-    auto scores = sca.calcScores(useColor);
+    sca->setQuatTrans(quatTrans);
+    auto scores = sca->calcScores(useColor);
     if (scores[0] > bestScore) {
       bestScore = scores[0];
       bestQuat = i;
@@ -177,11 +172,12 @@ std::array<double, 4> getInitialRotationWiggle(
 
 // Return the translation that puts the extreme of refShape at the
 // extreme of the fitShape along the appropriate axis.
-RDGeom::Point3D getInitialTranslation(int index, ShapeInput &refShape,
-                                      ShapeInput fitShape) {
-  auto getDisp = [](ShapeInput &shape, size_t i) -> RDGeom::Point3D {
-    const double *coord =
-        shape.getCoords().data() + shape.calcExtremes()[i] * 3;
+RDGeom::Point3D getInitialTranslation(int index,
+                                      const details::ShapeView &refShape,
+                                      const details::ShapeView &fitShape) {
+  auto getDisp = [](const details::ShapeView &shape,
+                    size_t i) -> RDGeom::Point3D {
+    const double *coord = shape.coords + shape.extremes[i] * 3;
     return RDGeom::Point3D(coord[0], coord[1], coord[2]);
   };
   RDGeom::Point3D disp;
@@ -252,12 +248,12 @@ unsigned int calculateQrat(const std::array<double, 3> &eigenValues) {
   return qrat;
 }
 
-StartMode decideStartModeFromEigenValues(const ShapeInput &refShape,
-                                         const ShapeInput &fitShape) {
+StartMode decideStartModeFromEigenValues(const details::ShapeView &refShape,
+                                         const details::ShapeView &fitShape) {
   // The PubChem code uses the moments of inertia for this, rather than the
   // canonical transformation.
-  const auto rqratwf = calculateQrat(refShape.calcMomentsOfInertia(true));
-  const auto fqratwf = calculateQrat(fitShape.calcMomentsOfInertia(true));
+  const auto rqratwf = calculateQrat(refShape.momentsOfInertia);
+  const auto fqratwf = calculateQrat(fitShape.momentsOfInertia);
   StartMode startModeWF{StartMode::ROTATE_180_WIGGLE};
   if (rqratwf > 0 || fqratwf > 0) {
     startModeWF = StartMode::ROTATE_45;
@@ -265,14 +261,50 @@ StartMode decideStartModeFromEigenValues(const ShapeInput &refShape,
   return startModeWF;
 }
 
-std::array<double, 3> alignShape(ShapeInput &refShape, ShapeInput &fitShape,
-                                 RDGeom::Transform3D &bestXform,
+bool isFragmentStartMode(StartMode startMode) {
+  return startMode == StartMode::ROTATE_0_FRAGMENT ||
+         startMode == StartMode::ROTATE_45_FRAGMENT ||
+         startMode == StartMode::ROTATE_180_FRAGMENT;
+}
+
+// Fill in a view of the active shape of shape, computing the moments of
+// inertia and extremes only if the overlay options need them.
+details::ShapeView makeShapeView(ShapeInput &shape,
                                  const ShapeOverlayOptions &overlayOpts) {
-  unsigned int finalRotIndex = 1;
-  auto startMode = overlayOpts.startMode;
-  if (startMode == StartMode::A_LA_PUBCHEM) {
-    startMode = decideStartModeFromEigenValues(refShape, fitShape);
+  details::ShapeView view;
+  view.coords = shape.getCoords().data();
+  view.alphas = shape.getAlphas().data();
+  view.types = shape.getFeatureTypes().data();
+  view.carbonRadii = shape.getCarbonRadii();
+  view.numAtoms = shape.getNumAtoms();
+  view.numFeats = shape.getNumFeatures();
+  view.shapeVol = shape.getShapeVolume();
+  view.colorVol = shape.getColorVolume();
+  if (overlayOpts.startMode == StartMode::A_LA_PUBCHEM) {
+    view.momentsOfInertia = shape.calcMomentsOfInertia(true);
   }
+  if (isFragmentStartMode(overlayOpts.startMode)) {
+    view.extremes = shape.calcExtremes();
+  }
+  return view;
+}
+}  // namespace
+
+namespace details {
+StartMode resolveStartMode(const ShapeView &refShape, const ShapeView &fitShape,
+                           const ShapeOverlayOptions &overlayOpts) {
+  if (overlayOpts.startMode == StartMode::A_LA_PUBCHEM) {
+    return decideStartModeFromEigenValues(refShape, fitShape);
+  }
+  return overlayOpts.startMode;
+}
+
+std::array<double, 3> alignShapeViews(const ShapeView &refShape,
+                                      const ShapeView &fitShape,
+                                      RDGeom::Transform3D &bestXform,
+                                      const ShapeOverlayOptions &overlayOpts) {
+  unsigned int finalRotIndex = 1;
+  const auto startMode = resolveStartMode(refShape, fitShape, overlayOpts);
 
   switch (startMode) {
     case StartMode::ROTATE_0:
@@ -291,9 +323,7 @@ std::array<double, 3> alignShape(ShapeInput &refShape, ShapeInput &fitShape,
       break;
   }
   unsigned int finalTransIndex = 1;
-  if (startMode == StartMode::ROTATE_0_FRAGMENT ||
-      startMode == StartMode::ROTATE_45_FRAGMENT ||
-      startMode == StartMode::ROTATE_180_FRAGMENT) {
+  if (isFragmentStartMode(startMode)) {
     finalTransIndex = 7;
   }
 
@@ -319,19 +349,8 @@ std::array<double, 3> alignShape(ShapeInput &refShape, ShapeInput &fitShape,
       }
       std::array<double, 7> initQuat{quat[0],   quat[1],   quat[2],  quat[3],
                                      refDisp.x, refDisp.y, refDisp.z};
-      aligners.emplace_back(std::make_unique<SingleConformerAlignment>(
-          refShape.getCoords(), refShape.getAlphas(),
-          refShape.getFeatureTypes().data(), refShape.getCarbonRadii(),
-          refShape.getNumAtoms(), refShape.getNumFeatures(),
-          refShape.getShapeVolume(), refShape.getColorVolume(),
-          fitShape.getCoords(), fitShape.getAlphas(),
-          fitShape.getFeatureTypes().data(), fitShape.getCarbonRadii(),
-          fitShape.getNumAtoms(), fitShape.getNumFeatures(),
-          fitShape.getShapeVolume(), fitShape.getColorVolume(), initQuat,
-          overlayOpts.optimMode, overlayOpts.simAlpha, overlayOpts.simBeta,
-          overlayOpts.optParam, overlayOpts.useDistCutoff,
-          overlayOpts.distCutoff, overlayOpts.shapeConvergenceCriterion,
-          overlayOpts.nSteps));
+      aligners.emplace_back(
+          makeAligner(refShape, fitShape, initQuat, overlayOpts));
       bestScoreForStart.push_back({score, k});
     }
   }
@@ -365,7 +384,7 @@ std::array<double, 3> alignShape(ShapeInput &refShape, ShapeInput &fitShape,
   }
   return bestScore;
 }
-}  // namespace
+}  // namespace details
 
 std::array<double, 3> AlignShape(const ShapeInput &refShape,
                                  ShapeInput &fitShape,
@@ -401,14 +420,15 @@ std::array<double, 3> AlignShape(const ShapeInput &refShape,
   }
 
   RDGeom::Transform3D bestXform;
-  const auto scores =
-      alignShape(*workingRefShape, *workingFitShape, bestXform, overlayOpts);
+  const auto scores = details::alignShapeViews(
+      makeShapeView(*workingRefShape, overlayOpts),
+      makeShapeView(*workingFitShape, overlayOpts), bestXform, overlayOpts);
   if (!overlayOpts.normalize) {
     // Shove it back again.
     bestXform = moveFromOrigin * bestXform * moveToOrigin;
   } else {
-    bestXform = computeFinalTransform(inRefTrans, inRefRot, inFitTrans,
-                                      inFitRot, bestXform);
+    bestXform = details::computeFinalTransform(inRefTrans, inRefRot,
+                                               inFitTrans, inFitRot, bestXform);
   }
   fitShape.transformCoords(bestXform);
   if (xform) {
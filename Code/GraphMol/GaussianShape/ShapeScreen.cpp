@@ -0,0 +1,400 @@
+//
+//  Copyright (C) 2026 David Cosgrove and other RDKit contributors
+//
+//   @@ All Rights Reserved @@
+//  This file is part of the RDKit.
+//  The contents are covered by the terms of the BSD license
+//  which is included in the file license.txt, found at the root
+//  of the RDKit source tree.
+//
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+#include <GraphMol/GaussianShape/ShapeScreen.h>
+#include <GraphMol/GaussianShape/SingleConformerAlignment.h>
+#include <RDGeneral/BadFileException.h>
+#include <RDGeneral/Exceptions.h>
+#include <RDGeneral/Invariant.h>
+#include <RDGeneral/RDThreads.h>
+#include <RDGeneral/StreamOps.h>
+
+#ifdef RDK_BUILD_THREADSAFE_SSS
+#include <thread>
+#endif
+
+namespace RDKit {
+namespace GaussianShape {
+
+namespace {
+constexpr std::uint32_t shapeLibraryMagic = 0x53484c42;  // "SHLB"
+constexpr std::uint32_t shapeLibraryVersion = 1;
+
+// The per-item arrays are written little-endian, which on the usual hosts
+// means in one go.
+template <typename T>
+void writeBlock(std::ostream &os, const T *data, size_t n) {
+  if constexpr (HOST_ENDIAN_ORDER == LITTLE_ENDIAN_ORDER) {
+    os.write(reinterpret_cast<const char *>(data), n * sizeof(T));
+  } else {
+    for (size_t i = 0; i < n; ++i) {
+      streamWrite(os, data[i]);
+    }
+  }
+}
+
+template <typename T>
+void readBlock(std::istream &is, T *data, size_t n) {
+  if constexpr (HOST_ENDIAN_ORDER == LITTLE_ENDIAN_ORDER) {
+    is.read(reinterpret_cast<char *>(data), n * sizeof(T));
+  } else {
+    for (size_t i = 0; i < n; ++i) {
+      streamRead(is, data[i]);
+    }
+  }
+  if (is.fail()) {
+    throw ValueErrorException("Shape library stream is truncated.");
+  }
+}
+
+template <typename T>
+void writeVector(std::ostream &os, const std::vector<T> &vec) {
+  std::uint64_t n = vec.size();
+  streamWrite(os, n);
+  writeBlock(os, vec.data(), vec.size());
+}
+
+template <typename T, size_t N>
+void writeVector(std::ostream &os, const std::vector<std::array<T, N>> &vec) {
+  std::uint64_t n = vec.size();
+  streamWrite(os, n);
+  for (const auto &arr : vec) {
+    writeBlock(os, arr.data(), N);
+  }
+}
+
+template <typename T>
+void readVector(std::istream &is, std::vector<T> &vec) {
+  std::uint64_t n = 0;
+  streamRead(is, n);
+  if (is.fail()) {
+    throw ValueErrorException("Shape library stream is truncated.");
+  }
+  vec.resize(n);
+  readBlock(is, vec.data(), vec.size());
+}
+
+template <typename T, size_t N>
+void readVector(std::istream &is, std::vector<std::array<T, N>> &vec) {
+  std::uint64_t n = 0;
+  streamRead(is, n);
+  if (is.fail()) {
+    throw ValueErrorException("Shape library stream is truncated.");
+  }
+  vec.resize(n);
+  for (auto &arr : vec) {
+    readBlock(is, arr.data(), N);
+  }
+}
+}  // namespace
+
+ShapeLibrary::ShapeLibrary(std::istream &is) { read(is); }
+
+ShapeLibrary::ShapeLibrary(const std::string &fileName) {
+  std::ifstream ifs(fileName, std::ios_base::binary);
+  if (!ifs) {
+    throw BadFileException("Could not open shape library file " + fileName);
+  }
+  read(ifs);
+}
+
+unsigned int ShapeLibrary::addShapes(const ShapeInput &shapes,
+                                     unsigned int id) {
+  const auto firstIdx = size();
+  ShapeInput working(shapes);
+  const auto numPoints = working.getNumAtoms() + working.getNumFeatures();
+  for (unsigned int i = 0; i < working.getNumShapes(); ++i) {
+    working.setActiveShape(i);
+    d_canonTranss.push_back(working.calcCanonicalTranslation());
+    d_canonRots.push_back(working.calcCanonicalRotation());
+    if (!working.getIsNormalized()) {
+      working.normalizeCoords();
+    }
+    const auto &coords = working.getCoords();
+    PRECONDITION(coords.size() == 3 * numPoints, "Bad number of coordinates.");
+    d_coords.insert(d_coords.end(), coords.begin(), coords.end());
+    d_alphas.insert(d_alphas.end(), working.getAlphas().begin(),
+                    working.getAlphas().begin() + numPoints);
+    d_types.insert(d_types.end(), working.getFeatureTypes().begin(),
+                   working.getFeatureTypes().begin() + numPoints);
+    // The carbon radii flags are only relevant to the atoms, but are stored
+    // for the features as well to keep the per-point arrays in step.
+    const auto carbonRadii = working.getCarbonRadii();
+    d_hasCarbonRadii.push_back(carbonRadii != nullptr);
+    for (unsigned int j = 0; j < numPoints; ++j) {
+      d_carbonRadii.push_back(carbonRadii && j < working.getNumAtoms() &&
+                              (*carbonRadii)[j]);
+    }
+    d_pointOffsets.push_back(d_pointOffsets.back() + numPoints);
+    d_ids.push_back(id);
+    d_shapeNums.push_back(i);
+    d_numAtoms.push_back(working.getNumAtoms());
+    d_numFeats.push_back(working.getNumFeatures());
+    d_shapeVols.push_back(working.getShapeVolume());
+    d_colorVols.push_back(working.getColorVolume());
+    d_momentsOfInertia.push_back(working.calcMomentsOfInertia(true));
+    std::array<unsigned int, 6> extremes;
+    std::ranges::copy(working.calcExtremes(), extremes.begin());
+    d_extremes.push_back(extremes);
+  }
+  return firstIdx;
+}
+
+unsigned int ShapeLibrary::getId(unsigned int idx) const {
+  URANGE_CHECK(idx, size());
+  return d_ids[idx];
+}
+
+unsigned int ShapeLibrary::getShapeNum(unsigned int idx) const {
+  URANGE_CHECK(idx, size());
+  return d_shapeNums[idx];
+}
+
+unsigned int ShapeLibrary::getNumAtoms(unsigned int idx) const {
+  URANGE_CHECK(idx, size());
+  return d_numAtoms[idx];
+}
+
+unsigned int ShapeLibrary::getNumFeatures(unsigned int idx) const {
+  URANGE_CHECK(idx, size());
+  return d_numFeats[idx];
+}
+
+double ShapeLibrary::getShapeVolume(unsigned int idx) const {
+  URANGE_CHECK(idx, size());
+  return d_shapeVols[idx];
+}
+
+double ShapeLibrary::getColorVolume(unsigned int idx) const {
+  URANGE_CHECK(idx, size());
+  return d_colorVols[idx];
+}
+
+const double *ShapeLibrary::getCoords(unsigned int idx) const {
+  URANGE_CHECK(idx, size());
+  return d_coords.data() + 3 * d_pointOffsets[idx];
+}
+
+void ShapeLibrary::getShapeView(unsigned int idx, details::ShapeView &view,
+                                boost::dynamic_bitset<> &carbonRadii) const {
+  const auto offset = d_pointOffsets[idx];
+  view.coords = d_coords.data() + 3 * offset;
+  view.alphas = d_alphas.data() + offset;
+  view.types = d_types.data() + offset;
+  view.numAtoms = d_numAtoms[idx];
+  view.numFeats = d_numFeats[idx];
+  view.shapeVol = d_shapeVols[idx];
+  view.colorVol = d_colorVols[idx];
+  view.momentsOfInertia = d_momentsOfInertia[idx];
+  std::ranges::copy(d_extremes[idx], view.extremes.begin());
+  view.carbonRadii = nullptr;
+  if (d_hasCarbonRadii[idx]) {
+    carbonRadii.resize(view.numAtoms);
+    for (unsigned int i = 0; i < view.numAtoms; ++i) {
+      carbonRadii[i] = d_carbonRadii[offset + i];
+    }
+    view.carbonRadii = &carbonRadii;
+  }
+}
+
+void ShapeLibrary::write(std::ostream &os) const {
+  streamWrite(os, shapeLibraryMagic);
+  streamWrite(os, shapeLibraryVersion);
+  writeVector(os, d_coords);
+  writeVector(os, d_alphas);
+  writeVector(os, d_types);
+  writeVector(os, d_carbonRadii);
+  writeVector(os, d_pointOffsets);
+  writeVector(os, d_ids);
+  writeVector(os, d_shapeNums);
+  writeVector(os, d_numAtoms);
+  writeVector(os, d_numFeats);
+  writeVector(os, d_hasCarbonRadii);
+  writeVector(os, d_shapeVols);
+  writeVector(os, d_colorVols);
+  writeVector(os, d_momentsOfInertia);
+  writeVector(os, d_extremes);
+  writeVector(os, d_canonRots);
+  writeVector(os, d_canonTranss);
+}
+
+void ShapeLibrary::write(const std::string &fileName) const {
+  std::ofstream ofs(fileName, std::ios_base::binary);
+  if (!ofs) {
+    throw BadFileException("Could not open shape library file " + fileName +
+                           " for writing");
+  }
+  write(ofs);
+}
+
+void ShapeLibrary::read(std::istream &is) {
+  std::uint32_t magic = 0, version = 0;
+  streamRead(is, magic);
+  streamRead(is, version);
+  if (is.fail() || magic != shapeLibraryMagic) {
+    throw ValueErrorException("Stream does not contain a shape library.");
+  }
+  if (version != shapeLibraryVersion) {
+    throw ValueErrorException("Unsupported shape library version " +
+                              std::to_string(version));
+  }
+  readVector(is, d_coords);
+  readVector(is, d_alphas);
+  readVector(is, d_types);
+  readVector(is, d_carbonRadii);
+  readVector(is, d_pointOffsets);
+  readVector(is, d_ids);
+  readVector(is, d_shapeNums);
+  readVector(is, d_numAtoms);
+  readVector(is, d_numFeats);
+  readVector(is, d_hasCarbonRadii);
+  readVector(is, d_shapeVols);
+  readVector(is, d_colorVols);
+  readVector(is, d_momentsOfInertia);
+  readVector(is, d_extremes);
+  readVector(is, d_canonRots);
+  readVector(is, d_canonTranss);
+
+  const auto n = d_ids.size();
+  if (d_pointOffsets.size() != n + 1 || d_shapeNums.size() != n ||
+      d_numAtoms.size() != n || d_numFeats.size() != n ||
+      d_hasCarbonRadii.size() != n || d_shapeVols.size() != n ||
+      d_colorVols.size() != n || d_momentsOfInertia.size() != n ||
+      d_extremes.size() != n || d_canonRots.size() != n ||
+      d_canonTranss.size() != n) {
+    throw ValueErrorException("Inconsistent shape library.");
+  }
+  const auto numPoints = d_pointOffsets.back();
+  if (d_coords.size() != 3 * numPoints || d_alphas.size() != numPoints ||
+      d_types.size() != numPoints || d_carbonRadii.size() != numPoints) {
+    throw ValueErrorException("Inconsistent shape library.");
+  }
+}
+
+ShapeScreener::ShapeScreener(const ShapeInput &refShape,
+                             const ShapeOverlayOptions &overlayOpts)
+    : d_refShape(refShape, refShape.getActiveShape()),
+      d_overlayOpts(overlayOpts) {
+  PRECONDITION(overlayOpts.normalize,
+               "Shape screening requires normalized shapes.");
+  d_refCanonTrans = d_refShape.calcCanonicalTranslation();
+  d_refCanonRot = d_refShape.calcCanonicalRotation();
+  if (!d_refShape.getIsNormalized()) {
+    d_refShape.normalizeCoords();
+  }
+  d_refMomentsOfInertia = d_refShape.calcMomentsOfInertia(true);
+  d_refExtremes = d_refShape.calcExtremes();
+}
+
+void ShapeScreener::getRefShapeView(details::ShapeView &view) const {
+  view.coords = d_refShape.getCoords().data();
+  view.alphas = d_refShape.getAlphas().data();
+  view.types = d_refShape.getFeatureTypes().data();
+  view.carbonRadii = d_refShape.getCarbonRadii();
+  view.numAtoms = d_refShape.getNumAtoms();
+  view.numFeats = d_refShape.getNumFeatures();
+  view.shapeVol = d_refShape.getShapeVolume();
+  view.colorVol = d_refShape.getColorVolume();
+  view.momentsOfInertia = d_refMomentsOfInertia;
+  view.extremes = d_refExtremes;
+}
+
+double ShapeScreener::maxPossibleScore(const ShapeLibrary &library,
+                                       unsigned int idx) const {
+  return maxScore(d_refShape.getShapeVolume(), library.getShapeVolume(idx),
+                  d_refShape.getColorVolume(), library.getColorVolume(idx),
+                  d_overlayOpts);
+}
+
+ShapeScreenResult ShapeScreener::screenOne(const ShapeLibrary &library,
+                                           unsigned int idx) const {
+  URANGE_CHECK(idx, library.size());
+  details::ShapeView refView;
+  getRefShapeView(refView);
+  boost::dynamic_bitset<> carbonRadii;
+  return screenOne(library, idx, refView, carbonRadii);
+}
+
+ShapeScreenResult ShapeScreener::screenOne(
+    const ShapeLibrary &library, unsigned int idx,
+    const details::ShapeView &refView,
+    boost::dynamic_bitset<> &carbonRadii) const {
+  details::ShapeView fitView;
+  library.getShapeView(idx, fitView, carbonRadii);
+  ShapeScreenResult res;
+  res.index = idx;
+  res.id = library.d_ids[idx];
+  res.shapeNum = library.d_shapeNums[idx];
+  RDGeom::Transform3D ovXform;
+  res.scores =
+      details::alignShapeViews(refView, fitView, ovXform, d_overlayOpts);
+  res.xform = details::computeFinalTransform(
+      d_refCanonTrans, d_refCanonRot, library.d_canonTranss[idx],
+      library.d_canonRots[idx], ovXform);
+  return res;
+}
+
+std::vector<ShapeScreenResult> ShapeScreener::screen(
+    const ShapeLibrary &library, double threshold, int numThreads) const {
+  details::ShapeView refView;
+  getRefShapeView(refView);
+
+  auto screenBlock = [&](unsigned int tidx, unsigned int nthreads,
+                         std::vector<ShapeScreenResult> &results) {
+    boost::dynamic_bitset<> carbonRadii;
+    for (unsigned int idx = tidx; idx < library.size(); idx += nthreads) {
+      // The volumes give a cheap upper bound on the score.
+      if (threshold > 0.0 && maxPossibleScore(library, idx) < threshold) {
+        continue;
+      }
+      auto res = screenOne(library, idx, refView, carbonRadii);
+      if (res.scores[0] >= threshold) {
+        results.push_back(std::move(res));
+      }
+    }
+  };
+
+  std::vector<ShapeScreenResult> results;
+  const auto nthreads = getNumThreadsToUse(numThreads);
+#ifdef RDK_BUILD_THREADSAFE_SSS
+  if (nthreads > 1) {
+    std::vector<std::vector<ShapeScreenResult>> threadResults(nthreads);
+    std::vector<std::thread> tg;
+    for (unsigned int ti = 0; ti < nthreads; ++ti) {
+      tg.emplace_back(screenBlock, ti, nthreads, std::ref(threadResults[ti]));
+    }
+    for (auto &thread : tg) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+    for (auto &tres : threadResults) {
+      std::ranges::move(tres, std::back_inserter(results));
+    }
+  } else
+#endif
+  {
+    screenBlock(0, 1, results);
+  }
+  std::ranges::sort(results, [](const auto &r1, const auto &r2) -> bool {
+    if (r1.scores[0] != r2.scores[0]) {
+      return r1.scores[0] > r2.scores[0];
+    }
+    return r1.index < r2.index;
+  });
+  return results;
+}
+
+}  // namespace GaussianShape
+}  // namespace RDKit
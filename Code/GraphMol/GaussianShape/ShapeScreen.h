@@ -0,0 +1,178 @@
+//
+//  Copyright (C) 2026 David Cosgrove and other RDKit contributors
+//
+//   @@ All Rights Reserved @@
+//  This file is part of the RDKit.
+//  The contents are covered by the terms of the BSD license
+//  which is included in the file license.txt, found at the root
+//  of the RDKit source tree.
+//
+// Screening of a library of shapes against a single reference shape.
+// It is experimental code and the API and/or results may change in future
+// releases.
+
+#ifndef RDKIT_SHAPESCREEN_GUARD
+#define RDKIT_SHAPESCREEN_GUARD
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <RDGeneral/export.h>
+#include <Geometry/Transform3D.h>
+#include <GraphMol/GaussianShape/ShapeInput.h>
+#include <GraphMol/GaussianShape/ShapeOverlayOptions.h>
+
+#include <RDGeneral/BoostStartInclude.h>
+#include <boost/dynamic_bitset.hpp>
+#include <RDGeneral/BoostEndInclude.h>
+
+namespace RDKit {
+namespace GaussianShape {
+namespace details {
+struct ShapeView;
+}
+
+//! A library of shapes for screening, in a compact form.
+/*!
+  Each shape (a single conformer of a ShapeInput) is stored normalized, i.e.
+  centred on the origin with its principal axes along the cartesian axes,
+  together with everything the overlay needs that would otherwise be
+  recomputed for every alignment (volumes, moments of inertia, extremes and
+  the canonical transformation). The data for all shapes is held in a
+  handful of flat arrays rather than one object per shape.
+
+  The library can be written to and read back from a binary stream, so it
+  only needs to be built once.
+*/
+class RDKIT_GAUSSIANSHAPE_EXPORT ShapeLibrary {
+ public:
+  ShapeLibrary() = default;
+  //! Construct the library from a stream written by write().
+  explicit ShapeLibrary(std::istream &is);
+  //! Construct the library from a file written by write().
+  explicit ShapeLibrary(const std::string &fileName);
+
+  //! Add all the shapes in shapes to the library, tagged with the given id.
+  //! Returns the index of the first of them in the library.
+  unsigned int addShapes(const ShapeInput &shapes, unsigned int id);
+
+  //! The number of shapes in the library.
+  unsigned int size() const { return d_ids.size(); }
+  bool empty() const { return d_ids.empty(); }
+  //! The id passed to addShapes() for the shape.
+  unsigned int getId(unsigned int idx) const;
+  //! The number of the shape in the ShapeInput it came from.
+  unsigned int getShapeNum(unsigned int idx) const;
+  unsigned int getNumAtoms(unsigned int idx) const;
+  unsigned int getNumFeatures(unsigned int idx) const;
+  double getShapeVolume(unsigned int idx) const;
+  double getColorVolume(unsigned int idx) const;
+  //! The normalized coordinates of the shape's atoms and features
+  const double *getCoords(unsigned int idx) const;
+
+  //! Write the library to a binary stream.
+  void write(std::ostream &os) const;
+  //! Write the library to a binary file.
+  void write(const std::string &fileName) const;
+
+ private:
+  friend class ShapeScreener;
+  // Fill in view with the data for shape idx.  carbonRadii is used as
+  // storage for the carbon radii flags, if the shape has them.
+  void getShapeView(unsigned int idx, details::ShapeView &view,
+                    boost::dynamic_bitset<> &carbonRadii) const;
+  void read(std::istream &is);
+
+  // Per point (atoms and features) data
+  std::vector<double> d_coords;
+  std::vector<double> d_alphas;
+  std::vector<int> d_types;
+  std::vector<std::uint8_t> d_carbonRadii;
+  // Per shape data.  d_pointOffsets has one more entry than there are
+  // shapes.
+  std::vector<std::uint64_t> d_pointOffsets{0};
+  std::vector<unsigned int> d_ids;
+  std::vector<unsigned int> d_shapeNums;
+  std::vector<unsigned int> d_numAtoms;
+  std::vector<unsigned int> d_numFeats;
+  std::vector<std::uint8_t> d_hasCarbonRadii;
+  std::vector<double> d_shapeVols;
+  std::vector<double> d_colorVols;
+  std::vector<std::array<double, 3>> d_momentsOfInertia;
+  std::vector<std::array<unsigned int, 6>> d_extremes;
+  std::vector<std::array<double, 9>> d_canonRots;
+  std::vector<std::array<double, 3>> d_canonTranss;
+};
+
+struct RDKIT_GAUSSIANSHAPE_EXPORT ShapeScreenResult {
+  unsigned int index{0};     //! The index of the shape in the library
+  unsigned int id{0};        //! The id of the shape in the library
+  unsigned int shapeNum{0};  //! The shape number within that id
+  std::array<double, 3> scores{
+      0.0, 0.0, 0.0};  //! The combination, shape and color scores, as
+                       //! returned by AlignShape()
+  RDGeom::Transform3D xform;  //! The transformation that overlays the
+                              //! original shape onto the reference
+};
+
+//! Overlays a library of shapes onto a single reference shape.
+/*!
+  The reference is set up (normalized etc.) once, when the screener is
+  created. Shapes whose maximum possible score, from the volumes alone, is
+  below the threshold are rejected without being aligned.
+
+  The scores are the same as those from AlignShape() for the same two
+  shapes.
+
+  <b>Notes:</b>
+    - The overlay options must have normalize set.
+*/
+class RDKIT_GAUSSIANSHAPE_EXPORT ShapeScreener {
+ public:
+  //! @param refShape: the reference.  Its current active shape is used.
+  //! @param overlayOpts: options for the overlays
+  explicit ShapeScreener(
+      const ShapeInput &refShape,
+      const ShapeOverlayOptions &overlayOpts = ShapeOverlayOptions());
+
+  //! Overlay all shapes in the library onto the reference.
+  //! @param library: the shapes to screen
+  //! @param threshold: only shapes with a combination score at least this
+  //!                   are returned.  The default -1.0 returns everything.
+  //! @param numThreads: the number of threads to use.  Uses the usual
+  //!                    RDKit convention where values <= 0 mean use all
+  //!                    available threads less that number.
+  //! @return the results, sorted in descending order of combination score
+  std::vector<ShapeScreenResult> screen(const ShapeLibrary &library,
+                                        double threshold = -1.0,
+                                        int numThreads = 1) const;
+
+  //! Overlay a single shape in the library onto the reference.
+  ShapeScreenResult screenOne(const ShapeLibrary &library,
+                              unsigned int idx) const;
+
+  //! The upper bound on the combination score for the library shape,
+  //! from the volumes alone.
+  double maxPossibleScore(const ShapeLibrary &library, unsigned int idx) const;
+
+ private:
+  ShapeScreenResult screenOne(const ShapeLibrary &library, unsigned int idx,
+                              const details::ShapeView &refView,
+                              boost::dynamic_bitset<> &carbonRadii) const;
+  void getRefShapeView(details::ShapeView &view) const;
+
+  ShapeInput d_refShape;
+  ShapeOverlayOptions d_overlayOpts;
+  std::array<double, 3> d_refCanonTrans;
+  std::array<double, 9> d_refCanonRot;
+  std::array<double, 3> d_refMomentsOfInertia;
+  std::array<size_t, 6> d_refExtremes;
+};
+
+}  // namespace GaussianShape
+}  // namespace RDKit
+
+#endif  // RDKIT_SHAPESCREEN_GUARD
@@ -35,16 +35,39 @@ SingleConformerAlignment::SingleConformerAlignment(
     const std::array<double, 7> &initQuatTrans, OptimMode optimMode,
     double simAlpha, double simBeta, double mixingParam, bool useCutoff,
     double distCutoff, double shapeConvergenceCriterion, unsigned int maxIts)
-    : d_ref(ref),
-      d_refAlphas(refAlphas),
+    : SingleConformerAlignment(
+          ref.data(), refAlphas.data(), refTypes, refCarbonRadii, nRefShape,
+          nRefColor, refShapeVol, refColorVol, fit.data(), fitAlphas.data(),
+          fitTypes, fitCarbonRadii, nFitShape, nFitColor, fitShapeVol,
+          fitColorVol, initQuatTrans, optimMode, simAlpha, simBeta,
+          mixingParam, useCutoff, distCutoff, shapeConvergenceCriterion,
+          maxIts) {
+  PRECONDITION(ref.size() == 3 * static_cast<size_t>(nRefShape + nRefColor),
+               "Wrong number of reference coordinates.");
+  PRECONDITION(fit.size() == 3 * static_cast<size_t>(nFitShape + nFitColor),
+               "Wrong number of fit coordinates.");
+}
+
+SingleConformerAlignment::SingleConformerAlignment(
+    const double *ref, const double *refAlphas, const int *refTypes,
+    const boost::dynamic_bitset<> *refCarbonRadii, int nRefShape,
+    int nRefColor, double refShapeVol, double refColorVol, const double *fit,
+    const double *fitAlphas, const int *fitTypes,
+    const boost::dynamic_bitset<> *fitCarbonRadii, int nFitShape,
+    int nFitColor, double fitShapeVol, double fitColorVol,
+    const std::array<double, 7> &initQuatTrans, OptimMode optimMode,
+    double simAlpha, double simBeta, double mixingParam, bool useCutoff,
+    double distCutoff, double shapeConvergenceCriterion, unsigned int maxIts)
+    : d_ref(ref, ref + 3 * (nRefShape + nRefColor)),
+      d_refAlphas(refAlphas, refAlphas + nRefShape + nRefColor),
       d_refTypes(refTypes),
       d_refCarbonRadii(refCarbonRadii),
       d_nRefShape(nRefShape),
       d_nRefColor(nRefColor),
       d_refShapeVol(refShapeVol),
       d_refColorVol(refColorVol),
-      d_fit(fit),
-      d_fitAlphas(fitAlphas),
+      d_fit(fit, fit + 3 * (nFitShape + nFitColor)),
+      d_fitAlphas(fitAlphas, fitAlphas + nFitShape + nFitColor),
       d_fitTypes(fitTypes),
       d_fitCarbonRadii(fitCarbonRadii),
       d_nFitShape(nFitShape),
@@ -19,6 +19,7 @@
 #define RDKIT_SINGLECONFORMERALIGNMENT_GUARD
 
 #include <array>
+#include <memory>
 
 #include <RDGeneral/BoostStartInclude.h>
 #include <boost/dynamic_bitset.hpp>
@@ -72,6 +73,19 @@ struct RDKIT_GAUSSIANSHAPE_EXPORT SingleConformerAlignment {
       const std::array<double, 7> &initQuatTrans, OptimMode optimMode,
       double simAlpha, double simBeta, double mixingParam, bool useCutoff,
       double distCutoff, double shapeConvergenceCriterion, unsigned int maxIts);
+  /// @brief As above, but with the coordinates and alphas passed as raw
+  /// arrays of 3 * (nShape + nColor) and (nShape + nColor) entries
+  /// respectively.  They are copied, as in the other constructor.
+  SingleConformerAlignment(
+      const double *ref, const double *refAlphas, const int *refTypes,
+      const boost::dynamic_bitset<> *refCarbonRadii, int nRefShape,
+      int nRefColor, double refShapeVol, double refColorVol, const double *fit,
+      const double *fitAlphas, const int *fitTypes,
+      const boost::dynamic_bitset<> *fitCarbonRadii, int nFitShape,
+      int nFitColor, double fitShapeVol, double fitColorVol,
+      const std::array<double, 7> &initQuatTrans, OptimMode optimMode,
+      double simAlpha, double simBeta, double mixingParam, bool useCutoff,
+      double distCutoff, double shapeConvergenceCriterion, unsigned int maxIts);
 
   SingleConformerAlignment(const SingleConformerAlignment &other) = delete;
   SingleConformerAlignment(SingleConformerAlignment &&other) = delete;
@@ -204,6 +218,52 @@ RDKIT_GAUSSIANSHAPE_EXPORT double calcVolAndGrads(
     std::vector<double> &gradConverters, const bool useCutoff,
     const double distCutoff2, const double *quat, double *gradients);
 
+namespace details {
+// A non-owning description of a single shape, which is all the overlay
+// code needs.  momentsOfInertia (including color features) is only used for
+// StartMode::A_LA_PUBCHEM and extremes only for the fragment start modes.
+struct ShapeView {
+  const double *coords{nullptr};
+  const double *alphas{nullptr};
+  const int *types{nullptr};
+  const boost::dynamic_bitset<> *carbonRadii{nullptr};
+  unsigned int numAtoms{0};
+  unsigned int numFeats{0};
+  double shapeVol{0.0};
+  double colorVol{0.0};
+  std::array<double, 3> momentsOfInertia{0.0, 0.0, 0.0};
+  std::array<size_t, 6> extremes{0, 0, 0, 0, 0, 0};
+};
+
+// Make a SingleConformerAlignment for the two shapes.
+std::unique_ptr<SingleConformerAlignment> makeAligner(
+    const ShapeView &ref, const ShapeView &fit,
+    const std::array<double, 7> &quatTrans,
+    const ShapeOverlayOptions &overlayOpts);
+
+// The start mode that will actually be used for overlaying fit onto ref,
+// i.e. with StartMode::A_LA_PUBCHEM resolved.
+StartMode resolveStartMode(const ShapeView &ref, const ShapeView &fit,
+                           const ShapeOverlayOptions &overlayOpts);
+
+// Overlay fit onto ref, both of which are assumed to be in the frame the
+// overlay is to be done in (normalized, usually).  Returns the scores, and
+// the transformation of fit onto ref in that frame in bestXform.
+std::array<double, 3> alignShapeViews(const ShapeView &ref,
+                                      const ShapeView &fit,
+                                      RDGeom::Transform3D &bestXform,
+                                      const ShapeOverlayOptions &overlayOpts);
+
+// Compute final overlay transform, which applies fitShape's
+// initial canonical transformation, followed by the overlay transform and
+// finally the inverse of refShape's initial canonical transformation.
+RDGeom::Transform3D computeFinalTransform(
+    const std::array<double, 3> &inRefTrans,
+    const std::array<double, 9> &inRefRot,
+    const std::array<double, 3> &inFitTrans,
+    const std::array<double, 9> &inFitRot, const RDGeom::Transform3D &ovXform);
+}  // namespace details
+
 }  // namespace GaussianShape
 }  // namespace RDKit
 
@@ -13,6 +13,7 @@
 
 #include <chrono>
 #include <random>
+#include <sstream>
 #include <algorithm>
 #include <execution>
 
@@ -25,6 +26,7 @@
 #include <GraphMol/FileParsers/MolSupplier.h>
 #include <GraphMol/GaussianShape/GaussianShape.h>
 #include <GraphMol/GaussianShape/ShapeInput.h>
+#include <GraphMol/GaussianShape/ShapeScreen.h>
 #include <GraphMol/MolTransforms/MolTransforms.h>
 #include <GraphMol/SmilesParse/SmilesWrite.h>
 #include <RDGeneral/RDLog.h>
@@ -1071,4 +1073,108 @@ TEST_CASE("github #9441: problem with explicit Hs") {
     auto scores = GaussianShape::AlignMolecule(*m1, *m2);
     CHECK_THAT(scores[0], Catch::Matchers::WithinAbs(0.4197, 0.0001));
   }
-}
\ No newline at end of file
+}
+TEST_CASE("Shape screening") {
+  std::string dirName = getenv("RDBASE");
+  dirName += "/Code/GraphMol/GaussianShape/test_data";
+  auto esomeprazole = loadConformers(dirName + "/esomeprazole_multi.smi");
+  auto ranit = loadConformers(dirName + "/ranitidine_multi.smi");
+  auto suppl = v2::FileParsers::SDMolSupplier(dirName + "/test1.sdf");
+
+  GaussianShape::ShapeLibrary library;
+  std::vector<GaussianShape::ShapeInput> fitShapes;
+  fitShapes.emplace_back(*ranit);
+  fitShapes.emplace_back(*esomeprazole);
+  for (unsigned int i = 0; i < 2; ++i) {
+    auto mol = suppl[i];
+    REQUIRE(mol);
+    fitShapes.emplace_back(*mol, -1);
+  }
+  for (unsigned int i = 0; i < fitShapes.size(); ++i) {
+    auto firstIdx = library.size();
+    CHECK(library.addShapes(fitShapes[i], i + 10) == firstIdx);
+  }
+  CHECK(library.size() == 22);
+  CHECK(library.getId(0) == 10);
+  CHECK(library.getShapeNum(3) == 3);
+  CHECK(library.getId(21) == 13);
+
+  GaussianShape::ShapeInput refShape(*esomeprazole, 8);
+  GaussianShape::ShapeScreener screener(refShape);
+
+  SECTION("same as AlignShape") {
+    unsigned int idx = 0;
+    for (auto &fitShape : fitShapes) {
+      for (unsigned int j = 0; j < fitShape.getNumShapes(); ++j, ++idx) {
+        fitShape.setActiveShape(j);
+        auto fitCp = GaussianShape::ShapeInput(fitShape, j);
+        RDGeom::Transform3D xform;
+        auto scores = GaussianShape::AlignShape(refShape, fitCp, &xform);
+        auto res = screener.screenOne(library, idx);
+        CHECK(res.index == idx);
+        CHECK_THAT(res.scores[0], Catch::Matchers::WithinAbs(scores[0], 1e-6));
+        CHECK_THAT(res.scores[1], Catch::Matchers::WithinAbs(scores[1], 1e-6));
+        CHECK_THAT(res.scores[2], Catch::Matchers::WithinAbs(scores[2], 1e-6));
+        for (unsigned int k = 0; k < 4; ++k) {
+          for (unsigned int l = 0; l < 4; ++l) {
+            CHECK_THAT(res.xform.getVal(k, l),
+                       Catch::Matchers::WithinAbs(xform.getVal(k, l), 1e-6));
+          }
+        }
+        CHECK(screener.maxPossibleScore(library, idx) + 1.0e-6 >=
+              res.scores[0]);
+      }
+    }
+  }
+
+  SECTION("screening and threshold") {
+    auto results = screener.screen(library);
+    REQUIRE(results.size() == library.size());
+    CHECK(std::ranges::is_sorted(results, [](const auto &r1, const auto &r2) {
+      return r1.scores[0] > r2.scores[0];
+    }));
+    // The reference itself is in the library.
+    CHECK(results.front().id == 11);
+    CHECK_THAT(results.front().scores[0],
+               Catch::Matchers::WithinAbs(1.0, 0.001));
+
+    auto threshold = results[5].scores[0];
+    auto tresults = screener.screen(library, threshold);
+    REQUIRE(tresults.size() >= 6);
+    for (unsigned int i = 0; i < tresults.size(); ++i) {
+      CHECK(tresults[i].index == results[i].index);
+      CHECK(tresults[i].scores == results[i].scores);
+    }
+    CHECK(screener.screen(library, 1.1).empty());
+  }
+
+#ifdef RDK_BUILD_THREADSAFE_SSS
+  SECTION("multithreaded") {
+    auto results = screener.screen(library, 0.3);
+    auto mtresults = screener.screen(library, 0.3, 4);
+    REQUIRE(mtresults.size() == results.size());
+    for (unsigned int i = 0; i < results.size(); ++i) {
+      CHECK(mtresults[i].index == results[i].index);
+      CHECK(mtresults[i].scores == results[i].scores);
+    }
+  }
+#endif
+
+  SECTION("serialization") {
+    std::stringstream ss(std::ios_base::in | std::ios_base::out |
+                         std::ios_base::binary);
+    library.write(ss);
+    GaussianShape::ShapeLibrary library2(ss);
+    REQUIRE(library2.size() == library.size());
+    for (unsigned int i = 0; i < library.size(); ++i) {
+      CHECK(library2.getId(i) == library.getId(i));
+      CHECK(library2.getNumAtoms(i) == library.getNumAtoms(i));
+      CHECK(library2.getShapeVolume(i) == library.getShapeVolume(i));
+      auto res1 = screener.screenOne(library, i);
+      auto res2 = screener.screenOne(library2, i);
+      CHECK(res1.scores == res2.scores);
+    }
+    std::stringstream bad("not a shape library");
+    CHECK_THROWS_AS(GaussianShape::ShapeLibrary(bad), ValueErrorException);
+  }
+}
@@ -12,6 +12,7 @@
 #include <Numerics/Vector.h>
 #include <GraphMol/Substruct/SubstructMatch.h>
 #include <GraphMol/Conformer.h>
+#include <GraphMol/ConformerEnsemble.h>
 #include <GraphMol/ROMol.h>
 #include <GraphMol/QueryOps.h>
 #include <GraphMol/QueryBond.h>
@@ -372,6 +373,239 @@ std::vector<double> getAllConformerBestRMS(const ROMol &mol,
   return res;
 }
 
+namespace {
+// the weighted inner products of the centered probe and reference points
+// which are needed by QCP: the sums of squared norms (gPrb, gRef) and the
+// correlation matrix M = sum_i w_i * prb_i * ref_i^T (row major)
+void getQCPInnerProducts(const double *prbCoords, const double *refCoords,
+                         const MatchVectType &match, const double *weights,
+                         double &gPrb, double &gRef, double M[9]) {
+  double prbCtr[3] = {0.0, 0.0, 0.0};
+  double refCtr[3] = {0.0, 0.0, 0.0};
+  double wtsSum = 0.0;
+  for (unsigned int i = 0; i < match.size(); ++i) {
+    const double w = weights ? weights[i] : 1.0;
+    const double *prb = prbCoords + 3 * match[i].first;
+    const double *ref = refCoords + 3 * match[i].second;
+    for (unsigned int k = 0; k < 3; ++k) {
+      prbCtr[k] += w * prb[k];
+      refCtr[k] += w * ref[k];
+    }
+    wtsSum += w;
+  }
+  for (unsigned int k = 0; k < 3; ++k) {
+    prbCtr[k] /= wtsSum;
+    refCtr[k] /= wtsSum;
+  }
+
+  gPrb = 0.0;
+  gRef = 0.0;
+  std::fill(M, M + 9, 0.0);
+  for (unsigned int i = 0; i < match.size(); ++i) {
+    const double w = weights ? weights[i] : 1.0;
+    const double *prb = prbCoords + 3 * match[i].first;
+    const double *ref = refCoords + 3 * match[i].second;
+    const double px = prb[0] - prbCtr[0];
+    const double py = prb[1] - prbCtr[1];
+    const double pz = prb[2] - prbCtr[2];
+    const double rx = ref[0] - refCtr[0];
+    const double ry = ref[1] - refCtr[1];
+    const double rz = ref[2] - refCtr[2];
+    gPrb += w * (px * px + py * py + pz * pz);
+    gRef += w * (rx * rx + ry * ry + rz * rz);
+    const double wpx = w * px;
+    const double wpy = w * py;
+    const double wpz = w * pz;
+    M[0] += wpx * rx;
+    M[1] += wpx * ry;
+    M[2] += wpx * rz;
+    M[3] += wpy * rx;
+    M[4] += wpy * ry;
+    M[5] += wpy * rz;
+    M[6] += wpz * rx;
+    M[7] += wpz * ry;
+    M[8] += wpz * rz;
+  }
+}
+
+// Finds the largest eigenvalue of the QCP key matrix built from the
+// correlation matrix M by Newton iteration on its characteristic polynomial,
+// starting from the upper bound E0 = (gPrb + gRef) / 2.
+// The iterates decrease monotonically towards the eigenvalue, so they are
+// all upper bounds on it: as soon as one of them drops below minLambda the
+// iteration is abandoned and that value is returned.
+double getQCPMaxEigenvalue(const double M[9], double E0, double minLambda) {
+  const double Sxx = M[0], Sxy = M[1], Sxz = M[2];
+  const double Syx = M[3], Syy = M[4], Syz = M[5];
+  const double Szx = M[6], Szy = M[7], Szz = M[8];
+
+  const double Sxx2 = Sxx * Sxx, Syy2 = Syy * Syy, Szz2 = Szz * Szz;
+  const double Sxy2 = Sxy * Sxy, Syz2 = Syz * Syz, Sxz2 = Sxz * Sxz;
+  const double Syx2 = Syx * Syx, Szy2 = Szy * Szy, Szx2 = Szx * Szx;
+
+  const double SyzSzymSyySzz2 = 2.0 * (Syz * Szy - Syy * Szz);
+  const double Sxx2Syy2Szz2Syz2Szy2 = Syy2 + Szz2 - Sxx2 + Syz2 + Szy2;
+
+  const double C2 =
+      -2.0 * (Sxx2 + Syy2 + Szz2 + Sxy2 + Syx2 + Sxz2 + Szx2 + Syz2 + Szy2);
+  const double C1 = 8.0 * (Sxx * Syz * Szy + Syy * Szx * Sxz +
+                           Szz * Sxy * Syx - Sxx * Syy * Szz -
+                           Syz * Szx * Sxy - Szy * Syx * Sxz);
+
+  const double SxzpSzx = Sxz + Szx;
+  const double SyzpSzy = Syz + Szy;
+  const double SxypSyx = Sxy + Syx;
+  const double SyzmSzy = Syz - Szy;
+  const double SxzmSzx = Sxz - Szx;
+  const double SxymSyx = Sxy - Syx;
+  const double SxxpSyy = Sxx + Syy;
+  const double SxxmSyy = Sxx - Syy;
+  const double Sxy2Sxz2Syx2Szx2 = Sxy2 + Sxz2 - Syx2 - Szx2;
+
+  const double C0 =
+      Sxy2Sxz2Syx2Szx2 * Sxy2Sxz2Syx2Szx2 +
+      (Sxx2Syy2Szz2Syz2Szy2 + SyzSzymSyySzz2) *
+          (Sxx2Syy2Szz2Syz2Szy2 - SyzSzymSyySzz2) +
+      (-SxzpSzx * SyzmSzy + SxymSyx * (SxxmSyy - Szz)) *
+          (-SxzmSzx * SyzpSzy + SxymSyx * (SxxmSyy + Szz)) +
+      (-SxzpSzx * SyzpSzy - SxypSyx * (SxxpSyy - Szz)) *
+          (-SxzmSzx * SyzmSzy - SxypSyx * (SxxpSyy + Szz)) +
+      (SxypSyx * SyzpSzy + SxzpSzx * (SxxmSyy + Szz)) *
+          (-SxymSyx * SyzmSzy + SxzpSzx * (SxxpSyy + Szz)) +
+      (SxypSyx * SyzmSzy + SxzmSzx * (SxxmSyy - Szz)) *
+          (-SxymSyx * SyzpSzy + SxzmSzx * (SxxpSyy - Szz));
+
+  const double evalPrec = 1e-11;
+  const unsigned int maxIters = 50;
+  double lambda = E0;
+  for (unsigned int iter = 0; iter < maxIters; ++iter) {
+    const double oldLambda = lambda;
+    const double x2 = lambda * lambda;
+    const double b = (x2 + C2) * lambda;
+    const double a = b + C1;
+    const double denom = 2.0 * x2 * lambda + b + a;
+    if (denom == 0.0) {
+      break;
+    }
+    lambda -= (a * lambda + C0) / denom;
+    if (lambda < minLambda ||
+        fabs(lambda - oldLambda) < fabs(evalPrec * lambda)) {
+      break;
+    }
+  }
+  return lambda;
+}
+
+// the best RMSD between two conformers over all mappings in matches.
+// Returns infinity if that is larger than threshold (when threshold > 0)
+double getBestQCPRMS(const double *prbCoords, const double *refCoords,
+                     const std::vector<MatchVectType> &matches,
+                     const double *weights, double threshold) {
+  const double inf = std::numeric_limits<double>::infinity();
+  const double msdCut = threshold > 0.0 ? threshold * threshold : inf;
+  double msdBest = inf;
+  double M[9];
+  for (const auto &match : matches) {
+    double gPrb, gRef;
+    getQCPInnerProducts(prbCoords, refCoords, match, weights, gPrb, gRef, M);
+    const auto npt = static_cast<double>(match.size());
+    // this mapping is only of interest if its MSD is below both the cutoff
+    // and the best value found so far, i.e. if the eigenvalue is above:
+    const double maxMSD = std::min(msdBest, msdCut);
+    const double minLambda =
+        maxMSD == inf ? -inf : 0.5 * (gPrb + gRef - maxMSD * npt);
+    // Cauchy-Schwarz gives a cheap upper bound on the eigenvalue
+    if (sqrt(gPrb * gRef) < minLambda) {
+      continue;
+    }
+    const double lambda =
+        getQCPMaxEigenvalue(M, 0.5 * (gPrb + gRef), minLambda);
+    if (lambda < minLambda) {
+      continue;
+    }
+    const double msd = std::max(0.0, (gPrb + gRef - 2.0 * lambda) / npt);
+    if (msd < msdBest) {
+      msdBest = msd;
+    }
+  }
+  if (msdBest > msdCut) {
+    return inf;
+  }
+  return sqrt(msdBest);
+}
+}  // namespace
+
+std::vector<double> getConformerRMSMatrix(
+    const ROMol &mol, const ConformerEnsembleT<double> &ensemble,
+    const BestAlignmentParams &params, double threshold) {
+  PRECONDITION(ensemble.getNumAtoms() == mol.getNumAtoms(),
+               "atom count mismatch");
+  auto numThreads = getNumThreadsToUse(params.numThreads);
+  std::vector<MatchVectType> allMatches;
+  if (params.map.empty()) {
+    getAllMatchesPrbRef(mol, mol, allMatches, params.maxMatches,
+                        params.symmetrizeConjugatedTerminalGroups,
+                        params.ignoreHs);
+  }
+  const auto &matches = params.map.empty() ? allMatches : params.map;
+  const double *weights = nullptr;
+  if (params.weights) {
+    for (const auto &match : matches) {
+      PRECONDITION(match.size() == params.weights->size(),
+                   "Mismatch in number of weights");
+    }
+    weights = params.weights->getData();
+  }
+  for (const auto &match : matches) {
+    PRECONDITION(!match.empty(), "empty atom mapping");
+    for (const auto &mi : match) {
+      PRECONDITION(mi.first >= 0 && mi.second >= 0 &&
+                       rdcast<unsigned int>(mi.first) < mol.getNumAtoms() &&
+                       rdcast<unsigned int>(mi.second) < mol.getNumAtoms(),
+                   "bad atom index in mapping");
+    }
+  }
+
+  const auto nconfs = ensemble.getNumConformers();
+  std::vector<double> res(nconfs * (nconfs - (nconfs ? 1 : 0)) / 2);
+  auto func = [&](unsigned int tidx, unsigned int nthreads) {
+    size_t idx = 0;
+    for (auto ci = 0u; ci < nconfs; ++ci) {
+      for (auto cj = 0u; cj < ci; ++cj, ++idx) {
+        if (idx % nthreads != tidx) {
+          continue;
+        }
+        res[idx] = getBestQCPRMS(ensemble.getCoords(ci), ensemble.getCoords(cj),
+                                 matches, weights, threshold);
+      }
+    }
+  };
+#ifdef RDK_BUILD_THREADSAFE_SSS
+  if (numThreads > 1) {
+    std::vector<std::thread> tg;
+    for (auto ti = 0u; ti < numThreads; ++ti) {
+      tg.emplace_back(std::thread(func, ti, numThreads));
+    }
+    for (auto &thread : tg) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+  } else
+#endif
+  {
+    func(0, 1);
+  }
+  return res;
+}
+
+std::vector<double> getConformerRMSMatrix(const ROMol &mol,
+                                          const BestAlignmentParams &params,
+                                          double threshold) {
+  ConformerEnsembleT<double> ensemble(mol);
+  return getConformerRMSMatrix(mol, ensemble, params, threshold);
+}
+
 double CalcRMS(ROMol &prbMol, const ROMol &refMol, int prbCid, int refCid,
                const std::vector<MatchVectType> &map, int maxMatches,
                bool symmetrizeConjugatedTerminalGroups,
@@ -474,5 +708,92 @@ void alignMolConformers(ROMol &mol, const std::vector<unsigned int> *atomIds,
     }
   }
 }
+
+namespace {
+template <typename T>
+void fillEnsemblePositions(const ConformerEnsembleT<T> &ensemble,
+                           unsigned int idx,
+                           const std::vector<unsigned int> *atomIds,
+                           RDGeom::POINT3D_VECT &pts) {
+  const auto *coords = ensemble.getCoords(idx);
+  if (atomIds == nullptr) {
+    pts.resize(ensemble.getNumAtoms());
+    for (auto &pt : pts) {
+      pt.x = *coords++;
+      pt.y = *coords++;
+      pt.z = *coords++;
+    }
+  } else {
+    pts.resize(atomIds->size());
+    for (unsigned int i = 0; i < atomIds->size(); ++i) {
+      const auto *atomCoords = coords + 3 * (*atomIds)[i];
+      pts[i].x = atomCoords[0];
+      pts[i].y = atomCoords[1];
+      pts[i].z = atomCoords[2];
+    }
+  }
+}
+
+template <typename T>
+void alignEnsemble(ConformerEnsembleT<T> &ensemble,
+                   const std::vector<unsigned int> *atomIds,
+                   const RDNumeric::DoubleVector *weights, bool reflect,
+                   unsigned int maxIters, std::vector<double> *RMSlist) {
+  if (ensemble.getNumConformers() == 0) {
+    // nothing to be done ;
+    return;
+  }
+  if (atomIds) {
+    for (auto aid : *atomIds) {
+      URANGE_CHECK(aid, ensemble.getNumAtoms());
+    }
+  }
+  // the points are copied into these buffers once per conformer, the
+  // pointer vectors needed by AlignPoints() stay valid throughout
+  RDGeom::POINT3D_VECT refPts, prbPts;
+  fillEnsemblePositions(ensemble, 0, atomIds, refPts);
+  prbPts.resize(refPts.size());
+  RDGeom::Point3DConstPtrVect refPoints, prbPoints;
+  for (unsigned int i = 0; i < refPts.size(); ++i) {
+    refPoints.push_back(&refPts[i]);
+    prbPoints.push_back(&prbPts[i]);
+  }
+
+  RDGeom::Transform3D trans;
+  for (unsigned int ci = 1; ci < ensemble.getNumConformers(); ++ci) {
+    fillEnsemblePositions(ensemble, ci, atomIds, prbPts);
+    auto ssd = RDNumeric::Alignments::AlignPoints(refPoints, prbPoints, trans,
+                                                  weights, reflect, maxIters);
+    if (RMSlist) {
+      ssd /= (prbPoints.size());
+      RMSlist->push_back(sqrt(ssd));
+    }
+    auto *coords = ensemble.getCoords(ci);
+    for (unsigned int ai = 0; ai < ensemble.getNumAtoms(); ++ai, coords += 3) {
+      RDGeom::Point3D pt(coords[0], coords[1], coords[2]);
+      trans.TransformPoint(pt);
+      coords[0] = static_cast<T>(pt.x);
+      coords[1] = static_cast<T>(pt.y);
+      coords[2] = static_cast<T>(pt.z);
+    }
+  }
+}
+}  // namespace
+
+void alignConformerEnsemble(ConformerEnsembleT<double> &ensemble,
+                            const std::vector<unsigned int> *atomIds,
+                            const RDNumeric::DoubleVector *weights,
+                            bool reflect, unsigned int maxIters,
+                            std::vector<double> *RMSlist) {
+  alignEnsemble(ensemble, atomIds, weights, reflect, maxIters, RMSlist);
+}
+
+void alignConformerEnsemble(ConformerEnsembleT<float> &ensemble,
+                            const std::vector<unsigned int> *atomIds,
+                            const RDNumeric::DoubleVector *weights,
+                            bool reflect, unsigned int maxIters,
+                            std::vector<double> *RMSlist) {
+  alignEnsemble(ensemble, atomIds, weights, reflect, maxIters, RMSlist);
+}
 }  // namespace MolAlign
 }  // namespace RDKit
@@ -21,6 +21,8 @@ typedef std::vector<std::pair<int, int>> MatchVectType;
 class Conformer;
 class ROMol;
 class RWMol;
+template <typename CoordType>
+class ConformerEnsembleT;
 namespace MolAlign {
 class RDKIT_MOLALIGN_EXPORT MolAlignException : public std::exception {
  public:
@@ -319,6 +321,44 @@ inline std::vector<double> getAllConformerBestRMS(
                                ignoreHs, numThreads, map, weights});
 }
 
+//! Returns the symmetric RMSD matrix between the conformers of a molecule.
+/*!
+  This computes the same values as getAllConformerBestRMS(), but is
+  intended for large conformer ensembles (e.g. pruning after embedding):
+    - the symmetry mappings are determined once for the whole molecule
+    - the optimal RMSD for each mapping is obtained directly from the
+      inner products of the coordinates using the QCP method (Theobald,
+      Acta Cryst. A61:478 (2005); Liu et al., J. Comput. Chem. 31:1561
+      (2010)), no rotation matrices or transforms are built
+    - conformer pairs are distributed over \c params.numThreads threads
+
+  If \c threshold is positive, pairs whose RMSD is larger than the
+  threshold are not computed exactly: the Newton iteration used to find the
+  RMSD for a mapping produces a decreasing sequence of upper bounds on the
+  best superposition, so work on a mapping (and on a pair) stops as soon as
+  it is clear that the RMSD will not be below the threshold. These pairs
+  are reported as \c std::numeric_limits<double>::infinity().
+
+  \param mol        the molecule to be considered
+  \param params     parameters for the matching
+  \param threshold  (optional) RMSD threshold, see above
+
+  <b>Returns</b>
+  a vector with the RMSD values stored in the order:
+    [(1,0), (2,0), (2,1), (3,0), (3, 2), (3,1), ...]
+*/
+RDKIT_MOLALIGN_EXPORT std::vector<double> getConformerRMSMatrix(
+    const ROMol &mol, const BestAlignmentParams &params,
+    double threshold = -1.0);
+//! \overload
+/*!
+  the coordinates are taken from \c ensemble, which must have the same number
+  of atoms as \c mol.
+*/
+RDKIT_MOLALIGN_EXPORT std::vector<double> getConformerRMSMatrix(
+    const ROMol &mol, const ConformerEnsembleT<double> &ensemble,
+    const BestAlignmentParams &params, double threshold = -1.0);
+
 //! Returns the RMS between two molecules, taking symmetry into account.
 //! In contrast to getBestRMS, the RMS is computed "in place", i.e.
 //! probe molecules are not aligned to the reference ahead of the
@@ -404,6 +444,33 @@ RDKIT_MOLALIGN_EXPORT void alignMolConformers(
     const RDNumeric::DoubleVector *weights = nullptr, bool reflect = false,
     unsigned int maxIters = 50, std::vector<double> *RMSlist = nullptr);
 
+//! Align the conformers of a ConformerEnsemble to its first conformer
+/*!
+  This is the equivalent of alignMolConformers() working directly on the
+  contiguous coordinate block of the ensemble.
+
+  \param ensemble  The conformer ensemble, modified in place
+  \param atomIds   vector of atoms to be used to generate the alignment.
+                   All atoms will be used is not specified
+  \param weights   (optional) weights for each pair of atoms.
+  \param reflect   toggles reflecting (about the origin) the alignment
+  \param maxIters  the maximum number of iterations to attempt
+  \param RMSlist   if nonzero, this will be used to return the RMS values
+                   between the first conformer and the other aligned
+                   conformers
+*/
+RDKIT_MOLALIGN_EXPORT void alignConformerEnsemble(
+    ConformerEnsembleT<double> &ensemble,
+    const std::vector<unsigned int> *atomIds = nullptr,
+    const RDNumeric::DoubleVector *weights = nullptr, bool reflect = false,
+    unsigned int maxIters = 50, std::vector<double> *RMSlist = nullptr);
+//! \overload
+RDKIT_MOLALIGN_EXPORT void alignConformerEnsemble(
+    ConformerEnsembleT<float> &ensemble,
+    const std::vector<unsigned int> *atomIds = nullptr,
+    const RDNumeric::DoubleVector *weights = nullptr, bool reflect = false,
+    unsigned int maxIters = 50, std::vector<double> *RMSlist = nullptr);
+
 namespace details {
 //! Converts terminal atoms in groups like nitro or carboxylate to be symmetry
 /// equivalent
@@ -285,6 +285,20 @@ python::tuple GetAllConformerBestRMS(
   }
   return python::tuple(res);
 }
+python::tuple GetConformerRMSMatrix(
+    ROMol &mol, const MolAlign::pyBestAlignmentParams &params,
+    double threshold) {
+  std::vector<double> rmsds;
+  {
+    NOGIL gil;
+    rmsds = MolAlign::getConformerRMSMatrix(mol, params, threshold);
+  }
+  python::list res;
+  for (auto v : rmsds) {
+    res.append(v);
+  }
+  return python::tuple(res);
+}
 python::tuple GetAllConformerBestRMS2(ROMol &mol, int numThreads,
                                       python::object map, int maxMatches,
                                       bool symmetrizeTerminalGroups,
@@ -880,6 +894,29 @@ BOOST_PYTHON_MODULE(rdMolAlign) {
   python::def("GetAllConformerBestRMS", RDKit::GetAllConformerBestRMS,
               (python::arg("mol"), python::arg("params")), docString.c_str());
 
+  docString =
+      R"DOC(Returns the symmetric RMSD matrix between the conformers of a molecule.
+       This returns the same values as GetAllConformerBestRMS(), but the
+       symmetry mappings are only determined once and the RMSD for each
+       mapping is calculated directly with the QCP method, without
+       aligning the conformers. This is considerably faster for large
+       conformer ensembles. The number of threads is taken from params.
+
+       ARGUMENTS
+        - mol:       the molecule to be considered
+        - params:    a BestAlignmentParams object
+        - threshold: (optional) if positive, pairs with RMSDs above the
+                     threshold are not calculated exactly and are returned
+                     as infinity.
+
+      RETURNS
+      A tuple with the RMSDS. The ordering is [(1,0),(2,0),(2,1),(3,0),... etc]
+  )DOC";
+  python::def("GetConformerRMSMatrix", RDKit::GetConformerRMSMatrix,
+              (python::arg("mol"), python::arg("params"),
+               python::arg("threshold") = -1.0),
+              docString.c_str());
+
   docString =
       "Returns the RMS between two molecules, taking symmetry into account.\n\
        In contrast to getBestRMS, the RMS is computed 'in place', i.e.\n\
@@ -596,6 +596,29 @@ class TestCase(unittest.TestCase):
     mcp = Chem.Mol(mol)
     self.assertAlmostEqual(origVals[0], rdMolAlign.GetBestRMS(mcp, mcp, params, 0, 1), 4)
 
+  def test20GetConformerRMSMatrix(self):
+    file1 = os.path.join(RDConfig.RDBaseDir, 'Code', 'GraphMol', 'MolAlign', 'test_data',
+                         'symmetric.confs.sdf')
+    ms = [x for x in Chem.SDMolSupplier(file1)]
+    mol = Chem.Mol(ms[0])
+    for i in range(1, len(ms)):
+      mol.AddConformer(ms[i].GetConformer(), assignId=True)
+
+    params = rdMolAlign.BestAlignmentParams()
+    origVals = rdMolAlign.GetAllConformerBestRMS(Chem.Mol(mol), params)
+    newVals = rdMolAlign.GetConformerRMSMatrix(mol, params)
+    self.assertEqual(len(origVals), len(newVals))
+    for ov, nv in zip(origVals, newVals):
+      self.assertAlmostEqual(ov, nv, 4)
+
+    threshold = sorted(origVals)[len(origVals) // 2]
+    newVals = rdMolAlign.GetConformerRMSMatrix(mol, params, threshold=threshold)
+    for ov, nv in zip(origVals, newVals):
+      if ov < threshold - 1e-4:
+        self.assertAlmostEqual(ov, nv, 4)
+      elif ov > threshold + 1e-4:
+        self.assertEqual(nv, float('inf'))
+
 
 if __name__ == '__main__':
   print("Testing MolAlign Wrappers")
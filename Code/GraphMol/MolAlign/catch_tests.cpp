@@ -13,8 +13,11 @@
 #include <GraphMol/FileParsers/MolSupplier.h>
 #include <GraphMol/ROMol.h>
 #include <GraphMol/Conformer.h>
+#include <GraphMol/ConformerEnsemble.h>
 #include <GraphMol/SmilesParse/SmilesParse.h>
 #include <GraphMol/MolTransforms/MolTransforms.h>
+#include <algorithm>
+#include <cmath>
 
 using namespace RDKit;
 
@@ -264,4 +267,152 @@ TEST_CASE("ignoring Hs") {
       CHECK_THAT(rmsd, Catch::Matchers::WithinAbs(0.0, 0.001));
     }
   }
-}
\ No newline at end of file
+}
+TEST_CASE("aligning conformer ensembles") {
+  auto m =
+      "CCC(=O)[O-] "
+      "|(-1.11,0.08,-0.29;0.08,-0.18,0.58;1.34,0.03,-0.16;1.74,1.22,-0.32;2.06,-1.04,-0.66)|"_smiles;
+  REQUIRE(m);
+  for (unsigned int i = 1; i < 4; ++i) {
+    auto *conf = new Conformer(m->getConformer());
+    RDGeom::Transform3D trans;
+    trans.SetRotation(0.7 * i, RDGeom::Point3D(1.0, i, 0.5));
+    trans.SetTranslation(RDGeom::Point3D(i, -2.0 * i, 0.3));
+    MolTransforms::transformConformer(*conf, trans);
+    conf->getAtomPos(0).x += 0.1 * i;
+    m->addConformer(conf, true);
+  }
+  REQUIRE(m->getNumConformers() == 4);
+
+  ROMol ref(*m);
+  SECTION("double") {
+    std::vector<double> refRMS;
+    MolAlign::alignMolConformers(ref, nullptr, nullptr, nullptr, false, 50,
+                                 &refRMS);
+    ConformerEnsemble ensemble(*m);
+    std::vector<double> rms;
+    MolAlign::alignConformerEnsemble(ensemble, nullptr, nullptr, false, 50,
+                                     &rms);
+    REQUIRE(rms.size() == refRMS.size());
+    for (unsigned int i = 0; i < rms.size(); ++i) {
+      CHECK_THAT(rms[i], Catch::Matchers::WithinAbs(refRMS[i], 1e-8));
+    }
+    ensemble.setMolConformers(*m);
+    for (unsigned int ci = 0; ci < m->getNumConformers(); ++ci) {
+      for (unsigned int ai = 0; ai < m->getNumAtoms(); ++ai) {
+        CHECK((m->getConformer(ci).getAtomPos(ai) -
+               ref.getConformer(ci).getAtomPos(ai))
+                  .length() < 1e-8);
+      }
+    }
+  }
+  SECTION("float, subset of atoms") {
+    std::vector<unsigned int> atomIds{0, 1, 2};
+    std::vector<double> refRMS;
+    MolAlign::alignMolConformers(ref, &atomIds, nullptr, nullptr, false, 50,
+                                 &refRMS);
+    ConformerEnsembleF ensemble(*m);
+    std::vector<double> rms;
+    MolAlign::alignConformerEnsemble(ensemble, &atomIds, nullptr, false, 50,
+                                     &rms);
+    REQUIRE(rms.size() == refRMS.size());
+    for (unsigned int i = 0; i < rms.size(); ++i) {
+      CHECK_THAT(rms[i], Catch::Matchers::WithinAbs(refRMS[i], 1e-5));
+    }
+    for (unsigned int ci = 0; ci < ensemble.getNumConformers(); ++ci) {
+      for (unsigned int ai = 0; ai < m->getNumAtoms(); ++ai) {
+        CHECK((ensemble.getAtomPos(ci, ai) -
+               ref.getConformer(ci).getAtomPos(ai))
+                  .length() < 1e-4);
+      }
+    }
+  }
+}
+
+TEST_CASE("getConformerRMSMatrix") {
+  std::string rdbase = getenv("RDBASE");
+  std::string fname1 =
+      rdbase + "/Code/GraphMol/MolAlign/test_data/symmetric.confs.sdf";
+  SDMolSupplier suppl(fname1);
+  std::unique_ptr<ROMol> mol{suppl[0]};
+  REQUIRE(mol);
+  for (auto i = 1u; i < suppl.length(); ++i) {
+    std::unique_ptr<ROMol> nm{suppl[i]};
+    REQUIRE(nm);
+    mol->addConformer(new Conformer(nm->getConformer()), true);
+  }
+  auto nconfs = mol->getNumConformers();
+  REQUIRE(nconfs > 2);
+  MolAlign::BestAlignmentParams params;
+  auto ref = MolAlign::getAllConformerBestRMS(*mol, params);
+  SECTION("basics") {
+    auto rmsds = MolAlign::getConformerRMSMatrix(*mol, params);
+    REQUIRE(rmsds.size() == ref.size());
+    for (auto i = 0u; i < ref.size(); ++i) {
+      CHECK_THAT(rmsds[i], Catch::Matchers::WithinAbs(ref[i], 1e-5));
+    }
+  }
+  SECTION("multithreaded") {
+    params.numThreads = 4;
+    auto rmsds = MolAlign::getConformerRMSMatrix(*mol, params);
+    REQUIRE(rmsds.size() == ref.size());
+    params.numThreads = 1;
+    auto strmsds = MolAlign::getConformerRMSMatrix(*mol, params);
+    CHECK(rmsds == strmsds);
+  }
+  SECTION("weights and Hs") {
+    params.ignoreHs = false;
+    auto nHeavy = mol->getNumHeavyAtoms();
+    auto nAtoms = mol->getNumAtoms();
+    MatchVectType match;
+    for (auto i = 0u; i < nAtoms; ++i) {
+      match.emplace_back(i, i);
+    }
+    params.map.push_back(match);
+    RDNumeric::DoubleVector weights(nAtoms, 1.0);
+    for (auto i = 0u; i < nAtoms; ++i) {
+      weights[i] = i < nHeavy ? 2.0 : 0.5;
+    }
+    params.weights = &weights;
+    auto wref = MolAlign::getAllConformerBestRMS(*mol, params);
+    auto rmsds = MolAlign::getConformerRMSMatrix(*mol, params);
+    REQUIRE(rmsds.size() == wref.size());
+    for (auto i = 0u; i < wref.size(); ++i) {
+      CHECK_THAT(rmsds[i], Catch::Matchers::WithinAbs(wref[i], 1e-5));
+    }
+  }
+  SECTION("threshold") {
+    std::vector<double> sorted(ref);
+    std::sort(sorted.begin(), sorted.end());
+    auto threshold = sorted[sorted.size() / 2];
+    auto rmsds = MolAlign::getConformerRMSMatrix(*mol, params, threshold);
+    REQUIRE(rmsds.size() == ref.size());
+    for (auto i = 0u; i < ref.size(); ++i) {
+      if (ref[i] < threshold - 1e-5) {
+        CHECK_THAT(rmsds[i], Catch::Matchers::WithinAbs(ref[i], 1e-5));
+      } else if (ref[i] > threshold + 1e-5) {
+        CHECK(std::isinf(rmsds[i]));
+      }
+    }
+  }
+  SECTION("conformer ensembles") {
+    ConformerEnsemble ensemble(*mol);
+    auto rmsds = MolAlign::getConformerRMSMatrix(*mol, ensemble, params);
+    CHECK(rmsds == MolAlign::getConformerRMSMatrix(*mol, params));
+    ConformerEnsemble wrongSize(mol->getNumAtoms() + 1);
+    CHECK_THROWS_AS(
+        MolAlign::getConformerRMSMatrix(*mol, wrongSize, params),
+        Invar::Invariant);
+  }
+  SECTION("edge cases") {
+    ROMol cp(*mol);
+    cp.clearConformers();
+    CHECK(MolAlign::getConformerRMSMatrix(cp, params).empty());
+    cp.addConformer(new Conformer(mol->getConformer()), true);
+    CHECK(MolAlign::getConformerRMSMatrix(cp, params).empty());
+    cp.addConformer(new Conformer(mol->getConformer()), true);
+    auto rmsds = MolAlign::getConformerRMSMatrix(cp, params);
+    REQUIRE(rmsds.size() == 1);
+    CHECK_THAT(rmsds[0], Catch::Matchers::WithinAbs(0.0, 1e-5));
+  }
+}
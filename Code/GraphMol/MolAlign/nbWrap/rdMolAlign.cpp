@@ -384,6 +384,22 @@ nb::tuple getAllConformerBestRMSParams(ROMol &mol,
   return nb::tuple(res);
 }
 
+nb::tuple getConformerRMSMatrix(ROMol &mol,
+                                const NbBestAlignmentParams &nbParams,
+                                double threshold) {
+  auto [params, weightsOwner] = nbParams.toNative();
+  std::vector<double> rmsds;
+  {
+    nb::gil_scoped_release release;
+    rmsds = MolAlign::getConformerRMSMatrix(mol, params, threshold);
+  }
+  nb::list res;
+  for (double v : rmsds) {
+    res.append(v);
+  }
+  return nb::tuple(res);
+}
+
 double calcRMS(ROMol &prbMol, ROMol &refMol, int prbCid, int refCid,
                nb::object map, int maxMatches, bool symmetrize,
                nb::object weights) {
@@ -883,6 +899,26 @@ using a BestAlignmentParams object.
 RETURNS
 A tuple with the best RMSDS. The ordering is [(1,0),(2,0),(2,1),(3,0),... etc])DOC");
 
+  m.def(
+      "GetConformerRMSMatrix", getConformerRMSMatrix, "mol"_a, "params"_a,
+      "threshold"_a = -1.0,
+      R"DOC(Returns the symmetric RMSD matrix between the conformers of a molecule.
+This returns the same values as GetAllConformerBestRMS(), but the
+symmetry mappings are only determined once and the RMSD for each
+mapping is calculated directly with the QCP method, without
+aligning the conformers. This is considerably faster for large
+conformer ensembles. The number of threads is taken from params.
+
+ARGUMENTS
+ - mol:       the molecule to be considered
+ - params:    a BestAlignmentParams object
+ - threshold: (optional) if positive, pairs with RMSDs above the
+              threshold are not calculated exactly and are returned
+              as infinity.
+
+RETURNS
+A tuple with the RMSDS. The ordering is [(1,0),(2,0),(2,1),(3,0),... etc])DOC");
+
   m.def(
       "CalcRMS", calcRMS, "prbMol"_a, "refMol"_a, "prbId"_a = -1,
       "refId"_a = -1, "map"_a = nb::none(), "maxMatches"_a = 1000000,
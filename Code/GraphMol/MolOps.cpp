@@ -608,6 +608,9 @@ void sanitizeMol(RWMol &mol, unsigned int &operationThatFailed,
                  unsigned int sanitizeOps) {
   // clear out any cached properties
   mol.clearComputedProps();
+  // and anything left over from deferSanitization()
+  mol.clearProp(common_properties::_SanitizePending);
+  mol.clearProp(common_properties::_SanitizeTriggered);
 
   operationThatFailed = SANITIZE_CLEANUP;
   if (sanitizeOps & operationThatFailed) {
@@ -716,6 +719,135 @@ void sanitizeMol(RWMol &mol, unsigned int &operationThatFailed,
   operationThatFailed = 0;
 }
 
+namespace {
+//! a stage of sanitizeMol() that deferSanitization() can leave until it is
+//! needed and the stages that have to be carried out before it
+struct DeferredStage {
+  unsigned int op;
+  unsigned int needs;
+};
+constexpr unsigned int deferrableOps =
+    SANITIZE_KEKULIZE | SANITIZE_SYMMRINGS | SANITIZE_FINDRADICALS |
+    SANITIZE_SETAROMATICITY | SANITIZE_SETCONJUGATION |
+    SANITIZE_SETHYBRIDIZATION | SANITIZE_CLEANUPATROPISOMERS |
+    SANITIZE_CLEANUPCHIRALITY | SANITIZE_ADJUSTHS;
+// in the order sanitizeMol() carries them out, SANITIZE_PROPERTIES is the
+// final check of the property cache
+constexpr DeferredStage deferredStages[] = {
+    {SANITIZE_KEKULIZE, 0},
+    {SANITIZE_SYMMRINGS, 0},
+    {SANITIZE_FINDRADICALS, SANITIZE_KEKULIZE},
+    {SANITIZE_SETAROMATICITY,
+     SANITIZE_KEKULIZE | SANITIZE_SYMMRINGS | SANITIZE_FINDRADICALS},
+    {SANITIZE_SETCONJUGATION, SANITIZE_SETAROMATICITY},
+    {SANITIZE_SETHYBRIDIZATION, SANITIZE_SETCONJUGATION},
+    {SANITIZE_CLEANUPATROPISOMERS, SANITIZE_SETHYBRIDIZATION},
+    {SANITIZE_CLEANUPCHIRALITY,
+     SANITIZE_SETHYBRIDIZATION | SANITIZE_CLEANUPATROPISOMERS},
+    {SANITIZE_ADJUSTHS, SANITIZE_SETAROMATICITY},
+    {SANITIZE_PROPERTIES, deferrableOps},
+};
+
+void runDeferredStage(RWMol &mol, unsigned int op) {
+  switch (op) {
+    case SANITIZE_KEKULIZE:
+      kekulizeForSanitize(mol);
+      break;
+    case SANITIZE_SYMMRINGS: {
+      VECT_INT_VECT arings;
+      bool recalcSSSR = false;
+      MolOps::symmetrizeSSSR(mol, arings, SymmetrizeSSSRAlgorithm::DEFAULT,
+                             recalcSSSR);
+    } break;
+    case SANITIZE_FINDRADICALS:
+      assignRadicals(mol);
+      break;
+    case SANITIZE_SETAROMATICITY:
+      setAromaticity(mol);
+      break;
+    case SANITIZE_SETCONJUGATION:
+      setConjugation(mol);
+      break;
+    case SANITIZE_SETHYBRIDIZATION:
+      setHybridization(mol);
+      break;
+    case SANITIZE_CLEANUPATROPISOMERS:
+      cleanupAtropisomers(mol);
+      break;
+    case SANITIZE_CLEANUPCHIRALITY:
+      cleanupChirality(mol);
+      break;
+    case SANITIZE_ADJUSTHS:
+      MolOps::adjustHs(mol);
+      break;
+    case SANITIZE_PROPERTIES:
+      mol.updatePropertyCache(true);
+      break;
+    default:
+      UNDER_CONSTRUCTION("unknown sanitization operation");
+  }
+}
+}  // namespace
+
+void deferSanitization(RWMol &mol, unsigned int sanitizeOps) {
+  unsigned int failedOp = 0;
+  sanitizeMol(mol, failedOp, sanitizeOps & ~deferrableOps);
+  unsigned int pending = sanitizeOps & deferrableOps;
+  if (!pending) {
+    return;
+  }
+  if (sanitizeOps & SANITIZE_PROPERTIES) {
+    pending |= SANITIZE_PROPERTIES;
+  }
+  mol.setProp(common_properties::_SanitizePending, pending);
+  mol.setProp(common_properties::_SanitizeTriggered, 0u);
+}
+
+unsigned int getPendingSanitization(const ROMol &mol) {
+  unsigned int pending = 0;
+  mol.getPropIfPresent(common_properties::_SanitizePending, pending);
+  return pending;
+}
+
+unsigned int getTriggeredSanitization(const ROMol &mol) {
+  unsigned int triggered = 0;
+  mol.getPropIfPresent(common_properties::_SanitizeTriggered, triggered);
+  return triggered;
+}
+
+unsigned int requireSanitization(const ROMol &mol, unsigned int sanitizeOps) {
+  unsigned int pending = getPendingSanitization(mol);
+  if (!(pending & sanitizeOps)) {
+    return 0;
+  }
+  // the needs of a stage are all earlier in the list, so one pass from the
+  // back finds everything that has to be done
+  unsigned int todo = pending & sanitizeOps;
+  for (auto it = std::rbegin(deferredStages); it != std::rend(deferredStages);
+       ++it) {
+    if (todo & it->op) {
+      todo |= pending & it->needs;
+    }
+  }
+
+  // like the ring finding code, this updates the molecule in place
+  auto &wmol = static_cast<RWMol &>(const_cast<ROMol &>(mol));
+  unsigned int triggered = getTriggeredSanitization(mol);
+  unsigned int done = 0;
+  for (const auto &stage : deferredStages) {
+    if (!(todo & stage.op)) {
+      continue;
+    }
+    runDeferredStage(wmol, stage.op);
+    done |= stage.op;
+    pending &= ~stage.op;
+    triggered |= stage.op;
+    wmol.setProp(common_properties::_SanitizePending, pending);
+    wmol.setProp(common_properties::_SanitizeTriggered, triggered);
+  }
+  return done;
+}
+
 std::vector<std::unique_ptr<MolSanitizeException>> detectChemistryProblems(
     const ROMol &imol, unsigned int sanitizeOps) {
   RWMol mol(imol);
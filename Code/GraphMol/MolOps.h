@@ -575,6 +575,63 @@ RDKIT_GRAPHMOL_EXPORT void sanitizeMol(
 //! \overload
 RDKIT_GRAPHMOL_EXPORT void sanitizeMol(RWMol &mol);
 
+//! \brief sanitizes a molecule in stages, each one when it is first needed
+/*!
+   The operations that check the molecule and that the others depend on
+   (MolOps::cleanUp(), MolOps::cleanUpOrganometallics() and
+   mol.updatePropertyCache()) are carried out now. The remaining operations
+   in \c sanitizeOps are recorded as pending on the molecule and are carried
+   out by requireSanitization() when an algorithm needs their results.
+   Molecules that are only fingerprinted never have their conjugation,
+   hybridization or chirality cleaned up, for example.
+
+   The result of running all of the pending operations is the same as that of
+   sanitizeMol() with the same \c sanitizeOps.
+
+   \param mol : the RWMol to be sanitized
+   \param sanitizeOps : the bits here are used to set which sanitization
+                        operations are carried out. The elements of the \c
+                        SanitizeFlags enum define the operations.
+
+   <b>Notes:</b>
+    - If there is a failure in one of the operations carried out now, a
+      \c MolSanitizeException will be thrown. Failures in the pending
+      operations, e.g. kekulization, are thrown by requireSanitization(), i.e.
+      by the algorithm that needed the operation.
+    - The molecule should not be modified while operations are pending.
+    - Fingerprint generators, MorganEnvironmentCache and the SMILES writers
+      call requireSanitization(). Other algorithms need it to be called first.
+*/
+RDKIT_GRAPHMOL_EXPORT void deferSanitization(
+    RWMol &mol, unsigned int sanitizeOps = SanitizeFlags::SANITIZE_ALL);
+
+//! \brief carries out pending sanitization operations
+/*!
+   Carries out the operations in \c sanitizeOps that deferSanitization() left
+   pending on the molecule, along with the pending operations that they
+   depend on. This does nothing for molecules without pending operations.
+
+   The final updatePropertyCache() of sanitizeMol() is requested with
+   \c SanitizeFlags::SANITIZE_PROPERTIES, it is carried out after everything
+   else that is pending.
+
+   Like ring perception, this modifies the molecule, so it must not be called
+   on the same molecule from more than one thread at a time.
+
+   \param mol : the molecule
+   \param sanitizeOps : the operations whose results are needed
+
+   \return the operations that were carried out
+*/
+RDKIT_GRAPHMOL_EXPORT unsigned int requireSanitization(
+    const ROMol &mol, unsigned int sanitizeOps = SanitizeFlags::SANITIZE_ALL);
+
+//! returns the sanitization operations that are pending on a molecule
+RDKIT_GRAPHMOL_EXPORT unsigned int getPendingSanitization(const ROMol &mol);
+//! returns the pending sanitization operations that have been carried out on
+//! demand since deferSanitization() was called
+RDKIT_GRAPHMOL_EXPORT unsigned int getTriggeredSanitization(const ROMol &mol);
+
 //! \brief Identifies chemistry problems (things that don't make chemical
 //! sense) in a molecule
 /*!
@@ -10,6 +10,7 @@
 #include <GraphMol/RDKitBase.h>
 #include <GraphMol/RDKitQueries.h>
 #include <GraphMol/MolPickler.h>
+#include <GraphMol/ConformerEnsemble.h>
 #include <GraphMol/QueryOps.h>
 #include <GraphMol/MonomerInfo.h>
 #include <GraphMol/StereoGroup.h>
@@ -1018,6 +1019,36 @@ struct IOStreamExceptionStateResetter {
   }
 };
 
+namespace {
+// coordinates are written and read as blocks rather than one value at a time
+template <typename C>
+void writeCoordBlock(std::ostream &ss, const C *coords, size_t n) {
+  if constexpr (HOST_ENDIAN_ORDER == LITTLE_ENDIAN_ORDER) {
+    // the coordinates are already in the pickle byte order: write them in one
+    // go
+    ss.write(reinterpret_cast<const char *>(coords), n * sizeof(C));
+  } else {
+    for (size_t i = 0; i < n; ++i) {
+      streamWrite(ss, coords[i]);
+    }
+  }
+}
+
+template <typename C>
+void readCoordBlock(std::istream &ss, C *coords, size_t n) {
+  if constexpr (HOST_ENDIAN_ORDER == LITTLE_ENDIAN_ORDER) {
+    ss.read(reinterpret_cast<char *>(coords), n * sizeof(C));
+    if (ss.fail()) {
+      throw std::runtime_error("failed to read from stream");
+    }
+  } else {
+    for (size_t i = 0; i < n; ++i) {
+      streamRead(ss, coords[i]);
+    }
+  }
+}
+}  // namespace
+
 void MolPickler::pickleMol(const ROMol *mol, std::ostream &ss) {
   pickleMol(mol, ss, MolPickler::getDefaultPickleProperties());
 }
@@ -1818,20 +1849,18 @@ void MolPickler::_pickleConformer(std::ostream &ss, const Conformer *conf) {
   T tmpT = static_cast<T>(conf->getNumAtoms());
   streamWrite(ss, tmpT);
   const RDGeom::POINT3D_VECT &pts = conf->getPositions();
+  std::vector<C> coords;
+  coords.reserve(3 * pts.size());
   for (const auto &pt : pts) {
-    C tmpFloat;
-    tmpFloat = static_cast<C>(pt.x);
-    streamWrite(ss, tmpFloat);
-    tmpFloat = static_cast<C>(pt.y);
-    streamWrite(ss, tmpFloat);
-    tmpFloat = static_cast<C>(pt.z);
-    streamWrite(ss, tmpFloat);
+    coords.push_back(static_cast<C>(pt.x));
+    coords.push_back(static_cast<C>(pt.y));
+    coords.push_back(static_cast<C>(pt.z));
   }
+  writeCoordBlock(ss, coords.data(), coords.size());
 }
 
 template <typename T, typename C>
 Conformer *MolPickler::_conformerFromPickle(std::istream &ss, int version) {
-  C tmpFloat;
   bool is3D = true;
   if (version > 4000) {
     char tmpChr;
@@ -1848,13 +1877,13 @@ Conformer *MolPickler::_conformerFromPickle(std::istream &ss, int version) {
   conf->setId(cid);
   conf->set3D(is3D);
   try {
-    for (unsigned int i = 0; i < numAtoms; i++) {
-      streamRead(ss, tmpFloat, version);
-      conf->getAtomPos(i).x = static_cast<double>(tmpFloat);
-      streamRead(ss, tmpFloat, version);
-      conf->getAtomPos(i).y = static_cast<double>(tmpFloat);
-      streamRead(ss, tmpFloat, version);
-      conf->getAtomPos(i).z = static_cast<double>(tmpFloat);
+    std::vector<C> coords(3 * static_cast<size_t>(numAtoms));
+    readCoordBlock(ss, coords.data(), coords.size());
+    auto cit = coords.begin();
+    for (auto &pt : conf->getPositions()) {
+      pt.x = static_cast<double>(*cit++);
+      pt.y = static_cast<double>(*cit++);
+      pt.z = static_cast<double>(*cit++);
     }
   } catch (...) {
     delete conf;
@@ -2771,4 +2800,122 @@ void MolPickler::_addBondFromPickleV1(std::istream &ss, ROMol *mol) {
   }
   mol->addBond(bond, true);
 }
+//--------------------------------------
+//
+//            Conformer ensembles
+//
+//--------------------------------------
+namespace {
+template <typename C>
+void pickleEnsemble(const ConformerEnsembleT<C> &ensemble, std::ostream &ss) {
+  IOStreamExceptionStateResetter resetter(ss, std::ios_base::eofbit |
+                                                  std::ios_base::failbit |
+                                                  std::ios_base::badbit);
+  try {
+    streamWrite(ss, MolPickler::endianId);
+    streamWrite(ss, static_cast<int>(MolPickler::VERSION));
+    streamWrite(ss, MolPickler::versionMajor);
+    streamWrite(ss, MolPickler::versionMinor);
+    streamWrite(ss, MolPickler::versionPatch);
+    streamWrite(ss, static_cast<int32_t>(std::is_same_v<C, double>
+                                             ? MolPickler::BEGINCONFS_DOUBLE
+                                             : MolPickler::BEGINCONFS));
+    streamWrite(ss, static_cast<int32_t>(ensemble.getNumAtoms()));
+    streamWrite(ss, static_cast<int32_t>(ensemble.getNumConformers()));
+    for (unsigned int i = 0; i < ensemble.getNumConformers(); ++i) {
+      streamWrite(ss, static_cast<int32_t>(ensemble.getConformerId(i)));
+      streamWrite(ss, static_cast<char>(ensemble.is3D(i)));
+    }
+    const auto &coords = ensemble.getCoordBlock();
+    writeCoordBlock(ss, coords.data(), coords.size());
+    streamWrite(ss, static_cast<int32_t>(MolPickler::ENDMOL));
+  } catch (const std::ios_base::failure &) {
+    throw MolPicklerException("Bad pickle format: error while writing");
+  }
+}
+
+template <typename C>
+void ensembleFromPickle(std::istream &ss, ConformerEnsembleT<C> &ensemble) {
+  IOStreamExceptionStateResetter resetter(ss, std::ios_base::eofbit |
+                                                  std::ios_base::failbit |
+                                                  std::ios_base::badbit);
+  try {
+    int32_t tmpInt;
+    streamRead(ss, tmpInt);
+    if (tmpInt != MolPickler::endianId) {
+      throw MolPicklerException(
+          "Bad pickle format: bad endian ID or invalid file format");
+    }
+    streamRead(ss, tmpInt);
+    if (static_cast<MolPickler::Tags>(tmpInt) != MolPickler::VERSION) {
+      throw MolPicklerException("Bad pickle format: no version tag");
+    }
+    int32_t majorVersion, minorVersion, patchVersion;
+    streamRead(ss, majorVersion);
+    streamRead(ss, minorVersion);
+    streamRead(ss, patchVersion);
+
+    int32_t tag;
+    streamRead(ss, tag);
+    if (tag != MolPickler::BEGINCONFS && tag != MolPickler::BEGINCONFS_DOUBLE) {
+      throw MolPicklerException("Bad pickle format: no conformer ensemble");
+    }
+    int32_t numAtoms, numConfs;
+    streamRead(ss, numAtoms);
+    streamRead(ss, numConfs);
+    if (numAtoms < 0 || numConfs < 0) {
+      throw MolPicklerException("Bad pickle format: bad ensemble size");
+    }
+    ensemble = ConformerEnsembleT<C>(numAtoms);
+    ensemble.reserve(numConfs);
+    for (int32_t i = 0; i < numConfs; ++i) {
+      int32_t cid;
+      char is3D;
+      streamRead(ss, cid);
+      streamRead(ss, is3D);
+      ensemble.addConformer(static_cast<unsigned int>(cid),
+                            static_cast<bool>(is3D));
+    }
+    auto &coords = ensemble.getCoordBlock();
+    if ((tag == MolPickler::BEGINCONFS_DOUBLE) == std::is_same_v<C, double>) {
+      readCoordBlock(ss, coords.data(), coords.size());
+    } else if (tag == MolPickler::BEGINCONFS_DOUBLE) {
+      std::vector<double> tmp(coords.size());
+      readCoordBlock(ss, tmp.data(), tmp.size());
+      std::copy(tmp.begin(), tmp.end(), coords.begin());
+    } else {
+      std::vector<float> tmp(coords.size());
+      readCoordBlock(ss, tmp.data(), tmp.size());
+      std::copy(tmp.begin(), tmp.end(), coords.begin());
+    }
+    streamRead(ss, tag);
+    if (tag != MolPickler::ENDMOL) {
+      throw MolPicklerException("Bad pickle format: ENDMOL tag not found.");
+    }
+  } catch (const std::ios_base::failure &) {
+    throw MolPicklerException(
+        "Bad pickle format: unexpected End-of-File while reading");
+  } catch (const std::runtime_error &) {
+    throw MolPicklerException(
+        "Bad pickle format: unexpected End-of-File while reading");
+  }
+}
+}  // namespace
+
+void MolPickler::pickleConformerEnsemble(
+    const ConformerEnsembleT<double> &ensemble, std::ostream &ss) {
+  pickleEnsemble(ensemble, ss);
+}
+void MolPickler::pickleConformerEnsemble(
+    const ConformerEnsembleT<float> &ensemble, std::ostream &ss) {
+  pickleEnsemble(ensemble, ss);
+}
+void MolPickler::conformerEnsembleFromPickle(
+    std::istream &ss, ConformerEnsembleT<double> &ensemble) {
+  ensembleFromPickle(ss, ensemble);
+}
+void MolPickler::conformerEnsembleFromPickle(
+    std::istream &ss, ConformerEnsembleT<float> &ensemble) {
+  ensembleFromPickle(ss, ensemble);
+}
 };  // namespace RDKit
@@ -34,6 +34,8 @@
 namespace RDKit {
 class ROMol;
 class RingInfo;
+template <typename CoordType>
+class ConformerEnsembleT;
 
 //! used to indicate exceptions whilst pickling (serializing) molecules
 class RDKIT_GRAPHMOL_EXPORT MolPicklerException : public std::exception {
@@ -218,6 +220,49 @@ class RDKIT_GRAPHMOL_EXPORT MolPickler {
                               PicklerOps::PropertyPickleOptions::AllProps);
   }
 
+  //! pickles the conformers of a ConformerEnsemble and sends the results to
+  //! stream \c ss
+  /*!
+    The coordinate block is written in one piece, in the precision of the
+    ensemble. Conformer ids and 3D flags are included, conformer properties
+    are not.
+  */
+  static void pickleConformerEnsemble(
+      const ConformerEnsembleT<double> &ensemble, std::ostream &ss);
+  //! \overload
+  static void pickleConformerEnsemble(const ConformerEnsembleT<float> &ensemble,
+                                      std::ostream &ss);
+  //! pickles the conformers of a ConformerEnsemble and adds the results to
+  //! string \c res
+  template <typename CoordType>
+  static void pickleConformerEnsemble(
+      const ConformerEnsembleT<CoordType> &ensemble, std::string &res) {
+    std::stringstream ss(std::ios_base::binary | std::ios_base::out |
+                         std::ios_base::in);
+    MolPickler::pickleConformerEnsemble(ensemble, ss);
+    res = ss.str();
+  }
+
+  //! fills a ConformerEnsemble from a pickle stored in a stream
+  /*!
+    Any existing contents of \c ensemble are replaced. Pickles written in the
+    other precision are converted.
+  */
+  static void conformerEnsembleFromPickle(std::istream &ss,
+                                          ConformerEnsembleT<double> &ensemble);
+  //! \overload
+  static void conformerEnsembleFromPickle(std::istream &ss,
+                                          ConformerEnsembleT<float> &ensemble);
+  //! fills a ConformerEnsemble from a pickle stored in a string
+  template <typename CoordType>
+  static void conformerEnsembleFromPickle(
+      const std::string &pickle, ConformerEnsembleT<CoordType> &ensemble) {
+    std::stringstream ss(std::ios_base::binary | std::ios_base::out |
+                         std::ios_base::in);
+    ss.write(pickle.c_str(), pickle.length());
+    MolPickler::conformerEnsembleFromPickle(ss, ensemble);
+  }
+
  private:
   //! Pickle nonquery atom data
   static std::int32_t _pickleAtomData(std::ostream &tss, const Atom *atom);
@@ -19,12 +19,9 @@
 #include "Charge.h"
 #include <GraphMol/SmilesParse/SmilesWrite.h>
 #include <GraphMol/SmilesParse/SmilesParse.h>
+#include <RDGeneral/RDThreadPool.h>
 #include <RDGeneral/RDThreads.h>
 
-#ifdef RDK_BUILD_THREADSAFE_SSS
-#include <thread>
-#endif
-
 #include <RDGeneral/BoostStartInclude.h>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
@@ -130,31 +127,8 @@ template <typename FuncType>
 void standardizeMultipleMolsInPlace(FuncType sfunc, std::vector<RWMol *> &mols,
                                     int numThreads,
                                     const CleanupParameters &params) {
-  unsigned int numThreadsToUse = std::min(
-      static_cast<unsigned int>(mols.size()), getNumThreadsToUse(numThreads));
-  if (numThreadsToUse == 1) {
-    for (auto molp : mols) {
-      sfunc(*molp, params);
-    }
-  }
-#ifdef RDK_BUILD_THREADSAFE_SSS
-  else {
-    auto func = [&](unsigned int tidx) {
-      for (auto mi = tidx; mi < mols.size(); mi += numThreads) {
-        sfunc(*mols[mi], params);
-      }
-    };
-    std::vector<std::thread> threads;
-    for (auto tidx = 0u; tidx < numThreadsToUse; ++tidx) {
-      threads.emplace_back(func, tidx);
-    }
-    for (auto &t : threads) {
-      if (t.joinable()) {
-        t.join();
-      }
-    }
-  }
-#endif
+  parallelFor(mols.size(), getNumThreadsToUse(numThreads),
+              [&](size_t mi) { sfunc(*mols[mi], params); });
 }
 
 void throwIfMolPtrListContainsDuplicates(const std::vector<RWMol *> &mols) {
@@ -195,17 +195,44 @@ unsigned int RingInfo::addRing(const INT_VECT &atomIndices,
   return rdcast<unsigned int>(d_atomRings.size());
 }
 
+unsigned int RingInfo::addRing(INT_VECT &&atomIndices,
+                               INT_VECT &&bondIndices) {
+  PRECONDITION(df_init, "RingInfo not initialized");
+  PRECONDITION(atomIndices.size() == bondIndices.size(), "length mismatch");
+  const int ringIdx = d_atomRings.size();
+  for (const auto &i : atomIndices) {
+    if (i >= static_cast<int>(d_atomMembers.size())) {
+      d_atomMembers.resize(i + 1);
+    }
+    d_atomMembers[i].push_back(ringIdx);
+  }
+  for (const auto &i : bondIndices) {
+    if (i >= static_cast<int>(d_bondMembers.size())) {
+      d_bondMembers.resize(i + 1);
+    }
+    d_bondMembers[i].push_back(ringIdx);
+  }
+  d_atomRings.push_back(std::move(atomIndices));
+  d_bondRings.push_back(std::move(bondIndices));
+  return rdcast<unsigned int>(d_atomRings.size());
+}
+
 bool RingInfo::isRingFused(unsigned int ringIdx) {
+  PRECONDITION(ringIdx < d_bondRings.size(), "ringIdx out of bounds");
   initFusedRings();
-  PRECONDITION(ringIdx < d_fusedRings.size(), "ringIdx out of bounds");
-  return d_fusedRings[ringIdx].any();
+  for (unsigned int i = 0; i < d_bondRings.size(); ++i) {
+    if (areRingsFusedInternal(ringIdx, i)) {
+      return true;
+    }
+  }
+  return false;
 }
 
 bool RingInfo::areRingsFused(unsigned int ring1Idx, unsigned int ring2Idx) {
+  PRECONDITION(ring1Idx < d_bondRings.size(), "ring1Idx out of bounds");
+  PRECONDITION(ring2Idx < d_bondRings.size(), "ring2Idx out of bounds");
   initFusedRings();
-  PRECONDITION(ring1Idx < d_fusedRings.size(), "ring1Idx out of bounds");
-  PRECONDITION(ring2Idx < d_fusedRings.size(), "ring2Idx out of bounds");
-  return d_fusedRings[ring1Idx].test(ring2Idx);
+  return areRingsFusedInternal(ring1Idx, ring2Idx);
 }
 
 unsigned int RingInfo::numFusedBonds(unsigned int ringIdx) {
@@ -223,18 +250,21 @@ unsigned int RingInfo::numFusedBonds(unsigned int ringIdx) {
 }
 
 unsigned int RingInfo::numFusedRingNeighbors(unsigned int ringIdx) {
+  PRECONDITION(ringIdx < d_bondRings.size(), "ringIdx out of bounds");
   initFusedRings();
-  PRECONDITION(ringIdx < d_fusedRings.size(), "ringIdx out of bounds");
-  return d_fusedRings[ringIdx].count();
+  unsigned int res = 0;
+  for (unsigned int i = 0; i < d_bondRings.size(); ++i) {
+    res += areRingsFusedInternal(ringIdx, i);
+  }
+  return res;
 }
 
 std::vector<unsigned int> RingInfo::fusedRingNeighbors(unsigned int ringIdx) {
+  PRECONDITION(ringIdx < d_bondRings.size(), "ringIdx out of bounds");
   initFusedRings();
-  PRECONDITION(ringIdx < d_fusedRings.size(), "ringIdx out of bounds");
   std::vector<unsigned int> res;
-  res.reserve(d_fusedRings[ringIdx].count());
-  for (unsigned int i = 0; i < d_fusedRings[ringIdx].size(); ++i) {
-    if (d_fusedRings[ringIdx].test(i)) {
+  for (unsigned int i = 0; i < d_bondRings.size(); ++i) {
+    if (areRingsFusedInternal(ringIdx, i)) {
       res.push_back(i);
     }
   }
@@ -242,17 +272,12 @@ std::vector<unsigned int> RingInfo::fusedRingNeighbors(unsigned int ringIdx) {
 }
 
 void RingInfo::initFusedRings() {
-  if (d_fusedRings.size() == d_bondRings.size()) {
+  const auto numRings = d_bondRings.size();
+  if (d_fusedRings.size() == numRings * numRings) {
     return;
   }
   d_fusedRings.clear();
-  if (d_bondRings.empty()) {
-    return;
-  }
-  d_fusedRings.resize(d_bondRings.size());
-  for (auto &fusedRing : d_fusedRings) {
-    fusedRing.resize(d_bondRings.size());
-  }
+  d_fusedRings.resize(numRings * numRings);
   for (const auto &ringIndices : d_bondMembers) {
     if (ringIndices.size() <= 1) {
       continue;
@@ -261,8 +286,8 @@ void RingInfo::initFusedRings() {
       unsigned int ringIdx1 = ringIndices[i];
       for (unsigned int j = i + 1; j < ringIndices.size(); ++j) {
         unsigned int ringIdx2 = ringIndices[j];
-        d_fusedRings[ringIdx1].set(ringIdx2);
-        d_fusedRings[ringIdx2].set(ringIdx1);
+        d_fusedRings.set(ringIdx1 * numRings + ringIdx2);
+        d_fusedRings.set(ringIdx2 * numRings + ringIdx1);
       }
     }
   }
@@ -290,6 +315,14 @@ unsigned int RingInfo::addRingFamily(const INT_VECT &atomIndices,
   return rdcast<unsigned int>(d_atomRingFamilies.size());
 }
 
+unsigned int RingInfo::addRingFamily(INT_VECT &&atomIndices,
+                                     INT_VECT &&bondIndices) {
+  PRECONDITION(df_init, "RingInfo not initialized");
+  d_atomRingFamilies.push_back(std::move(atomIndices));
+  d_bondRingFamilies.push_back(std::move(bondIndices));
+  return rdcast<unsigned int>(d_atomRingFamilies.size());
+}
+
 void RingInfo::resetRingFamilies() {
   d_atomRingFamilies.clear();
   d_bondRingFamilies.clear();
@@ -310,13 +343,18 @@ void RingInfo::reset(bool doRingFamilies) {
   d_bondMembers.clear();
   d_atomRings.clear();
   d_bondRings.clear();
+  d_fusedRings.clear();
+  d_numFusedBonds.clear();
   if (doRingFamilies) {
     resetRingFamilies();
   }
 }
-void RingInfo::preallocate(unsigned int numAtoms, unsigned int numBonds) {
+void RingInfo::preallocate(unsigned int numAtoms, unsigned int numBonds,
+                           unsigned int numRings) {
   d_atomMembers.resize(numAtoms);
   d_bondMembers.resize(numBonds);
+  d_atomRings.reserve(numRings);
+  d_bondRings.reserve(numRings);
 }
 
 std::vector<std::vector<int>> RingInfo::atomRelevantCycles() const {
@@ -83,6 +83,8 @@ class RDKIT_GRAPHMOL_EXPORT RingInfo {
   */
   unsigned int addRing(const INT_VECT &atomIndices,
                        const INT_VECT &bondIndices);
+  //! \overload
+  unsigned int addRing(INT_VECT &&atomIndices, INT_VECT &&bondIndices);
 
   //! \name Atom information
   //! @{
@@ -282,6 +284,8 @@ class RDKIT_GRAPHMOL_EXPORT RingInfo {
   */
   unsigned int addRingFamily(const INT_VECT &atomIndices,
                              const INT_VECT &bondIndices);
+  //! \overload
+  unsigned int addRingFamily(INT_VECT &&atomIndices, INT_VECT &&bondIndices);
   //! returns the total number of ring families
   /*!
     <b>Notes:</b>
@@ -320,16 +324,22 @@ class RDKIT_GRAPHMOL_EXPORT RingInfo {
   //! @}
 
   //! pre-allocates some memory to save time later
-  void preallocate(unsigned int numAtoms, unsigned int numBonds);
+  void preallocate(unsigned int numAtoms, unsigned int numBonds,
+                   unsigned int numRings = 0);
 
  private:
   void initFusedRings();
+  bool areRingsFusedInternal(unsigned int ring1Idx,
+                             unsigned int ring2Idx) const {
+    return d_fusedRings[ring1Idx * d_bondRings.size() + ring2Idx];
+  }
   bool df_init{false};
   FIND_RING_TYPE df_find_type_type{FIND_RING_TYPE_OTHER_OR_UNKNOWN};
   DataType d_atomMembers, d_bondMembers;
   VECT_INT_VECT d_atomRings, d_bondRings;
   VECT_INT_VECT d_atomRingFamilies, d_bondRingFamilies;
-  std::vector<boost::dynamic_bitset<>> d_fusedRings;
+  //! the ring adjacency matrix, stored row by row
+  boost::dynamic_bitset<> d_fusedRings;
   std::vector<unsigned int> d_numFusedBonds;
 
  public:
@@ -489,6 +489,8 @@ std::string MolToSmiles(const ROMol &mol, const SmilesWriteParams &params,
   if (!mol.getNumAtoms()) {
     return "";
   }
+  // the SMILES depend on everything sanitization sets
+  MolOps::requireSanitization(mol);
   PRECONDITION(
       params.rootedAtAtom < 0 ||
           static_cast<unsigned int>(params.rootedAtAtom) < mol.getNumAtoms(),
@@ -756,6 +758,7 @@ std::string MolToCXSmiles(const ROMol &romol,
                           const SmilesWriteParams &paramsInput,
                           std::uint32_t flags,
                           RestoreBondDirOption restoreBondDirs) {
+  MolOps::requireSanitization(romol);
   RWMol trwmol(romol);
 
   bool doingCXSmiles = true;
@@ -866,6 +869,7 @@ std::string MolFragmentToSmiles(const ROMol &mol,
   if (!mol.getNumAtoms()) {
     return "";
   }
+  MolOps::requireSanitization(mol);
   int rootedAtAtom = params.rootedAtAtom;
 
   ROMol tmol(mol, true);
@@ -282,6 +282,119 @@ pathFinderHelper(int *adjMat, unsigned int dim, unsigned int minLen,
 
   return res;
 }
+
+// the same walk as recurseWalkRange(), but the bonds marked as forbidden are
+// unmarked again on the way back up and the candidate stacks for each depth
+// are reused, so nothing is copied or allocated once they have grown.
+bool visitWalkRange(
+    const std::vector<INT_VECT> &nbrs,  // neighbors for each bond
+    PATH_TYPE &spath,                   // the current path to be built upon
+    std::vector<INT_VECT> &cands,   // neighbors of the path at each depth
+    std::vector<INT_VECT> &marked,  // bonds forbidden at each depth
+    unsigned int lowerLen, unsigned int upperLen,
+    boost::dynamic_bitset<> &forbidden, const PATH_VISITOR &visitor) {
+  const unsigned int nsize = spath.size();
+  if (nsize >= lowerLen && !visitor(spath)) {
+    return false;
+  }
+  if (nsize >= upperLen) {
+    return true;
+  }
+
+  auto &lcands = cands[nsize];
+  auto &lmarked = marked[nsize];
+  lmarked.clear();
+  bool keepGoing = true;
+  while (keepGoing && !lcands.empty()) {
+    int next = lcands.back();
+    lcands.pop_back();
+    if (forbidden[next]) {
+      continue;
+    }
+    forbidden[next] = 1;
+    lmarked.push_back(next);
+
+    auto &tstack = cands[nsize + 1];
+    tstack = lcands;
+    for (const auto bid : nbrs[next]) {
+      if (!forbidden[bid]) {
+        tstack.push_back(bid);
+      }
+    }
+    spath.push_back(next);
+    keepGoing = visitWalkRange(nbrs, spath, cands, marked, lowerLen, upperLen,
+                               forbidden, visitor);
+    spath.pop_back();
+  }
+  for (const auto bid : lmarked) {
+    forbidden[bid] = 0;
+  }
+  return keepGoing;
+}
+
+// depth first search over the atoms for visitAllPathsOfLengthsMtoN().
+// pathFinderHelper() finds each set of bonds several times (an open path from
+// both of its ends, a ring from each of its atoms in both directions) and
+// findAllPathsOfLengthsMtoN() then removes the duplicates. Here only one of
+// those traversals is passed on, so there is nothing to remove:
+//   - open paths: the one which starts at the lower atom index
+//   - rings closing back onto the first atom: the one which starts at the
+//     lowest atom index and goes towards the lower of its two neighbors
+//   - rings closing onto an atom further along the path: the one which goes
+//     around the ring towards the lower atom index
+// Like pathFinderHelper(), rings may only be closed by the last bond of
+// the longest paths.
+bool visitPathsFrom(
+    const std::vector<std::vector<std::pair<int, int>>> &nbrs,
+    PATH_TYPE &atomPath, PATH_TYPE &bondPath, std::vector<int> &posInPath,
+    unsigned int lowerLen, unsigned int upperLen, bool rooted,
+    const PATH_VISITOR &visitor) {
+  const auto endAtom = atomPath.back();
+  const unsigned int nBonds = bondPath.size() + 1;
+  for (const auto &[nbr, bidx] : nbrs[endAtom]) {
+    const auto pos = posInPath[nbr];
+    if (pos < 0) {
+      atomPath.push_back(nbr);
+      bondPath.push_back(bidx);
+      posInPath[nbr] = nBonds;
+      bool keepGoing = true;
+      if (nBonds >= lowerLen && (rooted || atomPath.front() < nbr)) {
+        keepGoing = visitor(bondPath);
+      }
+      if (keepGoing && nBonds < upperLen) {
+        keepGoing = visitPathsFrom(nbrs, atomPath, bondPath, posInPath,
+                                   lowerLen, upperLen, rooted, visitor);
+      }
+      posInPath[nbr] = -1;
+      bondPath.pop_back();
+      atomPath.pop_back();
+      if (!keepGoing) {
+        return false;
+      }
+    } else if (nBonds == upperLen &&
+               static_cast<size_t>(pos) + 2 < atomPath.size()) {
+      // a ring closure, but not back along the bond we just came in on
+      bool use;
+      if (pos == 0) {
+        use = (rooted || atomPath.front() == *std::min_element(
+                                                 atomPath.begin(),
+                                                 atomPath.end())) &&
+              atomPath[1] < endAtom;
+      } else {
+        use = atomPath[pos + 1] < endAtom;
+      }
+      if (use) {
+        bondPath.push_back(bidx);
+        bool keepGoing = visitor(bondPath);
+        bondPath.pop_back();
+        if (!keepGoing) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
 }  // namespace Subgraphs
 
 PATH_LIST findAllSubgraphsOfLengthN(const ROMol &mol, unsigned int targetLen,
@@ -579,6 +692,116 @@ findAllPathsOfLengthN(const ROMol &mol, unsigned int targetLen, bool useBonds,
                                    ignoreAtoms)[targetLen];
 }
 
+bool visitAllSubgraphsOfLengthsMtoN(const ROMol &mol, unsigned int lowerLen,
+                                    unsigned int upperLen,
+                                    const PATH_VISITOR &visitor, bool useHs,
+                                    int rootedAtAtom,
+                                    boost::dynamic_bitset<> *ignoreAtoms) {
+  PRECONDITION(lowerLen <= upperLen, "");
+  PRECONDITION(!ignoreAtoms || ignoreAtoms->size() == mol.getNumAtoms(),
+               "bad ignoreAtoms size");
+  boost::dynamic_bitset<> forbidden(mol.getNumBonds());
+  if (ignoreAtoms) {
+    for (const auto bond : mol.bonds()) {
+      if (ignoreAtoms->test(bond->getBeginAtomIdx()) ||
+          ignoreAtoms->test(bond->getEndAtomIdx())) {
+        forbidden[bond->getIdx()] = 1;
+      }
+    }
+  }
+
+  INT_INT_VECT_MAP nbrMap;
+  Subgraphs::getNbrsList(mol, useHs, nbrMap);
+  std::vector<INT_VECT> nbrs(mol.getNumBonds());
+  for (const auto &[bid, bnbrs] : nbrMap) {
+    nbrs[bid] = bnbrs;
+  }
+
+  // a subgraph can't have more bonds than the molecule
+  const unsigned int maxDepth =
+      std::min(upperLen, static_cast<unsigned int>(mol.getNumBonds()));
+  std::vector<INT_VECT> cands(maxDepth + 2);
+  std::vector<INT_VECT> marked(maxDepth + 2);
+  PATH_TYPE spath;
+  spath.reserve(maxDepth + 1);
+
+  // start paths at each bond:
+  for (const auto &elem : nbrMap) {
+    int i = elem.first;
+    if (forbidden[i]) {
+      continue;
+    }
+    if (rootedAtAtom >= 0 &&
+        mol.getBondWithIdx(i)->getBeginAtomIdx() !=
+            static_cast<unsigned int>(rootedAtAtom) &&
+        mol.getBondWithIdx(i)->getEndAtomIdx() !=
+            static_cast<unsigned int>(rootedAtAtom)) {
+      continue;
+    }
+    // don't come back to this bond in the later subgraphs
+    forbidden[i] = 1;
+    spath.assign(1, i);
+    cands[1] = nbrs[i];
+    if (!Subgraphs::visitWalkRange(nbrs, spath, cands, marked, lowerLen,
+                                   upperLen, forbidden, visitor)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool visitAllPathsOfLengthsMtoN(const ROMol &mol, unsigned int lowerLen,
+                                unsigned int upperLen,
+                                const PATH_VISITOR &visitor, bool useHs,
+                                int rootedAtAtom,
+                                boost::dynamic_bitset<> *ignoreAtoms) {
+  PRECONDITION(lowerLen <= upperLen, "");
+  PRECONDITION(!ignoreAtoms || ignoreAtoms->size() == mol.getNumAtoms(),
+               "bad ignoreAtoms size");
+  const int nAtoms = mol.getNumAtoms();
+  // (neighbor atom, bond) pairs for each atom
+  std::vector<std::vector<std::pair<int, int>>> nbrs(nAtoms);
+  for (const auto bond : mol.bonds()) {
+    const auto beg = bond->getBeginAtom();
+    const auto end = bond->getEndAtom();
+    if (!useHs && (beg->getAtomicNum() == 1 || end->getAtomicNum() == 1)) {
+      continue;
+    }
+    if (ignoreAtoms &&
+        (ignoreAtoms->test(beg->getIdx()) || ignoreAtoms->test(end->getIdx()))) {
+      continue;
+    }
+    nbrs[beg->getIdx()].emplace_back(end->getIdx(), bond->getIdx());
+    nbrs[end->getIdx()].emplace_back(beg->getIdx(), bond->getIdx());
+  }
+
+  PATH_TYPE atomPath;
+  PATH_TYPE bondPath;
+  std::vector<int> posInPath(nAtoms, -1);
+  auto visitFrom = [&](int aidx, bool rooted) {
+    atomPath.assign(1, aidx);
+    posInPath[aidx] = 0;
+    bool res = Subgraphs::visitPathsFrom(nbrs, atomPath, bondPath, posInPath,
+                                         lowerLen, upperLen, rooted, visitor);
+    posInPath[aidx] = -1;
+    return res;
+  };
+  if (rootedAtAtom < 0) {
+    for (int i = 0; i < nAtoms; ++i) {
+      if (ignoreAtoms && ignoreAtoms->test(i)) {
+        continue;
+      }
+      if (!visitFrom(i, false)) {
+        return false;
+      }
+    }
+  } else if (rootedAtAtom < nAtoms &&
+             (!ignoreAtoms || !ignoreAtoms->test(rootedAtAtom))) {
+    return visitFrom(rootedAtAtom, true);
+  }
+  return true;
+}
+
 PATH_TYPE findAtomEnvironmentOfRadiusN(
     const ROMol &mol, unsigned int radius, unsigned int rootedAtAtom,
     bool useHs, bool enforceSize,
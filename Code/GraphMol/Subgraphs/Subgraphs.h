@@ -29,6 +29,7 @@
 #ifndef RD_SUBGRAPHS_H
 #define RD_SUBGRAPHS_H
 
+#include <functional>
 #include <vector>
 #include <list>
 #include <map>
@@ -47,6 +48,9 @@ typedef PATH_LIST::const_iterator PATH_LIST_CI;
 typedef std::map<int, PATH_LIST> INT_PATH_LIST_MAP;
 typedef INT_PATH_LIST_MAP::const_iterator INT_PATH_LIST_MAP_CI;
 typedef INT_PATH_LIST_MAP::iterator INT_PATH_LIST_MAP_I;
+//! called with each path found by the visit functions, returning false stops
+//! the enumeration
+typedef std::function<bool(const PATH_TYPE &)> PATH_VISITOR;
 
 // --- --- --- --- --- --- --- --- --- --- --- --- ---
 //
@@ -141,6 +145,61 @@ RDKIT_SUBGRAPHS_EXPORT INT_PATH_LIST_MAP findAllPathsOfLengthsMtoN(
     bool onlyShortestPaths = false,
     boost::dynamic_bitset<> *ignoreAtoms = nullptr);
 
+//! \brief calls a function with each bond subgraph in a range of sizes
+/*!
+ *   This finds the same subgraphs as findAllSubgraphsOfLengthsMtoN(), but
+ *   they are passed to \c visitor as they are found instead of being
+ *   collected, so the memory used does not grow with the number of
+ *   subgraphs.
+ *
+ *   \param mol - the molecule to be considered
+ *   \param lowerLen - the minimum subgraph size to find
+ *   \param upperLen - the maximum subgraph size to find
+ *   \param visitor - called with each subgraph (a list of bond indices). The
+ *                    path is only valid during the call.
+ *   \param useHs     - if set, hydrogens in the graph will be considered
+ *                      eligible to be in paths. NOTE: this will not add
+ *                      Hs to the graph.
+ *   \param rootedAtAtom - if non-negative, only subgraphs that start at
+ *                         this atom will be visited.
+ *   \param ignoreAtoms - if provided, any subgraph that contains any of
+ *                        the atoms in this set will be ignored
+ *
+ *   \return false if \c visitor stopped the enumeration
+ */
+RDKIT_SUBGRAPHS_EXPORT bool visitAllSubgraphsOfLengthsMtoN(
+    const ROMol &mol, unsigned int lowerLen, unsigned int upperLen,
+    const PATH_VISITOR &visitor, bool useHs = false, int rootedAtAtom = -1,
+    boost::dynamic_bitset<> *ignoreAtoms = nullptr);
+
+//! \brief calls a function with each bond path in a range of sizes
+/*!
+ *   This finds the same paths as findAllPathsOfLengthsMtoN() with
+ *   \c useBonds set and \c onlyShortestPaths not set, though not in the same
+ *   order or necessarily in the same direction. The paths are passed to
+ *   \c visitor as they are found instead of being collected and then
+ *   deduplicated.
+ *
+ *   \param mol - the molecule to be considered
+ *   \param lowerLen - the minimum path length (in bonds) to find
+ *   \param upperLen - the maximum path length (in bonds) to find
+ *   \param visitor - called with each path (a list of bond indices). The
+ *                    path is only valid during the call.
+ *   \param useHs     - if set, hydrogens in the graph will be considered
+ *                      eligible to be in paths. NOTE: this will not add
+ *                      Hs to the graph.
+ *   \param rootedAtAtom - if non-negative, only paths that start at
+ *                         this atom will be visited.
+ *   \param ignoreAtoms - if provided, any path that contains any of
+ *                        the atoms in this set will be ignored
+ *
+ *   \return false if \c visitor stopped the enumeration
+ */
+RDKIT_SUBGRAPHS_EXPORT bool visitAllPathsOfLengthsMtoN(
+    const ROMol &mol, unsigned int lowerLen, unsigned int upperLen,
+    const PATH_VISITOR &visitor, bool useHs = false, int rootedAtAtom = -1,
+    boost::dynamic_bitset<> *ignoreAtoms = nullptr);
+
 //! \brief Find bond subgraphs of a particular radius around an atom.
 //!        Return empty result if there is no bond at the requested radius.
 /*!
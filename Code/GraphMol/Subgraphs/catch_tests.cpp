@@ -149,4 +149,98 @@ TEST_CASE("ignoreAtoms") {
     CHECK(ps3.size() == 1);
     CHECK(ps3[3].empty());
   }
-}
\ No newline at end of file
+}
+TEST_CASE("visiting subgraphs and paths") {
+  // the bond sets, sorted, so that the order and direction of the paths
+  // don't matter
+  auto canon = [](const PATH_LIST &paths) {
+    std::vector<PATH_TYPE> res;
+    for (auto path : paths) {
+      std::sort(path.begin(), path.end());
+      res.push_back(path);
+    }
+    std::sort(res.begin(), res.end());
+    return res;
+  };
+  auto flatten = [](const INT_PATH_LIST_MAP &paths) {
+    PATH_LIST res;
+    for (const auto &[len, lpaths] : paths) {
+      res.insert(res.end(), lpaths.begin(), lpaths.end());
+    }
+    return res;
+  };
+  std::vector<std::string> smileses = {
+      "CCO",
+      "CC1CCC1",
+      "c1ccccc1C(=O)O",
+      "C1CC2CCC1CC2",
+      "C12C3C4C1C5C2C3C45",
+      "CC(C)(C)C1CCC(CC1)[C@H](F)Cl",
+      "[H]C([H])([H])C(=O)N",
+      "C1CCCCCCCCCCC1"};
+  for (const auto &smi : smileses) {
+    INFO(smi);
+    std::unique_ptr<RWMol> m(SmilesToMol(smi, 0, false));
+    REQUIRE(m);
+    m->updatePropertyCache(false);
+    for (auto useHs : {false, true}) {
+      for (auto [lowerLen, upperLen] :
+           std::vector<std::pair<unsigned int, unsigned int>>{
+               {1, 1}, {1, 4}, {2, 6}, {3, 7}, {5, 5}}) {
+        for (int rootedAt : {-1, 0, 2}) {
+          PATH_LIST visited;
+          auto collect = [&visited](const PATH_TYPE &path) {
+            visited.push_back(path);
+            return true;
+          };
+          CHECK(visitAllSubgraphsOfLengthsMtoN(*m, lowerLen, upperLen, collect,
+                                               useHs, rootedAt));
+          auto subgraphs = flatten(findAllSubgraphsOfLengthsMtoN(
+              *m, lowerLen, upperLen, useHs, rootedAt));
+          CHECK(visited.size() == subgraphs.size());
+          CHECK(canon(visited) == canon(subgraphs));
+
+          visited.clear();
+          CHECK(visitAllPathsOfLengthsMtoN(*m, lowerLen, upperLen, collect,
+                                           useHs, rootedAt));
+          auto paths = flatten(findAllPathsOfLengthsMtoN(
+              *m, lowerLen, upperLen, true, useHs, rootedAt));
+          CHECK(visited.size() == paths.size());
+          CHECK(canon(visited) == canon(paths));
+        }
+      }
+    }
+  }
+  SECTION("ignoreAtoms") {
+    auto m = "C1CC2CCC1CC2O"_smiles;
+    REQUIRE(m);
+    boost::dynamic_bitset<> ignore(m->getNumAtoms());
+    ignore.set(1);
+    ignore.set(8);
+    PATH_LIST visited;
+    auto collect = [&visited](const PATH_TYPE &path) {
+      visited.push_back(path);
+      return true;
+    };
+    CHECK(visitAllSubgraphsOfLengthsMtoN(*m, 1, 5, collect, false, -1,
+                                         &ignore));
+    auto subgraphs = findAllSubgraphsOfLengthsMtoN(*m, 1, 5, false, -1, &ignore);
+    CHECK(canon(visited) == canon(flatten(subgraphs)));
+    visited.clear();
+    CHECK(visitAllPathsOfLengthsMtoN(*m, 1, 5, collect, false, -1, &ignore));
+    auto paths =
+        findAllPathsOfLengthsMtoN(*m, 1, 5, true, false, -1, false, &ignore);
+    CHECK(canon(visited) == canon(flatten(paths)));
+  }
+  SECTION("stopping early") {
+    auto m = "c1ccccc1CCCC"_smiles;
+    REQUIRE(m);
+    unsigned int count = 0;
+    auto stopAtTen = [&count](const PATH_TYPE &) { return ++count < 10; };
+    CHECK(!visitAllSubgraphsOfLengthsMtoN(*m, 1, 7, stopAtTen));
+    CHECK(count == 10);
+    count = 0;
+    CHECK(!visitAllPathsOfLengthsMtoN(*m, 1, 7, stopAtTen));
+    CHECK(count == 10);
+  }
+}
@@ -9,30 +9,10 @@
 //
 #include "SubstructLibrary.h"
 #include "PatternFactory.h"
+#include <RDGeneral/RDThreadPool.h>
 #include <RDGeneral/RDThreads.h>
 
-#ifdef RDK_BUILD_THREADSAFE_SSS
-#include <thread>
-#include <future>
-#endif
-
 namespace RDKit {
-namespace {
-void fillPatterns(const SubstructLibrary &slib, const FPHolderBase &fph,
-                  std::vector<ExplicitBitVect *> &fps, unsigned int start,
-                  unsigned int end, unsigned int numThreads) {
-  for (unsigned int idx = start; idx < end; idx += numThreads) {
-    auto mol = slib.getMol(idx);
-    if (mol.get()) {
-      fps[idx] = fph.makeFingerprint(*mol.get());
-    } else {
-      // Make an empty FP
-      fps[idx] = fph.makeFingerprint(ROMol());
-    }
-  }
-}
-}  // namespace
-
 namespace {
 void internalAddPatterns(SubstructLibrary &sslib, int numThreads,
                          boost::shared_ptr<FPHolderBase> *patterns) {
@@ -51,22 +31,15 @@ void internalAddPatterns(SubstructLibrary &sslib, int numThreads,
   unsigned int endIdx = sslib.getMolecules().size();
   fps.resize(endIdx);
 
-#ifdef RDK_BUILD_THREADSAFE_SSS
-  unsigned int startIdx = 0;
-  std::vector<std::future<void>> thread_group;
-  for (int thread_group_idx = 0; thread_group_idx < numThreads;
-       ++thread_group_idx) {
-    // need to use std::ref otherwise things are passed by value
-    thread_group.emplace_back(std::async(
-        std::launch::async, fillPatterns, std::ref(sslib), std::ref(*ptr),
-        std::ref(fps), startIdx + thread_group_idx, endIdx, numThreads));
-  }
-  for (auto &fut : thread_group) {
-    fut.get();
-  }
-#else
-  fillPatterns(sslib, *ptr, fps, 0, sslib.size(), 1);
-#endif
+  parallelFor(endIdx, numThreads, [&](size_t idx) {
+    auto mol = sslib.getMol(idx);
+    if (mol.get()) {
+      fps[idx] = ptr->makeFingerprint(*mol.get());
+    } else {
+      // Make an empty FP
+      fps[idx] = ptr->makeFingerprint(ROMol());
+    }
+  });
   if (ptr->size() != sslib.size()) {
     throw ValueErrorException(
         "Number of fingerprints generated not equal to current number of "
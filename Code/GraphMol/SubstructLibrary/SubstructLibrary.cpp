@@ -31,11 +31,8 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //
 #include "SubstructLibrary.h"
+#include <RDGeneral/RDThreadPool.h>
 #include <RDGeneral/RDThreads.h>
-#ifdef RDK_BUILD_THREADSAFE_SSS
-#include <thread>
-#include <future>
-#endif
 
 #include <GraphMol/Substruct/SubstructMatch.h>
 #include <GraphMol/GeneralizedSubstruct/XQMol.h>
@@ -324,26 +321,21 @@ int internalGetMatches(const Query &query, MolHolderBase &mols,
         ++maxResultsVect[i];
       }
     }
-    std::vector<std::future<void>> thread_group;
     std::vector<std::vector<unsigned int>> internal_results;
-    std::vector<boost::dynamic_bitset<>> internal_found(numThreads);
+    std::vector<boost::dynamic_bitset<>> internal_found(numThreads, found);
     if (idxs) {
       internal_results.resize(numThreads);
     }
+    // each task takes every numThreads-th molecule, just as if it had a
+    // thread of its own
+    parallelFor(numThreads, numThreads, [&](size_t tidx) {
+      SubSearcher<Query>(query, bits, mols, startIdx + tidx, endIdxVect[tidx],
+                         numThreads, needs_rings, counterVect[tidx],
+                         maxResultsVect[tidx], internal_found[tidx],
+                         searchOrder,
+                         idxs ? &internal_results[tidx] : nullptr);
+    });
     int thread_group_idx;
-    for (thread_group_idx = 0; thread_group_idx < numThreads;
-         ++thread_group_idx) {
-      internal_found[thread_group_idx] = found;
-      // need to use boost::ref otherwise things are passed by value
-      thread_group.emplace_back(std::async(
-          std::launch::async, SubSearcher<Query>, std::ref(query), bits,
-          std::ref(mols), startIdx + thread_group_idx,
-          std::ref(endIdxVect[thread_group_idx]), numThreads, needs_rings,
-          std::ref(counterVect[thread_group_idx]),
-          maxResultsVect[thread_group_idx],
-          std::ref(internal_found[thread_group_idx]), std::ref(searchOrder),
-          idxs ? &internal_results[thread_group_idx] : nullptr));
-    }
     unsigned int maxEndIdx;
     if (maxResults > 0) {
       // If we are running with maxResults in a multi-threaded settings,
@@ -354,34 +346,32 @@ int internalGetMatches(const Query &query, MolHolderBase &mols,
       // many molecules as the most productive thread if we want
       // multi-threaded runs to yield the same results independently from the
       // number of threads.
-      thread_group_idx = 0;
-      for (auto &fut : thread_group) {
-        fut.get();
-        counter += counterVect[thread_group_idx++];
+      for (thread_group_idx = 0; thread_group_idx < numThreads;
+           ++thread_group_idx) {
+        counter += counterVect[thread_group_idx];
       }
-      thread_group.clear();
       // Find out out the max number of molecules that was screened by the
       // most productive thread and do the same in all other threads, unless
       // the max number of molecules was reached
       maxEndIdx = *std::max_element(endIdxVect.begin(), endIdxVect.end());
+      std::vector<unsigned int> topUps;
       for (thread_group_idx = 0; thread_group_idx < numThreads;
            ++thread_group_idx) {
         if (endIdxVect[thread_group_idx] >= maxEndIdx) {
           continue;
         }
         internal_found[thread_group_idx] = found;
-        // need to use boost::ref otherwise things are passed by value
-        thread_group.emplace_back(std::async(
-            std::launch::async, SubSearcher<Query>, std::ref(query), bits,
-            std::ref(mols), endIdxVect[thread_group_idx] + numThreads,
-            std::ref(maxEndIdx), numThreads, needs_rings,
-            std::ref(counterVect[thread_group_idx]), -1,
-            std::ref(internal_found[thread_group_idx]), std::ref(searchOrder),
-            &internal_results[thread_group_idx]));
+        topUps.push_back(thread_group_idx);
       }
-    }
-    for (auto &fut : thread_group) {
-      fut.get();
+      parallelFor(topUps.size(), numThreads, [&](size_t i) {
+        const auto tidx = topUps[i];
+        // SubSearcher() updates the end index it is given
+        auto endIdxCopy = maxEndIdx;
+        SubSearcher<Query>(query, bits, mols, endIdxVect[tidx] + numThreads,
+                           endIdxCopy, numThreads, needs_rings,
+                           counterVect[tidx], -1, internal_found[tidx],
+                           searchOrder, &internal_results[tidx]);
+      });
     }
     for (thread_group_idx = 0; thread_group_idx < numThreads;
          ++thread_group_idx) {
@@ -398,7 +388,7 @@ int internalGetMatches(const Query &query, MolHolderBase &mols,
     }
   } else {
     // if this is running single-threaded, no need to suffer the overhead of
-    // std::async
+    // the thread pool
     SubSearcher(query, bits, mols, startIdx, endIdx, 1, needs_rings, counter,
                 maxResults, found, searchOrder, idxs);
   }
@@ -425,6 +425,16 @@ MolOps::SanitizeFlags sanitizeMol(ROMol &mol, boost::uint64_t sanitizeOps,
   return static_cast<MolOps::SanitizeFlags>(operationThatFailed);
 }
 
+void deferSanitization(ROMol &mol, boost::uint64_t sanitizeOps) {
+  auto &wmol = static_cast<RWMol &>(mol);
+  MolOps::deferSanitization(wmol, sanitizeOps);
+}
+
+unsigned int requireSanitization(const ROMol &mol,
+                                 boost::uint64_t sanitizeOps) {
+  return MolOps::requireSanitization(mol, sanitizeOps);
+}
+
 RWMol *getEditable(const ROMol &mol) {
   auto *res = new RWMol(mol, false);
   return res;
@@ -1272,6 +1282,45 @@ struct molops_wrapper {
          python::arg("catchErrors") = false),
         docString.c_str());
 
+    // ------------------------------------------------------------------------
+    docString =
+        "Carries out the cheap sanitization operations and records the others\n\
+as pending, so that they are only carried out once something needs them.\n\
+\n\
+    - The molecule is modified in place.\n\
+\n\
+    - Fingerprint generators and the SMILES writers carry out the pending\n\
+      operations they need. Call RequireSanitization() before using anything\n\
+      else on the molecule.\n\
+\n\
+    - Errors in deferred operations are raised when they are carried out.\n\
+\n\
+  ARGUMENTS:\n\
+\n\
+    - mol: the molecule to be modified\n\
+    - sanitizeOps: (optional) sanitization operations to be carried out\n\
+      these should be constructed by or'ing together the\n\
+      operations in rdkit.Chem.SanitizeFlags\n\
+\n";
+    python::def("DeferSanitization", deferSanitization,
+                (python::arg("mol"),
+                 python::arg("sanitizeOps") = MolOps::SANITIZE_ALL),
+                docString.c_str());
+    python::def("RequireSanitization", requireSanitization,
+                (python::arg("mol"),
+                 python::arg("sanitizeOps") = MolOps::SANITIZE_ALL),
+                "Carries out the pending sanitization operations in sanitizeOps "
+                "(and any pending ones they depend on) and returns the "
+                "operations that were carried out.");
+    python::def("GetPendingSanitization", MolOps::getPendingSanitization,
+                python::args("mol"),
+                "Returns the sanitization operations that are still pending on "
+                "a molecule.");
+    python::def("GetTriggeredSanitization", MolOps::getTriggeredSanitization,
+                python::args("mol"),
+                "Returns the deferred sanitization operations that have been "
+                "carried out on a molecule.");
+
     // ------------------------------------------------------------------------
     docString =
         "Get the smallest set of simple rings for a molecule.\n\
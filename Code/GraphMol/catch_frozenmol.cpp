@@ -0,0 +1,172 @@
+//
+//  Copyright (C) 2026 Greg Landrum and other RDKit contributors
+//
+//   @@ All Rights Reserved @@
+//  This file is part of the RDKit.
+//  The contents are covered by the terms of the BSD license
+//  which is included in the file license.txt, found at the root
+//  of the RDKit source tree.
+//
+
+#include <catch2/catch_all.hpp>
+
+#include <GraphMol/RDKitBase.h>
+#include <GraphMol/FrozenMol.h>
+#include <GraphMol/SmilesParse/SmilesParse.h>
+#include <GraphMol/SmilesParse/SmilesWrite.h>
+
+using namespace RDKit;
+
+TEST_CASE("FrozenMol basics") {
+  auto mol = "C/C=C/[C@H](F)c1ccc[nH]1"_smiles;
+  REQUIRE(mol);
+  FrozenMol frozen(*mol);
+  REQUIRE(frozen.getNumAtoms() == mol->getNumAtoms());
+  REQUIRE(frozen.getNumBonds() == mol->getNumBonds());
+  CHECK(frozen.getNumHeavyAtoms() == mol->getNumHeavyAtoms());
+  CHECK(frozen.getNumAtomsWithHs() == mol->getNumAtoms(false));
+
+  SECTION("atoms") {
+    for (const auto atom : mol->atoms()) {
+      const auto idx = atom->getIdx();
+      const auto &data = frozen.getAtom(idx);
+      CHECK(data.atomicNum == atom->getAtomicNum());
+      CHECK(data.getChiralTag() == atom->getChiralTag());
+      CHECK(data.getHybridization() == atom->getHybridization());
+      CHECK(data.isAromatic == atom->getIsAromatic());
+      CHECK(frozen.getDegree(idx) == atom->getDegree());
+      CHECK(frozen.getTotalDegree(idx) == atom->getTotalDegree());
+      CHECK(frozen.getTotalNumHs(idx) == atom->getTotalNumHs());
+      CHECK(frozen.getMass(idx) == atom->getMass());
+      CHECK(frozen.numAtomRings(idx) ==
+            mol->getRingInfo()->numAtomRings(idx));
+      unsigned int i = 0;
+      for (const auto bond : mol->atomBonds(atom)) {
+        CHECK(frozen.getNeighbors(idx)[i].bond == bond->getIdx());
+        CHECK(frozen.getNeighbors(idx)[i].atom == bond->getOtherAtomIdx(idx));
+        ++i;
+      }
+    }
+  }
+  SECTION("bonds") {
+    for (const auto bond : mol->bonds()) {
+      const auto &data = frozen.getBond(bond->getIdx());
+      CHECK(data.beginAtom == bond->getBeginAtomIdx());
+      CHECK(data.endAtom == bond->getEndAtomIdx());
+      CHECK(data.getBondType() == bond->getBondType());
+      CHECK(data.getStereo() == bond->getStereo());
+      CHECK(frozen.getBondBetweenAtoms(data.endAtom, data.beginAtom) ==
+            static_cast<int>(bond->getIdx()));
+    }
+    CHECK(frozen.getBondBetweenAtoms(0, 5) == -1);
+  }
+  SECTION("rings") {
+    CHECK(frozen.getRingType() == mol->getRingInfo()->getRingType());
+    REQUIRE(frozen.numRings() == 1);
+    CHECK(std::vector<int>(frozen.getRingAtoms(0).begin(),
+                           frozen.getRingAtoms(0).end()) ==
+          mol->getRingInfo()->atomRings()[0]);
+    CHECK(std::vector<int>(frozen.getRingBonds(0).begin(),
+                           frozen.getRingBonds(0).end()) ==
+          mol->getRingInfo()->bondRings()[0]);
+  }
+  SECTION("ring information is found if it is missing") {
+    auto noRings = v2::SmilesParse::MolFromSmiles("C1CC1C");
+    REQUIRE(noRings);
+    noRings->getRingInfo()->reset();
+    FrozenMol frozenNoRings(*noRings);
+    CHECK(frozenNoRings.numRings() == 1);
+    CHECK(frozenNoRings.numAtomRings(3) == 0);
+    CHECK(frozenNoRings.numBondRings(0) == 1);
+  }
+}
+
+TEST_CASE("FrozenMol properties") {
+  auto mol = "CCO"_smiles;
+  REQUIRE(mol);
+  mol->setProp("_Name", "ethanol");
+  mol->setProp("count", 3);
+  mol->getAtomWithIdx(2)->setProp("label", std::string("hydroxyl"));
+  mol->getAtomWithIdx(2)->setProp("weight", 1.5);
+  mol->getAtomWithIdx(0)->setProp("weight", 0.5);
+  mol->getBondWithIdx(1)->setProp("ids", std::vector<int>{1, 2});
+
+  FrozenMol frozen(*mol);
+  // the names are only stored once
+  CHECK(std::count(frozen.getPropNames().begin(), frozen.getPropNames().end(),
+                   "weight") == 1);
+
+  std::string name;
+  CHECK(frozen.getPropIfPresent("_Name", name));
+  CHECK(name == "ethanol");
+  int count = 0;
+  CHECK(frozen.getPropIfPresent("count", count));
+  CHECK(count == 3);
+  CHECK(!frozen.hasProp("label"));
+  CHECK(frozen.hasAtomProp(2, "label"));
+  CHECK(!frozen.hasAtomProp(1, "label"));
+  double weight = 0.0;
+  CHECK(frozen.getAtomPropIfPresent(0, "weight", weight));
+  CHECK(weight == 0.5);
+  CHECK(frozen.getAtomPropIfPresent(2, "weight", weight));
+  CHECK(weight == 1.5);
+  std::vector<int> ids;
+  CHECK(!frozen.getBondPropIfPresent(0, "ids", ids));
+  CHECK(frozen.getBondPropIfPresent(1, "ids", ids));
+  CHECK(ids == std::vector<int>{1, 2});
+
+  SECTION("copies are independent") {
+    std::unique_ptr<FrozenMol> other(new FrozenMol(frozen));
+    FrozenMol copy(*other);
+    other.reset();
+    std::string label;
+    CHECK(copy.getAtomPropIfPresent(2, "label", label));
+    CHECK(label == "hydroxyl");
+    FrozenMol moved(std::move(copy));
+    CHECK(moved.getBondPropIfPresent(1, "ids", ids));
+    copy = moved;
+    CHECK(copy.getAtomPropIfPresent(2, "label", label));
+  }
+}
+
+TEST_CASE("FrozenMol round trips") {
+  for (const auto smi :
+       {"C/C=C/[C@H](F)c1ccc[nH]1", "[13CH3]C(=O)[O-].[Na+]",
+        "[CH2]C1CC1[2H]", "c1ccc2c(c1)CCC1CCCCC21", "[Pt+2].CC"}) {
+    INFO(smi);
+    std::unique_ptr<RWMol> mol(SmilesToMol(smi));
+    REQUIRE(mol);
+    mol->setProp("_Name", "mol");
+    mol->getBondWithIdx(0)->setProp("bondNote", 7);
+    auto conf = new Conformer(mol->getNumAtoms());
+    for (unsigned int i = 0; i < mol->getNumAtoms(); ++i) {
+      conf->setAtomPos(i, RDGeom::Point3D(i, 2.0 * i, 0.5));
+    }
+    conf->set3D(false);
+    mol->addConformer(conf, true);
+
+    FrozenMol frozen(*mol);
+    auto copy = frozen.toMol();
+    REQUIRE(copy);
+    CHECK(MolToSmiles(*copy) == MolToSmiles(*mol));
+    CHECK(copy->getProp<std::string>("_Name") == "mol");
+    CHECK(copy->getBondWithIdx(0)->getProp<int>("bondNote") == 7);
+    CHECK(copy->getRingInfo()->atomRings() == mol->getRingInfo()->atomRings());
+    CHECK(copy->getRingInfo()->bondRings() == mol->getRingInfo()->bondRings());
+    for (const auto atom : mol->atoms()) {
+      const auto other = copy->getAtomWithIdx(atom->getIdx());
+      CHECK(other->getTotalNumHs() == atom->getTotalNumHs());
+      CHECK(other->getHybridization() == atom->getHybridization());
+    }
+    REQUIRE(copy->getNumConformers() == 1);
+    CHECK(!copy->getConformer().is3D());
+    CHECK(copy->getConformer().getAtomPos(mol->getNumAtoms() - 1).y ==
+          2.0 * (mol->getNumAtoms() - 1));
+  }
+}
+
+TEST_CASE("FrozenMol does not support queries") {
+  auto query = "[C,N]C"_smarts;
+  REQUIRE(query);
+  CHECK_THROWS_AS(FrozenMol(*query), ValueErrorException);
+}
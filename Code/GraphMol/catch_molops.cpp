@@ -12,6 +12,7 @@
 
 #include <GraphMol/RDKitBase.h>
 #include <GraphMol/MolOps.h>
+#include <GraphMol/Rings.h>
 #include <GraphMol/Subset.h>
 #include <GraphMol/test_fixtures.h>
 
@@ -884,4 +885,153 @@ TEST_CASE("GitHub #9270: Segfault when calling MolToSmiles on submol") {
     REQUIRE(dblBond->getStereo() == Bond::BondStereo::STEREOTRANS);
     REQUIRE(dblBond->getStereoAtoms() == std::vector<int>{1, 3});
   }
-}
\ No newline at end of file
+}
+TEST_CASE("deferred sanitization") {
+  SECTION("requiring everything is the same as sanitizing") {
+    for (const auto smi :
+         {"c1ccccc1C(=O)[O-]", "C/C=C/[C@H](F)c1ccc[nH]1", "[CH2]C1CC1",
+          "O=c1cc[nH]cc1", "C1=CC=CC=C1[N+](=O)[O-]"}) {
+      INFO(smi);
+      std::unique_ptr<RWMol> expected(SmilesToMol(smi));
+      REQUIRE(expected);
+      v2::SmilesParse::SmilesParserParams ps;
+      ps.sanitize = false;
+      auto mol = v2::SmilesParse::MolFromSmiles(smi, ps);
+      REQUIRE(mol);
+      MolOps::deferSanitization(*mol);
+      CHECK(MolOps::getPendingSanitization(*mol) != 0);
+      MolOps::requireSanitization(*mol);
+      CHECK(MolOps::getPendingSanitization(*mol) == 0);
+      for (const auto atom : mol->atoms()) {
+        const auto other = expected->getAtomWithIdx(atom->getIdx());
+        CHECK(atom->getIsAromatic() == other->getIsAromatic());
+        CHECK(atom->getHybridization() == other->getHybridization());
+        CHECK(atom->getTotalNumHs() == other->getTotalNumHs());
+      }
+      for (const auto bond : mol->bonds()) {
+        const auto other = expected->getBondWithIdx(bond->getIdx());
+        CHECK(bond->getBondType() == other->getBondType());
+        CHECK(bond->getIsConjugated() == other->getIsConjugated());
+      }
+    }
+  }
+  SECTION("only what is needed is done") {
+    v2::SmilesParse::SmilesParserParams ps;
+    ps.sanitize = false;
+    auto mol = v2::SmilesParse::MolFromSmiles("C1=CC=CC=C1CC=C", ps);
+    REQUIRE(mol);
+    MolOps::deferSanitization(*mol);
+    CHECK(!mol->getRingInfo()->isInitialized());
+    auto done = MolOps::requireSanitization(*mol, MolOps::SANITIZE_SYMMRINGS);
+    CHECK(done == MolOps::SANITIZE_SYMMRINGS);
+    CHECK(mol->getRingInfo()->isInitialized());
+    CHECK(!mol->getAtomWithIdx(0)->getIsAromatic());
+
+    done = MolOps::requireSanitization(*mol, MolOps::SANITIZE_SETAROMATICITY);
+    CHECK(done == (MolOps::SANITIZE_KEKULIZE | MolOps::SANITIZE_FINDRADICALS |
+                   MolOps::SANITIZE_SETAROMATICITY));
+    CHECK(mol->getAtomWithIdx(0)->getIsAromatic());
+    CHECK(!mol->getBondWithIdx(7)->getIsConjugated());
+    CHECK(MolOps::getTriggeredSanitization(*mol) ==
+          (done | MolOps::SANITIZE_SYMMRINGS));
+    CHECK((MolOps::getPendingSanitization(*mol) &
+           MolOps::SANITIZE_SETCONJUGATION));
+    // nothing more to do
+    CHECK(MolOps::requireSanitization(*mol, MolOps::SANITIZE_SETAROMATICITY) ==
+          0);
+  }
+  SECTION("the SMILES writer triggers what it needs") {
+    v2::SmilesParse::SmilesParserParams ps;
+    ps.sanitize = false;
+    auto mol = v2::SmilesParse::MolFromSmiles("C1=CC=CC=C1O", ps);
+    REQUIRE(mol);
+    MolOps::deferSanitization(*mol);
+    CHECK(MolToSmiles(*mol) == "Oc1ccccc1");
+    CHECK(MolOps::getPendingSanitization(*mol) == 0);
+  }
+  SECTION("errors happen when the operation is carried out") {
+    v2::SmilesParse::SmilesParserParams ps;
+    ps.sanitize = false;
+    auto mol = v2::SmilesParse::MolFromSmiles("c1cccc1", ps);
+    REQUIRE(mol);
+    MolOps::deferSanitization(*mol);
+    CHECK_NOTHROW(
+        MolOps::requireSanitization(*mol, MolOps::SANITIZE_SYMMRINGS));
+    CHECK_THROWS_AS(
+        MolOps::requireSanitization(*mol, MolOps::SANITIZE_SETAROMATICITY),
+        KekulizeException);
+    // valence errors are never deferred
+    auto bad = v2::SmilesParse::MolFromSmiles("CC(C)(C)(C)C", ps);
+    REQUIRE(bad);
+    CHECK_THROWS_AS(MolOps::deferSanitization(*bad),
+                    AtomValenceException);
+  }
+  SECTION("sanitizing clears the pending operations") {
+    v2::SmilesParse::SmilesParserParams ps;
+    ps.sanitize = false;
+    auto mol = v2::SmilesParse::MolFromSmiles("c1ccccc1", ps);
+    REQUIRE(mol);
+    MolOps::deferSanitization(*mol);
+    MolOps::sanitizeMol(*mol);
+    CHECK(MolOps::getPendingSanitization(*mol) == 0);
+    CHECK(MolOps::getTriggeredSanitization(*mol) == 0);
+  }
+}
+
+TEST_CASE("symmetrized SSSR of molecules with simple ring systems") {
+  // these take the shortcut when every ring family is a single ring
+  for (const auto smi :
+       {"c1ccccc1", "C1CC1CC1CCC1", "c1ccc2ccccc2c1", "C1CC2CCC1CC2",
+        "O=C1N2[C@H]3N4CN5C(=O)N6C7C5N(C2)C(=O)N7CN2C(=O)N5CN1[C@@H]3N(CN1C5C2N("
+        "C1=O)C6)C4=O",
+        "C1CC2CCC1CC1CCC(CC1)CC1CCC(CC1)CC1CCC(CC1)C2", "C12C3C4C1C5C2C3C45"}) {
+    INFO(smi);
+    auto mol = v2::SmilesParse::MolFromSmiles(smi);
+    REQUIRE(mol);
+    auto ringInfo = mol->getRingInfo();
+    REQUIRE(ringInfo->isSymmSssr());
+    // the relevant cycles as enumerated by the RDL
+    auto expected = ringInfo->atomRelevantCycles();
+    CHECK(ringInfo->atomRings() == expected);
+    VECT_INT_VECT bondRings;
+    RingUtils::convertToBonds(ringInfo->atomRings(), bondRings, *mol);
+    CHECK(ringInfo->bondRings() == bondRings);
+  }
+}
+
+TEST_CASE("fused ring information") {
+  auto mol = "c1ccc2cc3ccccc3cc2c1.C1CC1"_smiles;
+  REQUIRE(mol);
+  auto ringInfo = mol->getRingInfo();
+  REQUIRE(ringInfo->numRings() == 4);
+  unsigned int middle = 0;
+  unsigned int cyclopropane = 0;
+  for (unsigned int i = 0; i < ringInfo->numRings(); ++i) {
+    if (ringInfo->numFusedRingNeighbors(i) == 2) {
+      middle = i;
+    }
+    if (ringInfo->atomRings()[i].size() == 3) {
+      cyclopropane = i;
+    }
+  }
+  CHECK(ringInfo->isRingFused(middle));
+  CHECK(!ringInfo->isRingFused(cyclopropane));
+  CHECK(ringInfo->numFusedRingNeighbors(cyclopropane) == 0);
+  CHECK(ringInfo->fusedRingNeighbors(middle).size() == 2);
+  CHECK(!ringInfo->areRingsFused(middle, middle));
+  for (auto other : ringInfo->fusedRingNeighbors(middle)) {
+    CHECK(ringInfo->areRingsFused(middle, other));
+    CHECK(ringInfo->areRingsFused(other, middle));
+    CHECK(!ringInfo->areRingsFused(other, cyclopropane));
+  }
+  CHECK(ringInfo->numFusedBonds(middle) == 2);
+
+  // the fused ring information follows changes to the rings
+  MolOps::fastFindRings(*mol);
+  ringInfo = mol->getRingInfo();
+  REQUIRE(ringInfo->numRings() == 4);
+  for (unsigned int i = 0; i < ringInfo->numRings(); ++i) {
+    CHECK(ringInfo->fusedRingNeighbors(i).empty() ==
+          (ringInfo->atomRings()[i].size() == 3));
+  }
+}
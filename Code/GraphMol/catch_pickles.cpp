@@ -16,6 +16,7 @@
 
 #include <GraphMol/RDKitBase.h>
 #include <GraphMol/MolPickler.h>
+#include <GraphMol/ConformerEnsemble.h>
 #include <GraphMol/FileParsers/FileParsers.h>
 #include <GraphMol/SmilesParse/SmilesParse.h>
 #include <GraphMol/SmilesParse/SmilesWrite.h>
@@ -287,3 +288,91 @@ TEST_CASE("pickling HasPropWithValue queries") {
     }
   }
 }
+
+TEST_CASE("pickling conformer ensembles") {
+  auto mol = "OCC(=O)N"_smiles;
+  REQUIRE(mol);
+  for (unsigned int ci = 0; ci < 3; ++ci) {
+    auto *conf = new Conformer(mol->getNumAtoms());
+    for (unsigned int ai = 0; ai < mol->getNumAtoms(); ++ai) {
+      conf->setAtomPos(ai, RDGeom::Point3D(0.1 * ai + ci, -1.3 * ai, 0.7 * ci));
+    }
+    conf->setId(10 + ci);
+    conf->set3D(ci != 1);
+    mol->addConformer(conf, false);
+  }
+  ConformerEnsemble ensemble(*mol);
+  REQUIRE(ensemble.getNumConformers() == 3);
+  REQUIRE(ensemble.getNumAtoms() == mol->getNumAtoms());
+  CHECK(ensemble.getCoordBlock().size() == 3 * 3 * mol->getNumAtoms());
+
+  SECTION("double") {
+    std::string pkl;
+    MolPickler::pickleConformerEnsemble(ensemble, pkl);
+    ConformerEnsemble ensemble2;
+    MolPickler::conformerEnsembleFromPickle(pkl, ensemble2);
+    CHECK(ensemble2.getNumAtoms() == ensemble.getNumAtoms());
+    CHECK(ensemble2.getCoordBlock() == ensemble.getCoordBlock());
+    for (unsigned int i = 0; i < 3; ++i) {
+      CHECK(ensemble2.getConformerId(i) == 10 + i);
+      CHECK(ensemble2.is3D(i) == (i != 1));
+    }
+    // back onto a molecule
+    RWMol mol2(*mol);
+    mol2.clearConformers();
+    ensemble2.setMolConformers(mol2);
+    REQUIRE(mol2.getNumConformers() == 3);
+    for (unsigned int ci = 10; ci < 13; ++ci) {
+      CHECK(mol2.getConformer(ci).is3D() == mol->getConformer(ci).is3D());
+      for (unsigned int ai = 0; ai < mol->getNumAtoms(); ++ai) {
+        CHECK(mol2.getConformer(ci).getAtomPos(ai).x ==
+              mol->getConformer(ci).getAtomPos(ai).x);
+        CHECK(mol2.getConformer(ci).getAtomPos(ai).z ==
+              mol->getConformer(ci).getAtomPos(ai).z);
+      }
+    }
+  }
+  SECTION("float, with precision conversion") {
+    ConformerEnsembleF fensemble(*mol);
+    std::string pkl;
+    MolPickler::pickleConformerEnsemble(fensemble, pkl);
+    ConformerEnsemble ensemble2;
+    MolPickler::conformerEnsembleFromPickle(pkl, ensemble2);
+    REQUIRE(ensemble2.getNumConformers() == 3);
+    for (unsigned int i = 0; i < ensemble.getCoordBlock().size(); ++i) {
+      CHECK_THAT(ensemble2.getCoordBlock()[i],
+                 Catch::Matchers::WithinAbs(ensemble.getCoordBlock()[i], 1e-5));
+    }
+    MolPickler::pickleConformerEnsemble(ensemble, pkl);
+    ConformerEnsembleF fensemble2;
+    MolPickler::conformerEnsembleFromPickle(pkl, fensemble2);
+    CHECK(fensemble2.getCoordBlock() == fensemble.getCoordBlock());
+  }
+  SECTION("bad pickles") {
+    std::string pkl;
+    MolPickler::pickleConformerEnsemble(ensemble, pkl);
+    ConformerEnsemble ensemble2;
+    CHECK_THROWS_AS(MolPickler::conformerEnsembleFromPickle(
+                        pkl.substr(0, pkl.size() - 10), ensemble2),
+                    MolPicklerException);
+    std::string molPkl;
+    MolPickler::pickleMol(*mol, molPkl);
+    CHECK_THROWS_AS(MolPickler::conformerEnsembleFromPickle(molPkl, ensemble2),
+                    MolPicklerException);
+  }
+  SECTION("molecule pickles are unchanged") {
+    for (unsigned int flags :
+         {0u, static_cast<unsigned int>(PicklerOps::CoordsAsDouble)}) {
+      std::string pkl;
+      MolPickler::pickleMol(*mol, pkl, flags);
+      RWMol mol2(pkl);
+      REQUIRE(mol2.getNumConformers() == 3);
+      ConformerEnsemble ensemble2(mol2);
+      for (unsigned int i = 0; i < ensemble.getCoordBlock().size(); ++i) {
+        CHECK_THAT(ensemble2.getCoordBlock()[i],
+                   Catch::Matchers::WithinAbs(ensemble.getCoordBlock()[i],
+                                              1e-5));
+      }
+    }
+  }
+}
@@ -437,6 +437,16 @@ MolOps::SanitizeFlags sanitizeMol(ROMol &mol, boost::uint64_t sanitizeOps,
   return static_cast<MolOps::SanitizeFlags>(operationThatFailed);
 }
 
+void deferSanitization(ROMol &mol, boost::uint64_t sanitizeOps) {
+  auto &wmol = static_cast<RWMol &>(mol);
+  MolOps::deferSanitization(wmol, sanitizeOps);
+}
+
+unsigned int requireSanitization(const ROMol &mol,
+                                 boost::uint64_t sanitizeOps) {
+  return MolOps::requireSanitization(mol, sanitizeOps);
+}
+
 RWMol *getEditable(const ROMol &mol) {
   auto *res = new RWMol(mol, false);
   return res;
@@ -1267,6 +1277,41 @@ struct molops_wrapper {
           "sanitizeOps"_a = static_cast<boost::uint64_t>(MolOps::SANITIZE_ALL),
           "catchErrors"_a = false, docString.c_str());
 
+    // ------------------------------------------------------------------------
+    docString =
+        "Carries out the cheap sanitization operations and records the others\n\
+as pending, so that they are only carried out once something needs them.\n\
+\n\
+    - The molecule is modified in place.\n\
+\n\
+    - Fingerprint generators and the SMILES writers carry out the pending\n\
+      operations they need. Call RequireSanitization() before using anything\n\
+      else on the molecule.\n\
+\n\
+    - Errors in deferred operations are raised when they are carried out.\n\
+\n\
+  ARGUMENTS:\n\
+\n\
+    - mol: the molecule to be modified\n\
+    - sanitizeOps: (optional) sanitization operations to be carried out\n\
+      these should be constructed by or'ing together the\n\
+      operations in rdkit.Chem.SanitizeFlags\n\
+\n";
+    m.def("DeferSanitization", deferSanitization, "mol"_a,
+          "sanitizeOps"_a = static_cast<boost::uint64_t>(MolOps::SANITIZE_ALL),
+          docString.c_str());
+    m.def("RequireSanitization", requireSanitization, "mol"_a,
+          "sanitizeOps"_a = static_cast<boost::uint64_t>(MolOps::SANITIZE_ALL),
+          "Carries out the pending sanitization operations in sanitizeOps "
+          "(and any pending ones they depend on) and returns the operations "
+          "that were carried out.");
+    m.def("GetPendingSanitization", MolOps::getPendingSanitization, "mol"_a,
+          "Returns the sanitization operations that are still pending on a "
+          "molecule.");
+    m.def("GetTriggeredSanitization", MolOps::getTriggeredSanitization, "mol"_a,
+          "Returns the deferred sanitization operations that have been "
+          "carried out on a molecule.");
+
     // ------------------------------------------------------------------------
     docString =
         "Get the smallest set of simple rings for a molecule.\n\
@@ -18,6 +18,7 @@
 #include <vector>
 #include <algorithm>
 #include "BFGSOpt_SVE.h"
+#include "BFGSOpt_AVX2.h"
 
 namespace BFGSOpt {
 RDKIT_OPTIMIZER_EXPORT extern int HEAD_ONLY_LIBRARY;
@@ -107,8 +108,15 @@ void linearSearch(unsigned int dim, double *oldPt, double oldVal, double *grad,
       resCode = 1;
       break;
     }
-    for (unsigned int i = 0; i < dim; i++) {
-      newPt[i] = oldPt[i] + lambda * dir[i];
+#ifdef RDK_AVX2_AVAILABLE
+    if (cpuHasAVX2()) {
+      avx2Axpy(dim, lambda, dir, oldPt, newPt);
+    } else
+#endif
+    {
+      for (unsigned int i = 0; i < dim; i++) {
+        newPt[i] = oldPt[i] + lambda * dir[i];
+      }
     }
     newVal = func(newPt);
     if (newVal - oldVal <= FUNCTOL * lambda * slope) {
@@ -288,6 +296,14 @@ int minimize(unsigned int dim, double *pos, double gradTol,
       sveHessianVecMul(dim, invHessian.data(), dGrad.data(), hessDGrad.data(),
                        xi.data(), &fac, &fae, &sumDGrad, &sumXi);
     } else
+#endif
+#ifdef RDK_AVX2_AVAILABLE
+    if (cpuHasAVX2()) {
+      // AVX2 path: four rows of the matrix-vector multiply at a time (using
+      // the symmetry of the inverse Hessian for contiguous loads).
+      avx2HessianVecMul(dim, invHessian.data(), dGrad.data(), hessDGrad.data(),
+                        xi.data(), &fac, &fae, &sumDGrad, &sumXi);
+    } else
 #endif
     {
       // Scalar path: fused matrix-vector multiply and dot-product accumulation.
@@ -321,6 +337,14 @@ int minimize(unsigned int dim, double *pos, double gradTol,
         sveHessianRank1Update(dim, invHessian.data(), xi.data(),
                               hessDGrad.data(), dGrad.data(), fac, fad, fae);
       } else
+#endif
+#ifdef RDK_AVX2_AVAILABLE
+      if (cpuHasAVX2()) {
+        // AVX2 path: vectorised update of the upper triangle, mirrored row by
+        // row
+        avx2HessianRank1Update(dim, invHessian.data(), xi.data(),
+                               hessDGrad.data(), dGrad.data(), fac, fad, fae);
+      } else
 #endif
       {
         // Scalar path: upper-triangle-only update (j >= i) followed by
@@ -343,6 +367,11 @@ int minimize(unsigned int dim, double *pos, double gradTol,
     if (cpuHasSVE()) {
       sveHessianVecMulNeg(dim, invHessian.data(), grad.data(), xi.data());
     } else
+#endif
+#ifdef RDK_AVX2_AVAILABLE
+    if (cpuHasAVX2()) {
+      avx2HessianVecMulNeg(dim, invHessian.data(), grad.data(), xi.data());
+    } else
 #endif
     {
       for (unsigned int i = 0; i < dim; i++) {
@@ -0,0 +1,157 @@
+#ifndef RDKIT_NUMERICS_OPTIMIZER_BFGSOPT_AVX2_H
+#define RDKIT_NUMERICS_OPTIMIZER_BFGSOPT_AVX2_H
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#if defined(__has_include)
+#if __has_include(<immintrin.h>)
+#include <immintrin.h>
+#define RDK_AVX2_AVAILABLE 1
+#endif
+#endif
+#endif
+
+// The AVX2 kernels reproduce the scalar code bit for bit: the vector lanes
+// run over independent outputs (rows of the inverse Hessian, elements of a
+// vector) while every individual sum is still accumulated in the scalar
+// order. FMA is deliberately not used since fused rounding would change the
+// results (and with them conformer generation) compared to the scalar path.
+
+namespace BFGSOpt {
+static bool cpuHasAVX2() {
+#ifdef RDK_AVX2_AVAILABLE
+  static const bool result = __builtin_cpu_supports("avx2");
+  return result;
+#else
+  return false;
+#endif
+}
+
+#ifdef RDK_AVX2_AVAILABLE
+
+// ---------------------------------------------------------------------------
+// AVX2 kernel: res = (+/-) invHessian * vec
+//
+// The inverse Hessian is symmetric, so four consecutive rows i..i+3 can be
+// processed at once by streaming contiguous chunks of the rows j instead:
+// invHessian[(i + k) * dim + j] == invHessian[j * dim + i + k].
+// ---------------------------------------------------------------------------
+template <bool negate>
+__attribute__((target("avx2"))) static inline void avx2SymMatVec(
+    unsigned int dim, const double *invHessian, const double *vec,
+    double *res) {
+  unsigned int i = 0;
+  for (; i + 4 <= dim; i += 4) {
+    __m256d acc = _mm256_setzero_pd();
+    const double *col = invHessian + i;
+    for (unsigned int j = 0; j < dim; ++j, col += dim) {
+      const __m256d prod =
+          _mm256_mul_pd(_mm256_loadu_pd(col), _mm256_set1_pd(vec[j]));
+      acc = negate ? _mm256_sub_pd(acc, prod) : _mm256_add_pd(acc, prod);
+    }
+    _mm256_storeu_pd(res + i, acc);
+  }
+  for (; i < dim; ++i) {
+    const double *ivh = invHessian + i * dim;
+    double acc = 0.0;
+    for (unsigned int j = 0; j < dim; ++j) {
+      if (negate) {
+        acc -= ivh[j] * vec[j];
+      } else {
+        acc += ivh[j] * vec[j];
+      }
+    }
+    res[i] = acc;
+  }
+}
+
+// ---------------------------------------------------------------------------
+// AVX2 kernel: hessDGrad = invHessian * dGrad, then the four dot products
+// (fac, fae, sumDGrad, sumXi) needed for the BFGS update. The dot products
+// are O(dim) and stay scalar to keep their summation order.
+// ---------------------------------------------------------------------------
+__attribute__((target("avx2"))) static inline void avx2HessianVecMul(
+    unsigned int dim, const double *invHessian, const double *dGrad,
+    double *hessDGrad, const double *xi, double *outFac, double *outFae,
+    double *outSumDGrad, double *outSumXi) {
+  avx2SymMatVec<false>(dim, invHessian, dGrad, hessDGrad);
+  double fac = 0.0, fae = 0.0, sumDGrad = 0.0, sumXi = 0.0;
+  for (unsigned int i = 0; i < dim; ++i) {
+    fac += dGrad[i] * xi[i];
+    fae += dGrad[i] * hessDGrad[i];
+    sumDGrad += dGrad[i] * dGrad[i];
+    sumXi += xi[i] * xi[i];
+  }
+  *outFac = fac;
+  *outFae = fae;
+  *outSumDGrad = sumDGrad;
+  *outSumXi = sumXi;
+}
+
+// ---------------------------------------------------------------------------
+// AVX2 kernel: symmetric update of the inverse Hessian approximation. Only
+// the upper triangle is computed, the lower one is mirrored afterwards.
+// ---------------------------------------------------------------------------
+__attribute__((target("avx2"))) static inline void avx2HessianRank1Update(
+    unsigned int dim, double *invHessian, const double *xi,
+    const double *hessDGrad, const double *dGrad, double fac, double fad,
+    double fae) {
+  for (unsigned int i = 0; i < dim; i++) {
+    const double pxi = fac * xi[i];
+    const double hdgi = fad * hessDGrad[i];
+    const double dgi = fae * dGrad[i];
+    const __m256d vpxi = _mm256_set1_pd(pxi);
+    const __m256d vhdgi = _mm256_set1_pd(hdgi);
+    const __m256d vdgi = _mm256_set1_pd(dgi);
+    double *row = invHessian + i * dim;
+    unsigned int j = i;
+    for (; j + 4 <= dim; j += 4) {
+      // same evaluation order as the scalar expression
+      __m256d upd =
+          _mm256_sub_pd(_mm256_mul_pd(vpxi, _mm256_loadu_pd(xi + j)),
+                        _mm256_mul_pd(vhdgi, _mm256_loadu_pd(hessDGrad + j)));
+      upd =
+          _mm256_add_pd(upd, _mm256_mul_pd(vdgi, _mm256_loadu_pd(dGrad + j)));
+      _mm256_storeu_pd(row + j, _mm256_add_pd(_mm256_loadu_pd(row + j), upd));
+    }
+    for (; j < dim; ++j) {
+      row[j] += pxi * xi[j] - hdgi * hessDGrad[j] + dgi * dGrad[j];
+    }
+    for (unsigned int j2 = i + 1; j2 < dim; j2++) {
+      invHessian[j2 * dim + i] = row[j2];
+    }
+  }
+}
+
+// ---------------------------------------------------------------------------
+// AVX2 kernel: new search direction xi = -(invHessian * grad)
+// ---------------------------------------------------------------------------
+__attribute__((target("avx2"))) static inline void avx2HessianVecMulNeg(
+    unsigned int dim, const double *invHessian, const double *grad,
+    double *xi) {
+  avx2SymMatVec<true>(dim, invHessian, grad, xi);
+}
+
+// ---------------------------------------------------------------------------
+// AVX2 kernel for linearSearch(): the trial point newPt = oldPt + lambda * dir
+// ---------------------------------------------------------------------------
+__attribute__((target("avx2"))) static inline void avx2Axpy(
+    unsigned int dim, double lambda, const double *dir, const double *oldPt,
+    double *newPt) {
+  const __m256d vl = _mm256_set1_pd(lambda);
+  unsigned int i = 0;
+  for (; i + 4 <= dim; i += 4) {
+    _mm256_storeu_pd(
+        newPt + i, _mm256_add_pd(_mm256_loadu_pd(oldPt + i),
+                                 _mm256_mul_pd(vl, _mm256_loadu_pd(dir + i))));
+  }
+  for (; i < dim; ++i) {
+    newPt[i] = oldPt[i] + lambda * dir[i];
+  }
+}
+
+#endif
+
+}  // namespace BFGSOpt
+
+#endif  // RDKIT_NUMERICS_OPTIMIZER_BFGSOPT_AVX2_H
@@ -9,6 +9,8 @@
 //
 #include <RDGeneral/test.h>
 #include <cmath>
+#include <random>
+#include <vector>
 #include <RDGeneral/Invariant.h>
 #include <catch2/catch_all.hpp>
 
@@ -193,3 +195,83 @@ TEST_CASE("testBFGSOptimizationNegativeEnergy") {
   REQUIRE_THAT(oLoc[0], Catch::Matchers::WithinAbs(3.0, 1e-3));
   REQUIRE_THAT(oLoc[1], Catch::Matchers::WithinAbs(-1.0, 1e-3));
 }
+
+#ifdef RDK_AVX2_AVAILABLE
+// The AVX2 kernels are expected to reproduce the scalar code exactly, not
+// just within a tolerance, so that conformer generation does not depend on
+// the CPU it runs on.
+TEST_CASE("AVX2 kernels match the scalar code") {
+  if (!BFGSOpt::cpuHasAVX2()) {
+    return;
+  }
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist(-2.0, 2.0);
+  for (unsigned int dim : {1u, 3u, 4u, 7u, 12u, 30u}) {
+    std::vector<double> invHessian(dim * dim);
+    for (unsigned int i = 0; i < dim; ++i) {
+      for (unsigned int j = i; j < dim; ++j) {
+        invHessian[i * dim + j] = invHessian[j * dim + i] = dist(gen);
+      }
+    }
+    std::vector<double> xi(dim), dGrad(dim), grad(dim);
+    for (unsigned int i = 0; i < dim; ++i) {
+      xi[i] = dist(gen);
+      dGrad[i] = dist(gen);
+      grad[i] = dist(gen);
+    }
+
+    std::vector<double> hessDGrad(dim), refHessDGrad(dim);
+    double fac, fae, sumDGrad, sumXi;
+    double refFac = 0, refFae = 0, refSumDGrad = 0, refSumXi = 0;
+    BFGSOpt::avx2HessianVecMul(dim, invHessian.data(), dGrad.data(),
+                               hessDGrad.data(), xi.data(), &fac, &fae,
+                               &sumDGrad, &sumXi);
+    for (unsigned int i = 0; i < dim; ++i) {
+      for (unsigned int j = 0; j < dim; ++j) {
+        refHessDGrad[i] += invHessian[i * dim + j] * dGrad[j];
+      }
+      refFac += dGrad[i] * xi[i];
+      refFae += dGrad[i] * refHessDGrad[i];
+      refSumDGrad += dGrad[i] * dGrad[i];
+      refSumXi += xi[i] * xi[i];
+    }
+    CHECK(hessDGrad == refHessDGrad);
+    CHECK(fac == refFac);
+    CHECK(fae == refFae);
+    CHECK(sumDGrad == refSumDGrad);
+    CHECK(sumXi == refSumXi);
+
+    auto refInvHessian = invHessian;
+    BFGSOpt::avx2HessianRank1Update(dim, invHessian.data(), xi.data(),
+                                    hessDGrad.data(), dGrad.data(), 0.3, 0.7,
+                                    1.1);
+    for (unsigned int i = 0; i < dim; ++i) {
+      double pxi = 0.3 * xi[i], hdgi = 0.7 * hessDGrad[i],
+             dgi = 1.1 * dGrad[i];
+      for (unsigned int j = i; j < dim; ++j) {
+        refInvHessian[i * dim + j] +=
+            pxi * xi[j] - hdgi * hessDGrad[j] + dgi * dGrad[j];
+        refInvHessian[j * dim + i] = refInvHessian[i * dim + j];
+      }
+    }
+    CHECK(invHessian == refInvHessian);
+
+    std::vector<double> newXi(dim), refNewXi(dim);
+    BFGSOpt::avx2HessianVecMulNeg(dim, invHessian.data(), grad.data(),
+                                  newXi.data());
+    for (unsigned int i = 0; i < dim; ++i) {
+      for (unsigned int j = 0; j < dim; ++j) {
+        refNewXi[i] -= invHessian[i * dim + j] * grad[j];
+      }
+    }
+    CHECK(newXi == refNewXi);
+
+    std::vector<double> newPt(dim), refNewPt(dim);
+    BFGSOpt::avx2Axpy(dim, 0.37, xi.data(), grad.data(), newPt.data());
+    for (unsigned int i = 0; i < dim; ++i) {
+      refNewPt[i] = grad[i] + 0.37 * xi[i];
+    }
+    CHECK(newPt == refNewPt);
+  }
+}
+#endif
@@ -16,6 +16,7 @@
 #include <cstdlib>
 
 #include <RDGeneral/RDLog.h>
+#include <RDGeneral/RDThreadPool.h>
 
 namespace python = boost::python;
 namespace logging = boost::logging;
@@ -438,6 +439,12 @@ BOOST_PYTHON_MODULE(rdBase) {
               "of the RDKit C++ components.",
               (python::arg("seed")));
 
+  python::def("SetThreadPoolSize", RDKit::setThreadPoolSize,
+              "Sets the number of worker threads shared by the multithreaded "
+              "RDKit functions.\n"
+              "Values <= 0 mean use all available threads less that number.",
+              (python::arg("numThreads")));
+
   python_streambuf_wrapper::wrap();
   python_ostream_wrapper::wrap();
 
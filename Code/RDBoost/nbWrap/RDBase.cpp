@@ -20,6 +20,7 @@
 #include <nanobind/stl/string.h>
 
 #include <RDGeneral/RDLog.h>
+#include <RDGeneral/RDThreadPool.h>
 
 namespace nb = nanobind;
 using namespace nb::literals;
@@ -423,6 +424,11 @@ NB_MODULE(rdBase, m) {
         "This does not affect pure Python code, but is relevant to some "
         "of the RDKit C++ components.");
 
+  m.def("SetThreadPoolSize", RDKit::setThreadPoolSize, "numThreads"_a,
+        "Sets the number of worker threads shared by the multithreaded "
+        "RDKit functions.\n"
+        "Values <= 0 mean use all available threads less that number.");
+
   nb::class_<BlockLogs>(
       m, "BlockLogs",
       "Temporarily block logs from outputting while this instance is in scope.")
@@ -16,6 +16,9 @@
 #ifndef RD_DICT_H_012020
 #define RD_DICT_H_012020
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -31,7 +34,8 @@ typedef std::vector<std::string> STR_VECT;
 //! \brief The \c Dict class can be used to store objects of arbitrary
 //!        type keyed by \c strings.
 //!
-//!  The actual storage is done using \c RDValue objects.
+//!  The actual storage is done using \c RDValue objects. Copies of a
+//!  dictionary share the storage until one of them is modified.
 //!
 class RDKIT_RDGENERAL_EXPORT Dict {
  public:
@@ -53,44 +57,27 @@ class RDKIT_RDGENERAL_EXPORT Dict {
 
   Dict() {}
 
-  Dict(const Dict &other) : _data(other._data) {
-    _hasNonPodData = other._hasNonPodData;
-    if (other._hasNonPodData) {  // other has non pod data, need to copy
-      std::vector<Pair> data(other._data.size());
-      _data.swap(data);
-      for (size_t i = 0; i < _data.size(); ++i) {
-        _data[i].key = other._data[i].key;
-        copy_rdvalue(_data[i].val, other._data[i].val);
-      }
-    }
-  }
-
+  //! copies share their storage until one of them is modified
+  Dict(const Dict &other) = default;
   Dict(Dict &&other) noexcept = default;
-
-  ~Dict() {
-    reset();  // to clear pointers if necessary
-  }
+  ~Dict() = default;
 
   void update(const Dict &other, bool preserveExisting = false) {
-    if (!preserveExisting) {
+    if (!preserveExisting || empty()) {
       *this = other;
-    } else {
-      if (other._hasNonPodData) {
-        _hasNonPodData = true;
+    } else if (!other.empty() && _storage != other._storage) {
+      auto &storage = getMutableStorage();
+      if (other._storage->hasNonPodData) {
+        storage.hasNonPodData = true;
       }
-      for (const auto &opair : other._data) {
-        Pair *target = nullptr;
-        for (auto &dpair : _data) {
-          if (dpair.key == opair.key) {
-            target = &dpair;
-            break;
-          }
-        }
-
+      for (size_t i = 0; i < other._storage->data.size(); ++i) {
+        const auto &opair = other._storage->data[i];
+        Pair *target = findPair(opair.key, other._storage->keyHashes[i]);
         if (!target) {
           // need to create blank entry and copy
-          _data.push_back(Pair(opair.key));
-          copy_rdvalue(_data.back().val, opair.val);
+          storage.data.push_back(Pair(opair.key));
+          storage.keyHashes.push_back(other._storage->keyHashes[i]);
+          copy_rdvalue(storage.data.back().val, opair.val);
         } else {
           // just copy
           copy_rdvalue(target->val, opair.val);
@@ -99,74 +86,72 @@ class RDKIT_RDGENERAL_EXPORT Dict {
     }
   }
 
-  Dict &operator=(const Dict &other) {
-    if (this == &other) {
-      return *this;
-    }
-    if (_hasNonPodData) {
-      reset();
-    }
+  Dict &operator=(const Dict &other) = default;
+  Dict &operator=(Dict &&other) noexcept = default;
 
-    if (other._hasNonPodData) {
-      std::vector<Pair> data(other._data.size());
-      _data.swap(data);
-      for (size_t i = 0; i < _data.size(); ++i) {
-        _data[i].key = other._data[i].key;
-        copy_rdvalue(_data[i].val, other._data[i].val);
-      }
-    } else {
-      _data = other._data;
+  //----------------------------------------------------------
+  //! \brief Returns the hash used to look up a key
+  /*!
+     Each entry stores the hash of its key, so lookups only compare the
+     full key strings when the hashes match.
+  */
+  static constexpr std::uint32_t hashKey(const std::string_view key) {
+    // 32 bit FNV-1a
+    std::uint32_t res = 2166136261u;
+    for (const auto c : key) {
+      res = (res ^ static_cast<unsigned char>(c)) * 16777619u;
     }
-    _hasNonPodData = other._hasNonPodData;
-    return *this;
+    return res;
   }
 
-  Dict &operator=(Dict &&other) noexcept {
-    if (this == &other) {
-      return *this;
-    }
-    if (_hasNonPodData) {
-      reset();
-    }
-    _hasNonPodData = other._hasNonPodData;
-    other._hasNonPodData = false;
-    _data = std::move(other._data);
-    return *this;
-  }
+  //! \brief Returns whether or not this dictionary shares its storage with
+  //!        a copy
+  bool isShared() const { return _storage && _storage.use_count() > 1; }
 
   //----------------------------------------------------------
   //! \brief Returns the number of entries in the dictionary
-  std::size_t size() const { return _data.size(); }
+  std::size_t size() const { return _storage ? _storage->data.size() : 0; }
 
   //! \brief Returns whether the dictionary is empty
-  bool empty() const { return _data.empty(); }
+  bool empty() const { return !_storage || _storage->data.empty(); }
 
   using const_iterator = DataType::const_iterator;
-  const_iterator begin() const { return _data.begin(); }
-  const_iterator end() const { return _data.end(); }
+  const_iterator begin() const {
+    return _storage ? _storage->data.cbegin() : const_iterator();
+  }
+  const_iterator end() const {
+    return _storage ? _storage->data.cend() : const_iterator();
+  }
 
   //! \brief Appends a populated Pair to the dictionary.
   void insert(Pair &&pair) {
-    _hasNonPodData |= pair.val.needsCleanup();
-    _data.push_back(std::move(pair));
+    auto &storage = getMutableStorage();
+    storage.hasNonPodData |= pair.val.needsCleanup();
+    storage.keyHashes.push_back(hashKey(pair.key));
+    storage.data.push_back(std::move(pair));
   }
 
   //! \brief Bulk-appends a vector of Pairs, moving them into the dictionary.
   void extend(std::vector<Pair> &&pairs) {
+    if (pairs.empty()) {
+      return;
+    }
+    auto &storage = getMutableStorage();
+    storage.keyHashes.reserve(storage.keyHashes.size() + pairs.size());
     for (auto &p : pairs) {
-      _hasNonPodData |= p.val.needsCleanup();
+      storage.hasNonPodData |= p.val.needsCleanup();
+      storage.keyHashes.push_back(hashKey(p.key));
     }
-    _data.insert(_data.end(), std::make_move_iterator(pairs.begin()),
-                 std::make_move_iterator(pairs.end()));
+    storage.data.insert(storage.data.end(),
+                        std::make_move_iterator(pairs.begin()),
+                        std::make_move_iterator(pairs.end()));
   }
 
   //! \brief Returns a const reference to the RDValue for a key.
   //! Throws KeyErrorException if the key is not found.
   const RDValue &getRDValue(const std::string_view what) const {
-    for (const auto &data : _data) {
-      if (data.key == what) {
-        return data.val;
-      }
+    if (const auto pair = findPair(what)) {
+      return pair->val;
     }
     throw KeyErrorException(what);
   }
@@ -176,12 +161,7 @@ class RDKIT_RDGENERAL_EXPORT Dict {
   //! \brief Returns whether or not the dictionary contains a particular
   //!        key.
   bool hasVal(const std::string_view what) const {
-    for (const auto &data : _data) {
-      if (data.key == what) {
-        return true;
-      }
-    }
-    return false;
+    return findPair(what) != nullptr;
   }
 
   //----------------------------------------------------------
@@ -191,8 +171,8 @@ class RDKIT_RDGENERAL_EXPORT Dict {
   */
   STR_VECT keys() const {
     STR_VECT res;
-    res.reserve(_data.size());
-    for (const auto &item : _data) {
+    res.reserve(size());
+    for (const auto &item : *this) {
       res.push_back(item.key);
     }
     return res;
@@ -219,21 +199,17 @@ class RDKIT_RDGENERAL_EXPORT Dict {
   //! \overload
   template <typename T>
   T getVal(const std::string_view what) const {
-    for (auto &data : _data) {
-      if (data.key == what) {
-        return from_rdvalue<T>(data.val);
-      }
+    if (const auto pair = findPair(what)) {
+      return from_rdvalue<T>(pair->val);
     }
     throw KeyErrorException(what);
   }
 
   //! \overload
   void getVal(const std::string_view what, std::string &res) const {
-    for (const auto &i : _data) {
-      if (i.key == what) {
-        rdvalue_tostring(i.val, res);
-        return;
-      }
+    if (const auto pair = findPair(what)) {
+      rdvalue_tostring(pair->val, res);
+      return;
     }
     throw KeyErrorException(what);
   }
@@ -254,22 +230,18 @@ class RDKIT_RDGENERAL_EXPORT Dict {
   */
   template <typename T>
   bool getValIfPresent(const std::string_view what, T &res) const {
-    for (const auto &data : _data) {
-      if (data.key == what) {
-        res = from_rdvalue<T>(data.val);
-        return true;
-      }
+    if (const auto pair = findPair(what)) {
+      res = from_rdvalue<T>(pair->val);
+      return true;
     }
     return false;
   }
 
   //! \overload
   bool getValIfPresent(const std::string_view what, std::string &res) const {
-    for (const auto &i : _data) {
-      if (i.key == what) {
-        rdvalue_tostring(i.val, res);
-        return true;
-      }
+    if (const auto pair = findPair(what)) {
+      rdvalue_tostring(pair->val, res);
+      return true;
     }
     return false;
   }
@@ -294,15 +266,8 @@ class RDKIT_RDGENERAL_EXPORT Dict {
     if (what.empty()) {
       throw ValueErrorException("Cannot set value with empty key");
     }
-    _hasNonPodData = true;
-    for (auto &&data : _data) {
-      if (data.key == what) {
-        RDValue::cleanup_rdvalue(data.val);
-        data.val = val;
-        return;
-      }
-    }
-    _data.push_back(Pair(what, val));
+    getMutableStorage().hasNonPodData = true;
+    storeVal(what, val);
   }
 
   template <typename T>
@@ -313,14 +278,8 @@ class RDKIT_RDGENERAL_EXPORT Dict {
       throw ValueErrorException("Cannot set value with empty key");
     }
     // don't change the hasNonPodData status
-    for (auto &&data : _data) {
-      if (data.key == what) {
-        RDValue::cleanup_rdvalue(data.val);
-        data.val = val;
-        return;
-      }
-    }
-    _data.push_back(Pair(what, val));
+    getMutableStorage();
+    storeVal(what, val);
   }
 
   void setVal(const std::string_view what, bool val) {
@@ -375,12 +334,18 @@ class RDKIT_RDGENERAL_EXPORT Dict {
 
   */
   void clearVal(const std::string_view what) {
-    for (auto it = _data.begin(); it < _data.end(); ++it) {
-      if (it->key == what) {
-        if (_hasNonPodData) {
-          RDValue::cleanup_rdvalue(it->val);
+    if (!hasVal(what)) {
+      return;
+    }
+    auto &storage = getMutableStorage();
+    const auto hash = hashKey(what);
+    for (size_t i = 0; i < storage.data.size(); ++i) {
+      if (storage.keyHashes[i] == hash && storage.data[i].key == what) {
+        if (storage.hasNonPodData) {
+          RDValue::cleanup_rdvalue(storage.data[i].val);
         }
-        _data.erase(it);
+        storage.data.erase(storage.data.begin() + i);
+        storage.keyHashes.erase(storage.keyHashes.begin() + i);
         return;
       }
     }
@@ -389,20 +354,83 @@ class RDKIT_RDGENERAL_EXPORT Dict {
   //----------------------------------------------------------
   //! \brief Clears all keys (and values) from the dictionary.
   //!
-  void reset() {
-    if (_hasNonPodData) {
-      for (auto &&data : _data) {
-        RDValue::cleanup_rdvalue(data.val);
+  void reset() { _storage.reset(); }
+
+ private:
+  //! the entries along with the hashes of their keys
+  struct Storage {
+    DataType data;
+    std::vector<std::uint32_t> keyHashes;
+    bool hasNonPodData{false};  // if true, need a deep copy
+                                //  (copy_rdvalue)
+
+    Storage() = default;
+    Storage(const Storage &other)
+        : keyHashes(other.keyHashes), hasNonPodData(other.hasNonPodData) {
+      if (hasNonPodData) {
+        data.resize(other.data.size());
+        for (size_t i = 0; i < data.size(); ++i) {
+          data[i].key = other.data[i].key;
+          copy_rdvalue(data[i].val, other.data[i].val);
+        }
+      } else {
+        data = other.data;
       }
     }
-    DataType data;
-    _data.swap(data);
+    Storage &operator=(const Storage &) = delete;
+    ~Storage() {
+      if (hasNonPodData) {
+        for (auto &&pair : data) {
+          RDValue::cleanup_rdvalue(pair.val);
+        }
+      }
+    }
+  };
+
+  const Pair *findPair(const std::string_view what) const {
+    return _storage ? findPair(what, hashKey(what)) : nullptr;
+  }
+  Pair *findPair(const std::string_view what, std::uint32_t hash) const {
+    if (!_storage) {
+      return nullptr;
+    }
+    const auto &hashes = _storage->keyHashes;
+    for (size_t i = 0; i < hashes.size(); ++i) {
+      if (hashes[i] == hash && _storage->data[i].key == what) {
+        return &_storage->data[i];
+      }
+    }
+    return nullptr;
   }
 
- private:
-  DataType _data{};            //!< the actual dictionary
-  bool _hasNonPodData{false};  // if true, need a deep copy
-                               //  (copy_rdvalue)
+  //! returns storage that is not shared with any copies of this dictionary
+  Storage &getMutableStorage() {
+    if (!_storage) {
+      _storage = std::make_shared<Storage>();
+    } else if (_storage.use_count() > 1) {
+      _storage = std::make_shared<Storage>(*_storage);
+    } else {
+      // pairs with the release done when the last copy let go of the
+      // storage
+      std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    return *_storage;
+  }
+
+  //! the storage must not be shared when this is called
+  template <typename T>
+  void storeVal(const std::string_view what, T &val) {
+    const auto hash = hashKey(what);
+    if (auto pair = findPair(what, hash)) {
+      RDValue::cleanup_rdvalue(pair->val);
+      pair->val = val;
+      return;
+    }
+    _storage->data.push_back(Pair(what, val));
+    _storage->keyHashes.push_back(hash);
+  }
+
+  std::shared_ptr<Storage> _storage;  //!< the actual dictionary
 };
 
 template <>
@@ -0,0 +1,247 @@
+//
+//  Copyright (C) 2026 Greg Landrum and other RDKit contributors
+//
+//   @@ All Rights Reserved @@
+//  This file is part of the RDKit.
+//  The contents are covered by the terms of the BSD license
+//  which is included in the file license.txt, found at the root
+//  of the RDKit source tree.
+//
+
+#include "RDThreadPool.h"
+#include "RDThreads.h"
+
+#include <algorithm>
+
+#ifdef RDK_BUILD_THREADSAFE_SSS
+#include <exception>
+#endif
+
+namespace RDKit {
+
+#ifdef RDK_BUILD_THREADSAFE_SSS
+namespace {
+thread_local ThreadPool *tl_pool = nullptr;
+thread_local unsigned int tl_workerIdx = 0;
+
+std::mutex &getPoolMutex() {
+  static std::mutex poolMutex;
+  return poolMutex;
+}
+// Never destroyed: joining the workers while the process exits is not safe
+// on every platform.
+std::shared_ptr<ThreadPool> &getPoolInstance() {
+  static auto *pool = new std::shared_ptr<ThreadPool>();
+  return *pool;
+}
+
+// The state shared by the calling thread and the helpers of one call to
+// parallelFor()
+struct ParallelForJob {
+  std::atomic<size_t> nextItem{0};
+  std::mutex mutex;
+  std::condition_variable finished;
+  unsigned int numActive{0};
+  bool closed{false};
+  std::exception_ptr error;
+};
+}  // namespace
+
+ThreadPool::ThreadPool(unsigned int numWorkers) {
+  numWorkers = std::max(numWorkers, 1u);
+  d_queues.reserve(numWorkers);
+  for (unsigned int i = 0; i < numWorkers; ++i) {
+    d_queues.emplace_back(new WorkQueue);
+  }
+  d_workers.reserve(numWorkers);
+  for (unsigned int i = 0; i < numWorkers; ++i) {
+    d_workers.emplace_back(&ThreadPool::workerLoop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_stop = true;
+  }
+  d_wakeUp.notify_all();
+  for (auto &worker : d_workers) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+ThreadPool *ThreadPool::getCurrentPool() { return tl_pool; }
+
+void ThreadPool::submit(std::function<void()> task) {
+  // workers keep the tasks they create for themselves, everything else is
+  // spread over the queues
+  const auto queueIdx = tl_pool == this
+                            ? tl_workerIdx
+                            : d_nextQueue++ % static_cast<unsigned int>(
+                                                  d_queues.size());
+  {
+    std::lock_guard<std::mutex> lock(d_mutex);
+    ++d_numQueued;
+  }
+  {
+    auto &queue = *d_queues[queueIdx];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  d_wakeUp.notify_one();
+}
+
+bool ThreadPool::popTask(unsigned int queueIdx, std::function<void()> &task) {
+  // the newest task from our own queue ...
+  {
+    auto &queue = *d_queues[queueIdx];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+      --d_numQueued;
+      return true;
+    }
+  }
+  // ... or the oldest one from somebody else's
+  const auto numQueues = static_cast<unsigned int>(d_queues.size());
+  for (unsigned int i = 1; i < numQueues; ++i) {
+    auto &queue = *d_queues[(queueIdx + i) % numQueues];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      --d_numQueued;
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::workerLoop(unsigned int workerIdx) {
+  tl_pool = this;
+  tl_workerIdx = workerIdx;
+  std::function<void()> task;
+  while (true) {
+    if (popTask(workerIdx, task)) {
+      task();
+      task = nullptr;
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(d_mutex);
+    d_wakeUp.wait(lock, [this] { return d_stop || d_numQueued > 0; });
+    if (d_stop && !d_numQueued) {
+      return;
+    }
+  }
+}
+
+void ThreadPool::parallelFor(size_t numItems, unsigned int numThreads,
+                             const std::function<void(size_t)> &func) {
+  const auto numHelpers = static_cast<unsigned int>(std::min<size_t>(
+      std::min<size_t>(numThreads, numItems) - 1, getNumWorkers()));
+  if (!numThreads || !numHelpers) {
+    for (size_t i = 0; i < numItems; ++i) {
+      func(i);
+    }
+    return;
+  }
+
+  auto job = std::make_shared<ParallelForJob>();
+  auto runItems = [&job, &func, numItems]() {
+    size_t i;
+    while ((i = job->nextItem++) < numItems) {
+      try {
+        func(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        if (!job->error) {
+          job->error = std::current_exception();
+        }
+        job->nextItem = numItems;
+      }
+    }
+  };
+  // Helpers that only get to run once the job has been closed return
+  // straight away, so nothing here waits for a task that hasn't started.
+  // The ones that do join in keep this frame alive until they are done.
+  for (unsigned int i = 0; i < numHelpers; ++i) {
+    submit([job, &runItems]() {
+      {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        if (job->closed) {
+          return;
+        }
+        ++job->numActive;
+      }
+      runItems();
+      {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        --job->numActive;
+      }
+      job->finished.notify_all();
+    });
+  }
+  runItems();
+  std::unique_lock<std::mutex> lock(job->mutex);
+  job->closed = true;
+  job->finished.wait(lock, [&job] { return !job->numActive; });
+  if (job->error) {
+    std::rethrow_exception(job->error);
+  }
+}
+
+std::shared_ptr<ThreadPool> getThreadPool() {
+  std::lock_guard<std::mutex> lock(getPoolMutex());
+  auto &pool = getPoolInstance();
+  if (!pool) {
+    pool = std::make_shared<ThreadPool>(getNumThreadsToUse(0));
+  }
+  return pool;
+}
+
+void setThreadPoolSize(int numThreads) {
+  std::shared_ptr<ThreadPool> oldPool;
+  {
+    std::lock_guard<std::mutex> lock(getPoolMutex());
+    auto &pool = getPoolInstance();
+    if (pool && pool->getNumWorkers() == getNumThreadsToUse(numThreads)) {
+      return;
+    }
+    oldPool = std::move(pool);
+    pool = std::make_shared<ThreadPool>(getNumThreadsToUse(numThreads));
+  }
+  // the old workers are joined here, outside the lock, unless a running
+  // parallelFor() still holds on to the pool
+}
+
+void parallelFor(size_t numItems, unsigned int numThreads,
+                 const std::function<void(size_t)> &func) {
+  if (numThreads > 1 && numItems > 1) {
+    // nested calls stay on the pool that is running them
+    if (auto pool = ThreadPool::getCurrentPool()) {
+      pool->parallelFor(numItems, numThreads, func);
+    } else {
+      getThreadPool()->parallelFor(numItems, numThreads, func);
+    }
+    return;
+  }
+  for (size_t i = 0; i < numItems; ++i) {
+    func(i);
+  }
+}
+#else
+void setThreadPoolSize(int numThreads) { RDUNUSED_PARAM(numThreads); }
+
+void parallelFor(size_t numItems, unsigned int numThreads,
+                 const std::function<void(size_t)> &func) {
+  RDUNUSED_PARAM(numThreads);
+  for (size_t i = 0; i < numItems; ++i) {
+    func(i);
+  }
+}
+#endif
+
+}  // namespace RDKit
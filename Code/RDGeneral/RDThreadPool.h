@@ -0,0 +1,120 @@
+//
+//  Copyright (C) 2026 Greg Landrum and other RDKit contributors
+//
+//   @@ All Rights Reserved @@
+//  This file is part of the RDKit.
+//  The contents are covered by the terms of the BSD license
+//  which is included in the file license.txt, found at the root
+//  of the RDKit source tree.
+//
+
+/*! \file RDThreadPool.h
+
+  A process-wide pool of worker threads used by the multithreaded
+  functions in the RDKit, so that they don't have to start new threads for
+  every call.
+
+*/
+#include <RDGeneral/export.h>
+#ifndef RD_THREADPOOL_H
+#define RD_THREADPOOL_H
+
+#include <cstddef>
+#include <functional>
+
+#ifdef RDK_BUILD_THREADSAFE_SSS
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+namespace RDKit {
+
+#ifdef RDK_BUILD_THREADSAFE_SSS
+//! A work-stealing thread pool
+/*!
+  Each worker has its own queue of tasks. Tasks submitted from a worker go
+  onto that worker's queue, where they are run last in, first out. Idle
+  workers steal the oldest tasks from the other queues.
+
+  Most code should not use this class directly, but call parallelFor().
+*/
+class RDKIT_RDGENERAL_EXPORT ThreadPool {
+ public:
+  explicit ThreadPool(unsigned int numWorkers);
+  //! Runs the tasks that are still queued and then stops the workers.
+  ~ThreadPool();
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  unsigned int getNumWorkers() const {
+    return static_cast<unsigned int>(d_workers.size());
+  }
+  //! Queues a task to be run by one of the workers.
+  void submit(std::function<void()> task);
+  //! Runs func(i) for each i in [0, numItems) using up to numThreads
+  //! threads, see RDKit::parallelFor().
+  void parallelFor(size_t numItems, unsigned int numThreads,
+                   const std::function<void(size_t)> &func);
+
+  //! Returns the pool whose worker is running the current thread, if any.
+  static ThreadPool *getCurrentPool();
+
+ private:
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  bool popTask(unsigned int queueIdx, std::function<void()> &task);
+  void workerLoop(unsigned int workerIdx);
+
+  std::vector<std::unique_ptr<WorkQueue>> d_queues;
+  std::vector<std::thread> d_workers;
+  std::mutex d_mutex;
+  std::condition_variable d_wakeUp;
+  //! the number of tasks in the queues, changed with d_mutex held
+  std::atomic<size_t> d_numQueued{0};
+  std::atomic<unsigned int> d_nextQueue{0};
+  bool d_stop{false};
+};
+
+//! Returns the process-wide thread pool, creating it if needed.
+/*!
+  By default the pool has one worker per hardware thread.
+*/
+RDKIT_RDGENERAL_EXPORT std::shared_ptr<ThreadPool> getThreadPool();
+#endif
+
+//! Sets the number of workers in the process-wide thread pool.
+/*!
+  Uses the usual RDKit convention where values <= 0 mean use all available
+  threads less that number. Calls that are already running carry on with
+  the old pool. Has no effect if the RDKit was built without thread support.
+*/
+RDKIT_RDGENERAL_EXPORT void setThreadPoolSize(int numThreads);
+
+//! Runs func(i) for each i in [0, numItems) using up to numThreads threads.
+/*!
+  The calling thread takes part and the rest of the work is done by the
+  workers of the process-wide thread pool. The items are handed out one at
+  a time, so threads that get cheap items go on to take more of them.
+
+  The calling thread only waits for items that another thread has already
+  started, so parallelFor() can safely be called from inside func. func
+  must not wait for another item to run, e.g. with a barrier.
+
+  If func throws, no more items are started and the first exception is
+  rethrown once the running items have finished.
+*/
+RDKIT_RDGENERAL_EXPORT void parallelFor(
+    size_t numItems, unsigned int numThreads,
+    const std::function<void(size_t)> &func);
+
+}  // namespace RDKit
+
+#endif
@@ -7,7 +7,9 @@
 //  which is included in the file license.txt, found at the root
 //  of the RDKit source tree.
 //
+#include <memory>
 #include <string>
+#include <vector>
 #include <catch2/catch_all.hpp>
 #include "Dict.h"
 #include "RDProps.h"
@@ -92,4 +94,84 @@ TEST_CASE("github #9068: dicts with empty keys") {
   }
   SECTION("hasVal with empty key") { CHECK(!dict.hasVal("")); }
   SECTION("clearVal with empty key") { CHECK_NOTHROW(dict.clearVal("")); }
-}
\ No newline at end of file
+}
+TEST_CASE("Dict copy on write") {
+  RDKit::Dict d1;
+  d1.setVal("foo"s, 1);
+  d1.setVal("bar"s, "yep");
+  CHECK(!d1.isShared());
+  RDKit::Dict d2(d1);
+  CHECK(d1.isShared());
+  CHECK(d2.isShared());
+  CHECK(d2.getVal<int>("foo"s) == 1);
+  CHECK(d2.getVal<std::string>("bar"s) == "yep"s);
+  SECTION("modifying a copy") {
+    d2.setVal("bar"s, "nope");
+    CHECK(!d1.isShared());
+    CHECK(!d2.isShared());
+    CHECK(d1.getVal<std::string>("bar"s) == "yep"s);
+    CHECK(d2.getVal<std::string>("bar"s) == "nope"s);
+  }
+  SECTION("modifying the original") {
+    d1.setVal("baz"s, 2.0);
+    d1.clearVal("foo"s);
+    CHECK(!d1.hasVal("foo"s));
+    CHECK(d2.hasVal("foo"s));
+    CHECK(!d2.hasVal("baz"s));
+    CHECK(d1.getVal<std::string>("bar"s) == "yep"s);
+  }
+  SECTION("clearing a missing value does not copy") {
+    d2.clearVal("baz"s);
+    CHECK(d2.isShared());
+  }
+  SECTION("resetting a copy") {
+    d2.reset();
+    CHECK(d2.empty());
+    CHECK(!d1.isShared());
+    CHECK(d1.size() == 2);
+  }
+  SECTION("the original goes away") {
+    auto d3 = std::make_unique<RDKit::Dict>(d1);
+    RDKit::Dict d4(*d3);
+    d3.reset();
+    d4.setVal("foo"s, 3);
+    CHECK(d4.getVal<int>("foo"s) == 3);
+    CHECK(d1.getVal<int>("foo"s) == 1);
+    CHECK(d2.getVal<int>("foo"s) == 1);
+  }
+  SECTION("update") {
+    RDKit::Dict d3;
+    d3.setVal("foo"s, 4);
+    std::vector<int> qux{1, 2};
+    d3.setVal("qux"s, qux);
+    d2.update(d3, true);
+    CHECK(d2.getVal<int>("foo"s) == 4);
+    CHECK(d2.getVal<std::vector<int>>("qux"s) == std::vector<int>{1, 2});
+    CHECK(d1.getVal<int>("foo"s) == 1);
+    CHECK(!d1.hasVal("qux"s));
+    d1.update(d3);
+    CHECK(d1.isShared());
+    CHECK(!d1.hasVal("bar"s));
+  }
+}
+
+TEST_CASE("Dict key hashes") {
+  static_assert(RDKit::Dict::hashKey("foo") != RDKit::Dict::hashKey("bar"));
+  RDKit::Dict d;
+  std::vector<RDKit::Dict::Pair> pairs;
+  pairs.emplace_back("foo"s);
+  pairs.back().val = 1;
+  pairs.emplace_back("bar"s);
+  pairs.back().val = 2;
+  d.extend(std::move(pairs));
+  RDKit::Dict::Pair pair("baz"s);
+  pair.val = 3;
+  d.insert(std::move(pair));
+  CHECK(d.getVal<int>("foo"s) == 1);
+  CHECK(d.getVal<int>("bar"s) == 2);
+  CHECK(d.getVal<int>("baz"s) == 3);
+  d.clearVal("bar"s);
+  CHECK(!d.hasVal("bar"s));
+  CHECK(d.getVal<int>("baz"s) == 3);
+  CHECK(d.keys() == RDKit::STR_VECT{"foo", "baz"});
+}
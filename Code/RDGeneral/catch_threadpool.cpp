@@ -0,0 +1,99 @@
+//
+//  Copyright (C) 2026 Greg Landrum and other RDKit contributors
+//
+//   @@ All Rights Reserved @@
+//  This file is part of the RDKit.
+//  The contents are covered by the terms of the BSD license
+//  which is included in the file license.txt, found at the root
+//  of the RDKit source tree.
+//
+#include <atomic>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <catch2/catch_all.hpp>
+#include "RDThreadPool.h"
+
+using namespace RDKit;
+
+TEST_CASE("parallelFor") {
+  SECTION("every item once") {
+    for (unsigned int numThreads : {1u, 2u, 4u, 16u}) {
+      std::vector<std::atomic<int>> counts(1000);
+      parallelFor(counts.size(), numThreads,
+                  [&counts](size_t i) { ++counts[i]; });
+      for (const auto &count : counts) {
+        CHECK(count == 1);
+      }
+    }
+  }
+  SECTION("empty") {
+    bool called = false;
+    parallelFor(0, 4, [&called](size_t) { called = true; });
+    CHECK(!called);
+  }
+  SECTION("uses more than one thread") {
+    setThreadPoolSize(4);
+    CHECK(getThreadPool()->getNumWorkers() == 4);
+    std::mutex mutex;
+    std::set<std::thread::id> ids;
+    parallelFor(200, 4, [&](size_t) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      std::lock_guard<std::mutex> lock(mutex);
+      ids.insert(std::this_thread::get_id());
+    });
+    CHECK(ids.size() > 1);
+    CHECK(ids.count(std::this_thread::get_id()));
+  }
+  SECTION("nested") {
+    // more nested loops than workers must not deadlock
+    setThreadPoolSize(2);
+    std::vector<std::vector<int>> res(8, std::vector<int>(50, 0));
+    parallelFor(res.size(), 8, [&res](size_t i) {
+      parallelFor(res[i].size(), 8,
+                  [&res, i](size_t j) { res[i][j] = i * 100 + j; });
+    });
+    for (size_t i = 0; i < res.size(); ++i) {
+      for (size_t j = 0; j < res[i].size(); ++j) {
+        CHECK(res[i][j] == static_cast<int>(i * 100 + j));
+      }
+    }
+  }
+  SECTION("exceptions") {
+    setThreadPoolSize(4);
+    std::atomic<int> numRun{0};
+    CHECK_THROWS_AS(parallelFor(1000, 4,
+                                [&numRun](size_t i) {
+                                  ++numRun;
+                                  if (i == 10) {
+                                    throw std::runtime_error("boom");
+                                  }
+                                }),
+                    std::runtime_error);
+    CHECK(numRun < 1000);
+    // the pool is still usable
+    std::atomic<int> total{0};
+    parallelFor(100, 4, [&total](size_t) { ++total; });
+    CHECK(total == 100);
+  }
+}
+
+TEST_CASE("ThreadPool::submit") {
+  std::atomic<int> total{0};
+  std::atomic<int> numOnPool{0};
+  {
+    ThreadPool pool(3);
+    for (int i = 0; i < 100; ++i) {
+      pool.submit([&total, &numOnPool, &pool, i]() {
+        total += i;
+        numOnPool += ThreadPool::getCurrentPool() == &pool;
+      });
+    }
+    // the destructor runs whatever is still queued
+  }
+  CHECK(total == 4950);
+  CHECK(numOnPool == 100);
+  CHECK(ThreadPool::getCurrentPool() == nullptr);
+}
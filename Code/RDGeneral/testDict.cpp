@@ -684,6 +684,19 @@ TEST_CASE("custom AnyTag data is destroyed through Dict lifecycle") {
     Dict d2(d);
     REQUIRE(d2.getVal<Bar>("mybar").x == 7);
   }
+  // the copy shares the stored value
+  REQUIRE(count == 3);
+
+  count = 0;
+  {
+    Dict d;
+    Bar b(7, &count);
+    d.setVal<Bar>("mybar", b);
+    Dict d2(d);
+    // modifying the copy makes it take its own copy of the value
+    d2.setVal("other", 1);
+    REQUIRE(d2.getVal<Bar>("mybar").x == 7);
+  }
   REQUIRE(count == 4);
 }
 
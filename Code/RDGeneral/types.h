@@ -104,6 +104,8 @@ inline constexpr std::string_view reactionMapNum = "old_mapno";
 inline constexpr std::string_view reactantIdx = "react_idx";
 
 inline constexpr std::string_view _RingClosures = "_RingClosures";
+inline constexpr std::string_view _SanitizePending = "_SanitizePending";
+inline constexpr std::string_view _SanitizeTriggered = "_SanitizeTriggered";
 inline constexpr std::string_view _SLN_s = "_SLN_s";
 inline constexpr std::string_view _SmilesStart = "_SmilesStart";
 inline constexpr std::string_view _StereochemDone = "_StereochemDone";
@@ -0,0 +1,209 @@
+//
+//  Copyright (C) 2026 Greg Landrum and other RDKit contributors
+//
+//   @@ All Rights Reserved @@
+//  This file is part of the RDKit.
+//  The contents are covered by the terms of the BSD license
+//  which is included in the file license.txt, found at the root
+//  of the RDKit source tree.
+//
+#include "ButinaClustering.h"
+#include "PackedBitVects.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <utility>
+
+#include <RDGeneral/Invariant.h>
+#include <RDGeneral/RDThreads.h>
+
+#ifdef RDK_BUILD_THREADSAFE_SSS
+#include <thread>
+#endif
+
+namespace RDPickers {
+namespace {
+using NeighborPair = std::pair<std::uint32_t, std::uint32_t>;
+
+// Runs func(tidx, nthreads) on the requested number of threads.
+template <typename T>
+void runThreads(T &func, unsigned int nthreads) {
+#ifdef RDK_BUILD_THREADSAFE_SSS
+  if (nthreads > 1) {
+    std::vector<std::thread> tg;
+    for (unsigned int ti = 0; ti < nthreads; ++ti) {
+      tg.emplace_back(std::ref(func), ti, nthreads);
+    }
+    for (auto &thread : tg) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+    return;
+  }
+#endif
+  func(0, 1);
+}
+}  // namespace
+
+NeighborLists getTanimotoNeighborLists(
+    const std::vector<const ExplicitBitVect *> &fps, double distThresh,
+    int numThreads) {
+  PRECONDITION(fps.size() < std::numeric_limits<std::uint32_t>::max(),
+               "too many fingerprints");
+  NeighborLists res;
+  if (fps.empty()) {
+    return res;
+  }
+  const auto poolSize = static_cast<std::uint32_t>(fps.size());
+  const details::PackedBitVects packedFps(fps, poolSize);
+  const auto &popcounts = packedFps.popcounts();
+
+  // With the fingerprints in order of increasing bit count, the Tanimoto
+  // similarity of fp i with any later fp j is at most
+  // popcount(i) / popcount(j), so the scan over j for each i can stop as
+  // soon as that drops below the similarity threshold.
+  std::vector<std::uint32_t> order(poolSize);
+  std::iota(order.begin(), order.end(), 0);
+  std::ranges::stable_sort(order, [&popcounts](auto i, auto j) {
+    return popcounts[i] < popcounts[j];
+  });
+  const double simThresh = 1.0 - distThresh;
+  constexpr double popcountTol = 1.0e-9;
+
+  const auto nthreads = RDKit::getNumThreadsToUse(numThreads);
+  std::vector<std::vector<NeighborPair>> threadPairs(nthreads);
+  auto findNeighbors = [&](unsigned int tidx, unsigned int nthreads) {
+    auto &pairs = threadPairs[tidx];
+    for (std::uint32_t p = tidx; p < poolSize; p += nthreads) {
+      const auto i = order[p];
+      const auto popi = popcounts[i];
+      for (std::uint32_t q = p + 1; q < poolSize; ++q) {
+        const auto j = order[q];
+        const auto popj = popcounts[j];
+        if (popj &&
+            static_cast<double>(popi) / popj < simThresh - popcountTol) {
+          break;
+        }
+        if (1.0 - packedFps.tanimoto(i, j) <= distThresh) {
+          pairs.emplace_back(std::min(i, j), std::max(i, j));
+        }
+      }
+    }
+  };
+  runThreads(findNeighbors, nthreads);
+
+  // Now build the symmetric neighbor lists from the pairs.
+  std::vector<std::uint64_t> counts(poolSize + 1, 0);
+  for (const auto &pairs : threadPairs) {
+    for (const auto &[i, j] : pairs) {
+      ++counts[i + 1];
+      ++counts[j + 1];
+    }
+  }
+  std::partial_sum(counts.begin(), counts.end(), counts.begin());
+  res.offsets = counts;
+  res.neighbors.resize(res.offsets.back());
+  for (auto &pairs : threadPairs) {
+    for (const auto &[i, j] : pairs) {
+      res.neighbors[counts[i]++] = j;
+      res.neighbors[counts[j]++] = i;
+    }
+    pairs.clear();
+    pairs.shrink_to_fit();
+  }
+  auto sortNeighbors = [&res, poolSize](unsigned int tidx,
+                                        unsigned int nthreads) {
+    for (std::uint32_t i = tidx; i < poolSize; i += nthreads) {
+      std::sort(res.neighbors.begin() + res.offsets[i],
+                res.neighbors.begin() + res.offsets[i + 1]);
+    }
+  };
+  runThreads(sortNeighbors, nthreads);
+  return res;
+}
+
+RDKit::VECT_INT_VECT butinaCluster(const NeighborLists &nbrLists,
+                                   bool reordering) {
+  const auto poolSize = nbrLists.size();
+  RDKit::VECT_INT_VECT res;
+  if (!poolSize) {
+    return res;
+  }
+  // The counts include the item itself, as in the Python implementation,
+  // and ties are broken in favour of the larger index.
+  using CountIdx = std::pair<std::uint32_t, std::uint32_t>;
+  std::vector<std::uint32_t> counts(poolSize);
+  std::vector<CountIdx> candidates(poolSize);
+  for (std::uint32_t i = 0; i < poolSize; ++i) {
+    counts[i] = nbrLists.numNeighbors(i) + 1;
+    candidates[i] = std::make_pair(counts[i], i);
+  }
+  std::vector<char> seen(poolSize, 0);
+  auto makeCluster = [&](std::uint32_t centroid) {
+    RDKit::INT_VECT cluster{static_cast<int>(centroid)};
+    seen[centroid] = 1;
+    for (auto nbr = nbrLists.begin(centroid); nbr != nbrLists.end(centroid);
+         ++nbr) {
+      if (!seen[*nbr]) {
+        cluster.push_back(static_cast<int>(*nbr));
+        seen[*nbr] = 1;
+      }
+    }
+    return cluster;
+  };
+
+  if (!reordering) {
+    std::ranges::sort(candidates, std::greater<>());
+    for (const auto &[count, idx] : candidates) {
+      if (!seen[idx]) {
+        res.push_back(makeCluster(idx));
+      }
+    }
+    return res;
+  }
+
+  // With reordering, the number of unassigned neighbors of each item
+  // only ever goes down, so a heap with lazy deletion of out-of-date
+  // entries does the job of re-sorting the candidates.
+  std::priority_queue<CountIdx> heap(std::less<CountIdx>(),
+                                     std::move(candidates));
+  std::vector<std::uint32_t> affected;
+  while (!heap.empty()) {
+    const auto [count, idx] = heap.top();
+    heap.pop();
+    if (seen[idx] || count != counts[idx]) {
+      continue;
+    }
+    res.push_back(makeCluster(idx));
+    affected.clear();
+    for (const auto member : res.back()) {
+      for (auto nbr = nbrLists.begin(member); nbr != nbrLists.end(member);
+           ++nbr) {
+        if (!seen[*nbr]) {
+          affected.push_back(*nbr);
+          --counts[*nbr];
+        }
+      }
+    }
+    std::ranges::sort(affected);
+    const auto [first, last] = std::ranges::unique(affected);
+    affected.erase(first, last);
+    for (const auto a : affected) {
+      heap.emplace(counts[a], a);
+    }
+  }
+  return res;
+}
+
+RDKit::VECT_INT_VECT butinaCluster(
+    const std::vector<const ExplicitBitVect *> &fps, double distThresh,
+    bool reordering, int numThreads) {
+  const auto nbrLists = getTanimotoNeighborLists(fps, distThresh, numThreads);
+  return butinaCluster(nbrLists, reordering);
+}
+
+}  // namespace RDPickers
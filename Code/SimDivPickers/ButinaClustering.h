@@ -0,0 +1,90 @@
+//
+//  Copyright (C) 2026 Greg Landrum and other RDKit contributors
+//
+//   @@ All Rights Reserved @@
+//  This file is part of the RDKit.
+//  The contents are covered by the terms of the BSD license
+//  which is included in the file license.txt, found at the root
+//  of the RDKit source tree.
+//
+#include <RDGeneral/export.h>
+#ifndef RD_BUTINACLUSTERING_H
+#define RD_BUTINACLUSTERING_H
+
+#include <cstdint>
+#include <vector>
+
+#include <RDGeneral/types.h>
+
+class ExplicitBitVect;
+
+namespace RDPickers {
+
+//! Sparse, symmetric neighbor lists for a set of items.
+/*!
+  The neighbors of item i are neighbors[offsets[i]] to
+  neighbors[offsets[i+1] - 1], in ascending order.  An item is not included
+  in its own neighbor list.
+*/
+struct RDKIT_SIMDIVPICKERS_EXPORT NeighborLists {
+  std::vector<std::uint64_t> offsets{0};
+  std::vector<std::uint32_t> neighbors;
+
+  //! the number of items
+  unsigned int size() const { return offsets.size() - 1; }
+  //! the number of neighbors of item i
+  unsigned int numNeighbors(unsigned int i) const {
+    return offsets[i + 1] - offsets[i];
+  }
+  const std::uint32_t *begin(unsigned int i) const {
+    return neighbors.data() + offsets[i];
+  }
+  const std::uint32_t *end(unsigned int i) const {
+    return neighbors.data() + offsets[i + 1];
+  }
+};
+
+//! Finds the neighbors of each fingerprint within a Tanimoto distance
+//! threshold.
+/*!
+  The full distance matrix is never constructed. The fingerprints are
+  sorted by their number of set bits and only pairs whose bit counts allow
+  them to be within the threshold are compared.
+
+  \param fps          the fingerprints, which must all be the same length
+  \param distThresh   items with a Tanimoto distance (1-similarity) less
+                      than or equal to this are neighbors
+  \param numThreads   the number of threads to use.  Uses the usual RDKit
+                      convention where values <= 0 mean use all available
+                      threads less that number.
+*/
+RDKIT_SIMDIVPICKERS_EXPORT NeighborLists getTanimotoNeighborLists(
+    const std::vector<const ExplicitBitVect *> &fps, double distThresh,
+    int numThreads = 1);
+
+//! Butina clustering of items from their neighbor lists
+/*!
+  Implements the algorithm from Butina JCICS 39 747-750 (1999), giving the
+  same results as rdkit.ML.Cluster.Butina.ClusterData().
+
+  \param nbrLists    the neighbor lists of the items
+  \param reordering  if set, the number of neighbors of the unassigned items
+                     is updated after each cluster is created, so that the
+                     next cluster centroid is always the item with the most
+                     unassigned neighbors (Taylor-Butina).
+
+  \return the clusters, in the order they were created.  The first element
+          of each cluster is its centroid.
+*/
+RDKIT_SIMDIVPICKERS_EXPORT RDKit::VECT_INT_VECT butinaCluster(
+    const NeighborLists &nbrLists, bool reordering = false);
+
+//! \overload
+//! Butina clustering of fingerprints using the Tanimoto distance.
+RDKIT_SIMDIVPICKERS_EXPORT RDKit::VECT_INT_VECT butinaCluster(
+    const std::vector<const ExplicitBitVect *> &fps, double distThresh,
+    bool reordering = false, int numThreads = 1);
+
+}  // namespace RDPickers
+
+#endif
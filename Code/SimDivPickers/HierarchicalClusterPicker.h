@@ -11,9 +11,14 @@
 #ifndef _HIERARCHCLUSTERPICKER_H
 #define _HIERARCHCLUSTERPICKER_H
 
+#include <string>
+#include <vector>
+
 #include <RDGeneral/types.h>
 #include "DistPicker.h"
 
+class ExplicitBitVect;
+
 namespace RDPickers {
 
 /*! \brief Diversity picker based on hierarchical clustering
@@ -99,6 +104,47 @@ class RDKIT_SIMDIVPICKERS_EXPORT HierarchicalClusterPicker : public DistPicker {
   RDKit::VECT_INT_VECT cluster(const double *distMat, unsigned int poolSize,
                                unsigned int pickSize) const;
 
+  /*! \brief Clusters bit vectors using the Tanimoto distance
+   *
+   * This doesn't use the Murtagh code. Instead the clustering is done with
+   *the nearest-neighbor chain algorithm on a single precision distance matrix
+   *calculated from the bit vectors, using the same merging criteria.  This
+   *halves the memory needed compared to cluster() and, if matrixFile is
+   *provided, the matrix is held in a memory-mapped file rather than in RAM,
+   *so the size of the pool is limited by the disk space available instead.
+   *The searches for nearest neighbors and the updates of the distances after
+   *each merge are spread over the requested number of threads; the results
+   *don't depend on the number of threads.
+   *
+   * Only the WARD, SLINK, CLINK, UPGMA and MCQUITTY methods are supported.
+   *
+   *   \param fps - the bit vectors, which must all be the same length
+   *   \param poolSize - the number of items in the pool (<= fps.size())
+   *   \param pickSize - the number clusters to divide the pool into
+   *   \param numThreads - the number of threads to use. Uses the usual RDKit
+   *convention where values <= 0 mean use all available threads less that
+   *number.
+   *   \param matrixFile - if not empty, the name of a scratch file to hold the
+   *distance matrix.  It is removed when the clustering is done.
+   *
+   * \return the clusters, each in ascending order of index and ordered by
+   *their first members.
+   */
+  RDKit::VECT_INT_VECT clusterBitVects(
+      const std::vector<const ExplicitBitVect *> &fps, unsigned int poolSize,
+      unsigned int pickSize, int numThreads = 1,
+      const std::string &matrixFile = "") const;
+
+  /*! \brief Picks from bit vectors using clusterBitVects()
+   *
+   * The representative of each cluster is picked the same way as in pick().
+   * The arguments are the same as for clusterBitVects().
+   */
+  RDKit::INT_VECT pickBitVects(const std::vector<const ExplicitBitVect *> &fps,
+                               unsigned int poolSize, unsigned int pickSize,
+                               int numThreads = 1,
+                               const std::string &matrixFile = "") const;
+
  private:
   ClusterMethod d_method;
 };
@@ -9,5 +9,149 @@
 //
 
 #include "MaxMinPicker.h"
+#include "PackedBitVects.h"
 
-namespace RDPickers {}
+#include <algorithm>
+#include <limits>
+
+#include <RDGeneral/RDThreads.h>
+
+#ifdef RDK_BUILD_THREADSAFE_SSS
+#include <barrier>
+#include <thread>
+#endif
+
+namespace RDPickers {
+namespace {
+struct PickCandidate {
+  double dist{-1.0};
+  unsigned int idx{0};
+};
+}  // namespace
+
+RDKit::INT_VECT MaxMinPicker::bitVectorPick(
+    const std::vector<const ExplicitBitVect *> &fps, unsigned int poolSize,
+    unsigned int pickSize, const RDKit::INT_VECT &firstPicks, int seed,
+    double &threshold, int numThreads) const {
+  if (!poolSize) {
+    throw ValueErrorException("empty pool to pick from");
+  }
+  if (poolSize < pickSize) {
+    throw ValueErrorException("pickSize cannot be larger than the poolSize");
+  }
+  if (fps.size() < poolSize) {
+    throw ValueErrorException("poolSize cannot be larger than the number of "
+                              "bit vectors");
+  }
+
+  RDKit::INT_VECT picks;
+  picks.reserve(std::max<size_t>(pickSize, firstPicks.size()));
+  if (firstPicks.empty()) {
+    picks.push_back(details::getRandomFirstPick(poolSize, seed));
+  } else {
+    for (auto firstPick : firstPicks) {
+      if (static_cast<unsigned int>(firstPick) >= poolSize) {
+        throw ValueErrorException("pick index was larger than the poolSize");
+      }
+      picks.push_back(firstPick);
+    }
+  }
+  if (picks.size() >= pickSize) {
+    threshold = -1.0;
+    return picks;
+  }
+
+  const details::PackedBitVects packedFps(fps, poolSize);
+  // The distance from each item to its closest pick.  Items that have been
+  // picked are set to -1 so they can't be picked again.
+  std::vector<double> minDists(poolSize, std::numeric_limits<double>::max());
+  for (auto pick : picks) {
+    minDists[pick] = -1.0;
+  }
+
+  const auto nthreads =
+      std::min(RDKit::getNumThreadsToUse(numThreads), poolSize);
+  const auto blockSize = (poolSize + nthreads - 1) / nthreads;
+  std::vector<PickCandidate> blockBests(nthreads);
+  // picks before this have already been included in minDists
+  size_t numApplied = 0;
+  bool done = false;
+  double lastPickDist = -1.0;
+
+  // Brings the min distances of the items in a block up to date with the
+  // new picks and finds the best candidate in the block.  Ties go to the
+  // lowest index, as in lazyPick().
+  auto updateBlock = [&](unsigned int blockIdx) {
+    PickCandidate best;
+    const auto blockStart = blockIdx * blockSize;
+    const auto blockEnd = std::min(poolSize, blockStart + blockSize);
+    for (auto i = blockStart; i < blockEnd; ++i) {
+      auto &minDist = minDists[i];
+      if (minDist < 0.0) {
+        continue;
+      }
+      for (auto p = numApplied; p < picks.size(); ++p) {
+        minDist = std::min(minDist, 1.0 - packedFps.tanimoto(i, picks[p]));
+      }
+      if (minDist > best.dist) {
+        best.dist = minDist;
+        best.idx = i;
+      }
+    }
+    blockBests[blockIdx] = best;
+  };
+  // Combines the best candidates from the blocks and makes the next pick.
+  auto makePick = [&]() noexcept {
+    PickCandidate best;
+    for (const auto &blockBest : blockBests) {
+      if (blockBest.dist > best.dist) {
+        best = blockBest;
+      }
+    }
+    numApplied = picks.size();
+    // if the current distance is closer then threshold, we're done
+    if (best.dist < 0.0 || (best.dist <= threshold && threshold >= 0.0)) {
+      done = true;
+      return;
+    }
+    lastPickDist = best.dist;
+    picks.push_back(best.idx);
+    minDists[best.idx] = -1.0;
+    done = picks.size() >= pickSize;
+  };
+
+#ifdef RDK_BUILD_THREADSAFE_SSS
+  if (nthreads > 1) {
+    // The threads stay alive for the whole pick, meeting at the barrier
+    // after each round of updates, where the pick is made.
+    std::barrier sync(nthreads, makePick);
+    auto work = [&](unsigned int tidx) {
+      while (!done) {
+        updateBlock(tidx);
+        sync.arrive_and_wait();
+      }
+    };
+    std::vector<std::thread> tg;
+    for (unsigned int ti = 1; ti < nthreads; ++ti) {
+      tg.emplace_back(work, ti);
+    }
+    work(0);
+    for (auto &thread : tg) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+  } else
+#endif
+  {
+    while (!done) {
+      updateBlock(0);
+      makePick();
+    }
+  }
+
+  threshold = lastPickDist;
+  return picks;
+}
+
+}  // namespace RDPickers
@@ -22,6 +22,8 @@
 #include <boost/random.hpp>
 #include <random>
 
+class ExplicitBitVect;
+
 namespace RDPickers {
 
 /*! \brief Implements the MaxMin algorithm for picking a subset of item from a
@@ -74,6 +76,35 @@ class RDKIT_SIMDIVPICKERS_EXPORT MaxMinPicker : public DistPicker {
                            const RDKit::INT_VECT &firstPicks, int seed,
                            double &threshold) const;
 
+  /*! \brief MaxMin picking from a set of bit vectors using the Tanimoto
+   *distance
+   *
+   * The picks are the same as those from lazyPick() with a functor returning
+   *the Tanimoto distance between the bit vectors. Rather than evaluating the
+   *distances lazily, one pair at a time, the distances from each new pick to
+   *all the remaining pool items are calculated in blocks, which are spread
+   *over the requested number of threads, with the minimum distance of each
+   *item to the picks held in a flat array.
+   *
+   *   \param fps - the bit vectors, which must all be the same length
+   *   \param poolSize - the number of items in the pool (<= fps.size())
+   *   \param pickSize - the number items to pick from pool (<= poolSize)
+   *   \param firstPicks - the first items in the pick list
+   *   \param seed - seed for the random number generator.
+   *                 If this is <0 the generator will be seeded with a
+   *                 random number.
+   *   \param threshold - stop picking when the distance goes below this
+   *                 value. On return this holds the distance of the last pick
+   *                 made.
+   *   \param numThreads - the number of threads to use. Uses the usual RDKit
+   *                 convention where values <= 0 mean use all available
+   *                 threads less that number.
+   */
+  RDKit::INT_VECT bitVectorPick(const std::vector<const ExplicitBitVect *> &fps,
+                                unsigned int poolSize, unsigned int pickSize,
+                                const RDKit::INT_VECT &firstPicks, int seed,
+                                double &threshold, int numThreads = 1) const;
+
   /*! \brief Contains the implementation for the MaxMin diversity picker
    *
    * Here is how the picking algorithm works, refer to
@@ -132,6 +163,25 @@ class RDKIT_SIMDIVPICKERS_EXPORT MaxMinPicker : public DistPicker {
   }
 };
 
+namespace details {
+// Picks a random item from the pool to start things off.
+inline unsigned int getRandomFirstPick(unsigned int poolSize, int seed) {
+  // get a seeded random number generator:
+  typedef boost::mt19937 rng_type;
+  typedef boost::uniform_int<> distrib_type;
+  typedef boost::variate_generator<rng_type &, distrib_type> source_type;
+  rng_type generator;
+  distrib_type dist(0, poolSize - 1);
+  if (seed >= 0) {
+    generator.seed(static_cast<rng_type::result_type>(seed));
+  } else {
+    generator.seed(std::random_device()());
+  }
+  source_type randomSource(generator, dist);
+  return randomSource();
+}
+}  // namespace details
+
 struct MaxMinPickInfo {
   double dist_bound;   // distance to closest reference
   unsigned int picks;  // number of references considered
@@ -165,19 +215,7 @@ RDKit::INT_VECT MaxMinPicker::lazyPick(T &func, unsigned int poolSize,
 
   // pick the first entry
   if (firstPicks.empty()) {
-    // get a seeded random number generator:
-    typedef boost::mt19937 rng_type;
-    typedef boost::uniform_int<> distrib_type;
-    typedef boost::variate_generator<rng_type &, distrib_type> source_type;
-    rng_type generator;
-    distrib_type dist(0, poolSize - 1);
-    if (seed >= 0) {
-      generator.seed(static_cast<rng_type::result_type>(seed));
-    } else {
-      generator.seed(std::random_device()());
-    }
-    source_type randomSource(generator, dist);
-    pick = randomSource();
+    pick = details::getRandomFirstPick(poolSize, seed);
     // add the pick to the picks
     picks.push_back(pick);
     // and remove it from the pool
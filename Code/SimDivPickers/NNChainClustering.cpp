@@ -0,0 +1,466 @@
+//
+//  Copyright (C) 2026 Greg Landrum and other RDKit contributors
+//
+//   @@ All Rights Reserved @@
+//  This file is part of the RDKit.
+//  The contents are covered by the terms of the BSD license
+//  which is included in the file license.txt, found at the root
+//  of the RDKit source tree.
+//
+// Hierarchical clustering of bit vectors with the nearest-neighbor chain
+// algorithm.  See, for example, F. Murtagh, "A survey of recent advances in
+// hierarchical clustering algorithms", The Computer Journal 26:354-359
+// (1983) and D. Müllner, "Modern hierarchical, agglomerative clustering
+// algorithms", arXiv:1109.2378 (2011).
+
+#include "HierarchicalClusterPicker.h"
+#include "PackedBitVects.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <limits>
+#include <numeric>
+
+#include <RDGeneral/Exceptions.h>
+#include <RDGeneral/Invariant.h>
+#include <RDGeneral/RDThreads.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#ifdef RDK_BUILD_THREADSAFE_SSS
+#include <barrier>
+#include <thread>
+#endif
+
+namespace RDPickers {
+namespace {
+
+// The lower triangle of a symmetric matrix of distances in single
+// precision, either in memory or in a memory-mapped scratch file.
+class CondensedMatrix {
+ public:
+  CondensedMatrix(unsigned int numItems, const std::string &fileName)
+      : d_numEntries(static_cast<size_t>(numItems) * (numItems - 1) / 2),
+        d_fileName(fileName) {
+    if (d_fileName.empty()) {
+      d_mem.resize(d_numEntries);
+      d_data = d_mem.data();
+    } else {
+      mapFile();
+    }
+  }
+  CondensedMatrix(const CondensedMatrix &) = delete;
+  CondensedMatrix &operator=(const CondensedMatrix &) = delete;
+  ~CondensedMatrix() {
+    if (!d_fileName.empty()) {
+      unmapFile();
+    }
+  }
+
+  float &operator()(unsigned int i, unsigned int j) {
+    return d_data[index(i, j)];
+  }
+
+ private:
+  static size_t index(unsigned int i, unsigned int j) {
+    if (i < j) {
+      std::swap(i, j);
+    }
+    return static_cast<size_t>(i) * (i - 1) / 2 + j;
+  }
+
+  void mapFile() {
+    const auto numBytes = std::max<size_t>(d_numEntries * sizeof(float), 1);
+#ifdef _WIN32
+    d_fileHandle = CreateFileA(
+        d_fileName.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+        CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE,
+        nullptr);
+    if (d_fileHandle == INVALID_HANDLE_VALUE) {
+      throw ValueErrorException("could not create distance matrix file " +
+                                d_fileName);
+    }
+    const auto size = static_cast<unsigned long long>(numBytes);
+    d_mapHandle = CreateFileMappingA(d_fileHandle, nullptr, PAGE_READWRITE,
+                                     static_cast<DWORD>(size >> 32),
+                                     static_cast<DWORD>(size & 0xFFFFFFFF),
+                                     nullptr);
+    if (d_mapHandle == nullptr) {
+      CloseHandle(d_fileHandle);
+      throw ValueErrorException("could not map distance matrix file " +
+                                d_fileName);
+    }
+    d_data = static_cast<float *>(
+        MapViewOfFile(d_mapHandle, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+    if (d_data == nullptr) {
+      CloseHandle(d_mapHandle);
+      CloseHandle(d_fileHandle);
+      throw ValueErrorException("could not map distance matrix file " +
+                                d_fileName);
+    }
+#else
+    int fd = open(d_fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd == -1) {
+      throw ValueErrorException("could not create distance matrix file " +
+                                d_fileName);
+    }
+    if (ftruncate(fd, static_cast<off_t>(numBytes)) == -1) {
+      close(fd);
+      std::filesystem::remove(d_fileName);
+      throw ValueErrorException("could not size distance matrix file " +
+                                d_fileName);
+    }
+    void *mem =
+        mmap(nullptr, numBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) {
+      std::filesystem::remove(d_fileName);
+      throw ValueErrorException("could not map distance matrix file " +
+                                d_fileName);
+    }
+    d_data = static_cast<float *>(mem);
+#endif
+  }
+
+  void unmapFile() {
+#ifdef _WIN32
+    // the file is deleted when the last handle is closed
+    UnmapViewOfFile(d_data);
+    CloseHandle(d_mapHandle);
+    CloseHandle(d_fileHandle);
+#else
+    munmap(d_data, std::max<size_t>(d_numEntries * sizeof(float), 1));
+    std::error_code ec;
+    std::filesystem::remove(d_fileName, ec);
+#endif
+  }
+
+  size_t d_numEntries;
+  std::string d_fileName;
+  std::vector<float> d_mem;
+  float *d_data{nullptr};
+#ifdef _WIN32
+  HANDLE d_fileHandle{INVALID_HANDLE_VALUE};
+  HANDLE d_mapHandle{nullptr};
+#endif
+};
+
+struct Merge {
+  unsigned int item1;
+  unsigned int item2;
+  double dist;
+};
+
+struct Neighbor {
+  double dist{std::numeric_limits<double>::max()};
+  unsigned int idx{0};
+};
+
+// Runs func(tidx, nthreads) on the requested number of threads.
+template <typename T>
+void runThreads(T &func, unsigned int nthreads) {
+#ifdef RDK_BUILD_THREADSAFE_SSS
+  if (nthreads > 1) {
+    std::vector<std::thread> tg;
+    for (unsigned int ti = 0; ti < nthreads; ++ti) {
+      tg.emplace_back(std::ref(func), ti, nthreads);
+    }
+    for (auto &thread : tg) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+    return;
+  }
+#endif
+  func(0, 1);
+}
+
+// The Lance-Williams update for the distance from cluster k to the cluster
+// formed by merging i and j, the same as in the Murtagh code.
+double lanceWilliams(HierarchicalClusterPicker::ClusterMethod method,
+                     double dik, double djk, double dij, double ni, double nj,
+                     double nk) {
+  switch (method) {
+    case HierarchicalClusterPicker::WARD:
+      return ((ni + nk) * dik + (nj + nk) * djk - nk * dij) / (ni + nj + nk);
+    case HierarchicalClusterPicker::SLINK:
+      return std::min(dik, djk);
+    case HierarchicalClusterPicker::CLINK:
+      return std::max(dik, djk);
+    case HierarchicalClusterPicker::UPGMA:
+      return (ni * dik + nj * djk) / (ni + nj);
+    case HierarchicalClusterPicker::MCQUITTY:
+      return 0.5 * dik + 0.5 * djk;
+    default:
+      throw ValueErrorException("unsupported clustering method");
+  }
+}
+
+// The nearest-neighbor chain algorithm.  It relies on the merging criterion
+// being reducible, so the merges are found in an order that isn't
+// necessarily that of increasing distance.  Ties are broken in favour of the
+// previous cluster in the chain and then of the lowest index, so the
+// results are deterministic.
+std::vector<Merge> nnChainMerges(
+    CondensedMatrix &dists, unsigned int poolSize,
+    HierarchicalClusterPicker::ClusterMethod method, unsigned int nthreads) {
+  std::vector<Merge> merges;
+  merges.reserve(poolSize - 1);
+  std::vector<double> sizes(poolSize, 1.0);
+  std::vector<char> active(poolSize, 1);
+  unsigned int numActive = poolSize;
+  unsigned int firstActive = 0;
+  std::vector<unsigned int> chain;
+  chain.reserve(poolSize);
+
+  // The state for the current round of work.  Each round either searches
+  // for the nearest neighbor of the cluster at the end of the chain or
+  // updates the distances to a newly merged cluster.
+  enum class Task { Search, Update, Done };
+  Task task = Task::Search;
+  chain.push_back(0);
+  unsigned int prevInChain = poolSize;
+  unsigned int mergedLo = 0;
+  unsigned int mergedHi = 0;
+  double mergedDist = 0.0;
+
+  const auto blockSize = (poolSize + nthreads - 1) / nthreads;
+  std::vector<Neighbor> blockNbrs(nthreads);
+
+  auto searchBlock = [&](unsigned int blockIdx) {
+    Neighbor best;
+    const auto curr = chain.back();
+    const auto blockEnd = std::min(poolSize, (blockIdx + 1) * blockSize);
+    for (auto k = blockIdx * blockSize; k < blockEnd; ++k) {
+      if (!active[k] || k == curr || k == prevInChain) {
+        continue;
+      }
+      const double d = dists(curr, k);
+      if (d < best.dist) {
+        best.dist = d;
+        best.idx = k;
+      }
+    }
+    blockNbrs[blockIdx] = best;
+  };
+  auto updateBlock = [&](unsigned int blockIdx) {
+    const auto blockEnd = std::min(poolSize, (blockIdx + 1) * blockSize);
+    for (auto k = blockIdx * blockSize; k < blockEnd; ++k) {
+      if (!active[k] || k == mergedLo) {
+        continue;
+      }
+      auto &dlo = dists(mergedLo, k);
+      dlo = static_cast<float>(lanceWilliams(method, dlo, dists(mergedHi, k),
+                                             mergedDist, sizes[mergedLo],
+                                             sizes[mergedHi], sizes[k]));
+    }
+  };
+  auto doBlock = [&](unsigned int blockIdx) {
+    if (task == Task::Search) {
+      searchBlock(blockIdx);
+    } else {
+      updateBlock(blockIdx);
+    }
+  };
+  // The serial part, which works out what to do next.
+  auto advance = [&]() noexcept {
+    if (task == Task::Search) {
+      Neighbor best;
+      if (prevInChain != poolSize) {
+        best.dist = dists(chain.back(), prevInChain);
+        best.idx = prevInChain;
+      }
+      for (const auto &blockNbr : blockNbrs) {
+        if (blockNbr.dist < best.dist) {
+          best = blockNbr;
+        }
+      }
+      if (best.idx != prevInChain || prevInChain == poolSize) {
+        chain.push_back(best.idx);
+        prevInChain = chain[chain.size() - 2];
+        return;
+      }
+      // the last two clusters in the chain are reciprocal nearest
+      // neighbors, so merge them.
+      const auto curr = chain.back();
+      chain.resize(chain.size() - 2);
+      mergedLo = std::min(curr, prevInChain);
+      mergedHi = std::max(curr, prevInChain);
+      mergedDist = best.dist;
+      merges.push_back(Merge{mergedLo, mergedHi, mergedDist});
+      active[mergedHi] = 0;
+      --numActive;
+      task = Task::Update;
+      return;
+    }
+    sizes[mergedLo] += sizes[mergedHi];
+    if (numActive == 1) {
+      task = Task::Done;
+      return;
+    }
+    if (chain.empty()) {
+      while (!active[firstActive]) {
+        ++firstActive;
+      }
+      chain.push_back(firstActive);
+    }
+    prevInChain = chain.size() > 1 ? chain[chain.size() - 2] : poolSize;
+    task = Task::Search;
+  };
+
+#ifdef RDK_BUILD_THREADSAFE_SSS
+  if (nthreads > 1) {
+    std::barrier sync(nthreads, advance);
+    auto work = [&](unsigned int tidx) {
+      while (task != Task::Done) {
+        doBlock(tidx);
+        sync.arrive_and_wait();
+      }
+    };
+    std::vector<std::thread> tg;
+    for (unsigned int ti = 1; ti < nthreads; ++ti) {
+      tg.emplace_back(work, ti);
+    }
+    work(0);
+    for (auto &thread : tg) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+  } else
+#endif
+  {
+    while (task != Task::Done) {
+      doBlock(0);
+      advance();
+    }
+  }
+  return merges;
+}
+
+unsigned int findRoot(std::vector<unsigned int> &parents, unsigned int i) {
+  while (parents[i] != i) {
+    parents[i] = parents[parents[i]];
+    i = parents[i];
+  }
+  return i;
+}
+
+void checkArgs(const std::vector<const ExplicitBitVect *> &fps,
+               unsigned int poolSize, unsigned int pickSize,
+               HierarchicalClusterPicker::ClusterMethod method) {
+  if (!poolSize) {
+    throw ValueErrorException("empty pool to pick from");
+  }
+  if (fps.size() < poolSize) {
+    throw ValueErrorException(
+        "poolSize cannot be larger than the number of bit vectors");
+  }
+  if (!pickSize || poolSize < pickSize) {
+    throw ValueErrorException(
+        "pickSize must be between 1 and the poolSize");
+  }
+  if (method == HierarchicalClusterPicker::GOWER ||
+      method == HierarchicalClusterPicker::CENTROID) {
+    throw ValueErrorException(
+        "the GOWER and CENTROID methods are not supported for bit vectors");
+  }
+}
+}  // namespace
+
+RDKit::VECT_INT_VECT HierarchicalClusterPicker::clusterBitVects(
+    const std::vector<const ExplicitBitVect *> &fps, unsigned int poolSize,
+    unsigned int pickSize, int numThreads,
+    const std::string &matrixFile) const {
+  checkArgs(fps, poolSize, pickSize, d_method);
+  const auto nthreads =
+      std::min(RDKit::getNumThreadsToUse(numThreads), poolSize);
+
+  std::vector<Merge> merges;
+  if (poolSize > 1) {
+    CondensedMatrix dists(poolSize, matrixFile);
+    {
+      const details::PackedBitVects packedFps(fps, poolSize);
+      auto fillRows = [&](unsigned int tidx, unsigned int nthreads) {
+        for (auto i = tidx; i < poolSize; i += nthreads) {
+          for (unsigned int j = 0; j < i; ++j) {
+            dists(i, j) = static_cast<float>(1.0 - packedFps.tanimoto(i, j));
+          }
+        }
+      };
+      runThreads(fillRows, nthreads);
+    }
+    merges = nnChainMerges(dists, poolSize, d_method, nthreads);
+  }
+
+  // The merges in order of increasing distance give the dendrogram, which is
+  // cut to give the requested number of clusters.
+  std::ranges::stable_sort(merges, [](const Merge &m1, const Merge &m2) {
+    return m1.dist < m2.dist;
+  });
+  std::vector<unsigned int> parents(poolSize);
+  std::iota(parents.begin(), parents.end(), 0);
+  for (unsigned int i = 0; i < poolSize - pickSize; ++i) {
+    const auto root1 = findRoot(parents, merges[i].item1);
+    const auto root2 = findRoot(parents, merges[i].item2);
+    parents[std::max(root1, root2)] = std::min(root1, root2);
+  }
+  // each root is the lowest index in its cluster
+  RDKit::VECT_INT_VECT res;
+  std::vector<unsigned int> clusterIdx(poolSize);
+  for (unsigned int i = 0; i < poolSize; ++i) {
+    const auto root = findRoot(parents, i);
+    if (root == i) {
+      clusterIdx[i] = res.size();
+      res.emplace_back();
+    }
+    res[clusterIdx[root]].push_back(static_cast<int>(i));
+  }
+  CHECK_INVARIANT(res.size() == pickSize, "bad number of clusters");
+  return res;
+}
+
+RDKit::INT_VECT HierarchicalClusterPicker::pickBitVects(
+    const std::vector<const ExplicitBitVect *> &fps, unsigned int poolSize,
+    unsigned int pickSize, int numThreads,
+    const std::string &matrixFile) const {
+  const auto clusters =
+      clusterBitVects(fps, poolSize, pickSize, numThreads, matrixFile);
+
+  // find the member of each cluster with the smallest sum of squared
+  // distances to the others.
+  const details::PackedBitVects packedFps(fps, poolSize);
+  RDKit::INT_VECT picks(clusters.size());
+  auto pickRepresentatives = [&](unsigned int tidx, unsigned int nthreads) {
+    for (auto i = tidx; i < clusters.size(); i += nthreads) {
+      const auto &cluster = clusters[i];
+      double minSumD2 = RDKit::MAX_DOUBLE;
+      for (auto cxi1 : cluster) {
+        double d2sum = 0.0;
+        for (auto cxi2 : cluster) {
+          if (cxi1 == cxi2) {
+            continue;
+          }
+          double d = 1.0 - packedFps.tanimoto(cxi1, cxi2);
+          d2sum += (d * d);
+        }
+        if (d2sum < minSumD2) {
+          picks[i] = cxi1;
+          minSumD2 = d2sum;
+        }
+      }
+    }
+  };
+  runThreads(pickRepresentatives,
+             std::min(RDKit::getNumThreadsToUse(numThreads), pickSize));
+  return picks;
+}
+
+}  // namespace RDPickers
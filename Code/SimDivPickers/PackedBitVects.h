@@ -0,0 +1,81 @@
+//
+//  Copyright (C) 2026 Greg Landrum and other RDKit contributors
+//
+//   @@ All Rights Reserved @@
+//  This file is part of the RDKit.
+//  The contents are covered by the terms of the BSD license
+//  which is included in the file license.txt, found at the root
+//  of the RDKit source tree.
+//
+// Internal helper for the pickers and clustering that work directly on
+// bit vectors.  Not installed.
+
+#ifndef RD_PACKEDBITVECTS_H
+#define RD_PACKEDBITVECTS_H
+
+#include <bit>
+#include <iterator>
+#include <vector>
+
+#include <DataStructs/ExplicitBitVect.h>
+#include <RDGeneral/Exceptions.h>
+#include <RDGeneral/Invariant.h>
+
+namespace RDPickers {
+namespace details {
+
+//! A set of bit vectors copied into one contiguous block of words, which is
+//! a lot kinder to the cache than chasing pointers to the individual
+//! bitsets.
+class PackedBitVects {
+ public:
+  using BlockType = boost::dynamic_bitset<>::block_type;
+
+  PackedBitVects(const std::vector<const ExplicitBitVect *> &fps,
+                 unsigned int poolSize) {
+    PRECONDITION(poolSize <= fps.size(), "not enough bit vectors");
+    if (!poolSize) {
+      return;
+    }
+    PRECONDITION(fps[0], "bad fingerprint");
+    const auto numBits = fps[0]->getNumBits();
+    d_numBlocks = fps[0]->dp_bits->num_blocks();
+    d_blocks.reserve(poolSize * d_numBlocks);
+    d_popcounts.resize(poolSize);
+    for (unsigned int i = 0; i < poolSize; ++i) {
+      PRECONDITION(fps[i], "bad fingerprint");
+      if (fps[i]->getNumBits() != numBits) {
+        throw ValueErrorException("BitVects must be same length");
+      }
+      boost::to_block_range(*fps[i]->dp_bits, std::back_inserter(d_blocks));
+      d_popcounts[i] = fps[i]->getNumOnBits();
+    }
+  }
+
+  unsigned int size() const { return d_popcounts.size(); }
+  unsigned int popcount(unsigned int i) const { return d_popcounts[i]; }
+  const std::vector<unsigned int> &popcounts() const { return d_popcounts; }
+
+  //! the Tanimoto similarity, calculated the same way as
+  //! TanimotoSimilarity()
+  double tanimoto(unsigned int i, unsigned int j) const {
+    const auto *fpi = d_blocks.data() + i * d_numBlocks;
+    const auto *fpj = d_blocks.data() + j * d_numBlocks;
+    unsigned int common = 0;
+    for (size_t k = 0; k < d_numBlocks; ++k) {
+      common += std::popcount(fpi[k] & fpj[k]);
+    }
+    const auto total = d_popcounts[i] + d_popcounts[j];
+    return total ? static_cast<double>(common) / (total - common) : 0.0;
+  }
+
+ private:
+  std::vector<BlockType> d_blocks;
+  std::vector<unsigned int> d_popcounts;
+  size_t d_numBlocks{0};
+};
+
+}  // namespace details
+}  // namespace RDPickers
+
+#endif
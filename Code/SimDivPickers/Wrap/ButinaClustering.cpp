@@ -0,0 +1,62 @@
+//
+//  Copyright (C) 2026 Greg Landrum and other RDKit contributors
+//   @@ All Rights Reserved @@
+//  This file is part of the RDKit.
+//  The contents are covered by the terms of the BSD license
+//  which is included in the file license.txt, found at the root
+//  of the RDKit source tree.
+//
+#define NO_IMPORT_ARRAY
+
+#define PY_ARRAY_UNIQUE_SYMBOL rdpicker_array_API
+#include <RDBoost/python.h>
+#include <RDBoost/Wrap.h>
+
+#include <DataStructs/BitVects.h>
+#include <SimDivPickers/ButinaClustering.h>
+
+namespace python = boost::python;
+namespace RDPickers {
+namespace {
+python::tuple ButinaClusterBitVects(python::object objs, double distThresh,
+                                    bool reordering, int numThreads) {
+  auto poolSize = python::extract<unsigned int>(objs.attr("__len__")())();
+  std::vector<const ExplicitBitVect *> bvs(poolSize);
+  for (unsigned int i = 0; i < poolSize; ++i) {
+    bvs[i] = python::extract<const ExplicitBitVect *>(objs[i]);
+  }
+  RDKit::VECT_INT_VECT clusters;
+  {
+    NOGIL gil;
+    clusters = butinaCluster(bvs, distThresh, reordering, numThreads);
+  }
+  python::list res;
+  for (const auto &cluster : clusters) {
+    python::list members;
+    for (auto member : cluster) {
+      members.append(member);
+    }
+    res.append(python::tuple(members));
+  }
+  return python::tuple(res);
+}
+}  // end of anonymous namespace
+}  // end of namespace RDPickers
+
+void wrap_butina() {
+  python::def(
+      "ButinaClusterBitVects", RDPickers::ButinaClusterBitVects,
+      (python::arg("objects"), python::arg("distThresh"),
+       python::arg("reordering") = false, python::arg("numThreads") = 1),
+      "Butina clustering of a collection of bit vectors using the Tanimoto "
+      "distance, without building the full distance matrix. The results "
+      "are the same as rdkit.ML.Cluster.Butina.ClusterData().\n\n"
+      "ARGUMENTS:\n"
+      "  - objects: the bit vectors, which must all be the same length\n"
+      "  - distThresh: items within this distance (1-similarity) of each\n"
+      "    other are considered to be neighbors\n"
+      "  - reordering: update the number of neighbors of the unassigned\n"
+      "    items after each cluster is created\n"
+      "  - numThreads: the number of threads to use for finding neighbors\n\n"
+      "RETURNS: a tuple of clusters, each a tuple with its centroid first\n");
+}
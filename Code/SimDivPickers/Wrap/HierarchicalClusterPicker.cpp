@@ -16,6 +16,7 @@
 #include <numpy/arrayobject.h>
 #include <RDBoost/Wrap.h>
 
+#include <DataStructs/BitVects.h>
 #include <SimDivPickers/DistPicker.h>
 #include <SimDivPickers/HierarchicalClusterPicker.h>
 
@@ -67,6 +68,36 @@ RDKit::VECT_INT_VECT HierarchicalClusters(HierarchicalClusterPicker *picker,
   return res;
 }
 
+namespace {
+std::vector<const ExplicitBitVect *> extractBitVects(python::object &objs) {
+  auto poolSize = python::extract<unsigned int>(objs.attr("__len__")())();
+  std::vector<const ExplicitBitVect *> bvs(poolSize);
+  for (unsigned int i = 0; i < poolSize; ++i) {
+    bvs[i] = python::extract<const ExplicitBitVect *>(objs[i]);
+  }
+  return bvs;
+}
+}  // namespace
+
+RDKit::INT_VECT HierarchicalBitVectPicks(HierarchicalClusterPicker *picker,
+                                         python::object objs, int pickSize,
+                                         int numThreads,
+                                         const std::string &matrixFile) {
+  auto bvs = extractBitVects(objs);
+  NOGIL gil;
+  return picker->pickBitVects(bvs, bvs.size(), pickSize, numThreads,
+                              matrixFile);
+}
+
+RDKit::VECT_INT_VECT HierarchicalBitVectClusters(
+    HierarchicalClusterPicker *picker, python::object objs, int pickSize,
+    int numThreads, const std::string &matrixFile) {
+  auto bvs = extractBitVects(objs);
+  NOGIL gil;
+  return picker->clusterBitVects(bvs, bvs.size(), pickSize, numThreads,
+                                 matrixFile);
+}
+
 struct HierarchCP_wrap {
   static void wrap() {
     std::string docString =
@@ -95,7 +126,39 @@ struct HierarchCP_wrap {
              "  - distMat: 1D distance matrix (only the lower triangle "
              "elements)\n"
              "  - poolSize: number of items in the pool\n"
-             "  - pickSize: number of items to pick from the pool\n");
+             "  - pickSize: number of items to pick from the pool\n")
+        .def("PickBitVects", HierarchicalBitVectPicks,
+             (python::arg("self"), python::arg("objects"),
+              python::arg("pickSize"), python::arg("numThreads") = 1,
+              python::arg("matrixFile") = std::string("")),
+             "Pick a diverse subset of bit vectors using hierarchical "
+             "clustering with the Tanimoto distance\n"
+             "\n"
+             "ARGUMENTS: \n"
+             "  - objects: the bit vectors, which must all be the same "
+             "length\n"
+             "  - pickSize: number of items to pick\n"
+             "  - numThreads: the number of threads to use\n"
+             "  - matrixFile: (optional) the name of a scratch file to hold "
+             "the distance matrix, which is removed afterwards\n"
+             "\n"
+             "The GOWER and CENTROID methods are not supported.\n")
+        .def("ClusterBitVects", HierarchicalBitVectClusters,
+             (python::arg("self"), python::arg("objects"),
+              python::arg("pickSize"), python::arg("numThreads") = 1,
+              python::arg("matrixFile") = std::string("")),
+             "Return a list of clusters of bit vectors using hierarchical "
+             "clustering with the Tanimoto distance\n"
+             "\n"
+             "ARGUMENTS: \n"
+             "  - objects: the bit vectors, which must all be the same "
+             "length\n"
+             "  - pickSize: number of clusters to create\n"
+             "  - numThreads: the number of threads to use\n"
+             "  - matrixFile: (optional) the name of a scratch file to hold "
+             "the distance matrix, which is removed afterwards\n"
+             "\n"
+             "The GOWER and CENTROID methods are not supported.\n");
 
     python::enum_<HierarchicalClusterPicker::ClusterMethod>("ClusterMethod")
         .value("WARD", HierarchicalClusterPicker::WARD)
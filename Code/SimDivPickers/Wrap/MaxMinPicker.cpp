@@ -72,6 +72,28 @@ void LazyMaxMinHelper(MaxMinPicker *picker, T functor, unsigned int poolSize,
   res = picker->lazyPick(functor, poolSize, pickSize, firstPickVect, seed,
                          threshold);
 }
+
+// With more than one thread the picks are made by
+// MaxMinPicker::bitVectorPick(), which gives the same results.
+void BitVectMaxMinHelper(MaxMinPicker *picker,
+                         const std::vector<const ExplicitBitVect *> &bvs,
+                         unsigned int poolSize, unsigned int pickSize,
+                         python::object firstPicks, int seed,
+                         RDKit::INT_VECT &res, double &threshold,
+                         int numThreads) {
+  if (numThreads == 1) {
+    pyBVFunctor<ExplicitBitVect> functor(bvs, TANIMOTO);
+    LazyMaxMinHelper(picker, functor, poolSize, pickSize, firstPicks, seed,
+                     res, threshold);
+    return;
+  }
+  RDKit::INT_VECT firstPickVect;
+  for (unsigned int i = 0; i < boost::python::len(firstPicks); ++i) {
+    firstPickVect.push_back(python::extract<int>(firstPicks[i]));
+  }
+  res = picker->bitVectorPick(bvs, poolSize, pickSize, firstPickVect, seed,
+                              threshold, numThreads);
+}
 }  // end of anonymous namespace
 
 RDKit::INT_VECT LazyMaxMinPicks(MaxMinPicker *picker, python::object distFunc,
@@ -102,7 +124,7 @@ python::tuple LazyMaxMinPicksWithThreshold(
 RDKit::INT_VECT LazyVectorMaxMinPicks(MaxMinPicker *picker, python::object objs,
                                       int poolSize, int pickSize,
                                       python::object firstPicks, int seed,
-                                      python::object useCache) {
+                                      python::object useCache, int numThreads) {
   if (useCache != python::object()) {
     BOOST_LOG(rdWarningLog)
         << "the useCache argument is deprecated and ignored" << std::endl;
@@ -111,27 +133,23 @@ RDKit::INT_VECT LazyVectorMaxMinPicks(MaxMinPicker *picker, python::object objs,
   for (int i = 0; i < poolSize; ++i) {
     bvs[i] = python::extract<const ExplicitBitVect *>(objs[i]);
   }
-  pyBVFunctor<ExplicitBitVect> functor(bvs, TANIMOTO);
-
   RDKit::INT_VECT res;
   double threshold = -1.;
-  LazyMaxMinHelper(picker, functor, poolSize, pickSize, firstPicks, seed, res,
-                   threshold);
+  BitVectMaxMinHelper(picker, bvs, poolSize, pickSize, firstPicks, seed, res,
+                      threshold, numThreads);
   return res;
 }
 
 python::tuple LazyVectorMaxMinPicksWithThreshold(
     MaxMinPicker *picker, python::object objs, int poolSize, int pickSize,
-    double threshold, python::object firstPicks, int seed) {
+    double threshold, python::object firstPicks, int seed, int numThreads) {
   std::vector<const ExplicitBitVect *> bvs(poolSize);
   for (int i = 0; i < poolSize; ++i) {
     bvs[i] = python::extract<const ExplicitBitVect *>(objs[i]);
   }
-  pyBVFunctor<ExplicitBitVect> functor(bvs, TANIMOTO);
-
   RDKit::INT_VECT res;
-  LazyMaxMinHelper(picker, functor, poolSize, pickSize, firstPicks, seed, res,
-                   threshold);
+  BitVectMaxMinHelper(picker, bvs, poolSize, pickSize, firstPicks, seed, res,
+                      threshold, numThreads);
   return python::make_tuple(res, threshold);
 }
 
@@ -189,7 +207,8 @@ struct MaxMin_wrap {
               python::arg("poolSize"), python::arg("pickSize"),
               python::arg("firstPicks") = python::tuple(),
               python::arg("seed") = -1,
-              python::arg("useCache") = python::object()),
+              python::arg("useCache") = python::object(),
+              python::arg("numThreads") = 1),
              "Pick a subset of items from a pool of bit vectors using the "
              "MaxMin Algorithm\n"
              "Ashton, M. et. al., Quant. Struct.-Act. Relat., 21 (2002), "
@@ -202,7 +221,10 @@ struct MaxMin_wrap {
              "  - firstPicks: (optional) the first items to be picked (seeds "
              "the list)\n"
              "  - seed: (optional) seed for the random number generator\n"
-             "  - useCache: IGNORED.\n")
+             "  - useCache: IGNORED.\n"
+             "  - numThreads: (optional) the number of threads to use. The "
+             "picks\n"
+             "                don't depend on the number of threads.\n")
 
         .def("LazyPickWithThreshold", RDPickers::LazyMaxMinPicksWithThreshold,
              (python::arg("self"), python::arg("distFunc"),
@@ -235,7 +257,7 @@ struct MaxMin_wrap {
               python::arg("poolSize"), python::arg("pickSize"),
               python::arg("threshold"),
               python::arg("firstPicks") = python::tuple(),
-              python::arg("seed") = -1),
+              python::arg("seed") = -1, python::arg("numThreads") = 1),
              "Pick a subset of items from a pool of bit vectors using the "
              "MaxMin Algorithm\n"
              "Ashton, M. et. al., Quant. Struct.-Act. Relat., 21 (2002), "
@@ -249,7 +271,10 @@ struct MaxMin_wrap {
              "value\n"
              "  - firstPicks: (optional) the first items to be picked (seeds "
              "the list)\n"
-             "  - seed: (optional) seed for the random number generator\n");
+             "  - seed: (optional) seed for the random number generator\n"
+             "  - numThreads: (optional) the number of threads to use. The "
+             "picks\n"
+             "                don't depend on the number of threads.\n");
   };
 };
 
@@ -17,6 +17,7 @@ namespace python = boost::python;
 void wrap_maxminpick();
 void wrap_leaderpick();
 void wrap_HierarchCP();
+void wrap_butina();
 
 BOOST_PYTHON_MODULE(rdSimDivPickers) {
   python::scope().attr("__doc__") =
@@ -27,4 +28,5 @@ BOOST_PYTHON_MODULE(rdSimDivPickers) {
   wrap_maxminpick();
   wrap_leaderpick();
   wrap_HierarchCP();
+  wrap_butina();
 }
@@ -6,6 +6,7 @@ import numpy
 
 from rdkit import DataStructs, RDConfig
 from rdkit.DataManip.Metric import rdMetricMatrixCalc as rdmmc
+from rdkit.ML.Cluster import Butina
 from rdkit.SimDivFilters import rdSimDivPickers
 
 
@@ -262,6 +263,17 @@ class TestCase(unittest.TestCase):
     self.assertEqual(list(ids), [374, 720, 690, 339, 875, 842, 404, 725, 120, 385, 115, 868, 630])
     self.assertTrue(threshold >= 0.91)
 
+    # multithreaded picking gives the same results
+    ids, threshold = mmp.LazyBitVectorPickWithThreshold(fps, len(fps), 20, -1.0, seed=42,
+                                                        numThreads=2)
+    self.assertEqual(list(ids), [
+      374, 720, 690, 339, 875, 842, 404, 725, 120, 385, 115, 868, 630, 881, 516, 497, 412, 718, 869,
+      407
+    ])
+    self.assertAlmostEqual(threshold, 0.8977, 4)
+    ids = mmp.LazyBitVectorPick(fps, len(fps), 20, seed=42, numThreads=2)
+    self.assertEqual(list(ids)[:5], [374, 720, 690, 339, 875])
+
   def testBitVectorLeader1(self):
     # threshold tests
     fname = os.path.join(RDConfig.RDBaseDir, 'Code', 'SimDivPickers', 'Wrap', 'test_data',
@@ -294,6 +306,55 @@ class TestCase(unittest.TestCase):
         self.assertGreaterEqual(1 - DataStructs.TanimotoSimilarity(fps[ids[i]], fps[ids[j]]),
                                 thresh)
 
+  def testButinaBitVects(self):
+    fname = os.path.join(RDConfig.RDBaseDir, 'Code', 'SimDivPickers', 'Wrap', 'test_data',
+                         'chembl_cyps.head.fps')
+    fps = []
+    with open(fname) as infil:
+      for line in infil:
+        fp = DataStructs.CreateFromFPSText(line.strip())
+        fps.append(fp)
+    fps = fps[:200]
+    dists = []
+    for i in range(1, len(fps)):
+      dists.extend(DataStructs.BulkTanimotoSimilarity(fps[i], fps[:i], returnDistance=True))
+    for reordering in (False, True):
+      expected = Butina.ClusterData(dists, len(fps), 0.6, isDistData=True,
+                                    reordering=reordering)
+      clusters = rdSimDivPickers.ButinaClusterBitVects(fps, 0.6, reordering=reordering)
+      self.assertEqual(clusters, expected)
+      self.assertEqual(
+        rdSimDivPickers.ButinaClusterBitVects(fps, 0.6, reordering=reordering, numThreads=2),
+        expected)
+
+  def testHierarchBitVects(self):
+    fname = os.path.join(RDConfig.RDBaseDir, 'Code', 'SimDivPickers', 'Wrap', 'test_data',
+                         'chembl_cyps.head.fps')
+    fps = []
+    with open(fname) as infil:
+      for line in infil:
+        fp = DataStructs.CreateFromFPSText(line.strip())
+        fps.append(fp)
+    fps = fps[:200]
+    dists = []
+    for i in range(1, len(fps)):
+      dists.extend(DataStructs.BulkTanimotoSimilarity(fps[i], fps[:i], returnDistance=True))
+    # the bit vector clustering uses single precision distances
+    dists = numpy.array(dists, numpy.float32).astype(numpy.float64)
+    pkr = rdSimDivPickers.HierarchicalClusterPicker(rdSimDivPickers.ClusterMethod.WARD)
+    expected = sorted(sorted(x) for x in pkr.Cluster(dists, len(fps), 20))
+    clusters = pkr.ClusterBitVects(fps, 20)
+    self.assertEqual(sorted(sorted(x) for x in clusters), expected)
+    self.assertEqual(pkr.ClusterBitVects(fps, 20, numThreads=2), clusters)
+    picks = pkr.PickBitVects(fps, 20)
+    self.assertEqual(len(picks), 20)
+    for pick, cluster in zip(picks, clusters):
+      self.assertIn(pick, cluster)
+
+    pkr = rdSimDivPickers.HierarchicalClusterPicker(rdSimDivPickers.ClusterMethod.CENTROID)
+    with self.assertRaises(ValueError):
+      pkr.ClusterBitVects(fps, 20)
+
   def testLazyLeader(self):
     pkr = rdSimDivPickers.LeaderPicker()
 
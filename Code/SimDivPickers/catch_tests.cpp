@@ -14,7 +14,11 @@
 #include <DataStructs/ExplicitBitVect.h>
 #include <DataStructs/BitOps.h>
 #include <SimDivPickers/LeaderPicker.h>
+#include <SimDivPickers/ButinaClustering.h>
+#include <SimDivPickers/HierarchicalClusterPicker.h>
+#include <SimDivPickers/MaxMinPicker.h>
 
+#include <filesystem>
 #include <fstream>
 
 template <typename T>
@@ -83,3 +87,300 @@ TEST_CASE(
   }
 #endif
 }
+
+namespace {
+std::vector<std::unique_ptr<ExplicitBitVect>> readChemblFPs() {
+  std::string rdbase = getenv("RDBASE");
+  std::string fName =
+      rdbase + "/Code/SimDivPickers/Wrap/test_data/chembl_cyps.head.fps";
+  std::ifstream inf(fName);
+  std::string fpsText;
+  std::getline(inf, fpsText);
+  std::vector<std::unique_ptr<ExplicitBitVect>> fps;
+  while (!inf.eof() && !fpsText.empty()) {
+    fps.emplace_back(new ExplicitBitVect(fpsText.size() * 4));
+    UpdateBitVectFromFPSText(*fps.back(), fpsText);
+    std::getline(inf, fpsText);
+  };
+  return fps;
+}
+
+// A direct translation of rdkit.ML.Cluster.Butina.ClusterData(), using the
+// full distance matrix.
+RDKit::VECT_INT_VECT referenceButina(
+    const std::vector<const ExplicitBitVect *> &fps, double distThresh,
+    bool reordering) {
+  const auto nPts = fps.size();
+  std::vector<std::vector<int>> nbrLists(nPts);
+  for (unsigned int i = 0; i < nPts; ++i) {
+    for (unsigned int j = 0; j < nPts; ++j) {
+      if (i == j || 1.0 - TanimotoSimilarity(*fps[i], *fps[j]) <= distThresh) {
+        nbrLists[i].push_back(j);
+      }
+    }
+  }
+  std::vector<std::pair<unsigned int, int>> sortedIndices;
+  for (unsigned int i = 0; i < nPts; ++i) {
+    sortedIndices.emplace_back(nbrLists[i].size(), i);
+  }
+  std::sort(sortedIndices.rbegin(), sortedIndices.rend());
+  std::vector<bool> seen(nPts, false);
+  RDKit::VECT_INT_VECT clusters;
+  while (!sortedIndices.empty()) {
+    auto idx = sortedIndices.front().second;
+    sortedIndices.erase(sortedIndices.begin());
+    if (seen[idx]) {
+      continue;
+    }
+    RDKit::INT_VECT cluster{idx};
+    seen[idx] = true;
+    for (auto nbr : nbrLists[idx]) {
+      if (!seen[nbr]) {
+        cluster.push_back(nbr);
+        seen[nbr] = true;
+      }
+    }
+    clusters.push_back(cluster);
+    if (reordering) {
+      for (auto &elem : sortedIndices) {
+        auto &nbrs = nbrLists[elem.second];
+        if (seen[elem.second]) {
+          continue;
+        }
+        std::erase_if(nbrs, [&seen](int nbr) { return seen[nbr]; });
+        elem.first = nbrs.size();
+      }
+      std::sort(sortedIndices.rbegin(), sortedIndices.rend());
+    }
+  }
+  return clusters;
+}
+}  // namespace
+
+TEST_CASE("Butina clustering", "[Butina]") {
+  auto fpOwners = readChemblFPs();
+  REQUIRE(fpOwners.size() == 1000);
+  std::vector<const ExplicitBitVect *> fps;
+  for (const auto &fp : fpOwners) {
+    fps.push_back(fp.get());
+  }
+
+  SECTION("neighbor lists") {
+    double distThresh = 0.6;
+    auto nbrLists = RDPickers::getTanimotoNeighborLists(fps, distThresh);
+    REQUIRE(nbrLists.size() == fps.size());
+    for (unsigned int i = 0; i < fps.size(); ++i) {
+      std::vector<std::uint32_t> expected;
+      for (unsigned int j = 0; j < fps.size(); ++j) {
+        if (i != j &&
+            1.0 - TanimotoSimilarity(*fps[i], *fps[j]) <= distThresh) {
+          expected.push_back(j);
+        }
+      }
+      CHECK(std::vector<std::uint32_t>(nbrLists.begin(i), nbrLists.end(i)) ==
+            expected);
+    }
+  }
+  SECTION("same as the Python implementation") {
+    for (auto distThresh : {0.3, 0.6}) {
+      for (auto reordering : {false, true}) {
+        auto clusters = RDPickers::butinaCluster(fps, distThresh, reordering);
+        auto expected = referenceButina(fps, distThresh, reordering);
+        CHECK(clusters == expected);
+        unsigned int numItems = 0;
+        for (const auto &cluster : clusters) {
+          numItems += cluster.size();
+        }
+        CHECK(numItems == fps.size());
+      }
+    }
+  }
+#ifdef RDK_BUILD_THREADSAFE_SSS
+  SECTION("multithreaded") {
+    auto nbrLists = RDPickers::getTanimotoNeighborLists(fps, 0.6);
+    auto nbrLists4 = RDPickers::getTanimotoNeighborLists(fps, 0.6, 4);
+    CHECK(nbrLists.offsets == nbrLists4.offsets);
+    CHECK(nbrLists.neighbors == nbrLists4.neighbors);
+    CHECK(RDPickers::butinaCluster(fps, 0.6, true, 4) ==
+          RDPickers::butinaCluster(nbrLists, true));
+  }
+#endif
+  SECTION("edge cases") {
+    CHECK(RDPickers::butinaCluster(std::vector<const ExplicitBitVect *>(), 0.5)
+              .empty());
+    auto clusters = RDPickers::butinaCluster(fps, 0.0);
+    // no duplicates in there
+    CHECK(clusters.size() > 900);
+    ExplicitBitVect shortFP(16);
+    fps.push_back(&shortFP);
+    CHECK_THROWS_AS(RDPickers::butinaCluster(fps, 0.5), ValueErrorException);
+  }
+}
+
+TEST_CASE("MaxMin bit vector picking", "[MaxMinPicker]") {
+  auto fpOwners = readChemblFPs();
+  REQUIRE(fpOwners.size() == 1000);
+  std::vector<const ExplicitBitVect *> fps;
+  for (const auto &fp : fpOwners) {
+    fps.push_back(fp.get());
+  }
+  BVFunctor<std::vector<const ExplicitBitVect *>> bvf(fps);
+  RDPickers::MaxMinPicker pkr;
+
+  SECTION("basics") {
+    RDKit::INT_VECT firstPicks;
+    double threshold = -1.0;
+    auto picks =
+        pkr.bitVectorPick(fps, fps.size(), 20, firstPicks, 42, threshold);
+    CHECK(picks == RDKit::INT_VECT{374, 720, 690, 339, 875, 842, 404,
+                                   725, 120, 385, 115, 868, 630, 881,
+                                   516, 497, 412, 718, 869, 407});
+    CHECK_THAT(threshold, Catch::Matchers::WithinAbs(0.8977, 1e-4));
+  }
+  SECTION("same as lazyPick") {
+    for (auto seed : {42, 0xf00d}) {
+      RDKit::INT_VECT firstPicks;
+      double lazyThreshold = -1.0;
+      auto expected = pkr.lazyPick(bvf, fps.size(), 100, firstPicks, seed,
+                                   lazyThreshold);
+      double threshold = -1.0;
+      auto picks = pkr.bitVectorPick(fps, fps.size(), 100, firstPicks, seed,
+                                     threshold);
+      CHECK(picks == expected);
+      CHECK(threshold == lazyThreshold);
+    }
+  }
+  SECTION("first picks and a subset of the pool") {
+    RDKit::INT_VECT firstPicks{10, 20, 30};
+    double lazyThreshold = -1.0;
+    auto expected =
+        pkr.lazyPick(bvf, 500, 50, firstPicks, -1, lazyThreshold);
+    double threshold = -1.0;
+    auto picks = pkr.bitVectorPick(fps, 500, 50, firstPicks, -1, threshold);
+    CHECK(picks == expected);
+    CHECK(std::ranges::all_of(picks, [](int pick) { return pick < 500; }));
+
+    threshold = -1.0;
+    CHECK(pkr.bitVectorPick(fps, 500, 2, firstPicks, -1, threshold) ==
+          firstPicks);
+    CHECK(threshold == -1.0);
+  }
+  SECTION("threshold") {
+    RDKit::INT_VECT firstPicks;
+    double lazyThreshold = 0.8;
+    auto expected =
+        pkr.lazyPick(bvf, fps.size(), 200, firstPicks, 42, lazyThreshold);
+    double threshold = 0.8;
+    auto picks =
+        pkr.bitVectorPick(fps, fps.size(), 200, firstPicks, 42, threshold);
+    CHECK(picks.size() < 200);
+    CHECK(picks == expected);
+    CHECK(threshold == lazyThreshold);
+    CHECK(threshold > 0.8);
+  }
+#ifdef RDK_BUILD_THREADSAFE_SSS
+  SECTION("multithreaded") {
+    RDKit::INT_VECT firstPicks;
+    double threshold1 = -1.0;
+    auto picks1 =
+        pkr.bitVectorPick(fps, fps.size(), 150, firstPicks, 23, threshold1);
+    for (auto numThreads : {2, 3, 4}) {
+      double threshold = -1.0;
+      auto picks = pkr.bitVectorPick(fps, fps.size(), 150, firstPicks, 23,
+                                     threshold, numThreads);
+      CHECK(picks == picks1);
+      CHECK(threshold == threshold1);
+    }
+  }
+#endif
+  SECTION("errors") {
+    RDKit::INT_VECT firstPicks;
+    double threshold = -1.0;
+    CHECK_THROWS_AS(
+        pkr.bitVectorPick(fps, 2000, 10, firstPicks, 42, threshold),
+        ValueErrorException);
+    CHECK_THROWS_AS(pkr.bitVectorPick(fps, 100, 200, firstPicks, 42, threshold),
+                    ValueErrorException);
+    firstPicks.push_back(200);
+    CHECK_THROWS_AS(pkr.bitVectorPick(fps, 100, 20, firstPicks, 42, threshold),
+                    ValueErrorException);
+  }
+}
+
+namespace {
+RDKit::VECT_INT_VECT normalizeClusters(RDKit::VECT_INT_VECT clusters) {
+  for (auto &cluster : clusters) {
+    std::sort(cluster.begin(), cluster.end());
+  }
+  std::sort(clusters.begin(), clusters.end());
+  return clusters;
+}
+}  // namespace
+
+TEST_CASE("Hierarchical clustering of bit vectors",
+          "[HierarchicalClusterPicker]") {
+  auto fpOwners = readChemblFPs();
+  std::vector<const ExplicitBitVect *> fps;
+  for (const auto &fp : fpOwners) {
+    fps.push_back(fp.get());
+  }
+  constexpr unsigned int poolSize = 200;
+  // the distances are rounded to single precision, as in clusterBitVects().
+  // The Murtagh code modifies the matrix, so each call gets a copy.
+  std::vector<double> distMat;
+  for (unsigned int i = 1; i < poolSize; ++i) {
+    for (unsigned int j = 0; j < i; ++j) {
+      distMat.push_back(static_cast<float>(
+          1.0 - TanimotoSimilarity(*fps[i], *fps[j])));
+    }
+  }
+  SECTION("same clusters as the distance matrix version") {
+    for (auto method : {RDPickers::HierarchicalClusterPicker::WARD,
+                        RDPickers::HierarchicalClusterPicker::SLINK,
+                        RDPickers::HierarchicalClusterPicker::CLINK,
+                        RDPickers::HierarchicalClusterPicker::UPGMA,
+                        RDPickers::HierarchicalClusterPicker::MCQUITTY}) {
+      RDPickers::HierarchicalClusterPicker pkr(method);
+      for (auto pickSize : {1u, 10u, 50u, poolSize}) {
+        INFO("method " << method << " pickSize " << pickSize);
+        auto dists = distMat;
+        auto ref = pkr.cluster(dists.data(), poolSize, pickSize);
+        auto clusters = pkr.clusterBitVects(fps, poolSize, pickSize);
+        CHECK(clusters.size() == pickSize);
+        CHECK(normalizeClusters(clusters) == normalizeClusters(ref));
+      }
+    }
+  }
+  SECTION("threads and matrix files") {
+    RDPickers::HierarchicalClusterPicker pkr(
+        RDPickers::HierarchicalClusterPicker::WARD);
+    auto clusters = pkr.clusterBitVects(fps, poolSize, 20);
+    CHECK(pkr.clusterBitVects(fps, poolSize, 20, 4) == clusters);
+    auto fileName =
+        (std::filesystem::temp_directory_path() / "rdkit_hc_dists.bin")
+            .string();
+    CHECK(pkr.clusterBitVects(fps, poolSize, 20, 2, fileName) == clusters);
+    CHECK(!std::filesystem::exists(fileName));
+
+    auto picks = pkr.pickBitVects(fps, poolSize, 20);
+    REQUIRE(picks.size() == clusters.size());
+    for (unsigned int i = 0; i < picks.size(); ++i) {
+      CHECK(std::find(clusters[i].begin(), clusters[i].end(), picks[i]) !=
+            clusters[i].end());
+    }
+    CHECK(pkr.pickBitVects(fps, poolSize, 20, 3) == picks);
+  }
+  SECTION("errors") {
+    RDPickers::HierarchicalClusterPicker pkr(
+        RDPickers::HierarchicalClusterPicker::CENTROID);
+    CHECK_THROWS_AS(pkr.clusterBitVects(fps, poolSize, 20),
+                    ValueErrorException);
+    RDPickers::HierarchicalClusterPicker pkr2(
+        RDPickers::HierarchicalClusterPicker::WARD);
+    CHECK_THROWS_AS(pkr2.clusterBitVects(fps, poolSize, 0),
+                    ValueErrorException);
+    CHECK_THROWS_AS(pkr2.clusterBitVects(fps, 10, 20), ValueErrorException);
+    CHECK_THROWS_AS(pkr2.clusterBitVects(fps, fps.size() + 1, 20),
+                    ValueErrorException);
+  }
+}
@@ -0,0 +1,62 @@
+//
+//  Copyright (C) 2026 Greg Landrum and other RDKit contributors
+//   @@ All Rights Reserved @@
+//  This file is part of the RDKit.
+//  The contents are covered by the terms of the BSD license
+//  which is included in the file license.txt, found at the root
+//  of the RDKit source tree.
+//
+#include <nanobind/nanobind.h>
+
+#include <DataStructs/BitVects.h>
+#include <SimDivPickers/ButinaClustering.h>
+
+namespace nb = nanobind;
+using namespace nb::literals;
+
+namespace RDPickers {
+namespace {
+nb::tuple ButinaClusterBitVects(nb::object objs, double distThresh,
+                                bool reordering, int numThreads) {
+  auto poolSize = nb::len(objs);
+  std::vector<const ExplicitBitVect *> bvs(poolSize);
+  for (size_t i = 0; i < poolSize; ++i) {
+    bvs[i] = nb::cast<const ExplicitBitVect *>(objs[i]);
+  }
+  RDKit::VECT_INT_VECT clusters;
+  {
+    nb::gil_scoped_release release;
+    clusters = butinaCluster(bvs, distThresh, reordering, numThreads);
+  }
+  nb::list res;
+  for (const auto &cluster : clusters) {
+    nb::list members;
+    for (auto member : cluster) {
+      members.append(member);
+    }
+    res.append(nb::tuple(members));
+  }
+  return nb::tuple(res);
+}
+}  // end of anonymous namespace
+}  // end of namespace RDPickers
+
+void wrap_butina(nb::module_ &m) {
+  m.def("ButinaClusterBitVects", RDPickers::ButinaClusterBitVects,
+        "objects"_a, "distThresh"_a, "reordering"_a = false,
+        "numThreads"_a = 1,
+        R"DOC(Butina clustering of a collection of bit vectors using the Tanimoto
+distance, without building the full distance matrix. The results
+are the same as rdkit.ML.Cluster.Butina.ClusterData().
+
+ARGUMENTS:
+  - objects: the bit vectors, which must all be the same length
+  - distThresh: items within this distance (1-similarity) of each
+    other are considered to be neighbors
+  - reordering: update the number of neighbors of the unassigned
+    items after each cluster is created
+  - numThreads: the number of threads to use for finding neighbors
+
+RETURNS: a tuple of clusters, each a tuple with its centroid first
+)DOC");
+}
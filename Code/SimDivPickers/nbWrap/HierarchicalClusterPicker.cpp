@@ -7,9 +7,11 @@
 //  of the RDKit source tree.
 //
 #include <nanobind/nanobind.h>
+#include <nanobind/stl/string.h>
 #include <nanobind/stl/vector.h>
 #include <nanobind/ndarray.h>
 
+#include <DataStructs/BitVects.h>
 #include <SimDivPickers/DistPicker.h>
 #include <SimDivPickers/HierarchicalClusterPicker.h>
 
@@ -40,6 +42,36 @@ RDKit::VECT_INT_VECT HierarchicalClusters(HierarchicalClusterPicker *picker,
   return picker->cluster(dMatCopy.data(), poolSize, pickSize);
 }
 
+namespace {
+std::vector<const ExplicitBitVect *> extractBitVects(nb::object objs) {
+  auto poolSize = nb::len(objs);
+  std::vector<const ExplicitBitVect *> bvs(poolSize);
+  for (size_t i = 0; i < poolSize; ++i) {
+    bvs[i] = nb::cast<const ExplicitBitVect *>(objs[i]);
+  }
+  return bvs;
+}
+}  // namespace
+
+RDKit::INT_VECT HierarchicalBitVectPicks(HierarchicalClusterPicker *picker,
+                                         nb::object objs, int pickSize,
+                                         int numThreads,
+                                         const std::string &matrixFile) {
+  auto bvs = extractBitVects(objs);
+  nb::gil_scoped_release release;
+  return picker->pickBitVects(bvs, bvs.size(), pickSize, numThreads,
+                              matrixFile);
+}
+
+RDKit::VECT_INT_VECT HierarchicalBitVectClusters(
+    HierarchicalClusterPicker *picker, nb::object objs, int pickSize,
+    int numThreads, const std::string &matrixFile) {
+  auto bvs = extractBitVects(objs);
+  nb::gil_scoped_release release;
+  return picker->clusterBitVects(bvs, bvs.size(), pickSize, numThreads,
+                                 matrixFile);
+}
+
 }  // namespace RDPickers
 
 void wrap_HierarchCP(nb::module_ &m) {
@@ -65,6 +97,34 @@ ARGUMENTS:
   - distMat: 1D distance matrix (only the lower triangle elements)
   - poolSize: number of items in the pool
   - pickSize: number of items to pick from the pool
+)DOC")
+      .def("PickBitVects", RDPickers::HierarchicalBitVectPicks,
+           "objects"_a, "pickSize"_a, "numThreads"_a = 1,
+           "matrixFile"_a = std::string(""),
+           R"DOC(Pick a diverse subset of bit vectors using hierarchical clustering with the Tanimoto distance
+
+ARGUMENTS:
+  - objects: the bit vectors, which must all be the same length
+  - pickSize: number of items to pick
+  - numThreads: the number of threads to use
+  - matrixFile: (optional) the name of a scratch file to hold the
+    distance matrix, which is removed afterwards
+
+The GOWER and CENTROID methods are not supported.
+)DOC")
+      .def("ClusterBitVects", RDPickers::HierarchicalBitVectClusters,
+           "objects"_a, "pickSize"_a, "numThreads"_a = 1,
+           "matrixFile"_a = std::string(""),
+           R"DOC(Return a list of clusters of bit vectors using hierarchical clustering with the Tanimoto distance
+
+ARGUMENTS:
+  - objects: the bit vectors, which must all be the same length
+  - pickSize: number of clusters to create
+  - numThreads: the number of threads to use
+  - matrixFile: (optional) the name of a scratch file to hold the
+    distance matrix, which is removed afterwards
+
+The GOWER and CENTROID methods are not supported.
 )DOC");
 
   nb::enum_<RDPickers::HierarchicalClusterPicker::ClusterMethod>(
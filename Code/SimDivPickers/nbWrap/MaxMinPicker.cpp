@@ -58,6 +58,28 @@ void LazyMaxMinHelper(MaxMinPicker *picker, T functor, unsigned int poolSize,
   res = picker->lazyPick(functor, poolSize, pickSize, firstPickVect, seed,
                          threshold);
 }
+
+// With more than one thread the picks are made by
+// MaxMinPicker::bitVectorPick(), which gives the same results.
+void BitVectMaxMinHelper(MaxMinPicker *picker,
+                         const std::vector<const ExplicitBitVect *> &bvs,
+                         unsigned int poolSize, unsigned int pickSize,
+                         nb::object firstPicks, int seed,
+                         RDKit::INT_VECT &res, double &threshold,
+                         int numThreads) {
+  if (numThreads == 1) {
+    pyBVFunctor<ExplicitBitVect> functor(bvs, TANIMOTO);
+    LazyMaxMinHelper(picker, functor, poolSize, pickSize, firstPicks, seed,
+                     res, threshold);
+    return;
+  }
+  RDKit::INT_VECT firstPickVect;
+  for (unsigned int i = 0; i < nb::len(firstPicks); ++i) {
+    firstPickVect.push_back(nb::cast<int>(firstPicks[i]));
+  }
+  res = picker->bitVectorPick(bvs, poolSize, pickSize, firstPickVect, seed,
+                              threshold, numThreads);
+}
 }  // end of anonymous namespace
 
 RDKit::INT_VECT LazyMaxMinPicks(MaxMinPicker *picker, nb::object distFunc,
@@ -89,7 +111,7 @@ std::tuple<RDKit::INT_VECT, double> LazyMaxMinPicksWithThreshold(
 RDKit::INT_VECT LazyVectorMaxMinPicks(MaxMinPicker *picker, nb::object objs,
                                       int poolSize, int pickSize,
                                       nb::object firstPicks, int seed,
-                                      nb::object useCache) {
+                                      nb::object useCache, int numThreads) {
   if (!useCache.is_none()) {
     BOOST_LOG(rdWarningLog)
         << "the useCache argument is deprecated and ignored" << std::endl;
@@ -98,27 +120,23 @@ RDKit::INT_VECT LazyVectorMaxMinPicks(MaxMinPicker *picker, nb::object objs,
   for (int i = 0; i < poolSize; ++i) {
     bvs[i] = nb::cast<const ExplicitBitVect *>(objs[i]);
   }
-  pyBVFunctor<ExplicitBitVect> functor(bvs, TANIMOTO);
-
   RDKit::INT_VECT res;
   double threshold = -1.;
-  LazyMaxMinHelper(picker, functor, poolSize, pickSize, firstPicks, seed, res,
-                   threshold);
+  BitVectMaxMinHelper(picker, bvs, poolSize, pickSize, firstPicks, seed, res,
+                      threshold, numThreads);
   return res;
 }
 
 std::tuple<RDKit::INT_VECT, double> LazyVectorMaxMinPicksWithThreshold(
     MaxMinPicker *picker, nb::object objs, int poolSize, int pickSize,
-    double threshold, nb::object firstPicks, int seed) {
+    double threshold, nb::object firstPicks, int seed, int numThreads) {
   std::vector<const ExplicitBitVect *> bvs(poolSize);
   for (int i = 0; i < poolSize; ++i) {
     bvs[i] = nb::cast<const ExplicitBitVect *>(objs[i]);
   }
-  pyBVFunctor<ExplicitBitVect> functor(bvs, TANIMOTO);
-
   RDKit::INT_VECT res;
-  LazyMaxMinHelper(picker, functor, poolSize, pickSize, firstPicks, seed, res,
-                   threshold);
+  BitVectMaxMinHelper(picker, bvs, poolSize, pickSize, firstPicks, seed, res,
+                      threshold, numThreads);
   return std::make_tuple(res, threshold);
 }
 
@@ -164,7 +182,7 @@ ARGUMENTS:
       .def("LazyBitVectorPick", RDPickers::LazyVectorMaxMinPicks,
            "objects"_a, "poolSize"_a, "pickSize"_a,
            "firstPicks"_a = nb::tuple(), "seed"_a = -1,
-           "useCache"_a = nb::none(),
+           "useCache"_a = nb::none(), "numThreads"_a = 1,
            R"DOC(Pick a subset of items from a pool of bit vectors using the MaxMin Algorithm
 Ashton, M. et. al., Quant. Struct.-Act. Relat., 21 (2002), 598-604
 ARGUMENTS:
@@ -175,6 +193,8 @@ ARGUMENTS:
   - firstPicks: (optional) the first items to be picked (seeds the list)
   - seed: (optional) seed for the random number generator
   - useCache: IGNORED.
+  - numThreads: (optional) the number of threads to use. The picks
+                don't depend on the number of threads.
 )DOC")
 
       .def("LazyPickWithThreshold", RDPickers::LazyMaxMinPicksWithThreshold,
@@ -199,7 +219,7 @@ ARGUMENTS:
            RDPickers::LazyVectorMaxMinPicksWithThreshold,
            "objects"_a, "poolSize"_a, "pickSize"_a,
            "threshold"_a,
-           "firstPicks"_a = nb::tuple(), "seed"_a = -1,
+           "firstPicks"_a = nb::tuple(), "seed"_a = -1, "numThreads"_a = 1,
            R"DOC(Pick a subset of items from a pool of bit vectors using the MaxMin Algorithm
 Ashton, M. et. al., Quant. Struct.-Act. Relat., 21 (2002), 598-604
 ARGUMENTS:
@@ -210,5 +230,7 @@ ARGUMENTS:
   - threshold: stop picking when the distance goes below this value
   - firstPicks: (optional) the first items to be picked (seeds the list)
   - seed: (optional) seed for the random number generator
+  - numThreads: (optional) the number of threads to use. The picks
+                don't depend on the number of threads.
 )DOC");
 }
@@ -14,6 +14,7 @@ using namespace nb::literals;
 void wrap_maxminpick(nb::module_ &m);
 void wrap_leaderpick(nb::module_ &m);
 void wrap_HierarchCP(nb::module_ &m);
+void wrap_butina(nb::module_ &m);
 
 NB_MODULE(rdSimDivPickers, m) {
   m.doc() = "Module containing the diversity and similarity pickers";
@@ -21,4 +22,5 @@ NB_MODULE(rdSimDivPickers, m) {
   wrap_maxminpick(m);
   wrap_leaderpick(m);
   wrap_HierarchCP(m);
+  wrap_butina(m);
 }